@@ -60,6 +60,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/linalg/FlexibleSolver4.cpp
   opm/simulators/linalg/FlexibleSolver5.cpp
   opm/simulators/linalg/FlexibleSolver6.cpp
+  opm/simulators/linalg/HybridSolverSelector.cpp
   opm/simulators/linalg/ISTLSolverEbos.cpp
   opm/simulators/linalg/MILU.cpp
   opm/simulators/linalg/ParallelIstlInformation.cpp
@@ -138,6 +139,7 @@ list (APPEND MAIN_SOURCE_FILES
   opm/simulators/wells/WellInterfaceFluidSystem.cpp
   opm/simulators/wells/WellInterfaceGeneric.cpp
   opm/simulators/wells/WellInterfaceIndices.cpp
+  opm/simulators/wells/WellIPRCurve.cpp
   opm/simulators/wells/WellProdIndexCalculator.cpp
   opm/simulators/wells/WellState.cpp
   opm/simulators/wells/WellTest.cpp
@@ -243,6 +245,7 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_ALQState.cpp
   tests/test_aquifergridutils.cpp
   tests/test_blackoil_amg.cpp
+  tests/test_blockkernels.cpp
   tests/test_convergenceoutputconfiguration.cpp
   tests/test_convergencereport.cpp
   tests/test_deferredlogger.cpp
@@ -252,24 +255,35 @@ list (APPEND TEST_SOURCE_FILES
   tests/test_flexiblesolver.cpp
   tests/test_glift1.cpp
   tests/test_graphcoloring.cpp
+  tests/test_groupcontrolsweeps.cpp
   tests/test_GroupState.cpp
+  tests/test_hybridsolverselector.cpp
+  tests/test_impesweights.cpp
   tests/test_invert.cpp
   tests/test_keyword_validator.cpp
   tests/test_LogOutputHelper.cpp
   tests/test_milu.cpp
+  tests/test_multirhsbicgstab.cpp
   tests/test_multmatrixtransposed.cpp
+  tests/test_networkpressures.cpp
+  tests/test_nonlinearsolver.cpp
   tests/test_norne_pvt.cpp
   tests/test_parallel_wbp_sourcevalues.cpp
   tests/test_parallelwellinfo.cpp
   tests/test_partitionCells.cpp
   tests/test_preconditionerfactory.cpp
+  tests/test_pressuretransfer.cpp
   tests/test_privarspacking.cpp
   tests/test_relpermdiagnostics.cpp
   tests/test_RestartSerialization.cpp
   tests/test_stoppedwells.cpp
   tests/test_timer.cpp
+  tests/test_timestepcontrol.cpp
   tests/test_vfpproperties.cpp
+  tests/test_wellhelpers.cpp
+  tests/test_welliprcurve.cpp
   tests/test_wellmodel.cpp
+  tests/test_welloperators.cpp
   tests/test_wellprodindexcalculator.cpp
   tests/test_wellstate.cpp
   )
@@ -416,6 +430,7 @@ list (APPEND PUBLIC_HEADER_FILES
   ebos/eclwriter.hh
   ebos/femcpgridcompat.hh
   ebos/hdf5serializer.hh
+  ebos/memoryserializer.hh
   ebos/vtkecltracermodule.hh
   opm/simulators/flow/countGlobalCells.hpp
   opm/simulators/flow/priVarsPacking.hpp
@@ -476,25 +491,34 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/linalg/bda/WellContributions.hpp
   opm/simulators/linalg/amgcpr.hh
   opm/simulators/linalg/twolevelmethodcpr.hh
+  opm/simulators/linalg/BlockKernels.hpp
   opm/simulators/linalg/ExtractParallelGridInformationToISTL.hpp
   opm/simulators/linalg/FlexibleSolver.hpp
   opm/simulators/linalg/FlexibleSolver_impl.hpp
   opm/simulators/linalg/FlowLinearSolverParameters.hpp
   opm/simulators/linalg/GraphColoring.hpp
+  opm/simulators/linalg/HybridSolverSelector.hpp
   opm/simulators/linalg/ISTLSolverEbos.hpp
   opm/simulators/linalg/ISTLSolverEbosBda.hpp
   opm/simulators/linalg/MatrixMarketSpecializations.hpp
+  opm/simulators/linalg/MergedReduction.hpp
+  opm/simulators/linalg/MultiRhsBiCGSTAB.hpp
   opm/simulators/linalg/OwningBlockPreconditioner.hpp
   opm/simulators/linalg/OwningTwoLevelPreconditioner.hpp
   opm/simulators/linalg/ParallelOverlappingILU0.hpp
   opm/simulators/linalg/ParallelRestrictedAdditiveSchwarz.hpp
   opm/simulators/linalg/ParallelIstlInformation.hpp
+  opm/simulators/linalg/PipelinedBiCGSTABSolver.hpp
   opm/simulators/linalg/PressureSolverPolicy.hpp
+  opm/simulators/linalg/PressureTransferHelpers.hpp
   opm/simulators/linalg/PressureTransferPolicy.hpp
   opm/simulators/linalg/PreconditionerFactory.hpp
   opm/simulators/linalg/PreconditionerWithUpdate.hpp
   opm/simulators/linalg/PropertyTree.hpp
+  opm/simulators/linalg/RecyclingGMResSolver.hpp
+  opm/simulators/linalg/SStepGMResSolver.hpp
   opm/simulators/linalg/SmallDenseMatrixUtils.hpp
+  opm/simulators/linalg/ThreadedSmoothers.hpp
   opm/simulators/linalg/WellOperators.hpp
   opm/simulators/linalg/WriteSystemMatrixHelper.hpp
   opm/simulators/linalg/extractMatrix.hpp
@@ -584,6 +608,7 @@ list (APPEND PUBLIC_HEADER_FILES
   opm/simulators/wells/WellInterface.hpp
   opm/simulators/wells/WellInterfaceGeneric.hpp
   opm/simulators/wells/WellInterface_impl.hpp
+  opm/simulators/wells/WellIPRCurve.hpp
   opm/simulators/wells/WellProdIndexCalculator.hpp
   opm/simulators/wells/WellState.hpp
   opm/simulators/wells/WellTest.hpp
@@ -598,6 +623,7 @@ if(HDF5_FOUND)
 endif()
 
 list (APPEND EXAMPLE_SOURCE_FILES
+  examples/blockkernels_benchmark.cpp
   examples/printvfp.cpp
 )
 if(HDF5_FOUND)
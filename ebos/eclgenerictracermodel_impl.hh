@@ -49,6 +49,7 @@
 #include <opm/models/discretization/ecfv/ecfvstencil.hh>
 
 #include <opm/simulators/linalg/ilufirstelement.hh>
+#include <opm/simulators/linalg/MultiRhsBiCGSTAB.hpp>
 #include <opm/simulators/linalg/PropertyTree.hpp>
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
 
@@ -350,29 +351,11 @@ linearSolveBatchwise_(const TracerMatrix& M, std::vector<TracerVector>& x, std::
     else
     {
 #endif
-        using TracerSolver = Dune::BiCGSTABSolver<TracerVector>;
-        using TracerOperator = Dune::MatrixAdapter<TracerMatrix,TracerVector,TracerVector>;
-        using TracerScalarProduct = Dune::SeqScalarProduct<TracerVector>;
-        using TracerPreconditioner = Dune::SeqILU< TracerMatrix,TracerVector,TracerVector>;
-
-        TracerOperator tracerOperator(M);
-        TracerScalarProduct tracerScalarProduct;
-        TracerPreconditioner tracerPreconditioner(M, 0, 1); // results in ILU0
-
-        TracerSolver solver (tracerOperator, tracerScalarProduct,
-                             tracerPreconditioner, tolerance, maxIter,
-                             verbosity);
-
-        bool converged = true;
-        for (std::size_t nrhs = 0; nrhs < b.size(); ++nrhs) {
-            x[nrhs] = 0.0;
-            Dune::InverseOperatorResult result;
-            solver.apply(x[nrhs], b[nrhs], result);
-            converged = (converged && result.converged);
-        }
-
-        // return the result of the solver
-        return converged;
+        // All tracers of a batch share the matrix, so solve them as one
+        // multi right-hand side system: a single ILU0 factorisation and one
+        // traversal of matrix and factors per iteration for all tracers.
+        MultiRhsBiCGSTAB<TracerMatrix> solver(M, tolerance, maxIter, verbosity);
+        return solver.apply(x, b);
 #if HAVE_MPI
     }
 #endif
@@ -882,6 +882,26 @@ public:
     const typename Vanguard::TransmissibilityType& eclTransmissibilities() const
     { return transmissibilities_; }
 
+    /*!
+     * \brief Scale the intrinsic permeability of each element and recompute the
+     *        transmissibilities.
+     *
+     * This is meant for in-process model updates, e.g. from the Python bindings. The
+     * connection transmissibility factors of the wells are not affected.
+     */
+    void setPermeabilityMultipliers(std::vector<Scalar> multipliers)
+    {
+        auto& simulator = this->simulator();
+        std::function<unsigned int(unsigned int)> gridToEquilGrid = [&simulator](unsigned int i) {
+            return simulator.vanguard().gridIdxToEquilGridIdx(i);
+        };
+
+        transmissibilities_.setPermeabilityMultipliers(std::move(multipliers));
+        transmissibilities_.update(true, gridToEquilGrid);
+        updatePffDofData_();
+        this->model().linearizer().updateDiscretizationParameters();
+    }
+
     /*!
      * \copydoc BlackOilBaseProblem::thresholdPressure
      */
@@ -32,6 +32,8 @@
 
 #include <opm/common/OpmLog/OpmLog.hpp>
 
+#include <opm/input/eclipse/EclipseState/Grid/FaceDir.hpp>
+
 #include <opm/models/utils/propertysystem.hh>
 
 #include <opm/simulators/utils/VectorVectorDataHandle.hpp>
@@ -78,16 +80,20 @@ class EclTracerModel : public EclGenericTracerModel<GetPropType<TypeTag, Propert
     using Stencil = GetPropType<TypeTag, Properties::Stencil>;
     using FluidSystem = GetPropType<TypeTag, Properties::FluidSystem>;
     using ElementContext = GetPropType<TypeTag, Properties::ElementContext>;
+    using IntensiveQuantities = GetPropType<TypeTag, Properties::IntensiveQuantities>;
+    using ExtensiveQuantities = GetPropType<TypeTag, Properties::ExtensiveQuantities>;
+    using Evaluation = GetPropType<TypeTag, Properties::Evaluation>;
+    using Element = typename GridView::template Codim<0>::Entity;
     using RateVector = GetPropType<TypeTag, Properties::RateVector>;
     using Indices = GetPropType<TypeTag, Properties::Indices>;
 
-    using TracerEvaluation = DenseAd::Evaluation<Scalar,1>;
-
     using TracerMatrix = typename BaseType::TracerMatrix;
     using TracerVector = typename BaseType::TracerVector;
 
     enum { numEq = getPropValue<TypeTag, Properties::NumEq>() };
     enum { numPhases = FluidSystem::numPhases };
+    enum { dimWorld = GridView::dimensionworld };
+    enum { enablePolymer = getPropValue<TypeTag, Properties::EnablePolymer>() };
     enum { waterPhaseIdx = FluidSystem::waterPhaseIdx };
     enum { oilPhaseIdx = FluidSystem::oilPhaseIdx };
     enum { gasPhaseIdx = FluidSystem::gasPhaseIdx };
@@ -221,15 +227,10 @@ public:
 
 protected:
 
-    // evaluate water storage volume(s) in a single cell
-    template <class LhsEval>
-    void computeVolume_(LhsEval& freeVolume,
-                        const int tracerPhaseIdx,
-                        const ElementContext& elemCtx,
-                        unsigned scvIdx,
-                        unsigned timeIdx)
+    // evaluate the free volume of the tracer phase in a single cell
+    Scalar computeFreeVolume_(const int tracerPhaseIdx,
+                              const IntensiveQuantities& intQuants) const
     {
-        const auto& intQuants = elemCtx.intensiveQuantities(scvIdx, timeIdx);
         const auto& fs = intQuants.fluidState();
         Scalar phaseVolume =
             decay<Scalar>(fs.saturation(tracerPhaseIdx))
@@ -237,105 +238,227 @@ protected:
             *decay<Scalar>(intQuants.porosity());
 
         // avoid singular matrix if no water is present.
-        phaseVolume = max(phaseVolume, 1e-10);
+        return max(phaseVolume, 1e-10);
+    }
 
-        if (std::is_same<LhsEval, Scalar>::value)
-            freeVolume = phaseVolume;
-        else
-            freeVolume = phaseVolume * variable<LhsEval>(1.0, 0);
+    // Return the cached intensive quantities of a cell, falling back to
+    // evaluating them if the cache entry is not available.
+    const IntensiveQuantities& intensiveQuantities_(ElementContext& elemCtx,
+                                                    const Element& elem,
+                                                    const unsigned globalDofIdx) const
+    {
+        const auto* intQuants = simulator_.model().cachedIntensiveQuantities(globalDofIdx, /*timeIdx=*/0);
+        if (intQuants) {
+            return *intQuants;
+        }
 
+        elemCtx.updatePrimaryStencil(elem);
+        elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
+        return elemCtx.intensiveQuantities(/*dofIdx=*/0, /*timeIdx=*/0);
     }
 
-    // evaluate the flux(es) over one face
-    void computeFlux_(TracerEvaluation & freeFlux,
-                      bool & isUpFree,
-                      const int tracerPhaseIdx,
-                      const ElementContext& elemCtx,
-                      unsigned scvfIdx,
-                      unsigned timeIdx)
+    // Evaluate the phase fluxes over all interior faces of the local
+    // partition once and store them, along with the free volumes of the
+    // cells. The per-batch assembly then only loops over these arrays.
+    void updateFaceFluxes_()
+    {
+        const auto& gridView = simulator_.gridView();
+        const std::size_t numGridDof = simulator_.model().numGridDof();
+
+        faceFluxes_.clear();
+        interiorCells_.clear();
+        overlapCells_.clear();
+        freeVolume_.resize(numGridDof);
+
+        ElementContext elemCtx(simulator_);
+        for (const auto& elem : elements(gridView)) {
+            elemCtx.updateStencil(elem);
+            const unsigned I = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timeIdx=*/0);
+
+            if (elem.partitionType() != Dune::InteriorEntity) {
+                overlapCells_.push_back(I);
+                continue;
+            }
+            interiorCells_.push_back(I);
 
+            if (!this->addCachedFaceFluxes_(elemCtx, I)) {
+                this->addFaceFluxes_(elemCtx, I);
+            }
+        }
+    }
+
+    // Evaluate the fluxes of an element from the cached intensive quantities
+    // of the cell and its neighbours, the way the transmissibility flux module
+    // does, without updating the intensive and extensive quantities of the
+    // element context. Returns false if a cache entry is not available or
+    // the polymer module modifies the fluxes in the extensive quantities.
+    bool addCachedFaceFluxes_(const ElementContext& elemCtx, const unsigned I)
     {
-        const auto& stencil = elemCtx.stencil(timeIdx);
-        const auto& scvf = stencil.interiorFace(scvfIdx);
+        if constexpr (enablePolymer) {
+            return false;
+        }
 
-        const auto& extQuants = elemCtx.extensiveQuantities(scvfIdx, timeIdx);
-        unsigned inIdx = extQuants.interiorIndex();
+        const auto& model = simulator_.model();
+        const auto& problem = simulator_.problem();
+        const auto& stencil = elemCtx.stencil(/*timeIdx=*/0);
+        const auto* intQuantsIn = model.cachedIntensiveQuantities(I, /*timeIdx=*/0);
+        if (!intQuantsIn) {
+            return false;
+        }
 
-        unsigned upIdx = extQuants.upstreamIndex(tracerPhaseIdx);
+        const std::size_t numInteriorFaces = elemCtx.numInteriorFaces(/*timIdx=*/0);
+        for (unsigned scvfIdx = 0; scvfIdx < numInteriorFaces; ++scvfIdx) {
+            const auto& scvf = stencil.interiorFace(scvfIdx);
+            const unsigned J = stencil.globalSpaceIndex(scvf.exteriorIndex());
+            if (!model.cachedIntensiveQuantities(J, /*timeIdx=*/0)) {
+                return false;
+            }
+        }
 
-        const auto& intQuants = elemCtx.intensiveQuantities(upIdx, timeIdx);
-        const auto& fs = intQuants.fluidState();
+        for (const auto& tr : tbatch) {
+            if (tr.numTracer() != 0) {
+                freeVolume_[I][tr.phaseIdx_] = computeFreeVolume_(tr.phaseIdx_, *intQuantsIn);
+            }
+        }
+
+        const Scalar g = problem.gravity()[dimWorld - 1];
+        const Scalar zIn = problem.dofCenterDepth(I);
+        const bool directionalRelperms = problem.materialLawManager()->hasDirectionalRelperms();
+        for (unsigned scvfIdx = 0; scvfIdx < numInteriorFaces; ++scvfIdx) {
+            const auto& scvf = stencil.interiorFace(scvfIdx);
+            const unsigned interiorDofIdx = scvf.interiorIndex();
+            const unsigned exteriorDofIdx = scvf.exteriorIndex();
+            const unsigned J = stencil.globalSpaceIndex(exteriorDofIdx);
+            const auto& intQuantsEx = *model.cachedIntensiveQuantities(J, /*timeIdx=*/0);
+            const Scalar trans = problem.transmissibility(I, J);
+            const Scalar thpres = problem.thresholdPressure(I, J);
+            const Scalar distZg = (zIn - problem.dofCenterDepth(J)) * g;
+            const Scalar Vin = stencil.subControlVolume(interiorDofIdx).volume();
+            const Scalar Vex = stencil.subControlVolume(exteriorDofIdx).volume();
+            const FaceDir::DirEnum facedir = directionalRelperms
+                ? scvf.faceDirFromDirId() : FaceDir::DirEnum::Unknown;
+
+            TracerFaceFlux faceFlux;
+            faceFlux.interiorIdx = I;
+            faceFlux.exteriorIdx = J;
+            for (const auto& tr : tbatch) {
+                if (tr.numTracer() == 0)
+                    continue;
 
-        Scalar A = scvf.area();
-        Scalar v = decay<Scalar>(extQuants.volumeFlux(tracerPhaseIdx));
-        Scalar b = decay<Scalar>(fs.invB(tracerPhaseIdx));
+                short upIdx = 0;
+                short dnIdx = 0;
+                Evaluation pressureDifference = 0.0;
+                ExtensiveQuantities::calculatePhasePressureDiff_(upIdx, dnIdx, pressureDifference,
+                                                                 *intQuantsIn, intQuantsEx,
+                                                                 tr.phaseIdx_,
+                                                                 interiorDofIdx, exteriorDofIdx,
+                                                                 Vin, Vex, I, J, distZg, thpres);
+                const bool interiorIsUpstream = static_cast<unsigned>(upIdx) == interiorDofIdx;
+                faceFlux.interiorIsUpstream[tr.phaseIdx_] = interiorIsUpstream;
+                if (pressureDifference == 0) {
+                    continue;
+                }
+
+                // The face area of the volume flux cancels with the one of
+                // the flux over the face.
+                const auto& up = interiorIsUpstream ? *intQuantsIn : intQuantsEx;
+                const Scalar mob = decay<Scalar>(up.mobility(tr.phaseIdx_, facedir));
+                const Scalar transMult = decay<Scalar>(up.rockCompTransMultiplier());
+                const Scalar b = decay<Scalar>(up.fluidState().invB(tr.phaseIdx_));
+                faceFlux.flux[tr.phaseIdx_] =
+                    -decay<Scalar>(pressureDifference) * mob * transMult * trans * b;
+            }
+            faceFluxes_.push_back(faceFlux);
+        }
+        return true;
+    }
+
+    // Evaluate the fluxes of an element from the extensive quantities of
+    // the element context.
+    void addFaceFluxes_(ElementContext& elemCtx, const unsigned I)
+    {
+        elemCtx.updateAllIntensiveQuantities();
+        elemCtx.updateAllExtensiveQuantities();
 
-        if (inIdx == upIdx) {
-            freeFlux = A*v*b*variable<TracerEvaluation>(1.0, 0);
-            isUpFree = true;
+        const auto& intQuants = elemCtx.intensiveQuantities(/*dofIdx=*/ 0, /*timeIdx=*/0);
+        for (const auto& tr : tbatch) {
+            if (tr.numTracer() != 0) {
+                freeVolume_[I][tr.phaseIdx_] = computeFreeVolume_(tr.phaseIdx_, intQuants);
+            }
         }
-        else {
-            freeFlux = A*v*b*1.0;
-            isUpFree = false;
+
+        const auto& stencil = elemCtx.stencil(/*timeIdx=*/0);
+        const std::size_t numInteriorFaces = elemCtx.numInteriorFaces(/*timIdx=*/0);
+        for (unsigned scvfIdx = 0; scvfIdx < numInteriorFaces; ++scvfIdx) {
+            const auto& scvf = stencil.interiorFace(scvfIdx);
+            const auto& extQuants = elemCtx.extensiveQuantities(scvfIdx, /*timeIdx=*/0);
+            const unsigned inIdx = extQuants.interiorIndex();
+
+            TracerFaceFlux faceFlux;
+            faceFlux.interiorIdx = I;
+            faceFlux.exteriorIdx = elemCtx.globalSpaceIndex(scvf.exteriorIndex(), /*timeIdx=*/0);
+            for (const auto& tr : tbatch) {
+                if (tr.numTracer() == 0)
+                    continue;
+
+                const unsigned upIdx = extQuants.upstreamIndex(tr.phaseIdx_);
+                const auto& fs = elemCtx.intensiveQuantities(upIdx, /*timeIdx=*/0).fluidState();
+                const Scalar A = scvf.area();
+                const Scalar v = decay<Scalar>(extQuants.volumeFlux(tr.phaseIdx_));
+                const Scalar b = decay<Scalar>(fs.invB(tr.phaseIdx_));
+                faceFlux.flux[tr.phaseIdx_] = A*v*b;
+                faceFlux.interiorIsUpstream[tr.phaseIdx_] = (inIdx == upIdx);
+            }
+            faceFluxes_.push_back(faceFlux);
         }
     }
 
     template<class TrRe>
     void assembleTracerEquationVolume(TrRe& tr,
-                                      const ElementContext& elemCtx,
-                                      const Scalar scvVolume,
-                                      const Scalar dt,
-                                      unsigned I,
-                                      unsigned I1)
-
+                                      const Scalar dt)
     {
         if (tr.numTracer() == 0)
             return;
 
-        std::vector<Scalar> storageOfTimeIndex1(tr.numTracer());
-        if (elemCtx.enableStorageCache()) {
-            for (int tIdx = 0; tIdx < tr.numTracer(); ++tIdx) {
-                storageOfTimeIndex1[tIdx] = tr.storageOfTimeIndex1_[tIdx][I];
-            }
-        }
-        else {
-            Scalar fVolume1;
-            computeVolume_(fVolume1, tr.phaseIdx_, elemCtx, 0, /*timeIdx=*/1);
+        const auto& model = simulator_.model();
+        auto& mat = *tr.mat;
+        for (const unsigned I : interiorCells_) {
+            const Scalar scvVolume = model.dofTotalVolume(I);
+            const Scalar fVolume = freeVolume_[I][tr.phaseIdx_];
             for (int tIdx = 0; tIdx < tr.numTracer(); ++tIdx) {
-                storageOfTimeIndex1[tIdx] = fVolume1*tr.concentrationInitial_[tIdx][I1];
+                Scalar storageOfTimeIndex0 = fVolume*tr.concentration_[tIdx][I];
+                Scalar localStorage = (storageOfTimeIndex0 - tr.storageOfTimeIndex1_[tIdx][I]) * scvVolume/dt;
+                tr.residual_[tIdx][I][0] += localStorage; //residual + flux
             }
+            mat[I][I][0][0] += fVolume * scvVolume/dt;
         }
 
-        TracerEvaluation fVolume;
-        computeVolume_(fVolume, tr.phaseIdx_, elemCtx, 0, /*timeIdx=*/0);
-        for (int tIdx = 0; tIdx < tr.numTracer(); ++tIdx) {
-            Scalar storageOfTimeIndex0 = fVolume.value()*tr.concentration_[tIdx][I];
-            Scalar localStorage = (storageOfTimeIndex0 - storageOfTimeIndex1[tIdx]) * scvVolume/dt;
-            tr.residual_[tIdx][I][0] += localStorage; //residual + flux
+        // Dirichlet boundary conditions needed for the parallel matrix
+        for (const unsigned I : overlapCells_) {
+            mat[I][I][0][0] = 1.;
         }
-        (*tr.mat)[I][I][0][0] += fVolume.derivative(0) * scvVolume/dt;
     }
 
     template<class TrRe>
-    void assembleTracerEquationFlux(TrRe& tr,
-                                    const ElementContext& elemCtx,
-                                    unsigned scvfIdx,
-                                    unsigned I,
-                                    unsigned J)
+    void assembleTracerEquationFlux(TrRe& tr)
     {
         if (tr.numTracer() == 0)
             return;
 
-        TracerEvaluation flux;
-        bool isUpF;
-        computeFlux_(flux, isUpF, tr.phaseIdx_, elemCtx, scvfIdx, 0);
-        int globalUpIdx = isUpF ? I : J;
-        for (int tIdx =0; tIdx < tr.numTracer(); ++tIdx) {
-            tr.residual_[tIdx][I][0] += flux.value()*tr.concentration_[tIdx][globalUpIdx]; //residual + flux
-        }
-        if (isUpF) {
-            (*tr.mat)[J][I][0][0] = -flux.derivative(0);
-            (*tr.mat)[I][I][0][0] += flux.derivative(0);
+        auto& mat = *tr.mat;
+        for (const auto& faceFlux : faceFluxes_) {
+            const unsigned I = faceFlux.interiorIdx;
+            const unsigned J = faceFlux.exteriorIdx;
+            const Scalar flux = faceFlux.flux[tr.phaseIdx_];
+            const bool isUpF = faceFlux.interiorIsUpstream[tr.phaseIdx_];
+            const unsigned globalUpIdx = isUpF ? I : J;
+            for (int tIdx = 0; tIdx < tr.numTracer(); ++tIdx) {
+                tr.residual_[tIdx][I][0] += flux*tr.concentration_[tIdx][globalUpIdx]; //residual + flux
+            }
+            if (isUpF) {
+                mat[J][I][0][0] = -flux;
+                mat[I][I][0][0] += flux;
+            }
         }
     }
 
@@ -370,7 +493,7 @@ protected:
                 for (int tIdx = 0; tIdx < tr.numTracer(); ++tIdx) {
                     tr.residual_[tIdx][I][0] -= rate*tr.concentration_[tIdx][I];
                 }
-                (*tr.mat)[I][I][0][0] -= rate*variable<TracerEvaluation>(1.0, 0).derivative(0);
+                (*tr.mat)[I][I][0][0] -= rate;
             }
         }
     }
@@ -391,49 +514,12 @@ protected:
             }
         }
 
-        ElementContext elemCtx(simulator_);
-        for (const auto& elem : elements(simulator_.gridView())) {
-            elemCtx.updateStencil(elem);
-
-            std::size_t I = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timeIdx=*/0);
-
-            if (elem.partitionType() != Dune::InteriorEntity)
-            {
-                // Dirichlet boundary conditions needed for the parallel matrix
-                for (auto& tr : tbatch) {
-                    if (tr.numTracer() != 0)
-                        (*tr.mat)[I][I][0][0] = 1.;
-                }
-                continue;
-            }
-            elemCtx.updateAllIntensiveQuantities();
-            elemCtx.updateAllExtensiveQuantities();
-
-            Scalar extrusionFactor =
-                    elemCtx.intensiveQuantities(/*dofIdx=*/ 0, /*timeIdx=*/0).extrusionFactor();
-            Valgrind::CheckDefined(extrusionFactor);
-            assert(isfinite(extrusionFactor));
-            assert(extrusionFactor > 0.0);
-            Scalar scvVolume =
-                    elemCtx.stencil(/*timeIdx=*/0).subControlVolume(/*dofIdx=*/ 0).volume()
-                    * extrusionFactor;
-            Scalar dt = elemCtx.simulator().timeStepSize();
-
-            std::size_t I1 = elemCtx.globalSpaceIndex(/*dofIdx=*/ 0, /*timeIdx=*/1);
-
-            for (auto& tr : tbatch) {
-                this->assembleTracerEquationVolume(tr, elemCtx, scvVolume, dt, I, I1);
-            }
+        this->updateFaceFluxes_();
 
-            std::size_t numInteriorFaces = elemCtx.numInteriorFaces(/*timIdx=*/0);
-            for (unsigned scvfIdx = 0; scvfIdx < numInteriorFaces; scvfIdx++) {
-                const auto& face = elemCtx.stencil(0).interiorFace(scvfIdx);
-                unsigned j = face.exteriorIndex();
-                unsigned J = elemCtx.globalSpaceIndex(/*dofIdx=*/ j, /*timIdx=*/0);
-                for (auto& tr : tbatch) {
-                    this->assembleTracerEquationFlux(tr, elemCtx, scvfIdx, I, J);
-                }
-            }
+        const Scalar dt = simulator_.timeStepSize();
+        for (auto& tr : tbatch) {
+            this->assembleTracerEquationVolume(tr, dt);
+            this->assembleTracerEquationFlux(tr);
         }
 
         // Well terms
@@ -465,13 +551,12 @@ protected:
         ElementContext elemCtx(simulator_);
         for (const auto& elem : elements(simulator_.gridView())) {
             elemCtx.updatePrimaryStencil(elem);
-            elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-            int globalDofIdx = elemCtx.globalSpaceIndex(0, /*timeIdx=*/0);
+            const unsigned globalDofIdx = elemCtx.globalSpaceIndex(0, /*timeIdx=*/0);
+            const auto& intQuants = intensiveQuantities_(elemCtx, elem, globalDofIdx);
             for (auto& tr : tbatch) {
                 if (tr.numTracer() == 0)
                     continue;
-                Scalar fVolume;
-                computeVolume_(fVolume, tr.phaseIdx_, elemCtx, 0, /*timeIdx=*/0);
+                const Scalar fVolume = computeFreeVolume_(tr.phaseIdx_, intQuants);
                 for (int tIdx = 0; tIdx < tr.numTracer(); ++tIdx) {
                     tr.storageOfTimeIndex1_[tIdx][globalDofIdx] = fVolume*tr.concentrationInitial_[tIdx][globalDofIdx];
                 }
@@ -552,6 +637,21 @@ protected:
 
     Simulator& simulator_;
 
+    // Phase fluxes (surface volume per unit time) over one face of an
+    // interior cell, evaluated at the end of the time step.
+    struct TracerFaceFlux
+    {
+        unsigned interiorIdx;
+        unsigned exteriorIdx;
+        std::array<Scalar, numPhases> flux{};
+        std::array<bool, numPhases> interiorIsUpstream{};
+    };
+
+    std::vector<TracerFaceFlux> faceFluxes_;
+    std::vector<std::array<Scalar, numPhases>> freeVolume_;
+    std::vector<unsigned> interiorCells_;
+    std::vector<unsigned> overlapCells_;
+
     // This struct collects tracers of the same type (i.e, transported in same phase).
     // The idea being that, under the assumption of linearity, tracers of same type can
     // be solved in concert, having a common system matrix but separate right-hand-sides.
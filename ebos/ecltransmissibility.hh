@@ -39,6 +39,7 @@
 #include <cstdint>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace Opm {
@@ -129,6 +130,15 @@ public:
      */
     void update(bool global, const std::function<unsigned int(unsigned int)>& map = {});
 
+    /*!
+     * \brief Set per-element multipliers for the intrinsic permeabilities.
+     *
+     * The multipliers are applied to PERM{X,Y,Z} the next time update() is called.
+     * An empty vector disables the multipliers.
+     */
+    void setPermeabilityMultipliers(std::vector<Scalar> multipliers)
+    { permeabilityMultipliers_ = std::move(multipliers); }
+
 protected:
     void updateFromEclState_(bool global);
 
@@ -240,6 +250,7 @@ protected:
                    const std::vector<double>& ntg) const;
 
     std::vector<DimMatrix> permeability_;
+    std::vector<Scalar> permeabilityMultipliers_;
     std::vector<Scalar> porosity_;
     std::unordered_map<std::uint64_t, Scalar> trans_;
     const EclipseState& eclState_;
@@ -157,6 +157,14 @@ update(bool global, const std::function<unsigned int(unsigned int)>& map)
     else
         extractPermeability_();
 
+    if (!permeabilityMultipliers_.empty()) {
+        if (permeabilityMultipliers_.size() != permeability_.size())
+            throw std::logic_error("Number of permeability multipliers does not match the number of elements");
+
+        for (std::size_t elemIdx = 0; elemIdx < permeability_.size(); ++elemIdx)
+            permeability_[elemIdx] *= permeabilityMultipliers_[elemIdx];
+    }
+
     // calculate the axis specific centroids of all elements
     std::array<std::vector<DimVector>, dimWorld> axisCentroids;
 
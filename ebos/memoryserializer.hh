@@ -0,0 +1,75 @@
+/*
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 2 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+
+  Consult the COPYING file in the top-level source directory of this
+  module for the precise wording of the license and the list of
+  copyright holders.
+*/
+#ifndef ECL_MEMORY_SERIALIZER_HH
+#define ECL_MEMORY_SERIALIZER_HH
+
+#include <opm/common/utility/Serializer.hpp>
+
+#include <opm/simulators/utils/SerializationPackers.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace Opm {
+
+//! \brief Class for (de-)serializing to an in-process memory buffer.
+//! \details Uses the same packing as the HDF5Serializer, so everything
+//!          that can be written to an .OPMRST file can be snapshotted.
+class MemorySerializer : public Serializer<Serialization::MemPacker> {
+public:
+    MemorySerializer()
+        : Serializer<Serialization::MemPacker>(m_packer_priv)
+    {}
+
+    //! \brief Serialize data into a buffer.
+    //! \tparam T Type of class to write
+    //! \param data Class to write state for
+    template<class T>
+    std::vector<char> write(T& data)
+    {
+        try {
+            this->pack(data);
+        } catch (...) {
+            m_packSize = std::numeric_limits<size_t>::max();
+            throw;
+        }
+
+        return m_buffer;
+    }
+
+    //! \brief Deserialize data from a buffer.
+    //! \tparam T Type of class to read
+    //! \param data Class to read state for
+    //! \param buffer Buffer as returned by write()
+    template<class T>
+    void read(T& data, const std::vector<char>& buffer)
+    {
+        m_buffer = buffer;
+        this->unpack(data);
+    }
+
+private:
+    const Serialization::MemPacker m_packer_priv{}; //!< Packer instance
+};
+
+}
+
+#endif
@@ -0,0 +1,212 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Compares the block kernels of BlockKernels.hpp with the generic block
+// operations of dune-istl for the sparse matrix-vector product, the block
+// ILU0 factorization and the ILU0 triangular solves, for the block sizes
+// of the FlexibleSolver and PreconditionerFactory instantiations. The
+// triangular solves of both columns use the same factorization.
+//
+// Usage: blockkernels_benchmark [cells per direction] [repetitions]
+
+#include <config.h>
+
+#include <opm/simulators/linalg/BlockKernels.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0_impl.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#include <dune/common/version.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/ilu.hh>
+#include <dune/istl/paamg/pinfo.hh>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+
+namespace
+{
+
+template <class F>
+double timeIt(const int repetitions, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; ++r) {
+        f();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / repetitions;
+}
+
+void report(const std::string& name, const int n, const double generic, const double kernel)
+{
+    std::cout << std::setw(14) << name << std::setw(4) << n
+              << std::setw(14) << generic * 1e3 << std::setw(14) << kernel * 1e3
+              << std::setw(10) << generic / kernel << '\n';
+}
+
+// The ILU0 of ParallelOverlappingILU0 with the triangular solves of its
+// apply() done with the block operations of dune-common.
+template <class Matrix, class Vector>
+class GenericILU0
+    : public Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Dune::Amg::SequentialInformation>
+{
+    using Base = Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Dune::Amg::SequentialInformation>;
+
+public:
+    explicit GenericILU0(const Matrix& A)
+        : Base(A, 0, 1.0, Opm::MILU_VARIANT::ILU)
+    {}
+
+    void applyGeneric(Vector& v, const Vector& d) const
+    {
+        using size_type = typename Matrix::size_type;
+        const size_type iEnd = this->lower_.rows();
+        for (size_type i = 0; i < iEnd; ++i) {
+            auto rhs = d[i];
+            for (size_type col = this->lower_.rows_[i]; col < this->lower_.rows_[i + 1]; ++col) {
+                this->lower_.values_[col].mmv(v[this->lower_.cols_[col]], rhs);
+            }
+            v[i] = rhs;
+        }
+        for (size_type i = 0; i < iEnd; ++i) {
+            auto& vBlock = v[iEnd - 1 - i];
+            auto rhs = vBlock;
+            for (size_type col = this->upper_.rows_[i]; col < this->upper_.rows_[i + 1]; ++col) {
+                this->upper_.values_[col].mmv(v[this->upper_.cols_[col]], rhs);
+            }
+            this->inv_[i].mv(rhs, vBlock);
+        }
+    }
+};
+
+// 7-point stencil on an nx^3 grid with random, diagonally dominant blocks.
+template <int n>
+Dune::BCRSMatrix<Opm::MatrixBlock<double, n, n>> makeMatrix(const int nx)
+{
+    using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, n, n>>;
+    const int numCells = nx * nx * nx;
+    Matrix A(numCells, numCells, 7 * numCells, Matrix::row_wise);
+    const int offsets[3] = { 1, nx, nx * nx };
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int cell = row.index();
+        const int ijk[3] = { cell % nx, (cell / nx) % nx, cell / (nx * nx) };
+        for (int d = 2; d >= 0; --d) {
+            if (ijk[d] > 0) {
+                row.insert(cell - offsets[d]);
+            }
+        }
+        row.insert(cell);
+        for (int d = 0; d < 3; ++d) {
+            if (ijk[d] < nx - 1) {
+                row.insert(cell + offsets[d]);
+            }
+        }
+    }
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.0, 1.0);
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    (*col)[i][j] = dist(gen);
+                }
+                if (col.index() == row.index()) {
+                    (*col)[i][i] += 10.0 * n;
+                }
+            }
+        }
+    }
+    return A;
+}
+
+template <int n>
+void benchmark(const int nx, const int repetitions)
+{
+    using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, n, n>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, n>>;
+    const Matrix A = makeMatrix<n>(nx);
+    Vector x(A.N()), y(A.N());
+    x = 1.0;
+    y = 0.0;
+
+    const double spmvGeneric = timeIt(repetitions, [&] { A.umv(x, y); });
+    const double spmvKernel = timeIt(repetitions, [&] {
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            auto& yi = y[row.index()];
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                Opm::detail::blockUmv(*col, x[col.index()], yi);
+            }
+        }
+    });
+    report("spmv", n, spmvGeneric, spmvKernel);
+
+    const int factorizations = std::max(1, repetitions / 10);
+    Matrix ilu(A);
+    const double factorGeneric = timeIt(factorizations, [&] {
+        ilu = A;
+#if DUNE_VERSION_LT(DUNE_GRID, 2, 8)
+        bilu0_decomposition(ilu);
+#else
+        Dune::ILU::blockILU0Decomposition(ilu);
+#endif
+    });
+    const double factorKernel = timeIt(factorizations, [&] {
+        ilu = A;
+        Opm::detail::ghost_last_bilu0_decomposition(ilu, ilu.N());
+    });
+    report("ilu0 factor", n, factorGeneric, factorKernel);
+
+    GenericILU0<Matrix, Vector> opmIlu(A);
+    Vector d(A.N()), v(A.N());
+    d = 1.0;
+    const double applyGeneric = timeIt(repetitions, [&] { opmIlu.applyGeneric(v, d); });
+    const double applyKernel = timeIt(repetitions, [&] { opmIlu.apply(v, d); });
+    report("ilu0 apply", n, applyGeneric, applyKernel);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const int nx = argc > 1 ? std::atoi(argv[1]) : 40;
+    const int repetitions = argc > 2 ? std::atoi(argv[2]) : 50;
+
+    std::cout << "Grid " << nx << "^3, " << repetitions << " repetitions, AVX2 kernels "
+              << (OPM_BLOCK_KERNELS_AVX2 ? "enabled" : "disabled") << "\n"
+              << std::setw(14) << "operation" << std::setw(4) << "n"
+              << std::setw(14) << "dune [ms]" << std::setw(14) << "kernel [ms]"
+              << std::setw(10) << "speedup" << '\n'
+              << std::fixed << std::setprecision(3);
+
+    benchmark<1>(nx, repetitions);
+    benchmark<2>(nx, repetitions);
+    benchmark<3>(nx, repetitions);
+    benchmark<4>(nx, repetitions);
+    benchmark<5>(nx, repetitions);
+    benchmark<6>(nx, repetitions);
+    return EXIT_SUCCESS;
+}
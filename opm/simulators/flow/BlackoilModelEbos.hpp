@@ -43,6 +43,7 @@
 #include <opm/simulators/flow/countGlobalCells.hpp>
 #include <opm/simulators/flow/NonlinearSolverEbos.hpp>
 #include <opm/simulators/flow/BlackoilModelParametersEbos.hpp>
+#include <opm/simulators/linalg/HybridSolverSelector.hpp>
 #include <opm/simulators/timestepping/AdaptiveTimeSteppingEbos.hpp>
 #include <opm/simulators/timestepping/ConvergenceReport.hpp>
 #include <opm/simulators/timestepping/SimulatorReport.hpp>
@@ -54,11 +55,15 @@
 
 #include <dune/common/timer.hh>
 
+#include <dune/istl/istlexception.hh>
+
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
+#include <exception>
 #include <iomanip>
 #include <ios>
 #include <limits>
@@ -295,15 +300,20 @@ namespace Opm {
                 nlddSolver_->prepareStep();
             }
 
+            if (hybridSelector_) {
+                selectLinearSolver();
+            }
+
             report.pre_post_time += perfTimer.stop();
 
             return report;
         }
 
 
+        template <class NonlinearSolverType>
         void initialLinearization(SimulatorReportSingle& report,
                                   const int iteration,
-                                  const int minIter,
+                                  const NonlinearSolverType& nonlinear_solver,
                                   const SimulatorTimerInterface& timer)
         {
             // -----------   Set up reports and timer   -----------
@@ -331,7 +341,7 @@ namespace Opm {
             // the step is not considered converged until at least minIter iterations is done
             {
                 auto convrep = getConvergence(timer, iteration, residual_norms);
-                report.converged = convrep.converged() && iteration > minIter;
+                report.converged = convrep.converged() && iteration > nonlinear_solver.minIter();
                 ConvergenceReport::Severity severity = convrep.severityOfWorstFailure();
                 convergence_reports_.back().report.push_back(std::move(convrep));
 
@@ -344,6 +354,14 @@ namespace Opm {
             }
             report.update_time += perfTimer.stop();
             residual_norms_history_.push_back(residual_norms);
+
+            // Give up the time step early if the residuals grow consistently,
+            // instead of spending the remaining iterations of a failing step.
+            if (!report.converged &&
+                nonlinear_solver.detectDivergence(residual_norms_history_, residual_norms_history_.size() - 1)) {
+                failureReport_ += report;
+                OPM_THROW_NOLOG(NumericalProblem, "Diverging Newton iterations detected!");
+            }
         }
 
 
@@ -365,6 +383,7 @@ namespace Opm {
                 residual_norms_history_.clear();
                 current_relaxation_ = 1.0;
                 dx_old_ = 0.0;
+                num_linear_updates_ = 0;
                 convergence_reports_.push_back({timer.reportStepNum(), timer.currentStepNum(), {}});
                 convergence_reports_.back().report.reserve(11);
             }
@@ -390,7 +409,7 @@ namespace Opm {
             SimulatorReportSingle report;
             Dune::Timer perfTimer;
 
-            this->initialLinearization(report, iteration, nonlinear_solver.minIter(), timer);
+            this->initialLinearization(report, iteration, nonlinear_solver, timer);
 
             // -----------   If not converged, solve linear system and do Newton update  -----------
             if (!report.converged) {
@@ -597,7 +616,11 @@ namespace Opm {
             auto& ebosSolver = ebosSimulator_.model().newtonMethod().linearSolver();
 
             const int numSolvers = ebosSolver.numAvailableSolvers();
-            if ((numSolvers > 1) && (ebosSolver.getSolveCount() % 100 == 0)) {
+            if (numSolvers > 1 && !hybridSelector_) {
+                hybridSelector_ = std::make_unique<HybridSolverSelector>(numSolvers,
+                                                                         param_.linear_solver_switch_hysteresis_);
+            }
+            if ((numSolvers > 1) && (ebosSolver.getSolveCount() % param_.linear_solver_speed_test_interval_ == 0)) {
 
                 if ( terminal_output_ ) {
                     OpmLog::debug("\nRunning speed test for comparing available linear solvers.");
@@ -609,8 +632,13 @@ namespace Opm {
 
                 x = 0.0;
                 std::vector<BVector> x_trial(numSolvers, x);
+                // The linear solvers overwrite the right hand side with the
+                // residual, so every trial has to start from a copy.
+                const BVector b0(ebosResid);
                 for (int solver = 0; solver < numSolvers; ++solver) {
-                    BVector x0(x);
+                    if (solver > 0) {
+                        ebosResid = b0;
+                    }
                     ebosSolver.setActiveSolver(solver);
                     perfTimer.start();
                     ebosSolver.prepare(ebosJac, ebosResid);
@@ -618,9 +646,23 @@ namespace Opm {
                     perfTimer.reset();
                     ebosSolver.setResidual(ebosResid);
                     perfTimer.start();
-                    ebosSolver.solve(x_trial[solver]);
+                    bool converged = false;
+                    try {
+                        converged = ebosSolver.solve(x_trial[solver]);
+                    }
+                    catch (const NumericalProblem&) {
+                        converged = false;
+                    }
+                    catch (const Dune::SolverAbort&) {
+                        converged = false;
+                    }
                     times[solver] = perfTimer.stop();
                     perfTimer.reset();
+                    hybridSelector_->addSolve(solver, setupTimes[solver], times[solver],
+                                              ebosSolver.iterations(), converged);
+                    if (!converged) {
+                        times[solver] = std::numeric_limits<double>::max();
+                    }
                     if (terminal_output_) {
                         OpmLog::debug(fmt::format("Solver time {}: {}", solver, times[solver]));
                     }
@@ -629,29 +671,142 @@ namespace Opm {
                 int fastest_solver = std::min_element(times.begin(), times.end()) - times.begin();
                 // Use timing on rank 0 to determine fastest, must be consistent across ranks.
                 grid_.comm().broadcast(&fastest_solver, 1, 0);
+                if (times[fastest_solver] == std::numeric_limits<double>::max()) {
+                    OPM_THROW_NOLOG(NumericalProblem, "Convergence failure for all hybrid linear solvers.");
+                }
                 linear_solve_setup_time_ = setupTimes[fastest_solver];
                 x = x_trial[fastest_solver];
                 ebosSolver.setActiveSolver(fastest_solver);
+                hybridSelector_->setActiveSolver(fastest_solver);
 
             } else {
 
                 // set initial guess
-                x = 0.0;
+                if (param_.extrapolate_linear_initial_guess_) {
+                    extrapolateLinearUpdate(x);
+                } else {
+                    x = 0.0;
+                }
+                const BVector x0 = hybridSelector_ ? x : BVector();
+                // The linear solvers overwrite the right hand side with the
+                // residual, a retry has to start from the original one.
+                const BVector b0 = hybridSelector_ ? ebosResid : BVector();
 
-                Dune::Timer perfTimer;
-                perfTimer.start();
-                ebosSolver.prepare(ebosJac, ebosResid);
-                linear_solve_setup_time_ = perfTimer.stop();
-                ebosSolver.setResidual(ebosResid);
-                // actually, the error needs to be calculated after setResidual in order to
-                // account for parallelization properly. since the residual of ECFV
-                // discretizations does not need to be synchronized across processes to be
-                // consistent, this is not relevant for OPM-flow...
-                ebosSolver.solve(x);
+                linear_solve_setup_time_ = 0.0;
+                while (true) {
+                    Dune::Timer perfTimer;
+                    perfTimer.start();
+                    ebosSolver.prepare(ebosJac, ebosResid);
+                    const double setupTime = perfTimer.stop();
+                    linear_solve_setup_time_ += setupTime;
+                    ebosSolver.setResidual(ebosResid);
+                    // actually, the error needs to be calculated after setResidual in order to
+                    // account for parallelization properly. since the residual of ECFV
+                    // discretizations does not need to be synchronized across processes to be
+                    // consistent, this is not relevant for OPM-flow...
+                    if (!hybridSelector_) {
+                        ebosSolver.solve(x);
+                        break;
+                    }
+
+                    // Hybrid configuration: record the cost of the solve and
+                    // retry with another solver if it does not converge.
+                    perfTimer.reset();
+                    perfTimer.start();
+                    bool converged = false;
+                    std::exception_ptr failure;
+                    try {
+                        converged = ebosSolver.solve(x);
+                    }
+                    catch (const NumericalProblem&) {
+                        failure = std::current_exception();
+                    }
+                    catch (const Dune::SolverAbort&) {
+                        failure = std::current_exception();
+                    }
+                    const int solver = hybridSelector_->activeSolver();
+                    hybridSelector_->addSolve(solver, setupTime, perfTimer.stop(),
+                                              ebosSolver.iterations(), converged);
+                    if (converged) {
+                        break;
+                    }
+                    int next = hybridSelector_->fallback();
+                    grid_.comm().broadcast(&next, 1, 0);
+                    if (next < 0) {
+                        if (failure) {
+                            std::rethrow_exception(failure);
+                        }
+                        break;
+                    }
+                    if (terminal_output_) {
+                        OpmLog::info(fmt::format("Linear solver {} ({}) failed, retrying with solver {} ({}).",
+                                                 solver, ebosSolver.solverName(solver),
+                                                 next, ebosSolver.solverName(next)));
+                    }
+                    ebosSolver.setActiveSolver(next);
+                    hybridSelector_->setActiveSolver(next);
+                    x = x0;
+                    ebosResid = b0;
+                }
+            }
+
+            if (param_.extrapolate_linear_initial_guess_) {
+                std::swap(linear_updates_[0], linear_updates_[1]);
+                linear_updates_[0] = x;
+                ++num_linear_updates_;
             }
        }
 
 
+        /// Choose the linear solver of the hybrid configuration for the
+        /// next time step from the measured cost of the previous steps.
+        void selectLinearSolver()
+        {
+            auto& ebosSolver = ebosSimulator_.model().newtonMethod().linearSolver();
+            const int previous = hybridSelector_->activeSolver();
+            int solver = hybridSelector_->selectForStep();
+            // Use timing on rank 0, must be consistent across ranks.
+            grid_.comm().broadcast(&solver, 1, 0);
+            hybridSelector_->setActiveSolver(solver);
+            ebosSolver.setActiveSolver(solver);
+
+            if (!terminal_output_) {
+                return;
+            }
+            std::ostringstream costs;
+            for (int i = 0; i < hybridSelector_->numSolvers(); ++i) {
+                costs << fmt::format(" {}: {:.3g} s, {:.1f} its, {} failures;",
+                                     ebosSolver.solverName(i),
+                                     hybridSelector_->predictedCost(i),
+                                     hybridSelector_->predictedIterations(i),
+                                     hybridSelector_->failures(i));
+            }
+            const std::string msg = fmt::format("Linear solver for time step: {} ({}). Predicted cost per solve:{}",
+                                                solver, ebosSolver.solverName(solver), costs.str());
+            if (solver != previous) {
+                OpmLog::info(msg);
+            } else {
+                OpmLog::debug(msg);
+            }
+        }
+
+
+        /// Initial guess for the linear solver from the two previous
+        /// Newton updates of the time step: the Newton updates of
+        /// consecutive iterations are nearly parallel, and the ratio of
+        /// their sizes estimates the contraction of the iteration. The
+        /// linear solver falls back to a zero guess if the extrapolation
+        /// does not reduce the residual.
+        void extrapolateLinearUpdate(BVector& x) const
+        {
+            if (num_linear_updates_ < 2) {
+                x = 0.0;
+                return;
+            }
+            detail::extrapolateLinearUpdate(x, linear_updates_[0], linear_updates_[1], grid_.comm());
+        }
+
+
         /// Apply an update to the primary variables.
         void updateSolution(const BVector& dx)
         {
@@ -1027,6 +1182,12 @@ namespace Opm {
             return convergence_reports_;
         }
 
+        /// continue the step reports of a previous model
+        void setStepReports(std::vector<StepReport> reports)
+        {
+            convergence_reports_ = std::move(reports);
+        }
+
     protected:
         // ---------  Data members  ---------
 
@@ -1056,11 +1217,15 @@ namespace Opm {
         std::vector<std::vector<double>> residual_norms_history_;
         double current_relaxation_;
         BVector dx_old_;
+        // Linear solutions of the last two Newton iterations of the time step.
+        std::array<BVector, 2> linear_updates_;
+        int num_linear_updates_ = 0;
 
         std::vector<StepReport> convergence_reports_;
         ComponentName compNames_{};
 
         std::unique_ptr<BlackoilModelEbosNldd<TypeTag>> nlddSolver_; //!< Non-linear DD solver
+        std::unique_ptr<HybridSolverSelector> hybridSelector_; //!< Choice of hybrid linear solver
 
     public:
         /// return the StandardWells object
@@ -106,6 +106,10 @@ struct UseUpdateStabilization {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct ExtrapolateLinearInitialGuess {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct MatrixAddWellContributions {
     using type = UndefinedProperty;
 };
@@ -184,10 +188,34 @@ struct NetworkMaxIterations {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct NetworkNewtonIterations {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct WellPotentialReuseTolerance {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct InnerIterWellsSkipTolerance {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct GasLiftCurveIncrements {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct NonlinearSolver {
     using type = UndefinedProperty;
 };
 template<class TypeTag, class MyTypeTag>
+struct LinearSolverSwitchHysteresis {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct LinearSolverSpeedTestInterval {
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
 struct LocalSolveApproach {
     using type = UndefinedProperty;
 };
@@ -294,6 +322,10 @@ struct UseUpdateStabilization<TypeTag, TTag::FlowModelParameters> {
     static constexpr bool value = true;
 };
 template<class TypeTag>
+struct ExtrapolateLinearInitialGuess<TypeTag, TTag::FlowModelParameters> {
+    static constexpr bool value = false;
+};
+template<class TypeTag>
 struct MatrixAddWellContributions<TypeTag, TTag::FlowModelParameters> {
     static constexpr bool value = false;
 };
@@ -376,10 +408,37 @@ struct NetworkMaxIterations<TypeTag, TTag::FlowModelParameters> {
     static constexpr int value = 200;
 };
 template<class TypeTag>
+struct NetworkNewtonIterations<TypeTag, TTag::FlowModelParameters> {
+    static constexpr int value = 0;
+};
+template<class TypeTag>
+struct WellPotentialReuseTolerance<TypeTag, TTag::FlowModelParameters> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.0;
+};
+template<class TypeTag>
+struct InnerIterWellsSkipTolerance<TypeTag, TTag::FlowModelParameters> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.0;
+};
+template<class TypeTag>
+struct GasLiftCurveIncrements<TypeTag, TTag::FlowModelParameters> {
+    static constexpr int value = 0;
+};
+template<class TypeTag>
 struct NonlinearSolver<TypeTag, TTag::FlowModelParameters> {
     static constexpr auto value = "newton";
 };
 template<class TypeTag>
+struct LinearSolverSwitchHysteresis<TypeTag, TTag::FlowModelParameters> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 0.2;
+};
+template<class TypeTag>
+struct LinearSolverSpeedTestInterval<TypeTag, TTag::FlowModelParameters> {
+    static constexpr int value = 100;
+};
+template<class TypeTag>
 struct LocalSolveApproach<TypeTag, TTag::FlowModelParameters> {
     static constexpr auto value = "jacobi";
 };
@@ -506,6 +565,10 @@ namespace Opm
         /// Try to detect oscillation or stagnation.
         bool use_update_stabilization_;
 
+        /// Start the linear solver from an extrapolation of the previous
+        /// Newton updates of the time step instead of from zero.
+        bool extrapolate_linear_initial_guess_;
+
         /// Whether to use MultisegmentWell to handle multisegment wells
         /// it is something temporary before the multisegment well model is considered to be
         /// well developed and tested.
@@ -536,8 +599,35 @@ namespace Opm
         /// Maximum number of iterations in the network solver before giving up
         int network_max_iterations_;
 
+        /// Maximum number of Newton iterations for the network node pressures
+        /// with linearized well responses. Zero to use damped explicit updates only.
+        int network_newton_iterations_;
+
+        /// Largest change of the pressures (relative) and saturations (absolute) in
+        /// the perforated cells for which the last well potentials are reused.
+        /// Zero to always recompute them.
+        double well_potential_reuse_tolerance_;
+
+        /// Largest relative change of the well solution, the controls and the
+        /// state of the perforated cells since the inner iterations of a standard
+        /// well last converged for which they are skipped. Zero to always iterate.
+        double inner_iter_wells_skip_tolerance_;
+
+        /// Number of lift gas increments below and above the current lift gas
+        /// rate for which the bhp at the THP limit of the gas lifted wells is
+        /// computed concurrently before the gas lift optimization. Zero to
+        /// compute them on demand only.
+        int gas_lift_curve_increments_;
+
         /// Nonlinear solver type: newton or nldd.
         std::string nonlinear_solver_;
+
+        /// Relative cost advantage a linear solver of the hybrid configuration
+        /// must have before it replaces the active one.
+        double linear_solver_switch_hysteresis_;
+
+        /// Number of linear solves between speed tests of all hybrid linear solvers.
+        int linear_solver_speed_test_interval_;
         /// 'jacobi' and 'gauss-seidel' supported.
         DomainSolveApproach local_solve_approach_{DomainSolveApproach::Jacobi};
 
@@ -581,12 +671,15 @@ namespace Opm
             solve_welleq_initially_ = EWOMS_GET_PARAM(TypeTag, bool, SolveWelleqInitially);
             update_equations_scaling_ = EWOMS_GET_PARAM(TypeTag, bool, UpdateEquationsScaling);
             use_update_stabilization_ = EWOMS_GET_PARAM(TypeTag, bool, UseUpdateStabilization);
+            extrapolate_linear_initial_guess_ = EWOMS_GET_PARAM(TypeTag, bool, ExtrapolateLinearInitialGuess);
             matrix_add_well_contributions_ = EWOMS_GET_PARAM(TypeTag, bool, MatrixAddWellContributions);
             check_well_operability_ = EWOMS_GET_PARAM(TypeTag, bool, EnableWellOperabilityCheck);
             check_well_operability_iter_ = EWOMS_GET_PARAM(TypeTag, bool, EnableWellOperabilityCheckIter);
             max_number_of_well_switches_ = EWOMS_GET_PARAM(TypeTag, int, MaximumNumberOfWellSwitches);
             use_average_density_ms_wells_ = EWOMS_GET_PARAM(TypeTag, bool, UseAverageDensityMsWells);
             nonlinear_solver_ = EWOMS_GET_PARAM(TypeTag, std::string, NonlinearSolver);
+            linear_solver_switch_hysteresis_ = EWOMS_GET_PARAM(TypeTag, Scalar, LinearSolverSwitchHysteresis);
+            linear_solver_speed_test_interval_ = std::max(1, EWOMS_GET_PARAM(TypeTag, int, LinearSolverSpeedTestInterval));
             std::string approach = EWOMS_GET_PARAM(TypeTag, std::string, LocalSolveApproach);
             if (approach == "jacobi") {
                 local_solve_approach_ = DomainSolveApproach::Jacobi;
@@ -605,6 +698,10 @@ namespace Opm
             deck_file_name_ = EWOMS_GET_PARAM(TypeTag, std::string, EclDeckFileName);
             network_max_strict_iterations_ = EWOMS_GET_PARAM(TypeTag, int, NetworkMaxStrictIterations);
             network_max_iterations_ = EWOMS_GET_PARAM(TypeTag, int, NetworkMaxIterations);
+            network_newton_iterations_ = EWOMS_GET_PARAM(TypeTag, int, NetworkNewtonIterations);
+            well_potential_reuse_tolerance_ = EWOMS_GET_PARAM(TypeTag, Scalar, WellPotentialReuseTolerance);
+            inner_iter_wells_skip_tolerance_ = EWOMS_GET_PARAM(TypeTag, Scalar, InnerIterWellsSkipTolerance);
+            gas_lift_curve_increments_ = EWOMS_GET_PARAM(TypeTag, int, GasLiftCurveIncrements);
             std::string measure = EWOMS_GET_PARAM(TypeTag, std::string, LocalDomainsOrderingMeasure);
             if (measure == "residual") {
                 local_domain_ordering_ = DomainOrderingMeasure::Residual;
@@ -646,6 +743,7 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, bool, SolveWelleqInitially, "Fully solve the well equations before each iteration of the reservoir model");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UpdateEquationsScaling, "Update scaling factors for mass balance equations during the run");
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseUpdateStabilization, "Try to detect and correct oscillations or stagnation during the Newton method");
+            EWOMS_REGISTER_PARAM(TypeTag, bool, ExtrapolateLinearInitialGuess, "Start the linear solver from the previous Newton update scaled by the observed contraction instead of from zero");
             EWOMS_REGISTER_PARAM(TypeTag, bool, MatrixAddWellContributions, "Explicitly specify the influences of wells between cells in the Jacobian and preconditioner matrices");
             EWOMS_REGISTER_PARAM(TypeTag, bool, EnableWellOperabilityCheck, "Enable the well operability checking");
             EWOMS_REGISTER_PARAM(TypeTag, bool, EnableWellOperabilityCheckIter, "Enable the well operability checking during iterations");
@@ -653,7 +751,13 @@ namespace Opm
             EWOMS_REGISTER_PARAM(TypeTag, bool, UseAverageDensityMsWells, "Approximate segment densitities by averaging over segment and its outlet");
             EWOMS_REGISTER_PARAM(TypeTag, int, NetworkMaxStrictIterations, "Maximum iterations in network solver before relaxing tolerance");
             EWOMS_REGISTER_PARAM(TypeTag, int, NetworkMaxIterations, "Maximum number of iterations in the network solver before giving up");
+            EWOMS_REGISTER_PARAM(TypeTag, int, NetworkNewtonIterations, "Maximum number of Newton iterations for the network node pressures, using the VFP derivatives and the IPR of the wells under THP control. Zero to only use damped explicit pressure updates");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, WellPotentialReuseTolerance, "Reuse the last well potentials of a rate controlled well if the pressures (relative) and saturations (absolute) of its cells changed less than this. Zero to always recompute them");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, InnerIterWellsSkipTolerance, "Skip the inner iterations of a standard well if its controls are unchanged and its solution and the state of its cells changed less than this relative to their magnitude since they last converged. Zero to always iterate");
+            EWOMS_REGISTER_PARAM(TypeTag, int, GasLiftCurveIncrements, "Number of lift gas increments below and above the current lift gas rate of a gas lifted well for which the bhp at the THP limit is computed concurrently before the gas lift optimization. Zero to compute them on demand only");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, NonlinearSolver, "Choose nonlinear solver. Valid choices are newton or nldd.");
+            EWOMS_REGISTER_PARAM(TypeTag, Scalar, LinearSolverSwitchHysteresis, "Relative reduction of the predicted linear solve time required for switching between the hybrid linear solvers");
+            EWOMS_REGISTER_PARAM(TypeTag, int, LinearSolverSpeedTestInterval, "Number of linear solves between timing all hybrid linear solvers on the same system");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, LocalSolveApproach, "Choose local solve approach. Valid choices are jacobi and gauss-seidel");
             EWOMS_REGISTER_PARAM(TypeTag, int, MaxLocalSolveIterations, "Max iterations for local solves with NLDD nonlinear solver.");
             EWOMS_REGISTER_PARAM(TypeTag, Scalar, LocalToleranceScalingMb, "Set lower than 1.0 to use stricter convergence tolerance for local solves.");
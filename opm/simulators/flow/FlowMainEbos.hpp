@@ -22,6 +22,8 @@
 #ifndef OPM_FLOW_MAIN_EBOS_HEADER_INCLUDED
 #define OPM_FLOW_MAIN_EBOS_HEADER_INCLUDED
 
+#include <ebos/memoryserializer.hh>
+
 #include <opm/simulators/flow/Banners.hpp>
 #include <opm/simulators/flow/SimulatorFullyImplicitBlackoilEbos.hpp>
 
@@ -40,6 +42,7 @@
 #include <cstddef>
 #include <memory>
 #include <string_view>
+#include <vector>
 
 namespace Opm::Properties {
 
@@ -321,6 +324,31 @@ void handleExtraConvergenceOutput(SimulatorReport& report,
             return simtimer_.get();
         }
 
+        //! \brief In-memory snapshot of the simulator and its timer.
+        struct SimulatorState
+        {
+            std::vector<char> simulator;
+            std::vector<char> timer;
+            int reportStep = 0;
+        };
+
+        // Called from Python to take a snapshot between report steps.
+        SimulatorState saveState()
+        {
+            SimulatorState state;
+            state.simulator = simulator_->saveState();
+            state.timer = MemorySerializer().write(*simtimer_);
+            state.reportStep = simtimer_->currentStepNum();
+            return state;
+        }
+
+        // Called from Python to continue from a snapshot taken with saveState().
+        void loadState(const SimulatorState& state)
+        {
+            MemorySerializer().read(*simtimer_, state.timer);
+            simulator_->loadState(state.simulator, state.reportStep);
+        }
+
     private:
         // called by execute() or executeInitStep()
         int execute_(int (FlowMainEbos::* runOrInitFunc)(), bool cleanup)
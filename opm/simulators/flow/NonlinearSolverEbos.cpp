@@ -25,6 +25,7 @@
 
 #include <opm/common/ErrorMacros.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
@@ -65,6 +66,34 @@ void detectOscillations(const std::vector<std::vector<double>>& residualHistory,
     oscillate = (oscillatePhase > 1);
 }
 
+bool detectDivergence(const std::vector<std::vector<double>>& residualHistory,
+                      const int it, const int minIter, const double growthFactor)
+{
+    // The largest residual of each iteration is monitored. The iterations are
+    // regarded as diverging if it has grown in each of the last two iterations
+    // and exceeds the smallest value seen in this time step by growthFactor.
+
+    if (minIter <= 0 || it < std::max(minIter, 2)) {
+        return false;
+    }
+
+    auto maxNorm = [](const std::vector<double>& F)
+    {
+        return F.empty() ? 0.0 : *std::max_element(F.begin(), F.end());
+    };
+
+    double smallest = maxNorm(residualHistory[0]);
+    for (int i = 1; i < it; ++i) {
+        smallest = std::min(smallest, maxNorm(residualHistory[i]));
+    }
+
+    const double F0 = maxNorm(residualHistory[it]);
+    const double F1 = maxNorm(residualHistory[it - 1]);
+    const double F2 = maxNorm(residualHistory[it - 2]);
+
+    return (F0 > F1) && (F1 > F2) && (F0 > growthFactor * smallest);
+}
+
 template <class BVector>
 void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
                               const double omega,
@@ -33,6 +33,8 @@
 
 #include <dune/common/fmatrix.hh>
 #include <dune/istl/bcrsmatrix.hh>
+
+#include <algorithm>
 #include <memory>
 
 namespace Opm::Properties {
@@ -57,6 +59,14 @@ template<class TypeTag, class MyTypeTag>
 struct NewtonRelaxationType{
     using type = UndefinedProperty;
 };
+template<class TypeTag, class MyTypeTag>
+struct NewtonDivergenceCheckIterations{
+    using type = UndefinedProperty;
+};
+template<class TypeTag, class MyTypeTag>
+struct NewtonDivergenceFactor{
+    using type = UndefinedProperty;
+};
 
 template<class TypeTag>
 struct NewtonMaxRelax<TypeTag, TTag::FlowNonLinearSolver> {
@@ -75,6 +85,15 @@ template<class TypeTag>
 struct NewtonRelaxationType<TypeTag, TTag::FlowNonLinearSolver> {
     static constexpr auto value = "dampen";
 };
+template<class TypeTag>
+struct NewtonDivergenceCheckIterations<TypeTag, TTag::FlowNonLinearSolver> {
+    static constexpr int value = 0;
+};
+template<class TypeTag>
+struct NewtonDivergenceFactor<TypeTag, TTag::FlowNonLinearSolver> {
+    using type = GetPropType<TypeTag, Scalar>;
+    static constexpr type value = 10.0;
+};
 
 } // namespace Opm::Properties
 
@@ -95,12 +114,36 @@ void detectOscillations(const std::vector<std::vector<double>>& residualHistory,
                         const int it, const int numPhases, const double relaxRelTol,
                         bool& oscillate, bool& stagnate);
 
+/// Detect consistently growing residuals in a given residual history.
+/// The check is disabled if minIter <= 0.
+bool detectDivergence(const std::vector<std::vector<double>>& residualHistory,
+                      const int it, const int minIter, const double growthFactor);
+
 /// Apply a stabilization to dx, depending on dxOld and relaxation parameters.
 /// Implemention for Dune block vectors.
 template <class BVector>
 void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
                               const double omega, NonlinearRelaxType relaxType);
 
+/// Extrapolate the next Newton update from the last two, which are nearly
+/// parallel: x is the last update scaled by the contraction
+/// (last, previous) / (previous, previous), clamped to [0, 1].
+/// The dot products are summed over comm such that all processes use the
+/// same factor. Overlap entries are counted on several processes, which is
+/// acceptable for the estimate.
+template <class BVector, class Comm>
+void extrapolateLinearUpdate(BVector& x, const BVector& last,
+                             const BVector& previous, const Comm& comm)
+{
+    x = 0.0;
+    double dots[2] = { last.dot(previous), previous.dot(previous) };
+    comm.sum(dots, 2);
+    if (dots[1] > 0.0) {
+        const double factor = std::clamp(dots[0] / dots[1], 0.0, 1.0);
+        x.axpy(factor, last);
+    }
+}
+
 }
 
     /// A nonlinear solver class suitable for general fully-implicit models,
@@ -120,6 +163,8 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
             double relaxRelTol_;
             int maxIter_; // max nonlinear iterations
             int minIter_; // min nonlinear iterations
+            int divergenceCheckIter_; // first iteration checked for divergence (0 disables the check)
+            double divergenceFactor_; // residual growth regarded as divergence
 
             SolverParameters()
             {
@@ -130,6 +175,8 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
                 relaxMax_ = EWOMS_GET_PARAM(TypeTag, Scalar, NewtonMaxRelax);
                 maxIter_ = EWOMS_GET_PARAM(TypeTag, int, NewtonMaxIterations);
                 minIter_ = EWOMS_GET_PARAM(TypeTag, int, NewtonMinIterations);
+                divergenceCheckIter_ = EWOMS_GET_PARAM(TypeTag, int, NewtonDivergenceCheckIterations);
+                divergenceFactor_ = EWOMS_GET_PARAM(TypeTag, Scalar, NewtonDivergenceFactor);
 
                 const auto& relaxationTypeString = EWOMS_GET_PARAM(TypeTag, std::string, NewtonRelaxationType);
                 if (relaxationTypeString == "dampen") {
@@ -148,6 +195,8 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
                 EWOMS_REGISTER_PARAM(TypeTag, int, NewtonMaxIterations, "The maximum number of Newton iterations per time step");
                 EWOMS_REGISTER_PARAM(TypeTag, int, NewtonMinIterations, "The minimum number of Newton iterations per time step");
                 EWOMS_REGISTER_PARAM(TypeTag, std::string, NewtonRelaxationType, "The type of relaxation used by Newton method");
+                EWOMS_REGISTER_PARAM(TypeTag, int, NewtonDivergenceCheckIterations, "The number of Newton iterations after which a time step is given up if the residuals grow consistently (0 disables the check)");
+                EWOMS_REGISTER_PARAM(TypeTag, Scalar, NewtonDivergenceFactor, "The growth of the residual relative to its smallest value in the time step that is regarded as divergence");
             }
 
             void reset()
@@ -159,6 +208,8 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
                 relaxRelTol_ = 0.2;
                 maxIter_ = 10;
                 minIter_ = 1;
+                divergenceCheckIter_ = 0;
+                divergenceFactor_ = 10.0;
             }
 
         };
@@ -298,6 +349,14 @@ void stabilizeNonlinearUpdate(BVector& dx, BVector& dxOld,
                                        this->relaxRelTol(), oscillate, stagnate);
         }
 
+        /// Detect consistently growing residuals in a given residual history.
+        bool detectDivergence(const std::vector<std::vector<double>>& residualHistory,
+                              const int it) const
+        {
+            return detail::detectDivergence(residualHistory, it, param_.divergenceCheckIter_,
+                                            param_.divergenceFactor_);
+        }
+
 
         /// Apply a stabilization to dx, depending on dxOld and relaxation parameters.
         /// Implemention for Dune block vectors.
@@ -52,6 +52,8 @@
 #include <utility>
 #include <vector>
 
+#include <ebos/memoryserializer.hh>
+
 #if HAVE_HDF5
 #include <ebos/hdf5serializer.hh>
 #endif
@@ -527,6 +529,36 @@ public:
         serializer(adaptiveTimeStepping_);
     }
 
+    //! \brief Serialize the complete simulator state to a memory buffer.
+    //! \details Together with loadState() this allows to branch in-process
+    //!          from a state taken between report steps, without re-reading
+    //!          the deck.
+    std::vector<char> saveState()
+    {
+        MemorySerializer writer;
+        return writer.write(*this);
+    }
+
+    //! \brief Restore a simulator state stored with saveState().
+    //! \param buffer Serialized simulator state
+    //! \param reportStep Report step to be run next when the state was saved
+    void loadState(const std::vector<char>& buffer, const int reportStep)
+    {
+        wellModel_().prepareDeserialize(reportStep - 1);
+        MemorySerializer reader;
+        reader.read(*this, buffer);
+        ebosSimulator_.model().invalidateAndUpdateIntensiveQuantities(/*timeIdx=*/0);
+
+        // the nonlinear solver holds data of the old state, recreate it.
+        // The step reports continue, as the convergence output has been
+        // written up to already_reported_steps_.
+        if (solver_) {
+            auto reports = solver_->model().stepReports();
+            solver_ = createSolver(wellModel_());
+            solver_->model().setStepReports(std::move(reports));
+        }
+    }
+
     const Model& model() const
     { return solver_->model(); }
 
@@ -24,6 +24,7 @@
 #include <opm/simulators/flow/FlowMainEbos.hpp>
 #include <opm/models/utils/propertysystem.hh>
 #include <opm/simulators/flow/python/Pybind11Exporter.hpp>
+#include <opm/simulators/flow/python/PyFluidState.hpp>
 #include <opm/simulators/flow/python/PyMaterialState.hpp>
 #include <opm/input/eclipse/EclipseState/EclipseState.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
@@ -37,6 +38,8 @@ private:
     using Simulator = Opm::GetPropType<TypeTag, Opm::Properties::Simulator>;
 
 public:
+    using SimulatorState = typename Opm::FlowMainEbos<TypeTag>::SimulatorState;
+
     PyBlackOilSimulator( const std::string& deckFilename);
     PyBlackOilSimulator(
         std::shared_ptr<Opm::Deck> deck,
@@ -45,9 +48,23 @@ public:
         std::shared_ptr<Opm::SummaryConfig> summary_config);
     bool checkSimulationFinished();
     py::array_t<double> getPorosity();
+    py::array_t<double> getPressure();
+    py::array_t<double> getWaterSaturation();
+    py::array_t<double> getOilSaturation();
+    py::array_t<double> getGasSaturation();
+    py::array_t<double> getRs();
+    py::array_t<double> getRv();
+    py::array_t<double> getWellRates();
+    std::vector<std::string> getWellNames();
     int run();
     void setPorosity(
          py::array_t<double, py::array::c_style | py::array::forcecast> array);
+    void setPorosityMultipliers(
+         py::array_t<double, py::array::c_style | py::array::forcecast> array);
+    void setPermeabilityMultipliers(
+         py::array_t<double, py::array::c_style | py::array::forcecast> array);
+    std::shared_ptr<SimulatorState> snapshot();
+    void restore(const SimulatorState& state);
     int step();
     void advance(int report_step);
     int currentStep();
@@ -56,6 +73,9 @@ public:
     const Opm::FlowMainEbos<TypeTag>& getFlowMainEbos() const;
 
 private:
+    py::array_t<double> cellView_(const std::vector<double>& data);
+    void checkInitialized_(const std::string& func) const;
+
     const std::string deckFilename_;
     bool hasRunInit_ = false;
     bool hasRunCleanup_ = false;
@@ -68,6 +88,7 @@ private:
     std::unique_ptr<Opm::FlowMainEbos<TypeTag>> mainEbos_;
     Simulator *ebosSimulator_;
     std::unique_ptr<PyMaterialState<TypeTag>> materialState_;
+    std::unique_ptr<PyFluidState<TypeTag>> fluidState_;
     std::shared_ptr<Opm::Deck> deck_;
     std::shared_ptr<Opm::EclipseState> eclipse_state_;
     std::shared_ptr<Opm::Schedule> schedule_;
@@ -0,0 +1,77 @@
+/*
+  Copyright 2023 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PY_FLUID_STATE_HEADER_INCLUDED
+#define OPM_PY_FLUID_STATE_HEADER_INCLUDED
+
+#include <opm/models/utils/propertysystem.hh>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Opm::Pybind
+{
+    // Per-cell and per-well solution quantities stored as contiguous
+    // arrays. The arrays are allocated once and refreshed in place by
+    // update(), so that Python can hold zero-copy views of them.
+    template <class TypeTag>
+    class PyFluidState {
+        using Simulator = GetPropType<TypeTag, Opm::Properties::Simulator>;
+        using FluidSystem = GetPropType<TypeTag, Opm::Properties::FluidSystem>;
+
+    public:
+        PyFluidState(Simulator *ebosSimulator);
+
+        // Refresh all arrays from the current simulator state.
+        void update();
+
+        const std::vector<double>& pressure() const { return pressure_; }
+        const std::vector<double>& waterSaturation() const { return sw_; }
+        const std::vector<double>& oilSaturation() const { return so_; }
+        const std::vector<double>& gasSaturation() const { return sg_; }
+        const std::vector<double>& rs() const { return rs_; }
+        const std::vector<double>& rv() const { return rv_; }
+
+        // Surface rates of all wells in the schedule, row-major with
+        // numWellPhases() entries per well. Wells that are not active on
+        // this process report zero rates.
+        const std::vector<double>& wellRates() const { return wellRates_; }
+        const std::vector<std::string>& wellNames() const { return wellNames_; }
+        static constexpr std::size_t numWellPhases() { return 3; }
+
+    private:
+        void updateCells_();
+        void updateWells_();
+
+        Simulator *ebosSimulator_;
+        std::vector<double> pressure_;
+        std::vector<double> sw_;
+        std::vector<double> so_;
+        std::vector<double> sg_;
+        std::vector<double> rs_;
+        std::vector<double> rv_;
+        std::vector<std::string> wellNames_;
+        std::vector<double> wellRates_;
+    };
+
+}
+#include "PyFluidState_impl.hpp"
+
+#endif // OPM_PY_FLUID_STATE_HEADER_INCLUDED
@@ -0,0 +1,116 @@
+/*
+  Copyright 2023 Equinor ASA.
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <opm/core/props/BlackoilPhases.hpp>
+#include <opm/material/densead/Math.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace Opm::Pybind {
+
+template <class TypeTag>
+PyFluidState<TypeTag>::
+PyFluidState(Simulator *ebosSimulator)
+    : ebosSimulator_(ebosSimulator)
+{
+    const std::size_t numCells = ebosSimulator_->model().numGridDof();
+    pressure_.resize(numCells, 0.0);
+    sw_.resize(numCells, 0.0);
+    so_.resize(numCells, 0.0);
+    sg_.resize(numCells, 0.0);
+    rs_.resize(numCells, 0.0);
+    rv_.resize(numCells, 0.0);
+
+    // Use all wells of the schedule, so that the size of the rate array
+    // does not change when wells are opened later in the run.
+    wellNames_ = ebosSimulator_->vanguard().schedule().wellNames();
+    wellRates_.resize(wellNames_.size() * numWellPhases(), 0.0);
+}
+
+template <class TypeTag>
+void
+PyFluidState<TypeTag>::
+update()
+{
+    updateCells_();
+    updateWells_();
+}
+
+template <class TypeTag>
+void
+PyFluidState<TypeTag>::
+updateCells_()
+{
+    const auto& model = ebosSimulator_->model();
+    const unsigned pressurePhaseIdx = FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)
+        ? FluidSystem::oilPhaseIdx
+        : (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)
+           ? FluidSystem::gasPhaseIdx : FluidSystem::waterPhaseIdx);
+
+    for (std::size_t dofIdx = 0; dofIdx < pressure_.size(); ++dofIdx) {
+        const auto* intQuants = model.cachedIntensiveQuantities(dofIdx, /*timeIdx*/0);
+        if (!intQuants) {
+            throw std::logic_error("Cannot update fluid state: "
+                                   "intensive quantities are not cached");
+        }
+        const auto& fs = intQuants->fluidState();
+        pressure_[dofIdx] = getValue(fs.pressure(pressurePhaseIdx));
+        if (FluidSystem::phaseIsActive(FluidSystem::waterPhaseIdx)) {
+            sw_[dofIdx] = getValue(fs.saturation(FluidSystem::waterPhaseIdx));
+        }
+        if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)) {
+            so_[dofIdx] = getValue(fs.saturation(FluidSystem::oilPhaseIdx));
+        }
+        if (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
+            sg_[dofIdx] = getValue(fs.saturation(FluidSystem::gasPhaseIdx));
+        }
+        rs_[dofIdx] = getValue(fs.Rs());
+        rv_[dofIdx] = getValue(fs.Rv());
+    }
+}
+
+template <class TypeTag>
+void
+PyFluidState<TypeTag>::
+updateWells_()
+{
+    const auto& wellState = ebosSimulator_->problem().wellModel().wellState();
+    const auto& pu = wellState.phaseUsage();
+    const int activePhasePos[numWellPhases()] = {
+        pu.phase_used[BlackoilPhases::Aqua] ? pu.phase_pos[BlackoilPhases::Aqua] : -1,
+        pu.phase_used[BlackoilPhases::Liquid] ? pu.phase_pos[BlackoilPhases::Liquid] : -1,
+        pu.phase_used[BlackoilPhases::Vapour] ? pu.phase_pos[BlackoilPhases::Vapour] : -1,
+    };
+
+    std::fill(wellRates_.begin(), wellRates_.end(), 0.0);
+    for (std::size_t w = 0; w < wellNames_.size(); ++w) {
+        if (!wellState.has(wellNames_[w])) {
+            continue;
+        }
+        const auto& ws = wellState.well(wellNames_[w]);
+        for (std::size_t p = 0; p < numWellPhases(); ++p) {
+            if (activePhasePos[p] >= 0) {
+                wellRates_[w*numWellPhases() + p] = ws.surface_rates[activePhasePos[p]];
+            }
+        }
+    }
+}
+
+} //namespace Opm::Pybind
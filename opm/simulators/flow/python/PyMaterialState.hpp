@@ -48,8 +48,18 @@ namespace Opm::Pybind
         std::unique_ptr<double []> getCellVolumes( std::size_t *size);
         std::unique_ptr<double []> getPorosity( std::size_t *size);
         void setPorosity(const double *poro, std::size_t size);
+        void setPorosityMultipliers(const double *mult, std::size_t size);
+        // take the current porosity as the base of the next multipliers
+        void resetPorosityBase();
+        void setPermeabilityMultipliers(const double *mult, std::size_t size);
     private:
+        void checkSize_(const std::string& name, std::size_t size) const;
+
         Simulator *ebosSimulator_;
+        // porosity the multipliers apply to, taken from the reference
+        // porosity at the first call to setPorosityMultipliers() after
+        // construction, setPorosity() or resetPorosityBase()
+        std::vector<double> initialPorosity_;
     };
 
 }
@@ -54,16 +54,60 @@ PyMaterialState<TypeTag>::
 setPorosity(const double *poro, std::size_t size)
 {
     Problem &problem = ebosSimulator_->problem();
-    Model &model = ebosSimulator_->model();
-    auto model_size = model.numGridDof();
+    checkSize_("porosity", size);
+    for (unsigned dofIdx = 0; dofIdx < size; ++dofIdx) {
+        problem.setPorosity(poro[dofIdx], dofIdx);
+    }
+    // later multipliers apply to the porosity set here
+    resetPorosityBase();
+}
+
+template <class TypeTag>
+void
+PyMaterialState<TypeTag>::
+resetPorosityBase()
+{
+    initialPorosity_.clear();
+}
+
+template <class TypeTag>
+void
+PyMaterialState<TypeTag>::
+setPorosityMultipliers(const double *mult, std::size_t size)
+{
+    Problem &problem = ebosSimulator_->problem();
+    checkSize_("porosity multipliers", size);
+    if (initialPorosity_.empty()) {
+        initialPorosity_.resize(size);
+        for (unsigned dofIdx = 0; dofIdx < size; ++dofIdx) {
+            initialPorosity_[dofIdx] = problem.referencePorosity(dofIdx, /*timeIdx*/0);
+        }
+    }
+    for (unsigned dofIdx = 0; dofIdx < size; ++dofIdx) {
+        problem.setPorosity(initialPorosity_[dofIdx] * mult[dofIdx], dofIdx);
+    }
+}
+
+template <class TypeTag>
+void
+PyMaterialState<TypeTag>::
+setPermeabilityMultipliers(const double *mult, std::size_t size)
+{
+    checkSize_("permeability multipliers", size);
+    ebosSimulator_->problem().setPermeabilityMultipliers(std::vector<double>(mult, mult + size));
+}
+
+template <class TypeTag>
+void
+PyMaterialState<TypeTag>::
+checkSize_(const std::string& name, std::size_t size) const
+{
+    auto model_size = ebosSimulator_->model().numGridDof();
     if (model_size != size) {
         std::ostringstream message;
-        message << "Cannot set porosity. Expected array of size: "
+        message << "Cannot set " << name << ". Expected array of size: "
                 << model_size << ", got array of size: " << size;
         throw std::runtime_error(message.str());
     }
-    for (unsigned dofIdx = 0; dofIdx < size; ++dofIdx) {
-        problem.setPorosity(poro[dofIdx], dofIdx);
-    }
 }
 } //namespace Opm::Pybind
@@ -0,0 +1,251 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_BLOCK_KERNELS_HEADER_INCLUDED
+#define OPM_BLOCK_KERNELS_HEADER_INCLUDED
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define OPM_BLOCK_KERNELS_AVX2 1
+#else
+#define OPM_BLOCK_KERNELS_AVX2 0
+#endif
+
+namespace Opm
+{
+namespace detail
+{
+
+/// Operations on small dense n x n blocks, stored row major and
+/// contiguously as in Dune::FieldMatrix, used in the inner loops of the
+/// sparse matrix-vector product and of the block ILU0 factorization and
+/// triangular solves.
+///
+/// The generic version has loops with compile-time bounds, which the
+/// compiler unrolls completely, and sums every row in a local variable.
+/// Contrary to the generic DenseMatrix operations of dune-common this
+/// lets the compiler keep the vector in registers and vectorize. The
+/// block size 4 of the three-phase models with an additional component
+/// has an AVX2 specialization for double, selected when compiling with
+/// AVX2 and FMA enabled (e.g. -march=native).
+template <class K, int n>
+struct BlockKernelsGeneric
+{
+    //! y += A x
+    static void umv(const K* a, const K* x, K* y)
+    {
+        for (int i = 0; i < n; ++i) {
+            K s = 0;
+            for (int j = 0; j < n; ++j) {
+                s += a[i * n + j] * x[j];
+            }
+            y[i] += s;
+        }
+    }
+
+    //! y -= A x
+    static void mmv(const K* a, const K* x, K* y)
+    {
+        for (int i = 0; i < n; ++i) {
+            K s = 0;
+            for (int j = 0; j < n; ++j) {
+                s += a[i * n + j] * x[j];
+            }
+            y[i] -= s;
+        }
+    }
+
+    //! y += alpha A x
+    static void usmv(const K alpha, const K* a, const K* x, K* y)
+    {
+        for (int i = 0; i < n; ++i) {
+            K s = 0;
+            for (int j = 0; j < n; ++j) {
+                s += a[i * n + j] * x[j];
+            }
+            y[i] += alpha * s;
+        }
+    }
+
+    //! y = A x
+    static void mv(const K* a, const K* x, K* y)
+    {
+        for (int i = 0; i < n; ++i) {
+            K s = 0;
+            for (int j = 0; j < n; ++j) {
+                s += a[i * n + j] * x[j];
+            }
+            y[i] = s;
+        }
+    }
+
+    //! C = A B
+    static void multiply(const K* a, const K* b, K* c)
+    {
+        for (int i = 0; i < n; ++i) {
+            K row[n] = {};
+            for (int k = 0; k < n; ++k) {
+                const K aik = a[i * n + k];
+                for (int j = 0; j < n; ++j) {
+                    row[j] += aik * b[k * n + j];
+                }
+            }
+            for (int j = 0; j < n; ++j) {
+                c[i * n + j] = row[j];
+            }
+        }
+    }
+
+    //! C -= A B
+    static void multiplySubtract(const K* a, const K* b, K* c)
+    {
+        for (int i = 0; i < n; ++i) {
+            K row[n] = {};
+            for (int k = 0; k < n; ++k) {
+                const K aik = a[i * n + k];
+                for (int j = 0; j < n; ++j) {
+                    row[j] += aik * b[k * n + j];
+                }
+            }
+            for (int j = 0; j < n; ++j) {
+                c[i * n + j] -= row[j];
+            }
+        }
+    }
+};
+
+template <class K, int n>
+struct BlockKernels : public BlockKernelsGeneric<K, n>
+{};
+
+#if OPM_BLOCK_KERNELS_AVX2
+// The matrix-vector products would need horizontal sums for row major
+// blocks, which are slower than the unrolled scalar loops, so only the
+// block products used in the factorization are specialized. Row i of A B
+// is the sum of the rows of B weighted by row i of A.
+template <>
+struct BlockKernels<double, 4> : public BlockKernelsGeneric<double, 4>
+{
+    static __m256d productRow(const double* a, const __m256d b[4])
+    {
+        __m256d row = _mm256_mul_pd(_mm256_set1_pd(a[0]), b[0]);
+        row = _mm256_fmadd_pd(_mm256_set1_pd(a[1]), b[1], row);
+        row = _mm256_fmadd_pd(_mm256_set1_pd(a[2]), b[2], row);
+        return _mm256_fmadd_pd(_mm256_set1_pd(a[3]), b[3], row);
+    }
+
+    static void multiply(const double* a, const double* b, double* c)
+    {
+        const __m256d bv[4] = { _mm256_loadu_pd(b), _mm256_loadu_pd(b + 4),
+                                _mm256_loadu_pd(b + 8), _mm256_loadu_pd(b + 12) };
+        __m256d rows[4];
+        for (int i = 0; i < 4; ++i) {
+            rows[i] = productRow(a + 4 * i, bv);
+        }
+        for (int i = 0; i < 4; ++i) {
+            _mm256_storeu_pd(c + 4 * i, rows[i]);
+        }
+    }
+
+    static void multiplySubtract(const double* a, const double* b, double* c)
+    {
+        const __m256d bv[4] = { _mm256_loadu_pd(b), _mm256_loadu_pd(b + 4),
+                                _mm256_loadu_pd(b + 8), _mm256_loadu_pd(b + 12) };
+        for (int i = 0; i < 4; ++i) {
+            const __m256d row = productRow(a + 4 * i, bv);
+            _mm256_storeu_pd(c + 4 * i, _mm256_sub_pd(_mm256_loadu_pd(c + 4 * i), row));
+        }
+    }
+};
+#endif // OPM_BLOCK_KERNELS_AVX2
+
+/// Block operations on Dune::FieldMatrix and derived block types, square
+/// blocks use BlockKernels and others the operations of the block.
+template <class Block>
+constexpr bool useBlockKernels = Block::rows == Block::cols;
+
+template <class Block, class XBlock, class YBlock>
+void blockUmv(const Block& a, const XBlock& x, YBlock& y)
+{
+    if constexpr (useBlockKernels<Block>) {
+        BlockKernels<typename Block::field_type, Block::rows>::umv(&a[0][0], &x[0], &y[0]);
+    } else {
+        a.umv(x, y);
+    }
+}
+
+template <class Block, class XBlock, class YBlock>
+void blockMmv(const Block& a, const XBlock& x, YBlock& y)
+{
+    if constexpr (useBlockKernels<Block>) {
+        BlockKernels<typename Block::field_type, Block::rows>::mmv(&a[0][0], &x[0], &y[0]);
+    } else {
+        a.mmv(x, y);
+    }
+}
+
+template <class Block, class XBlock, class YBlock>
+void blockUsmv(const typename Block::field_type alpha, const Block& a, const XBlock& x, YBlock& y)
+{
+    if constexpr (useBlockKernels<Block>) {
+        BlockKernels<typename Block::field_type, Block::rows>::usmv(alpha, &a[0][0], &x[0], &y[0]);
+    } else {
+        a.usmv(alpha, x, y);
+    }
+}
+
+template <class Block, class XBlock, class YBlock>
+void blockMv(const Block& a, const XBlock& x, YBlock& y)
+{
+    if constexpr (useBlockKernels<Block>) {
+        BlockKernels<typename Block::field_type, Block::rows>::mv(&a[0][0], &x[0], &y[0]);
+    } else {
+        a.mv(x, y);
+    }
+}
+
+//! a = a b
+template <class Block>
+void blockRightMultiply(Block& a, const Block& b)
+{
+    if constexpr (useBlockKernels<Block>) {
+        const Block tmp(a);
+        BlockKernels<typename Block::field_type, Block::rows>::multiply(&tmp[0][0], &b[0][0], &a[0][0]);
+    } else {
+        a.rightmultiply(b);
+    }
+}
+
+//! c -= a b
+template <class Block>
+void blockMultiplySubtract(const Block& a, const Block& b, Block& c)
+{
+    if constexpr (useBlockKernels<Block>) {
+        BlockKernels<typename Block::field_type, Block::rows>::multiplySubtract(&a[0][0], &b[0][0], &c[0][0]);
+    } else {
+        Block tmp(b);
+        tmp.leftmultiply(a);
+        c -= tmp;
+    }
+}
+
+} // namespace detail
+} // namespace Opm
+
+#endif // OPM_BLOCK_KERNELS_HEADER_INCLUDED
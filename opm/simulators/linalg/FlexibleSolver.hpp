@@ -27,9 +27,12 @@
 #include <dune/istl/solver.hh>
 #include <dune/istl/paamg/pinfo.hh>
 
+#include <memory>
+
 namespace Opm
 {
 class PropertyTree;
+struct PressurePatternCache;
 }
 
 namespace Dune
@@ -53,7 +56,8 @@ public:
     FlexibleSolver(Operator& op,
                    const Opm::PropertyTree& prm,
                    const std::function<VectorType()>& weightsCalculator,
-                   std::size_t pressureIndex);
+                   std::size_t pressureIndex,
+                   const std::shared_ptr<Opm::PressurePatternCache>& patternCache = {});
 
     /// Create a parallel solver (if Comm is e.g. OwnerOverlapCommunication).
     template <class Comm>
@@ -61,7 +65,8 @@ public:
                    const Comm& comm,
                    const Opm::PropertyTree& prm,
                    const std::function<VectorType()>& weightsCalculator,
-                   std::size_t pressureIndex);
+                   std::size_t pressureIndex,
+                   const std::shared_ptr<Opm::PressurePatternCache>& patternCache = {});
 
     virtual void apply(VectorType& x, VectorType& rhs, Dune::InverseOperatorResult& res) override;
 
@@ -80,13 +85,16 @@ private:
     template <class Comm>
     void initOpPrecSp(Operator& op, const Opm::PropertyTree& prm,
                       const std::function<VectorType()> weightsCalculator, const Comm& comm,
-                      std::size_t pressureIndex);
+                      std::size_t pressureIndex,
+                      const std::shared_ptr<Opm::PressurePatternCache>& patternCache);
 
     void initOpPrecSp(Operator& op, const Opm::PropertyTree& prm,
                       const std::function<VectorType()> weightsCalculator, const Dune::Amg::SequentialInformation&,
-                      std::size_t pressureIndex);
+                      std::size_t pressureIndex,
+                      const std::shared_ptr<Opm::PressurePatternCache>& patternCache);
 
-    void initSolver(const Opm::PropertyTree& prm, const bool is_iorank);
+    template <class Comm>
+    void initSolver(const Opm::PropertyTree& prm, const Comm& comm);
 
     void recreateDirectSolver();
 
@@ -97,7 +105,8 @@ private:
               const Comm& comm,
               const Opm::PropertyTree& prm,
               const std::function<VectorType()> weightsCalculator,
-              std::size_t pressureIndex);
+              std::size_t pressureIndex,
+              const std::shared_ptr<Opm::PressurePatternCache>& patternCache);
 
     Operator* linearoperator_for_solver_;
     std::shared_ptr<AbstractPrecondType> preconditioner_;
@@ -26,8 +26,11 @@
 #include <opm/simulators/linalg/matrixblock.hh>
 #include <opm/simulators/linalg/ilufirstelement.hh>
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
+#include <opm/simulators/linalg/PipelinedBiCGSTABSolver.hpp>
 #include <opm/simulators/linalg/PreconditionerFactory.hpp>
 #include <opm/simulators/linalg/PropertyTree.hpp>
+#include <opm/simulators/linalg/RecyclingGMResSolver.hpp>
+#include <opm/simulators/linalg/SStepGMResSolver.hpp>
 #include <opm/simulators/linalg/WellOperators.hpp>
 
 #include <dune/common/fmatrix.hh>
@@ -49,10 +52,11 @@ namespace Dune
     FlexibleSolver(Operator& op,
                    const Opm::PropertyTree& prm,
                    const std::function<VectorType()>& weightsCalculator,
-                   std::size_t pressureIndex)
+                   std::size_t pressureIndex,
+                   const std::shared_ptr<Opm::PressurePatternCache>& patternCache)
     {
         init(op, Dune::Amg::SequentialInformation(), prm, weightsCalculator,
-             pressureIndex);
+             pressureIndex, patternCache);
     }
 
     /// Create a parallel solver (if Comm is e.g. OwnerOverlapCommunication).
@@ -63,9 +67,10 @@ namespace Dune
                    const Comm& comm,
                    const Opm::PropertyTree& prm,
                    const std::function<VectorType()>& weightsCalculator,
-                   std::size_t pressureIndex)
+                   std::size_t pressureIndex,
+                   const std::shared_ptr<Opm::PressurePatternCache>& patternCache)
     {
-        init(op, comm, prm, weightsCalculator, pressureIndex);
+        init(op, comm, prm, weightsCalculator, pressureIndex, patternCache);
     }
 
     template <class Operator>
@@ -116,7 +121,8 @@ namespace Dune
                  const Opm::PropertyTree& prm,
                  const std::function<VectorType()> weightsCalculator,
                  const Comm& comm,
-                 std::size_t pressureIndex)
+                 std::size_t pressureIndex,
+                 const std::shared_ptr<Opm::PressurePatternCache>& patternCache)
     {
         // Parallel case.
         linearoperator_for_solver_ = &op;
@@ -125,7 +131,8 @@ namespace Dune
                                                                              child ? *child : Opm::PropertyTree(),
                                                                              weightsCalculator,
                                                                              comm,
-                                                                             pressureIndex);
+                                                                             pressureIndex,
+                                                                             patternCache);
         scalarproduct_ = Dune::createScalarProduct<VectorType, Comm>(comm, op.category());
     }
 
@@ -136,7 +143,8 @@ namespace Dune
                  const Opm::PropertyTree& prm,
                  const std::function<VectorType()> weightsCalculator,
                  const Dune::Amg::SequentialInformation&,
-                 std::size_t pressureIndex)
+                 std::size_t pressureIndex,
+                 const std::shared_ptr<Opm::PressurePatternCache>& patternCache)
     {
         // Sequential case.
         linearoperator_for_solver_ = &op;
@@ -144,15 +152,18 @@ namespace Dune
         preconditioner_ = Opm::PreconditionerFactory<Operator,Dune::Amg::SequentialInformation>::create(op,
                                                                        child ? *child : Opm::PropertyTree(),
                                                                        weightsCalculator,
-                                                                       pressureIndex);
+                                                                       pressureIndex,
+                                                                       patternCache);
         scalarproduct_ = std::make_shared<Dune::SeqScalarProduct<VectorType>>();
     }
 
     template <class Operator>
+    template <class Comm>
     void
     FlexibleSolver<Operator>::
-    initSolver(const Opm::PropertyTree& prm, const bool is_iorank)
+    initSolver(const Opm::PropertyTree& prm, const Comm& comm)
     {
+        const bool is_iorank = comm.communicator().rank() == 0;
         const double tol = prm.get<double>("tol", 1e-2);
         const int maxiter = prm.get<int>("maxiter", 200);
         const int verbosity = is_iorank ? prm.get<int>("verbosity", 0) : 0;
@@ -189,6 +200,35 @@ namespace Dune
                                                                                           restart,
                                                                                           maxiter, // maximum number of iterations
                                                                                           verbosity);
+        } else if (solver_type == "pipelinedbicgstab") {
+            linsolver_ = std::make_shared<Opm::PipelinedBiCGSTABSolver<VectorType, Comm>>(*linearoperator_for_solver_,
+                                                                                          *preconditioner_,
+                                                                                          comm,
+                                                                                          tol, // desired residual reduction factor
+                                                                                          maxiter, // maximum number of iterations
+                                                                                          verbosity);
+        } else if (solver_type == "sstepgmres") {
+            int restart = prm.get<int>("restart", 15);
+            int sstep = prm.get<int>("sstep", 4);
+            linsolver_ = std::make_shared<Opm::SStepGMResSolver<VectorType, Comm>>(*linearoperator_for_solver_,
+                                                                                   *preconditioner_,
+                                                                                   comm,
+                                                                                   tol, // desired residual reduction factor
+                                                                                   restart,
+                                                                                   sstep, // number of basis vectors per reduction
+                                                                                   maxiter, // maximum number of iterations
+                                                                                   verbosity);
+        } else if (solver_type == "gcrodr") {
+            int restart = prm.get<int>("restart", 15);
+            int recycle = prm.get<int>("recycle", 5);
+            linsolver_ = std::make_shared<Opm::RecyclingGMResSolver<VectorType, Comm>>(*linearoperator_for_solver_,
+                                                                                       *preconditioner_,
+                                                                                       comm,
+                                                                                       tol, // desired residual reduction factor
+                                                                                       restart,
+                                                                                       recycle, // dimension of the recycled space
+                                                                                       maxiter, // maximum number of iterations
+                                                                                       verbosity);
 #if HAVE_SUITESPARSE_UMFPACK
         } else if (solver_type == "umfpack") {
             using MatrixType = std::remove_const_t<std::remove_reference_t<decltype(linearoperator_for_solver_->getmat())>>;
@@ -241,10 +281,11 @@ namespace Dune
          const Comm& comm,
          const Opm::PropertyTree& prm,
          const std::function<VectorType()> weightsCalculator,
-         std::size_t pressureIndex)
+         std::size_t pressureIndex,
+         const std::shared_ptr<Opm::PressurePatternCache>& patternCache)
     {
-        initOpPrecSp(op, prm, weightsCalculator, comm, pressureIndex);
-        initSolver(prm, comm.communicator().rank() == 0);
+        initOpPrecSp(op, prm, weightsCalculator, comm, pressureIndex, patternCache);
+        initSolver(prm, comm);
     }
 
 } // namespace Dune
@@ -283,7 +324,8 @@ template Dune::FlexibleSolver<Operator>::FlexibleSolver(Operator& op,
                                                         const Comm& comm,                                \
                                                         const Opm::PropertyTree& prm,                    \
                                                         const std::function<typename Operator::domain_type()>& weightsCalculator, \
-                                                        std::size_t pressureIndex);
+                                                        std::size_t pressureIndex,                       \
+                                                        const std::shared_ptr<Opm::PressurePatternCache>& patternCache);
 #define INSTANTIATE_FLEXIBLESOLVER(N)     \
 INSTANTIATE_FLEXIBLESOLVER_OP(SeqOpM<N>); \
 INSTANTIATE_FLEXIBLESOLVER_OP(SeqOpW<N>); \
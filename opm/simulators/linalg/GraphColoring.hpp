@@ -242,5 +242,131 @@ reorderVerticesSpheres(const std::vector<int>& colors, int noColors,
     }
     return indices;
 }
+
+/// \brief Reorder the vertices with the reverse Cuthill-McKee algorithm.
+///
+/// The ordering reduces the bandwidth of the matrix, and thereby improves the
+/// locality of the matrix and vector accesses in the matrix-vector products
+/// and triangular solves, and usually also the quality of ILU factorizations.
+/// Each connected component is numbered in a breadth first search starting
+/// at a pseudo-peripheral vertex found with the algorithm of George and Liu,
+/// visiting the neighbors by increasing degree. The result is reversed.
+/// \param graph The graph to reorder. Must adhere to the graph interface of dune-istl.
+/// \param noReordered Only the vertices with index less than this are reordered
+///        and edges to other vertices are ignored, e.g. to keep the ghost rows last.
+///        The other vertices keep their index.
+/// \return A vector with the new index of each vertex.
+template<class Graph>
+std::vector<std::size_t>
+reorderVerticesReverseCuthillMcKee(const Graph& graph,
+                                   std::size_t noReordered = std::numeric_limits<std::size_t>::max())
+{
+    using Vertex = typename Graph::VertexDescriptor;
+    const std::size_t noVertices = graph.maxVertex() + 1;
+    noReordered = std::min(noReordered, noVertices);
+
+    std::vector<std::size_t> degrees(noReordered, 0);
+    for (std::size_t vertex = 0; vertex < noReordered; ++vertex)
+    {
+        for (auto edge = graph.beginEdges(vertex), endEdge = graph.endEdges(vertex);
+             edge != endEdge; ++edge)
+        {
+            if ( static_cast<std::size_t>(edge.target()) < noReordered &&
+                 static_cast<std::size_t>(edge.target()) != vertex )
+            {
+                ++degrees[vertex];
+            }
+        }
+    }
+
+    const auto notVisitedTag = std::numeric_limits<std::size_t>::max();
+    // Breadth first search from root storing the vertices of its component
+    // in order[start, ...), the neighbors of each vertex sorted by degree.
+    // Returns the position of the first vertex of the last level.
+    std::vector<std::size_t> level(noReordered, notVisitedTag);
+    std::vector<Vertex> order;
+    order.reserve(noReordered);
+    std::vector<Vertex> neighbors;
+    auto levelStructure = [&](Vertex root, std::size_t start)
+        {
+            order.resize(start);
+            order.push_back(root);
+            level[root] = 0;
+            std::size_t lastLevelStart = start;
+            for (std::size_t next = start; next < order.size(); ++next)
+            {
+                const auto current = order[next];
+                if ( level[current] != level[order[lastLevelStart]] )
+                {
+                    lastLevelStart = next;
+                }
+                neighbors.clear();
+                for (auto edge = graph.beginEdges(current), endEdge = graph.endEdges(current);
+                     edge != endEdge; ++edge)
+                {
+                    const auto target = edge.target();
+                    if ( static_cast<std::size_t>(target) < noReordered &&
+                         level[target] == notVisitedTag )
+                    {
+                        level[target] = level[current] + 1;
+                        neighbors.push_back(target);
+                    }
+                }
+                std::stable_sort(neighbors.begin(), neighbors.end(),
+                                 [&degrees](const Vertex& v1, const Vertex& v2)
+                                 {
+                                     return degrees[v1] < degrees[v2];
+                                 });
+                order.insert(order.end(), neighbors.begin(), neighbors.end());
+            }
+            return lastLevelStart;
+        };
+    auto resetLevels = [&](std::size_t start)
+        {
+            for (auto vertex = order.begin() + start; vertex != order.end(); ++vertex)
+            {
+                level[*vertex] = notVisitedTag;
+            }
+        };
+
+    for (std::size_t candidate = 0; candidate < noReordered; ++candidate)
+    {
+        if ( level[candidate] != notVisitedTag )
+        {
+            continue;
+        }
+        const std::size_t start = order.size();
+        // Find a pseudo-peripheral vertex: restart from the vertex of minimum
+        // degree in the last level as long as the eccentricity increases.
+        std::size_t lastLevelStart = levelStructure(candidate, start);
+        std::size_t eccentricity = level[order.back()];
+        while (true)
+        {
+            auto minVertex = std::min_element(order.begin() + lastLevelStart, order.end(),
+                                              [&degrees](const Vertex& v1, const Vertex& v2)
+                                              {
+                                                  return degrees[v1] < degrees[v2];
+                                              });
+            const Vertex root = *minVertex;
+            resetLevels(start);
+            lastLevelStart = levelStructure(root, start);
+            const std::size_t newEccentricity = level[order.back()];
+            if ( newEccentricity <= eccentricity )
+            {
+                break;
+            }
+            eccentricity = newEccentricity;
+        }
+    }
+
+    std::vector<std::size_t> indices(noVertices);
+    std::iota(indices.begin() + noReordered, indices.end(), noReordered);
+    std::size_t index = noReordered;
+    for (const auto vertex : order)
+    {
+        indices[vertex] = --index;
+    }
+    return indices;
+}
 } // end namespace Opm
 #endif
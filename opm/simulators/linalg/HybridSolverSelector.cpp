@@ -0,0 +1,135 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/linalg/HybridSolverSelector.hpp>
+
+#include <stdexcept>
+#include <string>
+
+namespace Opm
+{
+
+HybridSolverSelector::HybridSolverSelector(const int numSolvers,
+                                           const double hysteresis,
+                                           const double smoothing,
+                                           const int penaltySteps)
+    : stats_(numSolvers)
+    , hysteresis_(hysteresis)
+    , smoothing_(smoothing)
+    , penaltySteps_(penaltySteps)
+{
+    if (numSolvers < 1) {
+        throw std::invalid_argument("HybridSolverSelector needs at least one solver.");
+    }
+    if (smoothing <= 0.0 || smoothing > 1.0) {
+        throw std::invalid_argument("HybridSolverSelector smoothing must be in (0, 1], got "
+                                    + std::to_string(smoothing));
+    }
+}
+
+void HybridSolverSelector::setActiveSolver(const int solver)
+{
+    if (solver < 0 || solver >= numSolvers()) {
+        throw std::invalid_argument("Solver number " + std::to_string(solver) + " not available.");
+    }
+    active_ = solver;
+}
+
+void HybridSolverSelector::addSolve(const int solver,
+                                    const double setupTime,
+                                    const double solveTime,
+                                    const int iterations,
+                                    const bool converged)
+{
+    auto& s = stats_[solver];
+    if (!converged) {
+        ++s.failures;
+        s.stepFailed = true;
+        return;
+    }
+    s.stepTime += setupTime + solveTime;
+    s.stepIterations += iterations;
+    ++s.stepSolves;
+}
+
+int HybridSolverSelector::selectForStep()
+{
+    for (auto& s : stats_) {
+        if (s.stepSolves > 0) {
+            const double cost = s.stepTime / s.stepSolves;
+            const double iterations = static_cast<double>(s.stepIterations) / s.stepSolves;
+            if (s.cost < 0.0) {
+                s.cost = cost;
+                s.iterations = iterations;
+            } else {
+                s.cost = smoothing_ * cost + (1.0 - smoothing_) * s.cost;
+                s.iterations = smoothing_ * iterations + (1.0 - smoothing_) * s.iterations;
+            }
+        }
+        if (s.stepFailed) {
+            s.penalty = penaltySteps_;
+        } else if (s.penalty > 0) {
+            --s.penalty;
+        }
+        s.stepTime = 0.0;
+        s.stepIterations = 0;
+        s.stepSolves = 0;
+        s.stepFailed = false;
+    }
+
+    int best = -1;
+    for (int i = 0; i < numSolvers(); ++i) {
+        const auto& s = stats_[i];
+        if (available(s) && s.cost >= 0.0 && (best < 0 || s.cost < stats_[best].cost)) {
+            best = i;
+        }
+    }
+    if (best < 0 || best == active_) {
+        return active_;
+    }
+
+    const auto& current = stats_[active_];
+    if (!available(current) || current.cost < 0.0
+        || stats_[best].cost < (1.0 - hysteresis_) * current.cost) {
+        active_ = best;
+    }
+    return active_;
+}
+
+int HybridSolverSelector::fallback() const
+{
+    // Prefer the cheapest measured solver, then the unmeasured ones, and
+    // only retry solvers excluded after failures in earlier steps last.
+    int best = -1;
+    auto rank = [](const Stats& s) { return s.penalty > 0 ? 2 : (s.cost < 0.0 ? 1 : 0); };
+    for (int i = 0; i < numSolvers(); ++i) {
+        const auto& s = stats_[i];
+        if (i == active_ || s.stepFailed) {
+            continue;
+        }
+        if (best < 0 || rank(s) < rank(stats_[best])
+            || (rank(s) == rank(stats_[best]) && s.cost < stats_[best].cost)) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+} // namespace Opm
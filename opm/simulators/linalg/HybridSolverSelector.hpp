@@ -0,0 +1,114 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_HYBRIDSOLVERSELECTOR_HEADER_INCLUDED
+#define OPM_HYBRIDSOLVERSELECTOR_HEADER_INCLUDED
+
+#include <vector>
+
+namespace Opm
+{
+
+/// Chooses between the linear solvers of the hybrid configuration from
+/// their measured performance.
+///
+/// The cost of a solver is the wall time of a linear solve including the
+/// preconditioner setup. The solves of every time step are accumulated
+/// and the average of the step is blended into an exponentially smoothed
+/// prediction when the solver for the next step is selected. A different
+/// solver is chosen only if its predicted cost is below the one of the
+/// active solver by more than the hysteresis fraction, such that noise in
+/// the timings does not make the choice oscillate. A solver that fails to
+/// converge is excluded from the selection for a number of time steps.
+///
+/// The selector only sees the timings of the calling process, callers
+/// running in parallel must make the choices consistent, e.g. by using
+/// the ones of the first process.
+class HybridSolverSelector
+{
+public:
+    /// \param numSolvers    number of available solvers
+    /// \param hysteresis    relative cost advantage required for switching
+    /// \param smoothing     weight of the last time step in the prediction
+    /// \param penaltySteps  number of time steps a failed solver is excluded
+    HybridSolverSelector(int numSolvers,
+                         double hysteresis,
+                         double smoothing = 0.5,
+                         int penaltySteps = 10);
+
+    int numSolvers() const
+    { return static_cast<int>(stats_.size()); }
+
+    int activeSolver() const
+    { return active_; }
+
+    void setActiveSolver(int solver);
+
+    /// Record one linear solve of the given solver.
+    void addSolve(int solver, double setupTime, double solveTime,
+                  int iterations, bool converged);
+
+    /// Fold the measurements of the finished time step into the
+    /// predictions and return the solver to use for the next one.
+    int selectForStep();
+
+    /// Solver to retry with after the active one failed in the current
+    /// time step, or -1 if all solvers have failed.
+    int fallback() const;
+
+    /// Predicted wall time of one linear solve, negative if the solver has
+    /// not been measured yet.
+    double predictedCost(int solver) const
+    { return stats_[solver].cost; }
+
+    /// Predicted number of linear iterations of one solve.
+    double predictedIterations(int solver) const
+    { return stats_[solver].iterations; }
+
+    /// Number of linear solves that did not converge.
+    int failures(int solver) const
+    { return stats_[solver].failures; }
+
+private:
+    struct Stats
+    {
+        double cost = -1.0;
+        double iterations = 0.0;
+        int failures = 0;
+        int penalty = 0;
+
+        double stepTime = 0.0;
+        int stepIterations = 0;
+        int stepSolves = 0;
+        bool stepFailed = false;
+    };
+
+    bool available(const Stats& s) const
+    { return s.penalty == 0 && !s.stepFailed; }
+
+    std::vector<Stats> stats_;
+    double hysteresis_;
+    double smoothing_;
+    int penaltySteps_;
+    int active_ = 0;
+};
+
+} // namespace Opm
+
+#endif // OPM_HYBRIDSOLVERSELECTOR_HEADER_INCLUDED
@@ -161,7 +161,8 @@ void FlexibleSolverInfo<Matrix,Vector,Comm>::create(const Matrix& matrix,
             using FlexibleSolverType = Dune::FlexibleSolver<ParOperatorType>;
             auto sol = std::make_unique<FlexibleSolverType>(*pop, comm, prm,
                                                             weightsCalculator,
-                                                            pressureIndex);
+                                                            pressureIndex,
+                                                            pressurePattern_);
             this->pre_ = &sol->preconditioner();
             this->op_ = std::move(pop);
             this->solver_ = std::move(sol);
@@ -172,7 +173,8 @@ void FlexibleSolverInfo<Matrix,Vector,Comm>::create(const Matrix& matrix,
             using FlexibleSolverType = Dune::FlexibleSolver<ParOperatorType>;
             auto sol = std::make_unique<FlexibleSolverType>(*pop, comm, prm,
                                                             weightsCalculator,
-                                                            pressureIndex);
+                                                            pressureIndex,
+                                                            pressurePattern_);
             this->pre_ = &sol->preconditioner();
             this->op_ = std::move(pop);
             this->solver_ = std::move(sol);
@@ -185,7 +187,8 @@ void FlexibleSolverInfo<Matrix,Vector,Comm>::create(const Matrix& matrix,
             using FlexibleSolverType = Dune::FlexibleSolver<SeqOperatorType>;
             auto sol = std::make_unique<FlexibleSolverType>(*sop, prm,
                                                             weightsCalculator,
-                                                            pressureIndex);
+                                                            pressureIndex,
+                                                            pressurePattern_);
             this->pre_ = &sol->preconditioner();
             this->op_ = std::move(sop);
             this->solver_ = std::move(sol);
@@ -195,7 +198,8 @@ void FlexibleSolverInfo<Matrix,Vector,Comm>::create(const Matrix& matrix,
             using FlexibleSolverType = Dune::FlexibleSolver<SeqOperatorType>;
             auto sol = std::make_unique<FlexibleSolverType>(*sop, prm,
                                                             weightsCalculator,
-                                                            pressureIndex);
+                                                            pressureIndex,
+                                                            pressurePattern_);
             this->pre_ = &sol->preconditioner();
             this->op_ = std::move(sop);
             this->solver_ = std::move(sol);
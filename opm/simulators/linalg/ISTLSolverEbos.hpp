@@ -41,6 +41,7 @@
 #include <opm/simulators/linalg/matrixblock.hh>
 #include <opm/simulators/linalg/istlsparsematrixadapter.hh>
 #include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+#include <opm/simulators/linalg/PressureTransferHelpers.hpp>
 #include <opm/simulators/linalg/WellOperators.hpp>
 #include <opm/simulators/linalg/WriteSystemMatrixHelper.hpp>
 #include <opm/simulators/linalg/findOverlapRowsAndColumns.hpp>
@@ -48,6 +49,7 @@
 #include <opm/simulators/linalg/setupPropertyTree.hpp>
 
 #include <any>
+#include <cmath>
 #include <cstddef>
 #include <functional>
 #include <memory>
@@ -111,6 +113,9 @@ struct FlexibleSolverInfo
     std::unique_ptr<LinearOperatorExtra<Vector,Vector>> wellOperator_;
     AbstractPreconditionerType* pre_ = nullptr;
     std::size_t interiorCellNum_ = 0;
+    // Outlives the solvers created above, such that a recreated CPR
+    // preconditioner reuses the coarse pattern.
+    std::shared_ptr<PressurePatternCache> pressurePattern_ = std::make_shared<PressurePatternCache>();
 };
 
 
@@ -315,6 +320,11 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
             return flexibleSolver_.size();
         }
 
+        const std::string& solverName(const int num) const
+        {
+            return parameters_[num].linsolver_;
+        }
+
         void prepare(const SparseMatrixAdapter& M, Vector& b)
         {
             prepare(M.istlMatrix(), b);
@@ -400,7 +410,17 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
             {
                 OPM_TIMEBLOCK(flexibleSolverApply);
                 assert(flexibleSolver_[activeSolverNum_].solver_);
-                flexibleSolver_[activeSolverNum_].solver_->apply(x, *rhs_, result);
+                const double ratio = initialResidualRatio(x);
+                if (ratio < 1.0) {
+                    const double tol = prm_[activeSolverNum_].template get<double>("tol", 1e-2);
+                    flexibleSolver_[activeSolverNum_].solver_->apply(x, *rhs_, tol / ratio, result);
+                    // The solver reports the reduction relative to the
+                    // initial residual, make it relative to the right hand
+                    // side like for a zero guess.
+                    result.reduction *= ratio;
+                } else {
+                    flexibleSolver_[activeSolverNum_].solver_->apply(x, *rhs_, result);
+                }
             }
 
             // Check convergence, iterations etc.
@@ -451,6 +471,40 @@ std::unique_ptr<Matrix> blockJacobiAdjacency(const Grid& grid,
         }
     protected:
 
+        /// Norm of the initial residual b - Ax relative to the norm of the
+        /// right hand side b. The solver must reduce the residual of a
+        /// nonzero guess x by the tolerance divided by this ratio to reach
+        /// the same tolerance, relative to b, as when starting from zero.
+        /// If the guess does not reduce the residual, x is reset to zero
+        /// and the ratio is one.
+        double initialResidualRatio(Vector& x) const
+        {
+            if (globalDot(x, x) == 0.0) {
+                return 1.0;
+            }
+            Vector r(*rhs_);
+            flexibleSolver_[activeSolverNum_].op_->applyscaleadd(-1.0, x, r);
+            const double rnorm = std::sqrt(globalDot(r, r));
+            const double bnorm = std::sqrt(globalDot(*rhs_, *rhs_));
+            if (!(rnorm < bnorm)) {
+                x = 0.0;
+                return 1.0;
+            }
+            return rnorm / bnorm;
+        }
+
+        double globalDot(const Vector& a, const Vector& b) const
+        {
+#if HAVE_MPI
+            if (isParallel()) {
+                double result = 0.0;
+                comm_->dot(a, b, result);
+                return result;
+            }
+#endif
+            return a.dot(b);
+        }
+
         bool isParallel() const {
 #if HAVE_MPI
             return !forceSerial_ && comm_->communicator().size() > 1;
@@ -225,7 +225,10 @@ public:
                                 this->comm_.get());
         }
 
-        // Solve system.
+        // Solve system. The accelerated solvers start from zero and
+        // report the reduction relative to the right hand side, so an
+        // initial guess from the Newton solver is discarded.
+        x = 0.0;
         Dune::InverseOperatorResult result;
 
         std::function<void(WellContributions&)> getContribs =
@@ -0,0 +1,147 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MERGED_REDUCTION_HEADER_INCLUDED
+#define OPM_MERGED_REDUCTION_HEADER_INCLUDED
+
+#include <dune/istl/owneroverlapcopy.hh>
+#include <dune/istl/paamg/pinfo.hh>
+
+#if HAVE_MPI
+#include <mpi.h>
+#endif
+
+#include <cstddef>
+#include <vector>
+
+namespace Opm
+{
+
+/// Global summation of several scalar products with a single collective
+/// operation, which may be overlapped with other work.
+///
+/// The Krylov solvers compute the local parts of their scalar products,
+/// weighting entry i by weight(i) so that entries which are not owned by
+/// this process are not counted twice, and sum them over all processes
+/// with start() and wait(). Between the two calls the values must not be
+/// accessed.
+template <class Comm>
+class MergedReduction
+{
+public:
+    explicit MergedReduction(const Comm& comm)
+        : comm_(comm)
+    {}
+
+    /// Prepare for vectors of the given size.
+    void resize(const std::size_t size)
+    {
+        if (mask_.size() == size) {
+            return;
+        }
+        mask_.assign(size, 1.0);
+        for (const auto& index : comm_.indexSet()) {
+            if (index.local().attribute() != Dune::OwnerOverlapCopyAttributeSet::owner) {
+                mask_[index.local().local()] = 0.0;
+            }
+        }
+    }
+
+    double weight(const std::size_t i) const
+    {
+        return mask_[i];
+    }
+
+    void start(double* values, const int count)
+    {
+#if HAVE_MPI
+        if (comm_.communicator().size() > 1) {
+            MPI_Iallreduce(MPI_IN_PLACE, values, count, MPI_DOUBLE, MPI_SUM,
+                           comm_.communicator(), &request_);
+            pending_ = true;
+        }
+#else
+        comm_.communicator().sum(values, count);
+#endif
+    }
+
+    void wait()
+    {
+#if HAVE_MPI
+        if (pending_) {
+            MPI_Wait(&request_, MPI_STATUS_IGNORE);
+            pending_ = false;
+        }
+#endif
+    }
+
+    void sum(std::vector<double>& values)
+    {
+        start(values.data(), values.size());
+        wait();
+    }
+
+    bool isIORank() const
+    {
+        return comm_.communicator().rank() == 0;
+    }
+
+private:
+    const Comm& comm_;
+    std::vector<double> mask_;
+#if HAVE_MPI
+    MPI_Request request_;
+    bool pending_ = false;
+#endif
+};
+
+/// Sequential case: all entries are owned and there is nothing to sum.
+template <>
+class MergedReduction<Dune::Amg::SequentialInformation>
+{
+public:
+    explicit MergedReduction(const Dune::Amg::SequentialInformation&)
+    {}
+
+    void resize(const std::size_t)
+    {}
+
+    static constexpr double weight(const std::size_t)
+    {
+        return 1.0;
+    }
+
+    void start(double*, const int)
+    {}
+
+    void wait()
+    {}
+
+    void sum(std::vector<double>&)
+    {}
+
+    bool isIORank() const
+    {
+        return true;
+    }
+};
+
+} // namespace Opm
+
+#endif // OPM_MERGED_REDUCTION_HEADER_INCLUDED
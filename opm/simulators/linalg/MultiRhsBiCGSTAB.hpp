@@ -0,0 +1,373 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_MULTI_RHS_BICGSTAB_HEADER_INCLUDED
+#define OPM_MULTI_RHS_BICGSTAB_HEADER_INCLUDED
+
+#include <dune/common/exceptions.hh>
+#include <dune/istl/istlexception.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace Opm
+{
+
+/// ILU(0)-preconditioned BiCGSTAB for several right-hand sides that share
+/// one sparse matrix with 1x1 blocks.
+///
+/// All systems are iterated in lockstep. The right-hand sides are stored
+/// interleaved (cell-major), so every traversal of the matrix and of the
+/// incomplete factors serves all systems at once. Each system has its own
+/// Krylov coefficients and convergence check; converged systems are frozen
+/// while the remaining ones continue.
+template<class Matrix>
+class MultiRhsBiCGSTAB
+{
+public:
+    using Scalar = typename Matrix::field_type;
+
+    /// Factorise the matrix. The reduction tolerance is relative to the
+    /// initial residual of each system, as in Dune::BiCGSTABSolver.
+    /// Throws Dune::MatrixBlockError on a zero pivot, like Dune::SeqILU.
+    /// With verbosity > 0 a summary of each solve is printed, with
+    /// verbosity > 1 also the largest relative defect of every iteration.
+    MultiRhsBiCGSTAB(const Matrix& A, const Scalar tolerance,
+                     const int maxIter, const int verbosity = 0)
+        : tolerance_(tolerance)
+        , maxIter_(maxIter)
+        , verbosity_(verbosity)
+    {
+        extractCsr_(A);
+        factorise_();
+    }
+
+    /// Solve A x[k] = b[k] for all k, starting from x = 0. The vectors are
+    /// of BlockVector<FieldVector<Scalar,1>> type. Returns true if all
+    /// systems converged.
+    template<class Vector>
+    bool apply(std::vector<Vector>& x, const std::vector<Vector>& b)
+    {
+        const std::size_t m = b.size();
+        if (m == 0) {
+            return true;
+        }
+        if (x.size() != m) {
+            throw std::logic_error("MultiRhsBiCGSTAB: number of solution and right-hand side vectors differ");
+        }
+        m_ = m;
+
+        const std::size_t len = n_ * m;
+        std::vector<Scalar> xs(len, 0.0), r(len), rt(len), p(len, 0.0), v(len, 0.0);
+        std::vector<Scalar> phat(len), s(len), shat(len), t(len);
+
+        for (std::size_t i = 0; i < n_; ++i) {
+            for (std::size_t k = 0; k < m; ++k) {
+                r[i*m + k] = b[k][i][0];
+            }
+        }
+        rt = r;
+
+        std::vector<Scalar> rho(m, 1.0), alpha(m, 1.0), omega(m, 1.0);
+        std::vector<Scalar> rhoNew(m), beta(m), tmp(m), tt(m);
+        std::vector<Scalar> norm0(m), norm(m);
+        std::vector<char> active(m, 1), converged(m, 0);
+
+        norms_(r, norm0);
+        for (std::size_t k = 0; k < m; ++k) {
+            if (norm0[k] == 0.0) {
+                active[k] = 0;
+                converged[k] = 1;
+            }
+        }
+
+        int it = 0;
+        for (; it < maxIter_ && anyActive_(active); ++it) {
+            dots_(rt, r, rhoNew);
+            for (std::size_t k = 0; k < m; ++k) {
+                if (active[k] && std::abs(rhoNew[k]) < tiny_) {
+                    active[k] = 0; // breakdown
+                }
+                beta[k] = active[k] ? (rhoNew[k] / rho[k]) * (alpha[k] / omega[k]) : 0.0;
+                tmp[k] = active[k] ? omega[k] : 0.0;
+            }
+
+            // p = r + beta*(p - omega*v)
+            for (std::size_t i = 0; i < n_; ++i) {
+                for (std::size_t k = 0; k < m; ++k) {
+                    const std::size_t ik = i*m + k;
+                    p[ik] = r[ik] + beta[k]*(p[ik] - tmp[k]*v[ik]);
+                }
+            }
+
+            precondition_(p, phat);
+            multiply_(phat, v);
+
+            dots_(rt, v, tmp);
+            for (std::size_t k = 0; k < m; ++k) {
+                if (active[k] && std::abs(tmp[k]) < tiny_) {
+                    active[k] = 0;
+                }
+                alpha[k] = active[k] ? rhoNew[k] / tmp[k] : 0.0;
+            }
+
+            // s = r - alpha*v, x += alpha*phat
+            for (std::size_t i = 0; i < n_; ++i) {
+                for (std::size_t k = 0; k < m; ++k) {
+                    const std::size_t ik = i*m + k;
+                    s[ik] = r[ik] - alpha[k]*v[ik];
+                    xs[ik] += alpha[k]*phat[ik];
+                }
+            }
+
+            norms_(s, norm);
+            for (std::size_t k = 0; k < m; ++k) {
+                if (active[k] && norm[k] <= tolerance_*norm0[k]) {
+                    active[k] = 0;
+                    converged[k] = 1;
+                    alpha[k] = 0.0;
+                }
+            }
+            if (!anyActive_(active)) {
+                break;
+            }
+
+            precondition_(s, shat);
+            multiply_(shat, t);
+
+            dots_(t, s, tmp);
+            dots_(t, t, tt);
+            for (std::size_t k = 0; k < m; ++k) {
+                if (active[k] && std::abs(tt[k]) < tiny_) {
+                    active[k] = 0;
+                }
+                omega[k] = active[k] ? tmp[k] / tt[k] : 0.0;
+            }
+
+            // x += omega*shat, r = s - omega*t
+            for (std::size_t i = 0; i < n_; ++i) {
+                for (std::size_t k = 0; k < m; ++k) {
+                    const std::size_t ik = i*m + k;
+                    xs[ik] += omega[k]*shat[ik];
+                    r[ik] = active[k] ? s[ik] - omega[k]*t[ik] : r[ik];
+                }
+            }
+
+            norms_(r, norm);
+            Scalar maxDefect = 0.0;
+            for (std::size_t k = 0; k < m; ++k) {
+                if (active[k]) {
+                    maxDefect = std::max(maxDefect, norm[k] / norm0[k]);
+                }
+                if (active[k] && norm[k] <= tolerance_*norm0[k]) {
+                    active[k] = 0;
+                    converged[k] = 1;
+                }
+                rho[k] = rhoNew[k];
+            }
+            if (verbosity_ > 1) {
+                std::cout << "MultiRhsBiCGSTAB iteration " << it + 1
+                          << ": largest relative defect " << maxDefect << std::endl;
+            }
+        }
+        iterations_ = it;
+
+        for (std::size_t k = 0; k < m; ++k) {
+            x[k].resize(n_);
+            for (std::size_t i = 0; i < n_; ++i) {
+                x[k][i][0] = xs[i*m + k];
+            }
+        }
+
+        const auto numConverged = std::count(converged.begin(), converged.end(), 1);
+        if (verbosity_ > 0) {
+            std::cout << "=== MultiRhsBiCGSTAB: " << numConverged << " of " << m
+                      << " systems converged in " << iterations_ << " iterations" << std::endl;
+        }
+        return static_cast<std::size_t>(numConverged) == m;
+    }
+
+    /// Number of lockstep iterations of the last solve.
+    int iterations() const
+    {
+        return iterations_;
+    }
+
+private:
+    void extractCsr_(const Matrix& A)
+    {
+        n_ = A.N();
+        rowStart_.assign(n_ + 1, 0);
+        diag_.assign(n_, 0);
+        cols_.clear();
+        lu_.clear();
+        cols_.reserve(A.nonzeroes());
+        lu_.reserve(A.nonzeroes());
+
+        bool hasDiag = true;
+        for (auto row = A.begin(); row != A.end(); ++row) {
+            const std::size_t i = row.index();
+            bool foundDiag = false;
+            for (auto col = row->begin(); col != row->end(); ++col) {
+                if (col.index() == i) {
+                    diag_[i] = cols_.size();
+                    foundDiag = true;
+                }
+                cols_.push_back(col.index());
+                lu_.push_back((*col)[0][0]);
+            }
+            hasDiag = hasDiag && foundDiag;
+            rowStart_[i + 1] = cols_.size();
+        }
+        if (!hasDiag) {
+            throw std::logic_error("MultiRhsBiCGSTAB: matrix lacks diagonal entries");
+        }
+        vals_ = lu_;
+    }
+
+    // In-place ILU(0) of lu_ on the sparsity pattern of the matrix. The
+    // inverse of the diagonal of U is kept separately.
+    void factorise_()
+    {
+        invDiag_.assign(n_, 0.0);
+        std::vector<std::size_t> pos(n_, std::numeric_limits<std::size_t>::max());
+        for (std::size_t i = 0; i < n_; ++i) {
+            for (std::size_t ij = rowStart_[i]; ij < rowStart_[i + 1]; ++ij) {
+                pos[cols_[ij]] = ij;
+            }
+            for (std::size_t ik = rowStart_[i]; ik < diag_[i]; ++ik) {
+                const std::size_t k = cols_[ik];
+                lu_[ik] *= invDiag_[k];
+                for (std::size_t kj = diag_[k] + 1; kj < rowStart_[k + 1]; ++kj) {
+                    const std::size_t ij = pos[cols_[kj]];
+                    if (ij != std::numeric_limits<std::size_t>::max()) {
+                        lu_[ij] -= lu_[ik] * lu_[kj];
+                    }
+                }
+            }
+            const Scalar d = lu_[diag_[i]];
+            if (d == 0.0) {
+                DUNE_THROW(Dune::MatrixBlockError,
+                           "MultiRhsBiCGSTAB: zero pivot in ILU0 row " << i);
+            }
+            invDiag_[i] = 1.0 / d;
+            for (std::size_t ij = rowStart_[i]; ij < rowStart_[i + 1]; ++ij) {
+                pos[cols_[ij]] = std::numeric_limits<std::size_t>::max();
+            }
+        }
+    }
+
+    // y = (LU)^-1 x
+    void precondition_(const std::vector<Scalar>& x, std::vector<Scalar>& y) const
+    {
+        const std::size_t m = m_;
+        for (std::size_t i = 0; i < n_; ++i) {
+            Scalar* yi = &y[i*m];
+            std::copy_n(&x[i*m], m, yi);
+            for (std::size_t ik = rowStart_[i]; ik < diag_[i]; ++ik) {
+                const Scalar l = lu_[ik];
+                const Scalar* yk = &y[cols_[ik]*m];
+                for (std::size_t k = 0; k < m; ++k) {
+                    yi[k] -= l*yk[k];
+                }
+            }
+        }
+        for (std::size_t i = n_; i-- > 0; ) {
+            Scalar* yi = &y[i*m];
+            for (std::size_t ij = diag_[i] + 1; ij < rowStart_[i + 1]; ++ij) {
+                const Scalar u = lu_[ij];
+                const Scalar* yj = &y[cols_[ij]*m];
+                for (std::size_t k = 0; k < m; ++k) {
+                    yi[k] -= u*yj[k];
+                }
+            }
+            for (std::size_t k = 0; k < m; ++k) {
+                yi[k] *= invDiag_[i];
+            }
+        }
+    }
+
+    // y = A x
+    void multiply_(const std::vector<Scalar>& x, std::vector<Scalar>& y) const
+    {
+        const std::size_t m = m_;
+        for (std::size_t i = 0; i < n_; ++i) {
+            Scalar* yi = &y[i*m];
+            std::fill_n(yi, m, 0.0);
+            for (std::size_t ij = rowStart_[i]; ij < rowStart_[i + 1]; ++ij) {
+                const Scalar a = vals_[ij];
+                const Scalar* xj = &x[cols_[ij]*m];
+                for (std::size_t k = 0; k < m; ++k) {
+                    yi[k] += a*xj[k];
+                }
+            }
+        }
+    }
+
+    void dots_(const std::vector<Scalar>& x,
+               const std::vector<Scalar>& y,
+               std::vector<Scalar>& res) const
+    {
+        const std::size_t m = m_;
+        std::fill(res.begin(), res.end(), 0.0);
+        for (std::size_t i = 0; i < n_; ++i) {
+            for (std::size_t k = 0; k < m; ++k) {
+                res[k] += x[i*m + k]*y[i*m + k];
+            }
+        }
+    }
+
+    void norms_(const std::vector<Scalar>& x, std::vector<Scalar>& res) const
+    {
+        dots_(x, x, res);
+        for (auto& r : res) {
+            r = std::sqrt(r);
+        }
+    }
+
+    static bool anyActive_(const std::vector<char>& active)
+    {
+        return std::any_of(active.begin(), active.end(),
+                           [](const char a) { return a != 0; });
+    }
+
+    static constexpr Scalar tiny_ = 1e-300;
+
+    Scalar tolerance_;
+    int maxIter_;
+    int verbosity_;
+    int iterations_ = 0;
+    std::size_t n_ = 0;
+    std::size_t m_ = 0;
+    std::vector<std::size_t> rowStart_;
+    std::vector<std::size_t> cols_;
+    std::vector<std::size_t> diag_;
+    std::vector<Scalar> vals_;
+    std::vector<Scalar> lu_;
+    std::vector<Scalar> invDiag_;
+};
+
+} // namespace Opm
+
+#endif // OPM_MULTI_RHS_BICGSTAB_HEADER_INCLUDED
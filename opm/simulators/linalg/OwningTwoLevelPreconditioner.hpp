@@ -31,6 +31,8 @@
 #include <dune/istl/paamg/amg.hh>
 
 #include <fstream>
+#include <memory>
+#include <string>
 #include <type_traits>
 
 
@@ -41,6 +43,8 @@ namespace Opm
 // must be broken, accomplished by forward-declaration here.
 template <class Operator, class Comm = Dune::Amg::SequentialInformation>
 class PreconditionerFactory;
+
+struct PressurePatternCache;
 }
 
 namespace Dune
@@ -84,7 +88,8 @@ public:
 
     OwningTwoLevelPreconditioner(const OperatorType& linearoperator, const Opm::PropertyTree& prm,
                                  const std::function<VectorType()> weightsCalculator,
-                                 std::size_t pressureIndex)
+                                 std::size_t pressureIndex,
+                                 const std::shared_ptr<Opm::PressurePatternCache>& patternCache = {})
         : linear_operator_(linearoperator)
         , finesmoother_(PrecFactory::create(linearoperator,
                                             prm.get_child_optional("finesmoother") ?
@@ -93,7 +98,7 @@ public:
         , comm_(nullptr)
         , weightsCalculator_(weightsCalculator)
         , weights_(weightsCalculator())
-        , levelTransferPolicy_(dummy_comm_, weights_, prm, pressureIndex)
+        , levelTransferPolicy_(dummy_comm_, weights_, prm, pressureIndex, patternCache)
         , coarseSolverPolicy_(prm.get_child_optional("coarsesolver") ? prm.get_child("coarsesolver") : Opm::PropertyTree())
         , twolevel_method_(linearoperator,
                            finesmoother_,
@@ -116,7 +121,8 @@ public:
 
     OwningTwoLevelPreconditioner(const OperatorType& linearoperator, const Opm::PropertyTree& prm,
                                  const std::function<VectorType()> weightsCalculator,
-                                 std::size_t pressureIndex, const Communication& comm)
+                                 std::size_t pressureIndex, const Communication& comm,
+                                 const std::shared_ptr<Opm::PressurePatternCache>& patternCache = {})
         : linear_operator_(linearoperator)
         , finesmoother_(PrecFactory::create(linearoperator,
                                             prm.get_child_optional("finesmoother") ?
@@ -126,7 +132,7 @@ public:
         , comm_(&comm)
         , weightsCalculator_(weightsCalculator)
         , weights_(weightsCalculator())
-        , levelTransferPolicy_(*comm_, weights_, prm, pressureIndex)
+        , levelTransferPolicy_(*comm_, weights_, prm, pressureIndex, patternCache)
         , coarseSolverPolicy_(prm.get_child_optional("coarsesolver") ? prm.get_child("coarsesolver") : Opm::PropertyTree())
         , twolevel_method_(linearoperator,
                            finesmoother_,
@@ -187,7 +193,11 @@ private:
     {
         // Parallel case.
         auto child = prm_.get_child_optional("finesmoother");
-        finesmoother_ = PrecFactory::create(linear_operator_, child ? *child : Opm::PropertyTree(), *comm_);
+        if (updatesFineSmootherInPlace()) {
+            finesmoother_->update();
+        } else {
+            finesmoother_ = PrecFactory::create(linear_operator_, child ? *child : Opm::PropertyTree(), *comm_);
+        }
         twolevel_method_.updatePreconditioner(finesmoother_, coarseSolverPolicy_);
     }
 
@@ -195,12 +205,26 @@ private:
     {
         // Serial case.
         auto child = prm_.get_child_optional("finesmoother");
-        finesmoother_ = PrecFactory::create(linear_operator_, child ? *child : Opm::PropertyTree());
+        if (updatesFineSmootherInPlace()) {
+            finesmoother_->update();
+        } else {
+            finesmoother_ = PrecFactory::create(linear_operator_, child ? *child : Opm::PropertyTree());
+        }
         twolevel_method_.updatePreconditioner(finesmoother_, coarseSolverPolicy_);
     }
 
+    // The ParOverILU0 smoother refactorizes the new values of the matrix in
+    // update() and keeps its ordering and sparsity pattern. Most others only
+    // have a dummy update() and are created anew.
+    bool updatesFineSmootherInPlace() const
+    {
+        auto child = prm_.get_child_optional("finesmoother");
+        const auto type = child ? child->get<std::string>("type", "ParOverILU0") : std::string("ParOverILU0");
+        return finesmoother_ && type == "ParOverILU0";
+    }
+
     const OperatorType& linear_operator_;
-    std::shared_ptr<Dune::Preconditioner<VectorType, VectorType>> finesmoother_;
+    std::shared_ptr<Dune::PreconditionerWithUpdate<VectorType, VectorType>> finesmoother_;
     const Communication* comm_;
     std::function<VectorType()> weightsCalculator_;
     VectorType weights_;
@@ -212,11 +212,14 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering of the
+                         interior rows. Ignored if redblack is true.
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool reorder_rcm = false);
 
     /*! \brief Constructor gets all parameters to operate the prec.
       \param A The matrix to operate on.
@@ -229,11 +232,14 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering of the
+                         interior rows. Ignored if redblack is true.
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const ParallelInfo& comm, const int n, const field_type w,
                              MILU_VARIANT milu, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool reorder_rcm = false);
 
     /*! \brief Constructor.
 
@@ -246,11 +252,14 @@ public:
                   The vertices on each layer aound it (same distance) are
                   ordered consecutivly. If false, we preserver the order of
                   the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering of the
+                         interior rows. Ignored if redblack is true.
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const field_type w, MILU_VARIANT milu,
                              bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool reorder_rcm = false);
 
     /*! \brief Constructor.
 
@@ -264,11 +273,14 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering of the
+                         interior rows. Ignored if redblack is true.
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const ParallelInfo& comm, const field_type w,
                              MILU_VARIANT milu, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool reorder_rcm = false);
 
     /*! \brief Constructor.
 
@@ -283,12 +295,15 @@ public:
                             The vertices on each layer aound it (same distance) are
                             ordered consecutivly. If false, we preserver the order of
                             the vertices with the same color.
+      \param reorder_rcm Whether to use a reverse Cuthill-McKee ordering of the
+                         interior rows. Ignored if redblack is true.
     */
     ParallelOverlappingILU0 (const Matrix& A,
                              const ParallelInfo& comm,
                              const field_type w, MILU_VARIANT milu,
                              size_type interiorSize, bool redblack = false,
-                             bool reorder_sphere = true);
+                             bool reorder_sphere = true,
+                             bool reorder_rcm = false);
 
     /*!
       \brief Prepare the preconditioner.
@@ -349,6 +364,7 @@ protected:
     MILU_VARIANT milu_;
     bool redBlack_;
     bool reorderSphere_;
+    bool reorderRCM_;
 };
 
 } // end namespace Opm
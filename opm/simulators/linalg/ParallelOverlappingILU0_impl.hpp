@@ -28,6 +28,7 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/common/TimingMacros.hpp>
 
+#include <opm/simulators/linalg/BlockKernels.hpp>
 #include <opm/simulators/linalg/GraphColoring.hpp>
 #include <opm/simulators/linalg/matrixblock.hh>
 
@@ -43,7 +44,6 @@ void ghost_last_bilu0_decomposition (M& A, std::size_t interiorSize)
     // iterator types
     using rowiterator = typename M::RowIterator;
     using coliterator = typename M::ColIterator;
-    using block = typename M::block_type;
 
     // implement left looking variant with stored inverse
     for (rowiterator i = A.begin(); i.index() < interiorSize; ++i)
@@ -59,7 +59,7 @@ void ghost_last_bilu0_decomposition (M& A, std::size_t interiorSize)
             coliterator jj = A[ij.index()].find(ij.index());
 
             // compute L_ij = A_jj^-1 * A_ij
-            (*ij).rightmultiply(*jj);
+            blockRightMultiply(*ij, *jj);
 
             // modify row
             coliterator endjk=A[ij.index()].end();    // end of row j
@@ -68,9 +68,7 @@ void ghost_last_bilu0_decomposition (M& A, std::size_t interiorSize)
             while (ik!=endij && jk!=endjk)
                 if (ik.index()==jk.index())
                 {
-                    block B(*jk);
-                    B.leftmultiply(*ij);
-                    *ik -= B;
+                    blockMultiplySubtract(*ij, *jk, *ik);
                     ++ik; ++jk;
                 }
                 else
@@ -89,7 +87,8 @@ void ghost_last_bilu0_decomposition (M& A, std::size_t interiorSize)
             (*ij).invert();   // compute inverse of diagonal block
         }
         catch (Dune::FMatrixError & e) {
-            DUNE_THROW(Dune::ISTLError,"ILU failed to invert matrix block");
+            DUNE_THROW(Dune::MatrixBlockError,"ILU failed to invert matrix block A["
+                       << i.index() << "][" << i.index() << "]");
         }
     }
 }
@@ -201,14 +200,15 @@ ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const int n, const field_type w,
                         MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool reorder_rcm)
     : lower_(),
       upper_(),
       inv_(),
       comm_(nullptr), w_(w),
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(n),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      reorderRCM_(reorder_rcm)
 {
     interiorSize_ = A.N();
     // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -221,14 +221,15 @@ ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const ParallelInfo& comm, const int n, const field_type w,
                         MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool reorder_rcm)
     : lower_(),
       upper_(),
       inv_(),
       comm_(&comm), w_(w),
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(n),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      reorderRCM_(reorder_rcm)
 {
     interiorSize_ = A.N();
     // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -240,8 +241,8 @@ template<class Matrix, class Domain, class Range, class ParallelInfoT>
 ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const field_type w, MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
-    : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere )
+                        bool reorder_sphere, bool reorder_rcm)
+    : ParallelOverlappingILU0( A, 0, w, milu, redblack, reorder_sphere, reorder_rcm )
 {}
 
 template<class Matrix, class Domain, class Range, class ParallelInfoT>
@@ -249,14 +250,15 @@ ParallelOverlappingILU0<Matrix,Domain,Range,ParallelInfoT>::
 ParallelOverlappingILU0(const Matrix& A,
                         const ParallelInfo& comm, const field_type w,
                         MILU_VARIANT milu, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool reorder_rcm)
     : lower_(),
       upper_(),
       inv_(),
       comm_(&comm), w_(w),
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(0),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      reorderRCM_(reorder_rcm)
 {
     interiorSize_ = A.N();
     // BlockMatrix is a Subclass of FieldMatrix that just adds
@@ -270,7 +272,7 @@ ParallelOverlappingILU0(const Matrix& A,
                         const ParallelInfo& comm,
                         const field_type w, MILU_VARIANT milu,
                         size_type interiorSize, bool redblack,
-                        bool reorder_sphere)
+                        bool reorder_sphere, bool reorder_rcm)
     : lower_(),
       upper_(),
       inv_(),
@@ -278,7 +280,8 @@ ParallelOverlappingILU0(const Matrix& A,
       relaxation_( std::abs( w - 1.0 ) > 1e-15 ),
       interiorSize_(interiorSize),
       A_(&reinterpret_cast<const Matrix&>(A)), iluIteration_(0),
-      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere)
+      milu_(milu), redBlack_(redblack), reorderSphere_(reorder_sphere),
+      reorderRCM_(reorder_rcm)
 {
     // BlockMatrix is a Subclass of FieldMatrix that just adds
     // methods. Therefore this cast should be safe.
@@ -315,7 +318,7 @@ apply (Domain& v, const Range& d)
 
         for (size_type col = rowI; col < rowINext; ++col)
         {
-            lower_.values_[ col ].mmv( mv[ lower_.cols_[ col ] ], rhs );
+            detail::blockMmv( lower_.values_[ col ], mv[ lower_.cols_[ col ] ], rhs );
         }
 
         mv[ i ] = rhs;  // Lii = I
@@ -330,11 +333,11 @@ apply (Domain& v, const Range& d)
 
         for (size_type col = rowI; col < rowINext; ++col)
         {
-            upper_.values_[ col ].mmv( mv[ upper_.cols_[ col ] ], rhs );
+            detail::blockMmv( upper_.values_[ col ], mv[ upper_.cols_[ col ] ], rhs );
         }
 
         // apply inverse and store result
-        inv_[ i ].mv( rhs, vBlock);
+        detail::blockMv( inv_[ i ], rhs, vBlock );
     }
 
     copyOwnerToAll( mv );
@@ -380,8 +383,11 @@ update()
     std::string message;
     const int rank = comm_ ? comm_->communicator().rank() : 0;
 
+    // Whether the ILU_ matrix needs a new sparsity pattern
+    bool newOrdering = false;
     if (redBlack_)
     {
+        newOrdering = true;
         using Graph = Dune::Amg::MatrixGraph<const Matrix>;
         Graph graph(*A_);
         auto colorsTuple = colorVerticesWelshPowell(graph);
@@ -399,6 +405,16 @@ update()
                                                   graph);
         }
     }
+    else if (reorderRCM_ && ordering_.empty())
+    {
+        // The sparsity pattern does not change between updates, hence the
+        // ordering is computed once. Only the interior rows are reordered
+        // such that the ghost rows stay last.
+        newOrdering = true;
+        using Graph = Dune::Amg::MatrixGraph<const Matrix>;
+        Graph graph(*A_);
+        ordering_ = reorderVerticesReverseCuthillMcKee(graph, interiorSize_);
+    }
 
     std::vector<std::size_t> inverseOrdering(ordering_.size());
     std::size_t index = 0;
@@ -435,19 +451,25 @@ update()
             }
             else
             {
-                ILU_ = std::make_unique<Matrix>(A_->N(), A_->M(),
-                                                A_->nonzeroes(), Matrix::row_wise);
-                auto& newA = *ILU_;
-                // Create sparsity pattern
-                for (auto iter = newA.createbegin(), iend = newA.createend(); iter != iend; ++iter)
+                if (!ILU_ || newOrdering)
                 {
-                    const auto& row = (*A_)[inverseOrdering[iter.index()]];
-                    for (auto col = row.begin(), cend = row.end(); col != cend; ++col)
+                    OPM_TIMEBLOCK(iluDecompositionMakeMatrix);
+                    ILU_ = std::make_unique<Matrix>(A_->N(), A_->M(),
+                                                    A_->nonzeroes(), Matrix::row_wise);
+                    auto& newA = *ILU_;
+                    // Create sparsity pattern
+                    for (auto iter = newA.createbegin(), iend = newA.createend(); iter != iend; ++iter)
                     {
-                        iter.insert(ordering_[col.index()]);
+                        const auto& row = (*A_)[inverseOrdering[iter.index()]];
+                        for (auto col = row.begin(), cend = row.end(); col != cend; ++col)
+                        {
+                            iter.insert(ordering_[col.index()]);
+                        }
                     }
                 }
-                // Copy values
+                // Copy values, the permuted pattern of ILU_ holds all the
+                // entries of A_, so each one is overwritten.
+                auto& newA = *ILU_;
                 for (auto iter = A_->begin(), iend = A_->end(); iter != iend; ++iter)
                 {
                     auto& newRow = newA[ordering_[iter.index()]];
@@ -476,14 +498,9 @@ update()
                                               detail::isPositiveFunctor<typename Matrix::field_type> );
                 break;
             default:
-                if (interiorSize_ == A_->N())
-#if DUNE_VERSION_LT(DUNE_GRID, 2, 8)
-                    bilu0_decomposition( *ILU_ );
-#else
-                    Dune::ILU::blockILU0Decomposition( *ILU_ );
-#endif
-                else
-                    detail::ghost_last_bilu0_decomposition(*ILU_, interiorSize_);
+                // With all rows interior this is the same as the
+                // decomposition of dune-istl, but uses the block kernels.
+                detail::ghost_last_bilu0_decomposition(*ILU_, interiorSize_);
                 break;
             }
         }
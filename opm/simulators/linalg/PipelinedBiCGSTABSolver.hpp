@@ -0,0 +1,260 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PIPELINED_BICGSTAB_SOLVER_HEADER_INCLUDED
+#define OPM_PIPELINED_BICGSTAB_SOLVER_HEADER_INCLUDED
+
+#include <opm/simulators/linalg/MergedReduction.hpp>
+
+#include <dune/common/timer.hh>
+#include <dune/istl/istlexception.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/solver.hh>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+namespace Opm
+{
+
+/// Pipelined, right preconditioned BiCGSTAB (Cools and Vanroose, 2017).
+///
+/// The method is mathematically equivalent to the BiCGSTAB of dune-istl,
+/// but the recurrences are rearranged with auxiliary vectors such that an
+/// iteration has two global reductions instead of five or six. All the
+/// scalar products of a reduction are computed in the same pass over the
+/// vectors, and the reduction is overlapped with a preconditioner and an
+/// operator application. The price is more vector updates and memory.
+template <class X, class Comm>
+class PipelinedBiCGSTABSolver : public Dune::InverseOperator<X, X>
+{
+public:
+    PipelinedBiCGSTABSolver(Dune::LinearOperator<X, X>& op,
+                            Dune::Preconditioner<X, X>& prec,
+                            const Comm& comm,
+                            const double reduction,
+                            const int maxit,
+                            const int verbose)
+        : op_(op)
+        , prec_(prec)
+        , reducer_(comm)
+        , reduction_(reduction)
+        , maxit_(maxit)
+        , verbose_(reducer_.isIORank() ? verbose : 0)
+    {}
+
+    void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+    {
+        apply(x, b, reduction_, res);
+    }
+
+    void apply(X& x, X& b, double reduction, Dune::InverseOperatorResult& res) override
+    {
+        res.clear();
+        Dune::Timer watch;
+        const std::size_t n = b.size();
+        reducer_.resize(n);
+
+        prec_.pre(x, b);
+
+        // r = b - Ax. Notation as in the paper: r is the residual, rhat the
+        // preconditioned residual, w = A rhat, what = M^-1 w, t = A what, and
+        // similarly for the search directions.
+        X r(b);
+        op_.applyscaleadd(-1.0, x, r);
+        X rt(r);
+        X rhat(n), w(n), what(n), t(n);
+        precAndApply(r, rhat, w);
+        precAndApply(w, what, t);
+
+        X phat(n), s(n), shat(n), z(n), zhat(n), v(n), q(n), qhat(n), y(n);
+        phat = 0.0; s = 0.0; shat = 0.0; z = 0.0; zhat = 0.0; v = 0.0;
+
+        std::array<double, 3> init{};
+        for (std::size_t i = 0; i < n; ++i) {
+            const double m = reducer_.weight(i);
+            for (std::size_t c = 0; c < bs; ++c) {
+                init[0] += m * rt[i][c] * r[i][c];
+                init[1] += m * rt[i][c] * w[i][c];
+                init[2] += m * r[i][c] * r[i][c];
+            }
+        }
+        reducer_.start(init.data(), init.size());
+        reducer_.wait();
+
+        double rho = init[0];
+        const double def0 = std::sqrt(init[2]);
+        double def = def0;
+
+        if (verbose_ > 0) {
+            std::cout << "=== PipelinedBiCGSTABSolver" << std::endl;
+            if (verbose_ > 1) {
+                this->printHeader(std::cout);
+                this->printOutput(std::cout, 0.0, def0);
+            }
+        }
+
+        if (def0 < 1e-30) {
+            res.converged = true;
+            res.iterations = 0;
+            res.reduction = 0;
+            res.conv_rate = 0;
+            res.elapsed = watch.elapsed();
+            prec_.post(x);
+            return;
+        }
+
+        if (std::abs(init[1]) < tiny_) {
+            DUNE_THROW(Dune::SolverAbort, "breakdown in PipelinedBiCGSTABSolver - (rt, w) = 0");
+        }
+        double alpha = rho / init[1];
+        double beta = 0.0;
+        double omega = 1.0;
+
+        double it = 0.0;
+        for (it = 0.5; it < maxit_; it += 0.5) {
+            // First half step. The reduction for omega is overlapped with
+            // zhat = M^-1 z and v = A zhat.
+            std::array<double, 3> half{};
+            for (std::size_t i = 0; i < n; ++i) {
+                const double m = reducer_.weight(i);
+                for (std::size_t c = 0; c < bs; ++c) {
+                    phat[i][c] = rhat[i][c] + beta * (phat[i][c] - omega * shat[i][c]);
+                    s[i][c] = w[i][c] + beta * (s[i][c] - omega * z[i][c]);
+                    shat[i][c] = what[i][c] + beta * (shat[i][c] - omega * zhat[i][c]);
+                    z[i][c] = t[i][c] + beta * (z[i][c] - omega * v[i][c]);
+                    q[i][c] = r[i][c] - alpha * s[i][c];
+                    qhat[i][c] = rhat[i][c] - alpha * shat[i][c];
+                    y[i][c] = w[i][c] - alpha * z[i][c];
+                    half[0] += m * q[i][c] * y[i][c];
+                    half[1] += m * y[i][c] * y[i][c];
+                    half[2] += m * q[i][c] * q[i][c];
+                }
+            }
+            reducer_.start(half.data(), half.size());
+            precAndApply(z, zhat, v);
+            reducer_.wait();
+
+            const double def_old = def;
+            def = std::sqrt(half[2]);
+            if (verbose_ > 1) {
+                this->printOutput(std::cout, it, def, def_old);
+            }
+            if (def <= reduction * def0) {
+                x.axpy(alpha, phat);
+                res.converged = true;
+                break;
+            }
+            if (std::abs(half[1]) < tiny_) {
+                DUNE_THROW(Dune::SolverAbort, "breakdown in PipelinedBiCGSTABSolver - (y, y) = 0");
+            }
+            omega = half[0] / half[1];
+
+            // Second half step. The reduction for alpha and beta is
+            // overlapped with what = M^-1 w and t = A what.
+            it += 0.5;
+            std::array<double, 5> full{};
+            for (std::size_t i = 0; i < n; ++i) {
+                const double m = reducer_.weight(i);
+                for (std::size_t c = 0; c < bs; ++c) {
+                    x[i][c] += alpha * phat[i][c] + omega * qhat[i][c];
+                    r[i][c] = q[i][c] - omega * y[i][c];
+                    rhat[i][c] = qhat[i][c] - omega * (what[i][c] - alpha * zhat[i][c]);
+                    w[i][c] = y[i][c] - omega * (t[i][c] - alpha * v[i][c]);
+                    full[0] += m * rt[i][c] * r[i][c];
+                    full[1] += m * rt[i][c] * w[i][c];
+                    full[2] += m * rt[i][c] * s[i][c];
+                    full[3] += m * rt[i][c] * z[i][c];
+                    full[4] += m * r[i][c] * r[i][c];
+                }
+            }
+            reducer_.start(full.data(), full.size());
+            precAndApply(w, what, t);
+            reducer_.wait();
+
+            const double def_half = def;
+            def = std::sqrt(full[4]);
+            if (verbose_ > 1) {
+                this->printOutput(std::cout, it, def, def_half);
+            }
+            if (def <= reduction * def0) {
+                res.converged = true;
+                break;
+            }
+
+            if (std::abs(rho) < tiny_ || std::abs(omega) < tiny_) {
+                DUNE_THROW(Dune::SolverAbort, "breakdown in PipelinedBiCGSTABSolver - rho or omega = 0");
+            }
+            beta = (alpha / omega) * (full[0] / rho);
+            rho = full[0];
+            const double denom = full[1] + beta * full[2] - beta * omega * full[3];
+            if (std::abs(denom) < tiny_) {
+                DUNE_THROW(Dune::SolverAbort, "breakdown in PipelinedBiCGSTABSolver - (rt, s) = 0");
+            }
+            alpha = rho / denom;
+        }
+
+        it = std::min(static_cast<double>(maxit_), it);
+        prec_.post(x);
+
+        res.iterations = static_cast<int>(std::ceil(it));
+        res.reduction = def / def0;
+        res.conv_rate = std::pow(res.reduction, 1.0 / it);
+        res.elapsed = watch.elapsed();
+
+        if (verbose_ > 0) {
+            std::cout << "=== rate=" << res.conv_rate
+                      << ", T=" << res.elapsed
+                      << ", TIT=" << res.elapsed / it
+                      << ", IT=" << it << std::endl;
+        }
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return op_.category();
+    }
+
+private:
+    // out = M^-1 in, image = A out
+    void precAndApply(const X& in, X& out, X& image)
+    {
+        out = 0.0;
+        prec_.apply(out, in);
+        op_.apply(out, image);
+    }
+
+    static constexpr std::size_t bs = X::block_type::dimension;
+    static constexpr double tiny_ = 1e-80;
+
+    Dune::LinearOperator<X, X>& op_;
+    Dune::Preconditioner<X, X>& prec_;
+    MergedReduction<Comm> reducer_;
+    double reduction_;
+    int maxit_;
+    int verbose_;
+};
+
+} // namespace Opm
+
+#endif // OPM_PIPELINED_BICGSTAB_SOLVER_HEADER_INCLUDED
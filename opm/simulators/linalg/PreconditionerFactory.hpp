@@ -37,6 +37,7 @@ namespace Opm
 {
 
 class PropertyTree;
+struct PressurePatternCache;
 
 template <class Operator, class Comm, class Matrix, class Vector>
 struct AMGHelper
@@ -70,30 +71,41 @@ public:
     /// The type of pointer returned by create().
     using PrecPtr = std::shared_ptr<Dune::PreconditionerWithUpdate<Vector, Vector>>;
 
+    /// Pattern cache of the CPR coarse system, owned by the linear solver.
+    using PatternCache = std::shared_ptr<PressurePatternCache>;
+
     /// The type of creator functions passed to addCreator().
     using Creator = std::function<PrecPtr(const Operator&, const PropertyTree&,
-                                          const std::function<Vector()>&, std::size_t)>;
+                                          const std::function<Vector()>&, std::size_t,
+                                          const PatternCache&)>;
     using ParCreator = std::function<PrecPtr(const Operator&, const PropertyTree&,
-                                             const std::function<Vector()>&, std::size_t, const Comm&)>;
+                                             const std::function<Vector()>&, std::size_t, const Comm&,
+                                             const PatternCache&)>;
 
     /// Create a new serial preconditioner and return a pointer to it.
     /// \param op    operator to be preconditioned.
     /// \param prm   parameters for the preconditioner, in particular its type.
     /// \param weightsCalculator Calculator for weights used in CPR.
+    /// \param patternCache Cache for the pattern of the CPR coarse system,
+    ///                     which may outlive the preconditioner.
     /// \return      (smart) pointer to the created preconditioner.
     static PrecPtr create(const Operator& op, const PropertyTree& prm,
                           const std::function<Vector()>& weightsCalculator = {},
-                          std::size_t pressureIndex = std::numeric_limits<std::size_t>::max());
+                          std::size_t pressureIndex = std::numeric_limits<std::size_t>::max(),
+                          const PatternCache& patternCache = {});
 
     /// Create a new parallel preconditioner and return a pointer to it.
     /// \param op    operator to be preconditioned.
     /// \param prm   parameters for the preconditioner, in particular its type.
     /// \param comm  communication object (typically OwnerOverlapCopyCommunication).
     /// \param weightsCalculator Calculator for weights used in CPR.
+    /// \param patternCache Cache for the pattern of the CPR coarse system,
+    ///                     which may outlive the preconditioner.
     /// \return      (smart) pointer to the created preconditioner.
     static PrecPtr create(const Operator& op, const PropertyTree& prm,
                           const std::function<Vector()>& weightsCalculator, const Comm& comm,
-                          std::size_t pressureIndex = std::numeric_limits<std::size_t>::max());
+                          std::size_t pressureIndex = std::numeric_limits<std::size_t>::max(),
+                          const PatternCache& patternCache = {});
 
     /// Create a new parallel preconditioner and return a pointer to it.
     /// \param op    operator to be preconditioned.
@@ -137,11 +149,13 @@ private:
     // Actually creates the product object.
     PrecPtr doCreate(const Operator& op, const PropertyTree& prm,
                      const std::function<Vector()> weightsCalculator,
-                     std::size_t pressureIndex);
+                     std::size_t pressureIndex,
+                     const PatternCache& patternCache);
 
     PrecPtr doCreate(const Operator& op, const PropertyTree& prm,
                      const std::function<Vector()> weightsCalculator,
-                     std::size_t pressureIndex, const Comm& comm);
+                     std::size_t pressureIndex, const Comm& comm,
+                     const PatternCache& patternCache);
 
     // Actually adds the creator.
     void doAddCreator(const std::string& type, Creator c);
@@ -33,6 +33,7 @@
 #include <opm/simulators/linalg/PressureBhpTransferPolicy.hpp>
 #include <opm/simulators/linalg/PressureTransferPolicy.hpp>
 #include <opm/simulators/linalg/PropertyTree.hpp>
+#include <opm/simulators/linalg/ThreadedSmoothers.hpp>
 #include <opm/simulators/linalg/WellOperators.hpp>
 
 #include <dune/istl/owneroverlapcopy.hh>
@@ -90,6 +91,37 @@ struct AMGSmootherArgsHelper<Opm::ParallelOverlappingILU0<M,V,V,C>>
     }
 };
 
+template<class M, class V, class C>
+struct AMGSmootherArgsHelper<Opm::ThreadedJacobi<M,V,V,C>>
+{
+    static auto args(const PropertyTree& prm)
+    {
+        using Smoother = Opm::ThreadedJacobi<M, V, V, C>;
+        using SmootherArgs = typename Dune::Amg::SmootherTraits<Smoother>::Arguments;
+        SmootherArgs smootherArgs;
+        smootherArgs.iterations = prm.get<int>("iterations", 1);
+        smootherArgs.relaxationFactor = prm.get<double>("relaxation", 1.0);
+        smootherArgs.setL1(prm.get<bool>("l1", false));
+        return smootherArgs;
+    }
+};
+
+template<class M, class V, class C>
+struct AMGSmootherArgsHelper<Opm::ChebyshevSmoother<M,V,V,C>>
+{
+    static auto args(const PropertyTree& prm)
+    {
+        using Smoother = Opm::ChebyshevSmoother<M, V, V, C>;
+        using SmootherArgs = typename Dune::Amg::SmootherTraits<Smoother>::Arguments;
+        SmootherArgs smootherArgs;
+        smootherArgs.iterations = prm.get<int>("iterations", 1);
+        smootherArgs.setDegree(prm.get<int>("degree", 2));
+        smootherArgs.setEigenvalueRatio(prm.get<double>("eigenvalue_ratio", 30.0));
+        smootherArgs.setPowerIterations(prm.get<int>("power_iterations", 10));
+        return smootherArgs;
+    }
+};
+
 template <class Operator, class Comm, class Matrix, class Vector>
 typename AMGHelper<Operator, Comm, Matrix, Vector>::Criterion
 AMGHelper<Operator,Comm,Matrix,Vector>::criterion(const PropertyTree& prm)
@@ -148,88 +180,111 @@ struct StandardPreconditioners
         using M = typename F::Matrix;
         using V = typename F::Vector;
         using P = PropertyTree;
-        F::addCreator("ILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm) {
+        using PC = typename F::PatternCache;
+        F::addCreator("ILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm, const PC&) {
           return createParILU(op, prm, comm, 0);
         });
-        F::addCreator("ParOverILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm) {
+        F::addCreator("ParOverILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm, const PC&) {
           return createParILU(op, prm, comm, prm.get<int>("ilulevel", 0));
         });
-        F::addCreator("ILUn", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm) {
+        F::addCreator("ILUn", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm, const PC&) {
           return createParILU(op, prm, comm, prm.get<int>("ilulevel", 0));
         });
         F::addCreator("Jac", [](const O& op, const P& prm, const std::function<V()>&,
-                     std::size_t, const C& comm) {
+                     std::size_t, const C& comm, const PC&) {
           const int n = prm.get<int>("repeats", 1);
           const double w = prm.get<double>("relaxation", 1.0);
           return wrapBlockPreconditioner<DummyUpdatePreconditioner<SeqJac<M, V, V>>>(comm, op.getmat(), n, w);
         });
-        F::addCreator("GS", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm) {
+        F::addCreator("GS", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm, const PC&) {
           const int n = prm.get<int>("repeats", 1);
           const double w = prm.get<double>("relaxation", 1.0);
           return wrapBlockPreconditioner<DummyUpdatePreconditioner<SeqGS<M, V, V>>>(comm, op.getmat(), n, w);
         });
-        F::addCreator("SOR", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm) {
+        F::addCreator("SOR", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm, const PC&) {
           const int n = prm.get<int>("repeats", 1);
           const double w = prm.get<double>("relaxation", 1.0);
           return wrapBlockPreconditioner<DummyUpdatePreconditioner<SeqSOR<M, V, V>>>(comm, op.getmat(), n, w);
         });
-        F::addCreator("SSOR", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm) {
+        F::addCreator("SSOR", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm, const PC&) {
           const int n = prm.get<int>("repeats", 1);
           const double w = prm.get<double>("relaxation", 1.0);
           return wrapBlockPreconditioner<DummyUpdatePreconditioner<SeqSSOR<M, V, V>>>(comm, op.getmat(), n, w);
         });
+        F::addCreator("ThreadedJac", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm, const PC&) {
+          const int n = prm.get<int>("repeats", 1);
+          const double w = prm.get<double>("relaxation", 1.0);
+          const bool l1 = prm.get<bool>("l1", false);
+          return std::make_shared<Opm::ThreadedJacobi<M, V, V, C>>(op.getmat(), comm, n, w, l1);
+        });
+        F::addCreator("Chebyshev", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm, const PC&) {
+          const int degree = prm.get<int>("degree", 2);
+          const double ratio = prm.get<double>("eigenvalue_ratio", 30.0);
+          const int powerIterations = prm.get<int>("power_iterations", 10);
+          return std::make_shared<Opm::ChebyshevSmoother<M, V, V, C>>(op.getmat(), comm, degree, ratio, powerIterations);
+        });
 
         // Only add AMG preconditioners to the factory if the operator
         // is the overlapping schwarz operator. This could be extended
         // later, but at this point no other operators are compatible
         // with the AMG hierarchy construction.
         if constexpr (std::is_same_v<O, Dune::OverlappingSchwarzOperator<M, V, V, C>>) {
-          F::addCreator("amg", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm) {
+          F::addCreator("amg", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm, const PC&) {
             const std::string smoother = prm.get<std::string>("smoother", "ParOverILU0");
             if (smoother == "ILU0" || smoother == "ParOverILU0") {
               using Smoother = Opm::ParallelOverlappingILU0<M, V, V, C>;
               auto crit = AMGHelper<O,C,M,V>::criterion(prm);
               auto sargs = AMGSmootherArgsHelper<Smoother>::args(prm);
               return std::make_shared<Dune::Amg::AMGCPR<O, V, Smoother, C>>(op, crit, sargs, comm);
+            } else if (smoother == "ThreadedJac") {
+              using Smoother = Opm::ThreadedJacobi<M, V, V, C>;
+              auto crit = AMGHelper<O,C,M,V>::criterion(prm);
+              auto sargs = AMGSmootherArgsHelper<Smoother>::args(prm);
+              return std::make_shared<Dune::Amg::AMGCPR<O, V, Smoother, C>>(op, crit, sargs, comm);
+            } else if (smoother == "Chebyshev") {
+              using Smoother = Opm::ChebyshevSmoother<M, V, V, C>;
+              auto crit = AMGHelper<O,C,M,V>::criterion(prm);
+              auto sargs = AMGSmootherArgsHelper<Smoother>::args(prm);
+              return std::make_shared<Dune::Amg::AMGCPR<O, V, Smoother, C>>(op, crit, sargs, comm);
             } else {
               OPM_THROW(std::invalid_argument, "Properties: No smoother with name " + smoother + ".");
             }
           });
         }
 
-        F::addCreator("cpr", [](const O& op, const P& prm, const std::function<V()> weightsCalculator, std::size_t pressureIndex, const C& comm) {
+        F::addCreator("cpr", [](const O& op, const P& prm, const std::function<V()> weightsCalculator, std::size_t pressureIndex, const C& comm, const PC& patternCache) {
           assert(weightsCalculator);
           if (pressureIndex == std::numeric_limits<std::size_t>::max())
           {
             OPM_THROW(std::logic_error, "Pressure index out of bounds. It needs to specified for CPR");
           }
           using LevelTransferPolicy = Opm::PressureTransferPolicy<O, Comm, false>;
-          return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy, Comm>>(op, prm, weightsCalculator, pressureIndex, comm);
+          return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy, Comm>>(op, prm, weightsCalculator, pressureIndex, comm, patternCache);
         });
-        F::addCreator("cprt", [](const O& op, const P& prm, const std::function<V()> weightsCalculator, std::size_t pressureIndex, const C& comm) {
+        F::addCreator("cprt", [](const O& op, const P& prm, const std::function<V()> weightsCalculator, std::size_t pressureIndex, const C& comm, const PC& patternCache) {
           assert(weightsCalculator);
           if (pressureIndex == std::numeric_limits<std::size_t>::max())
           {
             OPM_THROW(std::logic_error, "Pressure index out of bounds. It needs to specified for CPR");
           }
           using LevelTransferPolicy = Opm::PressureTransferPolicy<O, Comm, true>;
-          return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy, Comm>>(op, prm, weightsCalculator, pressureIndex, comm);
+          return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy, Comm>>(op, prm, weightsCalculator, pressureIndex, comm, patternCache);
         });
 
         if constexpr (std::is_same_v<O, WellModelGhostLastMatrixAdapter<M, V, V, true>>) {
           F::addCreator("cprw",
-                       [](const O& op, const P& prm, const std::function<V()> weightsCalculator, std::size_t pressureIndex, const C& comm) {
+                       [](const O& op, const P& prm, const std::function<V()> weightsCalculator, std::size_t pressureIndex, const C& comm, const PC& patternCache) {
             assert(weightsCalculator);
             if (pressureIndex == std::numeric_limits<std::size_t>::max()) {
               OPM_THROW(std::logic_error, "Pressure index out of bounds. It needs to specified for CPR");
             }
             using LevelTransferPolicy = Opm::PressureBhpTransferPolicy<O, Comm, false>;
-            return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy, Comm>>(op, prm, weightsCalculator, pressureIndex, comm);
+            return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy, Comm>>(op, prm, weightsCalculator, pressureIndex, comm, patternCache);
           });
         }
 
 #if HAVE_CUDA
-        F::addCreator("CUILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm) {
+        F::addCreator("CUILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const C& comm, const PC&) {
             const double w = prm.get<double>("relaxation", 1.0);
             using field_type = typename V::field_type;
             using CuILU0 = typename Opm::cuistl::CuSeqILU0<M, Opm::cuistl::CuVector<field_type>, Opm::cuistl::CuVector<field_type>>;
@@ -253,14 +308,17 @@ struct StandardPreconditioners
         const double w = prm.get<double>("relaxation", 1.0);
         const bool redblack = prm.get<bool>("redblack", false);
         const bool reorder_spheres = prm.get<bool>("reorder_spheres", false);
+        const bool reorder_rcm = prm.get<bool>("reorder_rcm", false);
         // Already a parallel preconditioner. Need to pass comm, but no need to wrap it in a BlockPreconditioner.
         if (ilulevel == 0) {
             const std::size_t num_interior = interiorIfGhostLast(comm);
             return std::make_shared<Opm::ParallelOverlappingILU0<M, V, V, Comm>>(
-                op.getmat(), comm, w, Opm::MILU_VARIANT::ILU, num_interior, redblack, reorder_spheres);
+                op.getmat(), comm, w, Opm::MILU_VARIANT::ILU, num_interior, redblack, reorder_spheres,
+                reorder_rcm);
         } else {
             return std::make_shared<Opm::ParallelOverlappingILU0<M, V, V, Comm>>(
-                op.getmat(), comm, ilulevel, w, Opm::MILU_VARIANT::ILU, redblack, reorder_spheres);
+                op.getmat(), comm, ilulevel, w, Opm::MILU_VARIANT::ILU, redblack, reorder_spheres,
+                reorder_rcm);
         }
     }
 
@@ -300,48 +358,64 @@ struct StandardPreconditioners<Operator,Dune::Amg::SequentialInformation>
         using M = typename F::Matrix;
         using V = typename F::Vector;
         using P = PropertyTree;
-        F::addCreator("ILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+        using PC = typename F::PatternCache;
+        F::addCreator("ILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
             const double w = prm.get<double>("relaxation", 1.0);
             return std::make_shared<Opm::ParallelOverlappingILU0<M, V, V, C>>(
                 op.getmat(), 0, w, Opm::MILU_VARIANT::ILU);
         });
-        F::addCreator("ParOverILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+        F::addCreator("ParOverILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
             const double w = prm.get<double>("relaxation", 1.0);
             const int n = prm.get<int>("ilulevel", 0);
+            const bool redblack = prm.get<bool>("redblack", false);
+            const bool reorder_spheres = prm.get<bool>("reorder_spheres", false);
+            const bool reorder_rcm = prm.get<bool>("reorder_rcm", false);
             return std::make_shared<Opm::ParallelOverlappingILU0<M, V, V, C>>(
-                op.getmat(), n, w, Opm::MILU_VARIANT::ILU);
+                op.getmat(), n, w, Opm::MILU_VARIANT::ILU, redblack, reorder_spheres, reorder_rcm);
         });
-        F::addCreator("ILUn", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+        F::addCreator("ILUn", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
             const int n = prm.get<int>("ilulevel", 0);
             const double w = prm.get<double>("relaxation", 1.0);
             return std::make_shared<Opm::ParallelOverlappingILU0<M, V, V, C>>(
                 op.getmat(), n, w, Opm::MILU_VARIANT::ILU);
         });
-        F::addCreator("Jac", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+        F::addCreator("Jac", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
             const int n = prm.get<int>("repeats", 1);
             const double w = prm.get<double>("relaxation", 1.0);
             return wrapPreconditioner<SeqJac<M, V, V>>(op.getmat(), n, w);
         });
-        F::addCreator("GS", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+        F::addCreator("GS", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
             const int n = prm.get<int>("repeats", 1);
             const double w = prm.get<double>("relaxation", 1.0);
             return wrapPreconditioner<SeqGS<M, V, V>>(op.getmat(), n, w);
         });
-        F::addCreator("SOR", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+        F::addCreator("SOR", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
             const int n = prm.get<int>("repeats", 1);
             const double w = prm.get<double>("relaxation", 1.0);
             return wrapPreconditioner<SeqSOR<M, V, V>>(op.getmat(), n, w);
         });
-        F::addCreator("SSOR", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+        F::addCreator("SSOR", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
             const int n = prm.get<int>("repeats", 1);
             const double w = prm.get<double>("relaxation", 1.0);
             return wrapPreconditioner<SeqSSOR<M, V, V>>(op.getmat(), n, w);
         });
+        F::addCreator("ThreadedJac", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
+            const int n = prm.get<int>("repeats", 1);
+            const double w = prm.get<double>("relaxation", 1.0);
+            const bool l1 = prm.get<bool>("l1", false);
+            return std::make_shared<Opm::ThreadedJacobi<M, V, V, C>>(op.getmat(), n, w, l1);
+        });
+        F::addCreator("Chebyshev", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
+            const int degree = prm.get<int>("degree", 2);
+            const double ratio = prm.get<double>("eigenvalue_ratio", 30.0);
+            const int powerIterations = prm.get<int>("power_iterations", 10);
+            return std::make_shared<Opm::ChebyshevSmoother<M, V, V, C>>(op.getmat(), degree, ratio, powerIterations);
+        });
 
         // Only add AMG preconditioners to the factory if the operator
         // is an actual matrix operator.
         if constexpr (std::is_same_v<O, Dune::MatrixAdapter<M, V, V>>) {
-            F::addCreator("amg", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+            F::addCreator("amg", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
                 const std::string smoother = prm.get<std::string>("smoother", "ParOverILU0");
                 if (smoother == "ILU0" || smoother == "ParOverILU0") {
                     using Smoother = SeqILU<M, V, V>;
@@ -358,12 +432,18 @@ struct StandardPreconditioners<Operator,Dune::Amg::SequentialInformation>
                 } else if (smoother == "ILUn") {
                     using Smoother = SeqILU<M, V, V>;
                     return AMGHelper<O,C,M,V>::template makeAmgPreconditioner<Smoother>(op, prm);
+                } else if (smoother == "ThreadedJac") {
+                    using Smoother = Opm::ThreadedJacobi<M, V, V, C>;
+                    return AMGHelper<O,C,M,V>::template makeAmgPreconditioner<Smoother>(op, prm);
+                } else if (smoother == "Chebyshev") {
+                    using Smoother = Opm::ChebyshevSmoother<M, V, V, C>;
+                    return AMGHelper<O,C,M,V>::template makeAmgPreconditioner<Smoother>(op, prm);
                 } else {
                     OPM_THROW(std::invalid_argument,
                               "Properties: No smoother with name " + smoother + ".");
                 }
             });
-            F::addCreator("kamg", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+            F::addCreator("kamg", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
                 const std::string smoother = prm.get<std::string>("smoother", "ParOverILU0");
                 if (smoother == "ILU0" || smoother == "ParOverILU0") {
                     using Smoother = SeqILU<M, V, V>;
@@ -383,12 +463,18 @@ struct StandardPreconditioners<Operator,Dune::Amg::SequentialInformation>
                 } else if (smoother == "ILUn") {
                     using Smoother = SeqILU<M, V, V>;
                     return AMGHelper<O,C,M,V>::template makeAmgPreconditioner<Smoother>(op, prm, true);
+                } else if (smoother == "ThreadedJac") {
+                    using Smoother = Opm::ThreadedJacobi<M, V, V, C>;
+                    return AMGHelper<O,C,M,V>::template makeAmgPreconditioner<Smoother>(op, prm, true);
+                } else if (smoother == "Chebyshev") {
+                    using Smoother = Opm::ChebyshevSmoother<M, V, V, C>;
+                    return AMGHelper<O,C,M,V>::template makeAmgPreconditioner<Smoother>(op, prm, true);
                 } else {
                     OPM_THROW(std::invalid_argument,
                               "Properties: No smoother with name " + smoother + ".");
                 }
             });
-            F::addCreator("famg", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+            F::addCreator("famg", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
                 auto crit = AMGHelper<O,C,M,V>::criterion(prm);
                 Dune::Amg::Parameters parms;
                 parms.setNoPreSmoothSteps(1);
@@ -397,41 +483,41 @@ struct StandardPreconditioners<Operator,Dune::Amg::SequentialInformation>
             });
         }
         if constexpr (std::is_same_v<O, WellModelMatrixAdapter<M, V, V, false>>) {
-            F::addCreator("cprw", [](const O& op, const P& prm, const std::function<V()>& weightsCalculator, std::size_t pressureIndex) {
+            F::addCreator("cprw", [](const O& op, const P& prm, const std::function<V()>& weightsCalculator, std::size_t pressureIndex, const PC& patternCache) {
                 if (pressureIndex == std::numeric_limits<std::size_t>::max()) {
                     OPM_THROW(std::logic_error, "Pressure index out of bounds. It needs to specified for CPR");
                 }
                 using LevelTransferPolicy = Opm::PressureBhpTransferPolicy<O, Dune::Amg::SequentialInformation, false>;
-                return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy>>(op, prm, weightsCalculator, pressureIndex);
+                return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy>>(op, prm, weightsCalculator, pressureIndex, patternCache);
             });
             }
 
-        F::addCreator("cpr", [](const O& op, const P& prm, const std::function<V()>& weightsCalculator, std::size_t pressureIndex) {
+        F::addCreator("cpr", [](const O& op, const P& prm, const std::function<V()>& weightsCalculator, std::size_t pressureIndex, const PC& patternCache) {
                                 if (pressureIndex == std::numeric_limits<std::size_t>::max())
                                 {
                                     OPM_THROW(std::logic_error, "Pressure index out of bounds. It needs to specified for CPR");
                                 }
                                 using LevelTransferPolicy = Opm::PressureTransferPolicy<O, Dune::Amg::SequentialInformation, false>;
-                                return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy>>(op, prm, weightsCalculator, pressureIndex);
+                                return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy>>(op, prm, weightsCalculator, pressureIndex, patternCache);
         });
-        F::addCreator("cprt", [](const O& op, const P& prm, const std::function<V()>& weightsCalculator, std::size_t pressureIndex) {
+        F::addCreator("cprt", [](const O& op, const P& prm, const std::function<V()>& weightsCalculator, std::size_t pressureIndex, const PC& patternCache) {
                                 if (pressureIndex == std::numeric_limits<std::size_t>::max())
                                 {
                                     OPM_THROW(std::logic_error, "Pressure index out of bounds. It needs to specified for CPR");
                                 }
                                 using LevelTransferPolicy = Opm::PressureTransferPolicy<O, Dune::Amg::SequentialInformation, true>;
-                                return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy>>(op, prm, weightsCalculator, pressureIndex);
+                                return std::make_shared<OwningTwoLevelPreconditioner<O, V, LevelTransferPolicy>>(op, prm, weightsCalculator, pressureIndex, patternCache);
         });
 
 #if HAVE_CUDA
-        F::addCreator("CUILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+        F::addCreator("CUILU0", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
             const double w = prm.get<double>("relaxation", 1.0);
             using field_type = typename V::field_type;
             using CuILU0 = typename Opm::cuistl::CuSeqILU0<M, Opm::cuistl::CuVector<field_type>, Opm::cuistl::CuVector<field_type>>;
             return std::make_shared<Opm::cuistl::PreconditionerAdapter<V, V, CuILU0>>(std::make_shared<CuILU0>(op.getmat(), w));
         });
 
-        F::addCreator("CUILU0Float", [](const O& op, const P& prm, const std::function<V()>&, std::size_t) {
+        F::addCreator("CUILU0Float", [](const O& op, const P& prm, const std::function<V()>&, std::size_t, const PC&) {
             const double w = prm.get<double>("relaxation", 1.0);
             using block_type = typename V::block_type;
             using VTo = Dune::BlockVector<Dune::FieldVector<float, block_type::dimension>>;
@@ -468,7 +554,8 @@ typename PreconditionerFactory<Operator,Comm>::PrecPtr
 PreconditionerFactory<Operator,Comm>::
 doCreate(const Operator& op, const PropertyTree& prm,
          const std::function<Vector()> weightsCalculator,
-         std::size_t pressureIndex)
+         std::size_t pressureIndex,
+         const PatternCache& patternCache)
 {
     if (!defAdded_) {
       StandardPreconditioners<Operator,Comm>::add();
@@ -485,7 +572,7 @@ doCreate(const Operator& op, const PropertyTree& prm,
         msg << std::endl;
         OPM_THROW(std::invalid_argument, msg.str());
     }
-    return it->second(op, prm, weightsCalculator, pressureIndex);
+    return it->second(op, prm, weightsCalculator, pressureIndex, patternCache);
 }
 
 template <class Operator, class Comm>
@@ -493,7 +580,8 @@ typename PreconditionerFactory<Operator,Comm>::PrecPtr
 PreconditionerFactory<Operator,Comm>::
 doCreate(const Operator& op, const PropertyTree& prm,
          const std::function<Vector()> weightsCalculator,
-         std::size_t pressureIndex, const Comm& comm)
+         std::size_t pressureIndex, const Comm& comm,
+         const PatternCache& patternCache)
 {
     if (!defAdded_) {
         StandardPreconditioners<Operator,Comm>::add();
@@ -511,7 +599,7 @@ doCreate(const Operator& op, const PropertyTree& prm,
         msg << std::endl;
         OPM_THROW(std::invalid_argument, msg.str());
     }
-    return it->second(op, prm, weightsCalculator, pressureIndex, comm);
+    return it->second(op, prm, weightsCalculator, pressureIndex, comm, patternCache);
 }
 
 template <class Operator, class Comm>
@@ -533,9 +621,10 @@ typename PreconditionerFactory<Operator,Comm>::PrecPtr
 PreconditionerFactory<Operator,Comm>::
 create(const Operator& op, const PropertyTree& prm,
        const std::function<Vector()>& weightsCalculator,
-       std::size_t pressureIndex)
+       std::size_t pressureIndex,
+       const PatternCache& patternCache)
 {
-    return instance().doCreate(op, prm, weightsCalculator, pressureIndex);
+    return instance().doCreate(op, prm, weightsCalculator, pressureIndex, patternCache);
 }
 
 template <class Operator, class Comm>
@@ -543,9 +632,10 @@ typename PreconditionerFactory<Operator,Comm>::PrecPtr
 PreconditionerFactory<Operator,Comm>::
 create(const Operator& op, const PropertyTree& prm,
        const std::function<Vector()>& weightsCalculator, const Comm& comm,
-       std::size_t pressureIndex)
+       std::size_t pressureIndex,
+       const PatternCache& patternCache)
 {
-    return instance().doCreate(op, prm, weightsCalculator, pressureIndex, comm);
+    return instance().doCreate(op, prm, weightsCalculator, pressureIndex, comm, patternCache);
 }
 
 
@@ -555,7 +645,7 @@ PreconditionerFactory<Operator,Comm>::
 create(const Operator& op, const PropertyTree& prm, const Comm& comm,
        std::size_t pressureIndex)
 {
-    return instance().doCreate(op, prm, std::function<Vector()>(), pressureIndex, comm);
+    return instance().doCreate(op, prm, std::function<Vector()>(), pressureIndex, comm, {});
 }
 
 template <class Operator, class Comm>
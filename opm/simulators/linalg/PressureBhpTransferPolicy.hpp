@@ -23,12 +23,15 @@
 #include <opm/common/TimingMacros.hpp>
 
 #include <opm/simulators/linalg/matrixblock.hh>
+#include <opm/simulators/linalg/PressureTransferHelpers.hpp>
 #include <opm/simulators/linalg/PropertyTree.hpp>
 #include <opm/simulators/linalg/twolevelmethodcpr.hh>
 
 #include <dune/istl/paamg/pinfo.hh>
 
 #include <cstddef>
+#include <memory>
+#include <utility>
 
 namespace Opm
 {
@@ -101,11 +104,14 @@ namespace Opm
         PressureBhpTransferPolicy(const Communication& comm,
                                   const FineVectorType& weights,
                                   const Opm::PropertyTree& prm,
-                                  const std::size_t pressureIndex)
+                                  const std::size_t pressureIndex,
+                                  std::shared_ptr<PressurePatternCache> patternCache = {})
             : communication_(&const_cast<Communication&>(comm))
             , weights_(weights)
             , prm_(prm)
             , pressure_var_index_(pressureIndex)
+            , patternCache_(patternCache ? std::move(patternCache)
+                                         : std::make_shared<PressurePatternCache>())
         {
         }
 
@@ -115,32 +121,21 @@ namespace Opm
             using CoarseMatrix = typename CoarseOperator::matrix_type;
             const auto& fineLevelMatrix = fineOperator.getmat();
             const auto& nw = fineOperator.getNumberOfExtraEquations();
+            const auto reservoirPattern = Details::cachedPressurePattern(fineLevelMatrix, patternCache_->pattern);
             if (prm_.get<bool>("add_wells")) {
-                const std::size_t average_elements_per_row
-                    = static_cast<std::size_t>(std::ceil(fineLevelMatrix.nonzeroes() / fineLevelMatrix.N()));
-                const double overflow_fraction = 1.2;
-                coarseLevelMatrix_.reset(new CoarseMatrix(fineLevelMatrix.N() + nw,
-                                                          fineLevelMatrix.M() + nw,
-                                                          average_elements_per_row,
-                                                          overflow_fraction,
-                                                          CoarseMatrix::implicit));
-                int rownum = 0;
-                for (const auto& row : fineLevelMatrix) {
-                    for (auto col = row.begin(), cend = row.end(); col != cend; ++col) {
-                        coarseLevelMatrix_->entry(rownum, col.index()) = 0.0;
-                    }
-                    ++rownum;
-                }
+                // The well couplings are few, collect them separately and
+                // append them to the reservoir pattern.
+                const double overflow_fraction = 3.0;
+                CoarseMatrix wellPattern(fineLevelMatrix.N() + nw,
+                                         fineLevelMatrix.M() + nw,
+                                         1,
+                                         overflow_fraction,
+                                         CoarseMatrix::implicit);
+                fineOperator.addWellPressureEquationsStruct(wellPattern);
+                wellPattern.compress();
+                coarseLevelMatrix_ = Details::mergeWellPattern(*reservoirPattern, wellPattern);
             } else {
-                coarseLevelMatrix_.reset(
-                    new CoarseMatrix(fineLevelMatrix.N(), fineLevelMatrix.M(), CoarseMatrix::row_wise));
-                auto createIter = coarseLevelMatrix_->createbegin();
-                for (const auto& row : fineLevelMatrix) {
-                    for (auto col = row.begin(), cend = row.end(); col != cend; ++col) {
-                        createIter.insert(col.index());
-                    }
-                    ++createIter;
-                }
+                coarseLevelMatrix_ = std::make_shared<CoarseMatrix>(*reservoirPattern);
             }
         if constexpr (std::is_same_v<Communication, Dune::Amg::SequentialInformation>) {
             coarseLevelCommunication_ = std::make_shared<Communication>();
@@ -149,8 +144,6 @@ namespace Opm
                 communication_->communicator(), communication_->category(), false);
         }
         if (prm_.get<bool>("add_wells")) {
-            fineOperator.addWellPressureEquationsStruct(*coarseLevelMatrix_);
-            coarseLevelMatrix_->compress(); // all elemenst should be set
             if constexpr (!std::is_same_v<Communication, Dune::Amg::SequentialInformation>) {
                 extendCommunicatorWithWells(*communication_, coarseLevelCommunication_, nw);
             }
@@ -167,39 +160,15 @@ namespace Opm
     virtual void calculateCoarseEntries(const FineOperator& fineOperator) override
     {
         OPM_TIMEBLOCK(calculateCoarseEntries);
-        const auto& fineMatrix = fineOperator.getmat();
-        *coarseLevelMatrix_ = 0;
-        auto rowCoarse = coarseLevelMatrix_->begin();
-        for (auto row = fineMatrix.begin(), rowEnd = fineMatrix.end(); row != rowEnd; ++row, ++rowCoarse) {
-            assert(row.index() == rowCoarse.index());
-            auto entryCoarse = rowCoarse->begin();
-            for (auto entry = row->begin(), entryEnd = row->end(); entry != entryEnd; ++entry, ++entryCoarse) {
-                assert(entry.index() == entryCoarse.index());
-                double matrix_el = 0;
-                if (transpose) {
-                    const auto& bw = weights_[entry.index()];
-                    for (std::size_t i = 0; i < bw.size(); ++i) {
-                        matrix_el += (*entry)[pressure_var_index_][i] * bw[i];
-                    }
-                } else {
-                    const auto& bw = weights_[row.index()];
-                    for (std::size_t i = 0; i < bw.size(); ++i) {
-                        matrix_el += (*entry)[i][pressure_var_index_] * bw[i];
-                    }
-                }
-                (*entryCoarse) = matrix_el;
-            }
-        }
+        Details::calculatePressureEntries<transpose>(fineOperator.getmat(), weights_,
+                                                     pressure_var_index_, *coarseLevelMatrix_);
         if (prm_.get<bool>("add_wells")) {
             OPM_TIMEBLOCK(cprwAddWellEquation);
             assert(transpose == false); // not implemented
             bool use_well_weights = prm_.get<bool>("use_well_weights");
             fineOperator.addWellPressureEquations(*coarseLevelMatrix_, weights_, use_well_weights);
-#ifndef NDEBUG
-            std::advance(rowCoarse, fineOperator.getNumberOfExtraEquations());
-            assert(rowCoarse == coarseLevelMatrix_->end());
-#endif
-
+            assert(fineOperator.getmat().N() + fineOperator.getNumberOfExtraEquations()
+                   == coarseLevelMatrix_->N());
         }
     }
 
@@ -207,24 +176,7 @@ namespace Opm
     {
         OPM_TIMEBLOCK(moveToCoarseLevel);
         //NB we iterate over fine assumming welldofs is at the end
-        // Set coarse vector to zero
-        this->rhs_ = 0;
-
-        auto end = fine.end(), begin = fine.begin();
-
-        for (auto block = begin; block != end; ++block) {
-            const auto& bw = weights_[block.index()];
-            double rhs_el = 0.0;
-            if (transpose) {
-                rhs_el = (*block)[pressure_var_index_];
-            } else {
-                for (std::size_t i = 0; i < block->size(); ++i) {
-                    rhs_el += (*block)[i] * bw[i];
-                }
-            }
-            this->rhs_[block - begin] = rhs_el;
-        }
-
+        Details::restrictToPressure<transpose>(fine, weights_, pressure_var_index_, this->rhs_);
         this->lhs_ = 0;
     }
 
@@ -232,18 +184,7 @@ namespace Opm
     {
         OPM_TIMEBLOCK(moveToFineLevel);
         //NB we iterate over fine assumming welldofs is at the end
-        auto end = fine.end(), begin = fine.begin();
-
-        for (auto block = begin; block != end; ++block) {
-            if (transpose) {
-                const auto& bw = weights_[block.index()];
-                for (std::size_t i = 0; i < block->size(); ++i) {
-                    (*block)[i] = this->lhs_[block - begin] * bw[i];
-                }
-            } else {
-                (*block)[pressure_var_index_] = this->lhs_[block - begin];
-            }
-        }
+        Details::prolongateFromPressure<transpose>(this->lhs_, weights_, pressure_var_index_, fine);
     }
 
     virtual PressureBhpTransferPolicy* clone() const override
@@ -263,6 +204,7 @@ private:
     const int pressure_var_index_;
     std::shared_ptr<Communication> coarseLevelCommunication_;
     std::shared_ptr<typename CoarseOperator::matrix_type> coarseLevelMatrix_;
+    std::shared_ptr<PressurePatternCache> patternCache_;
 };
 
 } // namespace Opm
@@ -0,0 +1,245 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_PRESSURE_TRANSFER_HELPERS_HEADER_INCLUDED
+#define OPM_PRESSURE_TRANSFER_HELPERS_HEADER_INCLUDED
+
+#include <opm/common/TimingMacros.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#include <dune/istl/bcrsmatrix.hh>
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Opm
+{
+
+/// Sparsity pattern of the coarse pressure system of CPR.
+///
+/// The owner of the linear solver keeps it and hands it to the
+/// preconditioner factory, so the pattern survives the recreation of the
+/// preconditioner. The transfer policies only rebuild it when the pattern
+/// of the fine system changes.
+struct PressurePatternCache
+{
+    std::shared_ptr<const Dune::BCRSMatrix<Opm::MatrixBlock<double, 1, 1>>> pattern;
+};
+
+} // namespace Opm
+
+/// Building blocks shared by PressureTransferPolicy and
+/// PressureBhpTransferPolicy. The loops over cells are OpenMP-parallel
+/// over rows, every row of the coarse system only depends on the same
+/// row of the fine system.
+namespace Opm::Details
+{
+
+/// True if the two matrices have the same sparsity pattern on the rows
+/// of the first one.
+template <class MatrixA, class MatrixB>
+bool samePattern(const MatrixA& a, const MatrixB& b)
+{
+    if (a.N() != b.N() || a.M() != b.M() || a.nonzeroes() != b.nonzeroes()) {
+        return false;
+    }
+    for (auto rowA = a.begin(), rowB = b.begin(); rowA != a.end(); ++rowA, ++rowB) {
+        if (rowA->size() != rowB->size()) {
+            return false;
+        }
+        for (auto colA = rowA->begin(), colB = rowB->begin(); colA != rowA->end(); ++colA, ++colB) {
+            if (colA.index() != colB.index()) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/// Scalar matrix with the sparsity pattern of the fine level matrix.
+///
+/// The pattern is kept in the cache, and reused as long as the fine
+/// pattern is unchanged. Checking the pattern is a single read-only pass
+/// over the column indices, which is much cheaper than building the
+/// matrix row by row. The values are not initialized.
+template <class CoarseMatrix, class FineMatrix>
+std::shared_ptr<const CoarseMatrix>
+cachedPressurePattern(const FineMatrix& fine,
+                      std::shared_ptr<const CoarseMatrix>& cache)
+{
+    OPM_TIMEBLOCK(cachedPressurePattern);
+    if (cache && samePattern(fine, *cache)) {
+        return cache;
+    }
+
+    auto pattern = std::make_shared<CoarseMatrix>(fine.N(), fine.M(), fine.nonzeroes(),
+                                                  CoarseMatrix::row_wise);
+    auto createIter = pattern->createbegin();
+    for (const auto& row : fine) {
+        for (auto col = row.begin(), cend = row.end(); col != cend; ++col) {
+            createIter.insert(col.index());
+        }
+        ++createIter;
+    }
+    cache = pattern;
+    return cache;
+}
+
+/// Scalar matrix with the pattern of the reservoir part followed by the
+/// couplings of the well rows and columns in the extra rows. The well
+/// columns are numbered after all the cells, so they are appended to the
+/// reservoir rows.
+template <class CoarseMatrix>
+std::shared_ptr<CoarseMatrix> mergeWellPattern(const CoarseMatrix& reservoir,
+                                               const CoarseMatrix& wells)
+{
+    OPM_TIMEBLOCK(mergeWellPattern);
+    const std::size_t numCells = reservoir.N();
+    auto merged = std::make_shared<CoarseMatrix>(wells.N(), wells.M(), CoarseMatrix::random);
+    for (std::size_t row = 0; row < wells.N(); ++row) {
+        const std::size_t size = row < numCells ? reservoir[row].size() : 0;
+        merged->setrowsize(row, size + wells[row].size());
+    }
+    merged->endrowsizes();
+
+    std::vector<typename CoarseMatrix::size_type> cols;
+    for (std::size_t row = 0; row < wells.N(); ++row) {
+        cols.clear();
+        if (row < numCells) {
+            for (auto col = reservoir[row].begin(); col != reservoir[row].end(); ++col) {
+                cols.push_back(col.index());
+            }
+        }
+        for (auto col = wells[row].begin(); col != wells[row].end(); ++col) {
+            assert(row >= numCells || col.index() >= numCells);
+            cols.push_back(col.index());
+        }
+        merged->setIndices(row, cols.begin(), cols.end());
+    }
+    merged->endindices();
+    return merged;
+}
+
+/// Coarse entries of the rows belonging to cells, weighted sums of the
+/// pressure columns (transpose: of the pressure rows). Entries of the
+/// coarse matrix which are not in the fine matrix, and the rows after
+/// those of the fine matrix, are set to zero.
+template <bool transpose, class FineMatrix, class Weights, class CoarseMatrix>
+void calculatePressureEntries(const FineMatrix& fine,
+                              const Weights& weights,
+                              const std::size_t pressureIndex,
+                              CoarseMatrix& coarse)
+{
+    const int numRows = fine.N();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int row = 0; row < numRows; ++row) {
+        const auto& fineRow = fine[row];
+        auto& coarseRow = coarse[row];
+        auto entryCoarse = coarseRow.begin();
+        for (auto entry = fineRow.begin(), entryEnd = fineRow.end(); entry != entryEnd; ++entry, ++entryCoarse) {
+            assert(entry.index() == entryCoarse.index());
+            double matrix_el = 0;
+            if constexpr (transpose) {
+                const auto& bw = weights[entry.index()];
+                for (std::size_t i = 0; i < bw.size(); ++i) {
+                    matrix_el += (*entry)[pressureIndex][i] * bw[i];
+                }
+            } else {
+                const auto& bw = weights[row];
+                for (std::size_t i = 0; i < bw.size(); ++i) {
+                    matrix_el += (*entry)[i][pressureIndex] * bw[i];
+                }
+            }
+            (*entryCoarse) = matrix_el;
+        }
+        for (auto end = coarseRow.end(); entryCoarse != end; ++entryCoarse) {
+            (*entryCoarse) = 0;
+        }
+    }
+
+    const int numCoarseRows = coarse.N();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int row = numRows; row < numCoarseRows; ++row) {
+        coarse[row] = 0;
+    }
+}
+
+/// coarse = w^T fine per cell (transpose: the pressure component).
+/// Coarse entries after those of the cells are set to zero.
+template <bool transpose, class FineVector, class Weights, class CoarseVector>
+void restrictToPressure(const FineVector& fine,
+                        const Weights& weights,
+                        const std::size_t pressureIndex,
+                        CoarseVector& coarse)
+{
+    const int numCells = fine.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int cell = 0; cell < numCells; ++cell) {
+        const auto& block = fine[cell];
+        double rhs_el = 0.0;
+        if constexpr (transpose) {
+            rhs_el = block[pressureIndex];
+        } else {
+            const auto& bw = weights[cell];
+            for (std::size_t i = 0; i < block.size(); ++i) {
+                rhs_el += block[i] * bw[i];
+            }
+        }
+        coarse[cell] = rhs_el;
+    }
+    for (std::size_t i = numCells; i < coarse.size(); ++i) {
+        coarse[i] = 0;
+    }
+}
+
+/// Pressure component of fine from coarse (transpose: fine = w coarse).
+template <bool transpose, class CoarseVector, class Weights, class FineVector>
+void prolongateFromPressure(const CoarseVector& coarse,
+                            const Weights& weights,
+                            const std::size_t pressureIndex,
+                            FineVector& fine)
+{
+    const int numCells = fine.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int cell = 0; cell < numCells; ++cell) {
+        auto& block = fine[cell];
+        if constexpr (transpose) {
+            const auto& bw = weights[cell];
+            for (std::size_t i = 0; i < block.size(); ++i) {
+                block[i] = coarse[cell] * bw[i];
+            }
+        } else {
+            block[pressureIndex] = coarse[cell];
+        }
+    }
+}
+
+} // namespace Opm::Details
+
+#endif // OPM_PRESSURE_TRANSFER_HELPERS_HEADER_INCLUDED
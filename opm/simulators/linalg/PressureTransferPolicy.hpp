@@ -23,10 +23,13 @@
 
 
 #include <opm/simulators/linalg/twolevelmethodcpr.hh>
+#include <opm/simulators/linalg/PressureTransferHelpers.hpp>
 #include <opm/simulators/linalg/PropertyTree.hpp>
 #include <opm/simulators/linalg/matrixblock.hh>
 
 #include <cstddef>
+#include <memory>
+#include <utility>
 
 namespace Opm
 {
@@ -61,10 +64,13 @@ public:
     PressureTransferPolicy(const Communication& comm,
                            const FineVectorType& weights,
                            const Opm::PropertyTree& /*prm*/,
-                           int pressure_var_index)
+                           int pressure_var_index,
+                           std::shared_ptr<PressurePatternCache> patternCache = {})
         : communication_(&const_cast<Communication&>(comm))
         , weights_(weights)
         , pressure_var_index_(pressure_var_index)
+        , patternCache_(patternCache ? std::move(patternCache)
+                                     : std::make_shared<PressurePatternCache>())
     {
     }
 
@@ -72,15 +78,8 @@ public:
     {
         using CoarseMatrix = typename CoarseOperator::matrix_type;
         const auto& fineLevelMatrix = fineOperator.getmat();
-        coarseLevelMatrix_.reset(new CoarseMatrix(fineLevelMatrix.N(), fineLevelMatrix.M(), CoarseMatrix::row_wise));
-        auto createIter = coarseLevelMatrix_->createbegin();
-
-        for (const auto& row : fineLevelMatrix) {
-            for (auto col = row.begin(), cend = row.end(); col != cend; ++col) {
-                createIter.insert(col.index());
-            }
-            ++createIter;
-        }
+        coarseLevelMatrix_ = std::make_shared<CoarseMatrix>(
+            *Details::cachedPressurePattern(fineLevelMatrix, patternCache_->pattern));
 
         calculateCoarseEntries(fineOperator);
         coarseLevelCommunication_.reset(communication_, [](Communication*) {});
@@ -94,69 +93,19 @@ public:
 
     virtual void calculateCoarseEntries(const FineOperator& fineOperator) override
     {
-        const auto& fineMatrix = fineOperator.getmat();
-        *coarseLevelMatrix_ = 0;
-        auto rowCoarse = coarseLevelMatrix_->begin();
-        for (auto row = fineMatrix.begin(), rowEnd = fineMatrix.end(); row != rowEnd; ++row, ++rowCoarse) {
-            assert(row.index() == rowCoarse.index());
-            auto entryCoarse = rowCoarse->begin();
-            for (auto entry = row->begin(), entryEnd = row->end(); entry != entryEnd; ++entry, ++entryCoarse) {
-                assert(entry.index() == entryCoarse.index());
-                double matrix_el = 0;
-                if (transpose) {
-                    const auto& bw = weights_[entry.index()];
-                    for (std::size_t i = 0; i < bw.size(); ++i) {
-                        matrix_el += (*entry)[pressure_var_index_][i] * bw[i];
-                    }
-                } else {
-                    const auto& bw = weights_[row.index()];
-                    for (std::size_t i = 0; i < bw.size(); ++i) {
-                        matrix_el += (*entry)[i][pressure_var_index_] * bw[i];
-                    }
-                }
-                (*entryCoarse) = matrix_el;
-            }
-        }
-        assert(rowCoarse == coarseLevelMatrix_->end());
+        Details::calculatePressureEntries<transpose>(fineOperator.getmat(), weights_,
+                                                     pressure_var_index_, *coarseLevelMatrix_);
     }
 
     virtual void moveToCoarseLevel(const typename ParentType::FineRangeType& fine) override
     {
-        // Set coarse vector to zero
-        this->rhs_ = 0;
-
-        auto end = fine.end(), begin = fine.begin();
-
-        for (auto block = begin; block != end; ++block) {
-            const auto& bw = weights_[block.index()];
-            double rhs_el = 0.0;
-            if (transpose) {
-                rhs_el = (*block)[pressure_var_index_];
-            } else {
-                for (std::size_t i = 0; i < block->size(); ++i) {
-                    rhs_el += (*block)[i] * bw[i];
-                }
-            }
-            this->rhs_[block - begin] = rhs_el;
-        }
-
+        Details::restrictToPressure<transpose>(fine, weights_, pressure_var_index_, this->rhs_);
         this->lhs_ = 0;
     }
 
     virtual void moveToFineLevel(typename ParentType::FineDomainType& fine) override
     {
-        auto end = fine.end(), begin = fine.begin();
-
-        for (auto block = begin; block != end; ++block) {
-            if (transpose) {
-                const auto& bw = weights_[block.index()];
-                for (std::size_t i = 0; i < block->size(); ++i) {
-                    (*block)[i] = this->lhs_[block - begin] * bw[i];
-                }
-            } else {
-                (*block)[pressure_var_index_] = this->lhs_[block - begin];
-            }
-        }
+        Details::prolongateFromPressure<transpose>(this->lhs_, weights_, pressure_var_index_, fine);
     }
 
     virtual PressureTransferPolicy* clone() const override
@@ -180,6 +129,7 @@ private:
     const std::size_t pressure_var_index_;
     std::shared_ptr<Communication> coarseLevelCommunication_;
     std::shared_ptr<typename CoarseOperator::matrix_type> coarseLevelMatrix_;
+    std::shared_ptr<PressurePatternCache> patternCache_;
 };
 
 } // namespace Opm
@@ -0,0 +1,729 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_RECYCLING_GMRES_SOLVER_HEADER_INCLUDED
+#define OPM_RECYCLING_GMRES_SOLVER_HEADER_INCLUDED
+
+#include <opm/simulators/linalg/MergedReduction.hpp>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/timer.hh>
+#include <dune/istl/istlexception.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/solver.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/// Restarted, right preconditioned GMRES with deflation by a recycled
+/// subspace (GCRO-DR, Parks et al. 2006).
+///
+/// The solver keeps k vectors U, and C = A M^-1 U with orthonormal
+/// columns. Each restart cycle first removes the components of the
+/// residual along C, then runs Arnoldi on (I - C C^T) A M^-1, so the
+/// directions in U, typically those of the eigenvalues closest to zero,
+/// no longer slow down convergence. At the end of each cycle U is replaced
+/// by the harmonic Ritz vectors of A M^-1 in span{U, V} belonging to the
+/// k harmonic Ritz values of smallest magnitude, which needs no additional
+/// operator applications.
+///
+/// The subspace is kept between calls to apply(). Consecutive Jacobians of
+/// a Newton method or of successive time steps are close, so the subspace
+/// remains useful: at the start of a solve C is recomputed from U with the
+/// current operator and preconditioner at the cost of k applications of
+/// each. The harmonic Ritz vectors are computed in real arithmetic as a
+/// basis of the dominant invariant subspace of the small projected
+/// problem, found by orthogonal iteration, such that complex conjugate
+/// pairs need no special treatment.
+template <class X, class Comm>
+class RecyclingGMResSolver : public Dune::InverseOperator<X, X>
+{
+public:
+    RecyclingGMResSolver(Dune::LinearOperator<X, X>& op,
+                         Dune::Preconditioner<X, X>& prec,
+                         const Comm& comm,
+                         const double reduction,
+                         const int restart,
+                         const int recycle,
+                         const int maxit,
+                         const int verbose)
+        : op_(op)
+        , prec_(prec)
+        , reducer_(comm)
+        , reduction_(reduction)
+        , restart_(std::max(restart, 1))
+        , recycle_(std::max(recycle, 0))
+        , maxit_(maxit)
+        , verbose_(reducer_.isIORank() ? verbose : 0)
+    {}
+
+    void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+    {
+        apply(x, b, reduction_, res);
+    }
+
+    void apply(X& x, X& b, double reduction, Dune::InverseOperatorResult& res) override
+    {
+        res.clear();
+        Dune::Timer watch;
+        const std::size_t n = b.size();
+        const int m = restart_;
+        reducer_.resize(n);
+
+        prec_.pre(x, b);
+
+        X r(b);
+        op_.applyscaleadd(-1.0, x, r);
+        double def = norm(r);
+        const double def0 = def;
+
+        if (verbose_ > 0) {
+            std::cout << "=== RecyclingGMResSolver" << std::endl;
+            if (verbose_ > 1) {
+                this->printHeader(std::cout);
+                this->printOutput(std::cout, 0, def0);
+            }
+        }
+
+        if (def0 < 1e-30) {
+            res.converged = true;
+            res.iterations = 0;
+            res.reduction = 0;
+            res.conv_rate = 0;
+            res.elapsed = watch.elapsed();
+            prec_.post(x);
+            return;
+        }
+
+        X tmp(n);
+        prepareRecycledSpace(n, tmp);
+
+        std::vector<X> v(m + 1, X(n));
+        X corr(n);
+
+        // Hessenberg matrix, column major with m + 1 rows, as computed
+        // (hraw) and with the Givens rotations applied (h). The
+        // coefficients along C are in e, column major with k rows.
+        std::vector<double> hraw((m + 1) * m), h((m + 1) * m);
+        std::vector<double> g(m + 1), cs(m), sn(m), e;
+
+        int it = 0;
+        while (it < maxit_ && !res.converged) {
+            const int kc = u_.size();
+
+            // Remove the components along C from the residual, the
+            // correction for them is U C^T r.
+            corr = 0.0;
+            if (kc > 0) {
+                std::vector<double> coeff(kc, 0.0);
+                localDots(c_, kc, r, coeff.data());
+                reducer_.sum(coeff);
+                for (int a = 0; a < kc; ++a) {
+                    r.axpy(-coeff[a], c_[a]);
+                    corr.axpy(coeff[a], u_[a]);
+                }
+                def = norm(r);
+                if (def <= reduction * def0) {
+                    // The recycled space alone is enough.
+                    applyCorrection(corr, tmp, x);
+                    r = b;
+                    op_.applyscaleadd(-1.0, x, r);
+                    def = norm(r);
+                    if (def <= reduction * def0) {
+                        res.converged = true;
+                        break;
+                    }
+                    corr = 0.0;
+                }
+            }
+
+            std::fill(hraw.begin(), hraw.end(), 0.0);
+            std::fill(g.begin(), g.end(), 0.0);
+            e.assign(kc * m, 0.0);
+            g[0] = def;
+            v[0] = r;
+            v[0] *= 1.0 / def;
+
+            int j = 0;
+            while (j < m && it < maxit_) {
+                tmp = 0.0;
+                prec_.apply(tmp, v[j]);
+                op_.apply(tmp, v[j + 1]);
+
+                // Classical Gram-Schmidt against C and v_0..v_j, repeated
+                // once. The norm of the result is obtained from the second
+                // reduction.
+                double hnext = 0.0;
+                double colnorm = 0.0;
+                for (int pass = 0; pass < 2; ++pass) {
+                    const int nc = kc + j + 1;
+                    std::vector<double> vals(nc + pass, 0.0);
+                    localDots(c_, kc, v[j + 1], vals.data());
+                    localDots(v, j + 1, v[j + 1], vals.data() + kc);
+                    if (pass == 1) {
+                        vals[nc] = localDot(v[j + 1], v[j + 1]);
+                    }
+                    reducer_.sum(vals);
+                    for (int a = 0; a < kc; ++a) {
+                        v[j + 1].axpy(-vals[a], c_[a]);
+                        e[j * kc + a] += vals[a];
+                    }
+                    for (int i = 0; i <= j; ++i) {
+                        v[j + 1].axpy(-vals[kc + i], v[i]);
+                        hraw[j * (m + 1) + i] += vals[kc + i];
+                    }
+                    if (pass == 1) {
+                        double ww = vals[nc];
+                        for (int l = 0; l < nc; ++l) {
+                            ww -= vals[l] * vals[l];
+                        }
+                        hnext = std::sqrt(std::max(ww, 0.0));
+                    }
+                }
+                for (int a = 0; a < kc; ++a) {
+                    colnorm += e[j * kc + a] * e[j * kc + a];
+                }
+                for (int i = 0; i <= j; ++i) {
+                    colnorm += hraw[j * (m + 1) + i] * hraw[j * (m + 1) + i];
+                }
+                colnorm = std::sqrt(colnorm + hnext * hnext);
+
+                hraw[j * (m + 1) + j + 1] = hnext;
+                std::copy_n(&hraw[j * (m + 1)], m + 1, &h[j * (m + 1)]);
+                applyGivens(h, g, cs, sn, j, m);
+                ++j;
+                ++it;
+
+                const double def_old = def;
+                def = std::abs(g[j]);
+                if (verbose_ > 1) {
+                    this->printOutput(std::cout, it, def, def_old);
+                }
+                if (hnext <= rankTol_ * colnorm) {
+                    // Invariant subspace, the solution is in the current space.
+                    break;
+                }
+                v[j] *= 1.0 / hnext;
+                if (def <= reduction * def0) {
+                    break;
+                }
+            }
+
+            // On breakdown A M^-1 v_i may lie in the span of C and the
+            // previous vectors, which leaves a zero on the diagonal of the
+            // rotated H. The least squares problem is then solved on the
+            // leading columns in front of it.
+            double hmax = 0.0;
+            for (int i = 0; i < j; ++i) {
+                hmax = std::max(hmax, std::abs(h[i * (m + 1) + i]));
+            }
+            for (int i = 0; i < j; ++i) {
+                if (std::abs(h[i * (m + 1) + i]) <= rankTol_ * hmax || hmax == 0.0) {
+                    j = i;
+                    break;
+                }
+            }
+            if (j == 0 && kc == 0) {
+                DUNE_THROW(Dune::SolverAbort, "breakdown in RecyclingGMResSolver - zero diagonal in H");
+            }
+
+            // Correction V y - U E y with H y = g.
+            std::vector<double> y(j);
+            for (int i = j - 1; i >= 0; --i) {
+                double val = g[i];
+                for (int l = i + 1; l < j; ++l) {
+                    val -= h[l * (m + 1) + i] * y[l];
+                }
+                y[i] = val / h[i * (m + 1) + i];
+            }
+            for (int i = 0; i < j; ++i) {
+                corr.axpy(y[i], v[i]);
+            }
+            for (int a = 0; a < kc; ++a) {
+                double ey = 0.0;
+                for (int i = 0; i < j; ++i) {
+                    ey += e[i * kc + a] * y[i];
+                }
+                corr.axpy(-ey, u_[a]);
+            }
+            applyCorrection(corr, tmp, x);
+
+            // True residual for the restart and the convergence check.
+            r = b;
+            op_.applyscaleadd(-1.0, x, r);
+            def = norm(r);
+            if (def <= reduction * def0) {
+                res.converged = true;
+            }
+
+            if (recycle_ > 0 && j > 0) {
+                updateRecycledSpace(v, j, hraw, e, m);
+            }
+        }
+
+        prec_.post(x);
+
+        res.iterations = it;
+        res.reduction = def / def0;
+        res.conv_rate = std::pow(res.reduction, 1.0 / std::max(it, 1));
+        res.elapsed = watch.elapsed();
+
+        if (verbose_ > 0) {
+            std::cout << "=== rate=" << res.conv_rate
+                      << ", T=" << res.elapsed
+                      << ", TIT=" << res.elapsed / std::max(it, 1)
+                      << ", IT=" << it
+                      << ", recycled=" << u_.size() << std::endl;
+        }
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return op_.category();
+    }
+
+    /// Number of vectors in the recycled space.
+    int recycledDimension() const
+    {
+        return u_.size();
+    }
+
+private:
+    void applyCorrection(const X& corr, X& tmp, X& x)
+    {
+        tmp = 0.0;
+        prec_.apply(tmp, corr);
+        x += tmp;
+    }
+
+    // C = A M^-1 U for the current operator and preconditioner, then
+    // C := C R^-1 and U := U R^-1 with R^T R = C^T C. Vectors which are
+    // numerically dependent are dropped.
+    void prepareRecycledSpace(const std::size_t n, X& tmp)
+    {
+        if (!u_.empty() && u_.front().size() != n) {
+            u_.clear();
+        }
+        const int kc = u_.size();
+        c_.resize(kc, X(n));
+        if (kc == 0) {
+            return;
+        }
+        for (int a = 0; a < kc; ++a) {
+            tmp = 0.0;
+            prec_.apply(tmp, u_[a]);
+            op_.apply(tmp, c_[a]);
+        }
+        std::vector<double> gram(kc * kc, 0.0);
+        for (int a = 0; a < kc; ++a) {
+            localDots(c_, a + 1, c_[a], &gram[a * kc]);
+        }
+        reducer_.sum(gram);
+        for (int a = 0; a < kc; ++a) {
+            for (int l = 0; l < a; ++l) {
+                gram[l * kc + a] = gram[a * kc + l];
+            }
+        }
+        std::vector<double> rfac;
+        const int kn = cholesky(gram, kc, rfac);
+        std::vector<double> coeff(kc * kn, 0.0);
+        for (int l = 0; l < kn; ++l) {
+            coeff[l * kc + l] = 1.0;
+        }
+        invertUpperFromRight(rfac, kc, kn, coeff, kc);
+        combine(u_, kc, coeff, kc, kn, tmp);
+        combine(c_, kc, coeff, kc, kn, tmp);
+    }
+
+    // Replace U by the harmonic Ritz vectors of the k harmonic Ritz values
+    // of smallest magnitude in span{U, v_0..v_(j-1)}, and C accordingly.
+    // With W = [U, V_j] and A M^-1 W = [C, V_(j+1)] G, they solve
+    // G^T G z = theta G^T [C, V_(j+1)]^T W z.
+    void updateRecycledSpace(const std::vector<X>& v, const int j,
+                             const std::vector<double>& hraw,
+                             const std::vector<double>& e, const int m)
+    {
+        const int kc = u_.size();
+        const int p = kc + j;
+        const int q = kc + j + 1;
+
+        // G = [I E; 0 H], column major with q rows.
+        std::vector<double> G(q * p, 0.0);
+        for (int a = 0; a < kc; ++a) {
+            G[a * q + a] = 1.0;
+        }
+        for (int col = 0; col < j; ++col) {
+            for (int a = 0; a < kc; ++a) {
+                G[(kc + col) * q + a] = e[col * kc + a];
+            }
+            for (int row = 0; row <= col + 1; ++row) {
+                G[(kc + col) * q + kc + row] = hraw[col * (m + 1) + row];
+            }
+        }
+
+        // Q = [C, V_(j+1)]^T W, only C^T U and V^T U need reductions.
+        std::vector<double> vals(kc * kc + kc * (j + 1), 0.0);
+        for (int a = 0; a < kc; ++a) {
+            localDots(c_, kc, u_[a], &vals[a * kc]);
+            localDots(v, j + 1, u_[a], &vals[kc * kc + a * (j + 1)]);
+        }
+        reducer_.sum(vals);
+        std::vector<double> Q(q * p, 0.0);
+        for (int a = 0; a < kc; ++a) {
+            for (int i = 0; i < kc; ++i) {
+                Q[a * q + i] = vals[a * kc + i];
+            }
+            for (int i = 0; i <= j; ++i) {
+                Q[a * q + kc + i] = vals[kc * kc + a * (j + 1) + i];
+            }
+        }
+        for (int col = 0; col < j; ++col) {
+            Q[(kc + col) * q + kc + col] = 1.0;
+        }
+
+        // S = G^T G, T = G^T Q and Z = S^-1 T, whose eigenvalues are the
+        // reciprocals of the harmonic Ritz values.
+        std::vector<double> S(p * p, 0.0), Z(p * p, 0.0);
+        for (int a = 0; a < p; ++a) {
+            for (int l = 0; l < p; ++l) {
+                double s = 0.0;
+                double t = 0.0;
+                for (int i = 0; i < q; ++i) {
+                    s += G[a * q + i] * G[l * q + i];
+                    t += G[a * q + i] * Q[l * q + i];
+                }
+                S[l * p + a] = s;
+                Z[l * p + a] = t;
+            }
+        }
+        std::vector<double> sfac;
+        if (cholesky(S, p, sfac) < p) {
+            return;
+        }
+        for (int l = 0; l < p; ++l) {
+            choleskySolve(sfac, p, &Z[l * p]);
+        }
+
+        // Dominant invariant subspace of Z by orthogonal iteration.
+        int kn = std::min(recycle_, p);
+        std::vector<double> P(p * kn), Pn(p * kn);
+        // Deterministic start, identical on all processes: the columns of
+        // the discrete sine transform, which are orthogonal.
+        const double pi = 3.14159265358979323846;
+        for (int l = 0; l < kn; ++l) {
+            for (int i = 0; i < p; ++i) {
+                P[l * p + i] = std::sin(pi * (i + 1) * (l + 1) / (p + 1));
+            }
+        }
+        kn = orthonormalizeColumns(P, p, kn);
+        for (int iter = 0; iter < maxRitzIter_ && kn > 0; ++iter) {
+            Pn.assign(p * kn, 0.0);
+            for (int l = 0; l < kn; ++l) {
+                for (int c = 0; c < p; ++c) {
+                    const double pc = P[l * p + c];
+                    for (int i = 0; i < p; ++i) {
+                        Pn[l * p + i] += Z[c * p + i] * pc;
+                    }
+                }
+            }
+            kn = orthonormalizeColumns(Pn, p, kn);
+            // Distance between the subspaces spanned by P and Pn.
+            double change = 0.0;
+            for (int l = 0; l < kn; ++l) {
+                double proj = 0.0;
+                for (int a = 0; a < kn; ++a) {
+                    double d = 0.0;
+                    for (int i = 0; i < p; ++i) {
+                        d += P[a * p + i] * Pn[l * p + i];
+                    }
+                    proj += d * d;
+                }
+                change = std::max(change, 1.0 - proj);
+            }
+            std::swap(P, Pn);
+            if (change < ritzTol_) {
+                break;
+            }
+        }
+        if (kn == 0) {
+            return;
+        }
+
+        // Normalise with R^T R = P^T S P, the Gram matrix of [C, V] G P.
+        std::vector<double> M(kn * kn, 0.0);
+        for (int a = 0; a < kn; ++a) {
+            for (int l = 0; l < kn; ++l) {
+                double val = 0.0;
+                for (int i = 0; i < p; ++i) {
+                    for (int c = 0; c < p; ++c) {
+                        val += P[a * p + i] * S[c * p + i] * P[l * p + c];
+                    }
+                }
+                M[l * kn + a] = val;
+            }
+        }
+        std::vector<double> rfac;
+        const int ldr = kn;
+        kn = cholesky(M, ldr, rfac);
+        if (kn == 0) {
+            return;
+        }
+        invertUpperFromRight(rfac, ldr, kn, P, p);
+
+        // U := [U, V_j] P, C := [C, V_(j+1)] G P.
+        std::vector<double> GP(q * kn, 0.0);
+        for (int l = 0; l < kn; ++l) {
+            for (int c = 0; c < p; ++c) {
+                const double pc = P[l * p + c];
+                for (int i = 0; i < q; ++i) {
+                    GP[l * q + i] += G[c * q + i] * pc;
+                }
+            }
+        }
+        std::vector<X> newU(kn, X(v[0].size())), newC(kn, X(v[0].size()));
+        for (int l = 0; l < kn; ++l) {
+            newU[l] = 0.0;
+            newC[l] = 0.0;
+            for (int a = 0; a < kc; ++a) {
+                newU[l].axpy(P[l * p + a], u_[a]);
+                newC[l].axpy(GP[l * q + a], c_[a]);
+            }
+            for (int i = 0; i < j; ++i) {
+                newU[l].axpy(P[l * p + kc + i], v[i]);
+            }
+            for (int i = 0; i <= j; ++i) {
+                newC[l].axpy(GP[l * q + kc + i], v[i]);
+            }
+        }
+        u_ = std::move(newU);
+        c_ = std::move(newC);
+    }
+
+    // vec := vec coeff, where coeff is column major with rows rows and
+    // cols columns. The vector is resized to cols entries.
+    static void combine(std::vector<X>& vec, const int rows,
+                        const std::vector<double>& coeff, const int ldc,
+                        const int cols, const X& proto)
+    {
+        std::vector<X> out(cols, X(proto.size()));
+        for (int l = 0; l < cols; ++l) {
+            out[l] = 0.0;
+            for (int a = 0; a < rows; ++a) {
+                out[l].axpy(coeff[l * ldc + a], vec[a]);
+            }
+        }
+        vec = std::move(out);
+    }
+
+    // Cholesky factorisation A = R^T R of a symmetric, column major n x n
+    // matrix. Stops at the first column which is numerically dependent on
+    // the previous ones and returns the number of accepted columns.
+    static int cholesky(const std::vector<double>& a, const int n, std::vector<double>& r)
+    {
+        r.assign(n * n, 0.0);
+        for (int j = 0; j < n; ++j) {
+            for (int i = 0; i <= j; ++i) {
+                double val = a[j * n + i];
+                for (int l = 0; l < i; ++l) {
+                    val -= r[i * n + l] * r[j * n + l];
+                }
+                if (i < j) {
+                    r[j * n + i] = val / r[i * n + i];
+                } else if (val > rankTol_ * a[j * n + j] && val > 0.0) {
+                    r[j * n + j] = std::sqrt(val);
+                } else {
+                    return j;
+                }
+            }
+        }
+        return n;
+    }
+
+    // x := (R^T R)^-1 x
+    static void choleskySolve(const std::vector<double>& r, const int n, double* x)
+    {
+        for (int i = 0; i < n; ++i) {
+            double val = x[i];
+            for (int l = 0; l < i; ++l) {
+                val -= r[i * n + l] * x[l];
+            }
+            x[i] = val / r[i * n + i];
+        }
+        for (int i = n - 1; i >= 0; --i) {
+            double val = x[i];
+            for (int l = i + 1; l < n; ++l) {
+                val -= r[l * n + i] * x[l];
+            }
+            x[i] = val / r[i * n + i];
+        }
+    }
+
+    // B := B R^-1 for the leading cols x cols block of the upper
+    // triangular R (leading dimension ldr), B column major with ldb rows.
+    static void invertUpperFromRight(const std::vector<double>& r, const int ldr, const int cols,
+                                     std::vector<double>& bmat, const int ldb)
+    {
+        for (int l = 0; l < cols; ++l) {
+            for (int a = 0; a < l; ++a) {
+                const double ral = r[l * ldr + a];
+                for (int i = 0; i < ldb; ++i) {
+                    bmat[l * ldb + i] -= ral * bmat[a * ldb + i];
+                }
+            }
+            const double d = r[l * ldr + l];
+            for (int i = 0; i < ldb; ++i) {
+                bmat[l * ldb + i] /= d;
+            }
+        }
+    }
+
+    // Modified Gram-Schmidt with reorthogonalisation of the columns of a
+    // small column major matrix, dropping dependent columns. Returns the
+    // number of remaining columns.
+    static int orthonormalizeColumns(std::vector<double>& a, const int rows, const int cols)
+    {
+        int kept = 0;
+        for (int l = 0; l < cols; ++l) {
+            double* col = &a[l * rows];
+            double norm0 = 0.0;
+            for (int i = 0; i < rows; ++i) {
+                norm0 += col[i] * col[i];
+            }
+            for (int pass = 0; pass < 2; ++pass) {
+                for (int c = 0; c < kept; ++c) {
+                    const double* prev = &a[c * rows];
+                    double d = 0.0;
+                    for (int i = 0; i < rows; ++i) {
+                        d += prev[i] * col[i];
+                    }
+                    for (int i = 0; i < rows; ++i) {
+                        col[i] -= d * prev[i];
+                    }
+                }
+            }
+            double nrm = 0.0;
+            for (int i = 0; i < rows; ++i) {
+                nrm += col[i] * col[i];
+            }
+            if (nrm <= rankTol_ * norm0 || nrm == 0.0) {
+                continue;
+            }
+            nrm = std::sqrt(nrm);
+            double* dest = &a[kept * rows];
+            for (int i = 0; i < rows; ++i) {
+                dest[i] = col[i] / nrm;
+            }
+            ++kept;
+        }
+        a.resize(kept * rows);
+        return kept;
+    }
+
+    double localDot(const X& a, const X& b) const
+    {
+        double val = 0.0;
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            const double wt = reducer_.weight(i);
+            for (std::size_t c = 0; c < bs; ++c) {
+                val += wt * a[i][c] * b[i][c];
+            }
+        }
+        return val;
+    }
+
+    // out[a] += (basis[a], w) for a < count, without the global sum.
+    void localDots(const std::vector<X>& basis, const int count, const X& w, double* out) const
+    {
+        for (std::size_t i = 0; i < w.size(); ++i) {
+            const double wt = reducer_.weight(i);
+            if (wt == 0.0) {
+                continue;
+            }
+            for (std::size_t c = 0; c < bs; ++c) {
+                const double wc = wt * w[i][c];
+                for (int a = 0; a < count; ++a) {
+                    out[a] += basis[a][i][c] * wc;
+                }
+            }
+        }
+    }
+
+    double norm(const X& x)
+    {
+        std::vector<double> val(1, localDot(x, x));
+        reducer_.sum(val);
+        return std::sqrt(val[0]);
+    }
+
+    // Apply the previous rotations to column k of h and compute a new one
+    // which eliminates the subdiagonal entry.
+    static void applyGivens(std::vector<double>& h, std::vector<double>& g,
+                            std::vector<double>& cs, std::vector<double>& sn,
+                            const int k, const int m)
+    {
+        double* col = &h[k * (m + 1)];
+        for (int i = 0; i < k; ++i) {
+            const double tmp = cs[i] * col[i] + sn[i] * col[i + 1];
+            col[i + 1] = -sn[i] * col[i] + cs[i] * col[i + 1];
+            col[i] = tmp;
+        }
+        const double a = col[k];
+        const double bb = col[k + 1];
+        const double rad = std::hypot(a, bb);
+        if (rad == 0.0) {
+            cs[k] = 1.0;
+            sn[k] = 0.0;
+        } else {
+            cs[k] = a / rad;
+            sn[k] = bb / rad;
+        }
+        col[k] = rad;
+        col[k + 1] = 0.0;
+        g[k + 1] = -sn[k] * g[k];
+        g[k] = cs[k] * g[k];
+    }
+
+    static constexpr std::size_t bs = X::block_type::dimension;
+    static constexpr double rankTol_ = 1e-12;
+    static constexpr double ritzTol_ = 1e-8;
+    static constexpr int maxRitzIter_ = 100;
+
+    Dune::LinearOperator<X, X>& op_;
+    Dune::Preconditioner<X, X>& prec_;
+    MergedReduction<Comm> reducer_;
+    double reduction_;
+    int restart_;
+    int recycle_;
+    int maxit_;
+    int verbose_;
+    std::vector<X> u_;
+    std::vector<X> c_;
+};
+
+} // namespace Opm
+
+#endif // OPM_RECYCLING_GMRES_SOLVER_HEADER_INCLUDED
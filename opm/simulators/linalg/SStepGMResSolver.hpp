@@ -0,0 +1,469 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_SSTEP_GMRES_SOLVER_HEADER_INCLUDED
+#define OPM_SSTEP_GMRES_SOLVER_HEADER_INCLUDED
+
+#include <opm/simulators/linalg/MergedReduction.hpp>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/timer.hh>
+#include <dune/istl/istlexception.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/solver.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace Opm
+{
+
+/// Restarted, right preconditioned s-step (communication avoiding) GMRES.
+///
+/// Instead of orthogonalising each new Krylov vector on its own, which
+/// costs one or more global reductions per iteration, s vectors
+/// w_i = (A M^-1)^i v / sigma^i are generated at a time and orthogonalised
+/// as a block against the basis and each other by block Gram-Schmidt with
+/// Cholesky QR, repeated once for stability. This costs two global
+/// reductions per s iterations. The Hessenberg matrix is recovered from the
+/// change of basis, and the usual Givens rotations give the residual
+/// estimates. The scaling sigma is estimated from the growth of the
+/// previous block. If the block basis becomes numerically rank deficient,
+/// the block is truncated and the next one starts from the last accepted
+/// basis vector.
+///
+/// As for Dune::RestartedGMResSolver, the preconditioner is assumed to be
+/// the same in all iterations of a restart cycle.
+template <class X, class Comm>
+class SStepGMResSolver : public Dune::InverseOperator<X, X>
+{
+public:
+    SStepGMResSolver(Dune::LinearOperator<X, X>& op,
+                     Dune::Preconditioner<X, X>& prec,
+                     const Comm& comm,
+                     const double reduction,
+                     const int restart,
+                     const int sstep,
+                     const int maxit,
+                     const int verbose)
+        : op_(op)
+        , prec_(prec)
+        , reducer_(comm)
+        , reduction_(reduction)
+        , restart_(std::max(restart, 1))
+        , sstep_(std::clamp(sstep, 1, restart_))
+        , maxit_(maxit)
+        , verbose_(reducer_.isIORank() ? verbose : 0)
+    {}
+
+    void apply(X& x, X& b, Dune::InverseOperatorResult& res) override
+    {
+        apply(x, b, reduction_, res);
+    }
+
+    void apply(X& x, X& b, double reduction, Dune::InverseOperatorResult& res) override
+    {
+        res.clear();
+        Dune::Timer watch;
+        const std::size_t n = b.size();
+        const int m = restart_;
+        reducer_.resize(n);
+
+        prec_.pre(x, b);
+
+        X r(b);
+        op_.applyscaleadd(-1.0, x, r);
+        double def = norm(r);
+        const double def0 = def;
+
+        if (verbose_ > 0) {
+            std::cout << "=== SStepGMResSolver" << std::endl;
+            if (verbose_ > 1) {
+                this->printHeader(std::cout);
+                this->printOutput(std::cout, 0, def0);
+            }
+        }
+
+        if (def0 < 1e-30) {
+            res.converged = true;
+            res.iterations = 0;
+            res.reduction = 0;
+            res.conv_rate = 0;
+            res.elapsed = watch.elapsed();
+            prec_.post(x);
+            return;
+        }
+
+        std::vector<X> v(m + 1, X(n));
+        std::vector<X> w(sstep_ + 1, X(n));
+        X tmp(n);
+
+        // Hessenberg matrix, column major with m + 1 rows, as computed
+        // (hraw) and with the Givens rotations applied (h).
+        std::vector<double> hraw((m + 1) * m), h((m + 1) * m);
+        std::vector<double> g(m + 1), cs(m), sn(m);
+        double sigma = 1.0;
+
+        int it = 0;
+        while (it < maxit_ && !res.converged) {
+            std::fill(hraw.begin(), hraw.end(), 0.0);
+            std::fill(g.begin(), g.end(), 0.0);
+            g[0] = def;
+            v[0] = r;
+            v[0] *= 1.0 / def;
+
+            int k = 0;
+            bool done = false;
+            while (k < m && it < maxit_ && !done) {
+                const int sb = std::min({sstep_, m - k, maxit_ - it});
+                const double block_sigma = sigma;
+
+                // w_0 = v_k, w_i = A M^-1 w_(i-1) / sigma
+                w[0] = v[k];
+                for (int i = 1; i <= sb; ++i) {
+                    tmp = 0.0;
+                    prec_.apply(tmp, w[i - 1]);
+                    op_.apply(tmp, w[i]);
+                    w[i] *= 1.0 / sigma;
+                }
+
+                // Two passes of block Gram-Schmidt with Cholesky QR,
+                // W = V C + Q R with Q stored in w[1..kb].
+                std::vector<double> c1, r1, c2, r2;
+                const int kb1 = orthogonalize(v, k + 1, w, sb, c1, r1);
+                const double growth = std::pow(gram_[(sb - 1) * sb + sb - 1], 0.5 / sb);
+                if (std::isfinite(growth) && growth > 0.0) {
+                    sigma *= growth;
+                }
+                const int kb = kb1 > 0 ? orthogonalize(v, k + 1, w, kb1, c2, r2) : 0;
+
+                if (kb == 0) {
+                    // A M^-1 v_k lies numerically in the span of the basis,
+                    // the approximation in this space is exact.
+                    for (int a = 0; a <= k; ++a) {
+                        hraw[k * (m + 1) + a] = block_sigma * c1[a];
+                    }
+                    std::copy_n(&hraw[k * (m + 1)], m + 1, &h[k * (m + 1)]);
+                    applyGivens(h, g, cs, sn, k, m);
+                    ++k;
+                    ++it;
+                    def = std::abs(g[k]);
+                    if (verbose_ > 1) {
+                        this->printOutput(std::cout, it, def);
+                    }
+                    done = true;
+                    break;
+                }
+
+                // Combined coefficients of w_1..w_kb: C = C1 + C2 R1, R = R2 R1.
+                const int nv = k + 1;
+                std::vector<double> cc(nv * kb), rr(kb * kb, 0.0);
+                for (int j = 0; j < kb; ++j) {
+                    for (int a = 0; a < nv; ++a) {
+                        double val = c1[j * nv + a];
+                        for (int l = 0; l <= j; ++l) {
+                            val += c2[l * nv + a] * r1[j * sb + l];
+                        }
+                        cc[j * nv + a] = val;
+                    }
+                    for (int i = 0; i <= j; ++i) {
+                        double val = 0.0;
+                        for (int l = i; l <= j; ++l) {
+                            val += r2[l * kb1 + i] * r1[j * sb + l];
+                        }
+                        rr[j * kb + i] = val;
+                    }
+                }
+                for (int j = 0; j < kb; ++j) {
+                    std::swap(v[k + 1 + j], w[1 + j]);
+                }
+
+                // Hessenberg columns k..k+kb-1 from the change of basis,
+                // H_new = (Y - H_old X_top) X_mid^-1, where X holds the
+                // coordinates of v_k, w_1..w_(kb-1) and Y those of
+                // sigma w_1..sigma w_kb in the extended basis.
+                const int rows = k + kb + 1;
+                auto coordW = [&](int i, int row) {
+                    // coordinate of w_i (1-based) in basis vector row
+                    if (row <= k) {
+                        return cc[(i - 1) * nv + row];
+                    }
+                    const int l = row - k - 1;
+                    return l < i ? rr[(i - 1) * kb + l] : 0.0;
+                };
+                for (int j = 0; j < kb; ++j) {
+                    const int col = k + j;
+                    std::vector<double> z(rows);
+                    for (int row = 0; row < rows; ++row) {
+                        z[row] = block_sigma * coordW(j + 1, row);
+                    }
+                    if (j > 0) {
+                        // subtract H_old X_top, X_top = coordinates of w_j in v_0..v_(k-1)
+                        for (int l = 0; l < k; ++l) {
+                            const double xl = coordW(j, l);
+                            for (int row = 0; row <= l + 1; ++row) {
+                                z[row] -= hraw[l * (m + 1) + row] * xl;
+                            }
+                        }
+                        // divide by X_mid from the right
+                        for (int l = 0; l < j; ++l) {
+                            const double xm = coordW(j, k + l);
+                            for (int row = 0; row < rows; ++row) {
+                                z[row] -= hraw[(k + l) * (m + 1) + row] * xm;
+                            }
+                        }
+                        const double diag = coordW(j, k + j);
+                        for (auto& zr : z) {
+                            zr /= diag;
+                        }
+                    }
+                    for (int row = 0; row < rows; ++row) {
+                        hraw[col * (m + 1) + row] = row <= col + 1 ? z[row] : 0.0;
+                    }
+                    std::copy_n(&hraw[col * (m + 1)], m + 1, &h[col * (m + 1)]);
+                }
+
+                // Givens rotations and residual estimates, column by column.
+                for (int j = 0; j < kb; ++j) {
+                    applyGivens(h, g, cs, sn, k, m);
+                    ++k;
+                    ++it;
+                    const double def_old = def;
+                    def = std::abs(g[k]);
+                    if (verbose_ > 1) {
+                        this->printOutput(std::cout, it, def, def_old);
+                    }
+                    if (def <= reduction * def0) {
+                        done = true;
+                        break;
+                    }
+                }
+            }
+
+            // On breakdown A M^-1 v_i may lie in the span of the previous
+            // vectors, which leaves a zero on the diagonal of the rotated H.
+            // The least squares problem is then solved on the leading
+            // columns in front of it.
+            double hmax = 0.0;
+            for (int i = 0; i < k; ++i) {
+                hmax = std::max(hmax, std::abs(h[i * (m + 1) + i]));
+            }
+            for (int i = 0; i < k; ++i) {
+                if (std::abs(h[i * (m + 1) + i]) <= rankTol_ * hmax || hmax == 0.0) {
+                    k = i;
+                    break;
+                }
+            }
+            if (k == 0) {
+                DUNE_THROW(Dune::SolverAbort, "breakdown in SStepGMResSolver - zero diagonal in H");
+            }
+
+            // Update the solution with the k basis vectors of this cycle,
+            // x += M^-1 V y with H y = g.
+            std::vector<double> yk(k);
+            for (int i = k - 1; i >= 0; --i) {
+                double val = g[i];
+                for (int j = i + 1; j < k; ++j) {
+                    val -= h[j * (m + 1) + i] * yk[j];
+                }
+                yk[i] = val / h[i * (m + 1) + i];
+            }
+            X u(n);
+            u = 0.0;
+            for (int i = 0; i < k; ++i) {
+                u.axpy(yk[i], v[i]);
+            }
+            tmp = 0.0;
+            prec_.apply(tmp, u);
+            x += tmp;
+
+            // True residual for the restart and the convergence check.
+            r = b;
+            op_.applyscaleadd(-1.0, x, r);
+            def = norm(r);
+            if (def <= reduction * def0) {
+                res.converged = true;
+            }
+        }
+
+        prec_.post(x);
+
+        res.iterations = it;
+        res.reduction = def / def0;
+        res.conv_rate = std::pow(res.reduction, 1.0 / std::max(it, 1));
+        res.elapsed = watch.elapsed();
+
+        if (verbose_ > 0) {
+            std::cout << "=== rate=" << res.conv_rate
+                      << ", T=" << res.elapsed
+                      << ", TIT=" << res.elapsed / std::max(it, 1)
+                      << ", IT=" << it << std::endl;
+        }
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return op_.category();
+    }
+
+private:
+    double norm(const X& x)
+    {
+        std::vector<double> val(1, 0.0);
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            const double wt = reducer_.weight(i);
+            for (std::size_t c = 0; c < bs; ++c) {
+                val[0] += wt * x[i][c] * x[i][c];
+            }
+        }
+        reducer_.sum(val);
+        return std::sqrt(val[0]);
+    }
+
+    // One pass of block Gram-Schmidt with Cholesky QR of w[1..nw] against
+    // v[0..nv). Computes C = V^T W and the Gram matrix of W with a single
+    // reduction, then W := (W - V C) R^-1 with R^T R = W^T W - C^T C.
+    // Columns are accepted as long as the Cholesky factorisation is
+    // numerically stable; returns their number. C is column major with nv
+    // rows, R column major with nw rows.
+    int orthogonalize(const std::vector<X>& v, const int nv,
+                      std::vector<X>& w, const int nw,
+                      std::vector<double>& c, std::vector<double>& r)
+    {
+        const std::size_t n = w[0].size();
+        const int nc = nv * nw;
+        std::vector<double> vals(nc + nw * nw, 0.0);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double wt = reducer_.weight(i);
+            if (wt == 0.0) {
+                continue;
+            }
+            for (std::size_t comp = 0; comp < bs; ++comp) {
+                for (int j = 0; j < nw; ++j) {
+                    const double wj = w[1 + j][i][comp];
+                    for (int a = 0; a < nv; ++a) {
+                        vals[j * nv + a] += wt * v[a][i][comp] * wj;
+                    }
+                    for (int l = 0; l <= j; ++l) {
+                        vals[nc + j * nw + l] += wt * w[1 + l][i][comp] * wj;
+                    }
+                }
+            }
+        }
+        reducer_.sum(vals);
+
+        c.assign(vals.begin(), vals.begin() + nc);
+        gram_.assign(nw * nw, 0.0);
+        for (int j = 0; j < nw; ++j) {
+            for (int l = 0; l <= j; ++l) {
+                gram_[j * nw + l] = gram_[l * nw + j] = vals[nc + j * nw + l];
+            }
+        }
+
+        // Cholesky factorisation of W^T W - C^T C, column by column.
+        r.assign(nw * nw, 0.0);
+        int accepted = 0;
+        for (int j = 0; j < nw && accepted == j; ++j) {
+            for (int i = 0; i <= j; ++i) {
+                double val = gram_[j * nw + i];
+                for (int a = 0; a < nv; ++a) {
+                    val -= c[i * nv + a] * c[j * nv + a];
+                }
+                for (int l = 0; l < i; ++l) {
+                    val -= r[i * nw + l] * r[j * nw + l];
+                }
+                if (i < j) {
+                    r[j * nw + i] = val / r[i * nw + i];
+                } else {
+                    if (val > rankTol_ * gram_[j * nw + j]) {
+                        r[j * nw + j] = std::sqrt(val);
+                        accepted = j + 1;
+                    }
+                }
+            }
+        }
+
+        // W := (W - V C) R^-1 for the accepted columns.
+        for (std::size_t i = 0; i < n; ++i) {
+            for (std::size_t comp = 0; comp < bs; ++comp) {
+                for (int j = 0; j < accepted; ++j) {
+                    double val = w[1 + j][i][comp];
+                    for (int a = 0; a < nv; ++a) {
+                        val -= c[j * nv + a] * v[a][i][comp];
+                    }
+                    for (int l = 0; l < j; ++l) {
+                        val -= r[j * nw + l] * w[1 + l][i][comp];
+                    }
+                    w[1 + j][i][comp] = val / r[j * nw + j];
+                }
+            }
+        }
+        return accepted;
+    }
+
+    // Apply the previous rotations to column k of h and compute a new one
+    // which eliminates the subdiagonal entry.
+    static void applyGivens(std::vector<double>& h, std::vector<double>& g,
+                            std::vector<double>& cs, std::vector<double>& sn,
+                            const int k, const int m)
+    {
+        double* col = &h[k * (m + 1)];
+        for (int i = 0; i < k; ++i) {
+            const double tmp = cs[i] * col[i] + sn[i] * col[i + 1];
+            col[i + 1] = -sn[i] * col[i] + cs[i] * col[i + 1];
+            col[i] = tmp;
+        }
+        const double a = col[k];
+        const double bb = col[k + 1];
+        const double rad = std::hypot(a, bb);
+        if (rad == 0.0) {
+            cs[k] = 1.0;
+            sn[k] = 0.0;
+        } else {
+            cs[k] = a / rad;
+            sn[k] = bb / rad;
+        }
+        col[k] = rad;
+        col[k + 1] = 0.0;
+        g[k + 1] = -sn[k] * g[k];
+        g[k] = cs[k] * g[k];
+    }
+
+    static constexpr std::size_t bs = X::block_type::dimension;
+    static constexpr double rankTol_ = 1e-12;
+
+    Dune::LinearOperator<X, X>& op_;
+    Dune::Preconditioner<X, X>& prec_;
+    MergedReduction<Comm> reducer_;
+    double reduction_;
+    int restart_;
+    int sstep_;
+    int maxit_;
+    int verbose_;
+    std::vector<double> gram_;
+};
+
+} // namespace Opm
+
+#endif // OPM_SSTEP_GMRES_SOLVER_HEADER_INCLUDED
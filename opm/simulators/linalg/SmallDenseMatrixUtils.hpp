@@ -22,6 +22,8 @@
 #define OPM_SMALL_DENSE_MATRIX_UTILS_HEADER_INCLUDED
 
 #include <dune/common/dynmatrix.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
 
 namespace Opm
 {
@@ -137,6 +139,76 @@ namespace detail
         }
     }
 
+    //! calculates the cofactor (i, j) of the 3x3 matrix given by the
+    //! accessor a(row, col)
+    template <class K, class Access>
+    static inline K cofactor3(const Access& a, const int i, const int j)
+    {
+        const int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+        const int j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+        return a(i1, j1) * a(i2, j2) - a(i1, j2) * a(i2, j1);
+    }
+
+    //! calculates the cofactor (i, j) of the 4x4 matrix given by the
+    //! accessor a(row, col)
+    template <class K, class Access>
+    static inline K cofactor4(const Access& a, const int i, const int j)
+    {
+        int r[3], c[3];
+        for (int k = 0, kr = 0, kc = 0; k < 4; ++k) {
+            if (k != i) { r[kr++] = k; }
+            if (k != j) { c[kc++] = k; }
+        }
+        const K minor = a(r[0], c[0]) * (a(r[1], c[1]) * a(r[2], c[2]) - a(r[1], c[2]) * a(r[2], c[1]))
+                      - a(r[0], c[1]) * (a(r[1], c[0]) * a(r[2], c[2]) - a(r[1], c[2]) * a(r[2], c[0]))
+                      + a(r[0], c[2]) * (a(r[1], c[0]) * a(r[2], c[1]) - a(r[1], c[1]) * a(r[2], c[0]));
+        return ((i + j) % 2 == 0) ? minor : -minor;
+    }
+
+    //! solves A x = e_k, or A^T x = e_k if transpose is true, where e_k
+    //! is the k-th unit vector, i.e. x is column (row) k of the inverse.
+    //! The 3x3 and 4x4 cases only need the cofactors of row (column) k,
+    //! which also give the determinant by expansion along that row. Other
+    //! sizes and singular blocks use the general solver of dune-common.
+    template <bool transpose, class K, int n>
+    static inline void solveUnitVector(const Dune::FieldMatrix<K, n, n>& A,
+                                       const int k,
+                                       Dune::FieldVector<K, n>& x)
+    {
+        const auto a = [&A](const int i, const int j) -> K
+        {
+            return transpose ? A[j][i] : A[i][j];
+        };
+        if constexpr (n == 3 || n == 4) {
+            K det = 0;
+            for (int i = 0; i < n; ++i) {
+                if constexpr (n == 3) {
+                    x[i] = cofactor3<K>(a, k, i);
+                } else {
+                    x[i] = cofactor4<K>(a, k, i);
+                }
+                det += a(k, i) * x[i];
+            }
+            if (det != 0) {
+                x /= det;
+                return;
+            }
+        }
+        Dune::FieldVector<K, n> rhs(0);
+        rhs[k] = 1;
+        if constexpr (transpose) {
+            Dune::FieldMatrix<K, n, n> At;
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    At[i][j] = A[j][i];
+                }
+            }
+            At.solve(x, rhs);
+        } else {
+            A.solve(x, rhs);
+        }
+    }
+
 } // namespace detail
 } // namespace Opm
 
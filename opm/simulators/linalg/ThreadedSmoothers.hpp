@@ -0,0 +1,540 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_THREADEDSMOOTHERS_HEADER_INCLUDED
+#define OPM_THREADEDSMOOTHERS_HEADER_INCLUDED
+
+#include <opm/common/TimingMacros.hpp>
+#include <opm/simulators/linalg/BlockKernels.hpp>
+#include <opm/simulators/linalg/PreconditionerWithUpdate.hpp>
+
+#include <dune/common/exceptions.hh>
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/istlexception.hh>
+#include <dune/istl/paamg/pinfo.hh>
+#include <dune/istl/paamg/smoother.hh>
+#include <dune/istl/solvercategory.hh>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Opm
+{
+
+template<class Matrix, class Domain, class Range, class ParallelInfo>
+class ThreadedJacobi;
+
+template<class Matrix, class Domain, class Range, class ParallelInfo>
+class ChebyshevSmoother;
+
+template<class F>
+class ThreadedJacobiArgs
+    : public Dune::Amg::DefaultSmootherArgs<F>
+{
+ public:
+    ThreadedJacobiArgs()
+        : l1_(false)
+    {}
+    void setL1(bool l1)
+    {
+        l1_ = l1;
+    }
+    bool getL1() const
+    {
+        return l1_;
+    }
+ private:
+    bool l1_;
+};
+
+template<class F>
+class ChebyshevSmootherArgs
+    : public Dune::Amg::DefaultSmootherArgs<F>
+{
+ public:
+    ChebyshevSmootherArgs()
+        : degree_(2), eigenvalueRatio_(30.0), powerIterations_(10)
+    {}
+    void setDegree(int degree)
+    {
+        degree_ = degree;
+    }
+    int getDegree() const
+    {
+        return degree_;
+    }
+    void setEigenvalueRatio(double ratio)
+    {
+        eigenvalueRatio_ = ratio;
+    }
+    double getEigenvalueRatio() const
+    {
+        return eigenvalueRatio_;
+    }
+    void setPowerIterations(int iterations)
+    {
+        powerIterations_ = iterations;
+    }
+    int getPowerIterations() const
+    {
+        return powerIterations_;
+    }
+ private:
+    int degree_;
+    double eigenvalueRatio_;
+    int powerIterations_;
+};
+
+} // end namespace Opm
+
+namespace Dune
+{
+
+namespace Amg
+{
+
+template<class M, class X, class Y, class C>
+struct SmootherTraits<Opm::ThreadedJacobi<M,X,Y,C> >
+{
+    using Arguments = Opm::ThreadedJacobiArgs<typename M::field_type>;
+};
+
+template<class M, class X, class Y, class C>
+struct SmootherTraits<Opm::ChebyshevSmoother<M,X,Y,C> >
+{
+    using Arguments = Opm::ChebyshevSmootherArgs<typename M::field_type>;
+};
+
+/// \brief Tells AMG how to construct the Opm::ThreadedJacobi smoother
+template<class Matrix, class Domain, class Range, class ParallelInfo>
+struct ConstructionTraits<Opm::ThreadedJacobi<Matrix,Domain,Range,ParallelInfo> >
+{
+    using T = Opm::ThreadedJacobi<Matrix,Domain,Range,ParallelInfo>;
+    using Arguments = DefaultParallelConstructionArgs<T,ParallelInfo>;
+
+    static inline std::shared_ptr<T> construct(Arguments& args)
+    {
+        return std::make_shared<T>(args.getMatrix(),
+                                   args.getComm(),
+                                   args.getArgs().iterations,
+                                   args.getArgs().relaxationFactor,
+                                   args.getArgs().getL1());
+    }
+};
+
+/// \brief Tells AMG how to construct the Opm::ChebyshevSmoother smoother
+template<class Matrix, class Domain, class Range, class ParallelInfo>
+struct ConstructionTraits<Opm::ChebyshevSmoother<Matrix,Domain,Range,ParallelInfo> >
+{
+    using T = Opm::ChebyshevSmoother<Matrix,Domain,Range,ParallelInfo>;
+    using Arguments = DefaultParallelConstructionArgs<T,ParallelInfo>;
+
+    static inline std::shared_ptr<T> construct(Arguments& args)
+    {
+        return std::make_shared<T>(args.getMatrix(),
+                                   args.getComm(),
+                                   args.getArgs().getDegree(),
+                                   args.getArgs().getEigenvalueRatio(),
+                                   args.getArgs().getPowerIterations());
+    }
+};
+
+} // end namespace Amg
+
+} // end namespace Dune
+
+namespace Opm
+{
+
+namespace detail
+{
+
+/// \brief Invert the diagonal blocks of a matrix using all threads.
+///
+/// With l1 the sum of the absolute values of the off-diagonal entries of
+/// each row is added to the diagonal before inverting. The resulting
+/// l1-Jacobi iteration converges for symmetric positive definite matrices
+/// without damping.
+template<class Matrix>
+void invertDiagonalBlocks(const Matrix& A, const bool l1,
+                          std::vector<typename Matrix::block_type>& invDiag)
+{
+    using Block = typename Matrix::block_type;
+    const int numRows = A.N();
+    invDiag.resize(numRows);
+    int failed = 0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+:failed)
+#endif
+    for (int row = 0; row < numRows; ++row) {
+        const auto& Arow = A[row];
+        Block diag(0.0);
+        std::array<typename Matrix::field_type, Block::rows> offDiagonalSums{};
+        for (auto col = Arow.begin(), end = Arow.end(); col != end; ++col) {
+            if (static_cast<int>(col.index()) == row) {
+                diag = *col;
+            } else if (l1) {
+                for (int i = 0; i < Block::rows; ++i) {
+                    for (int j = 0; j < Block::cols; ++j) {
+                        offDiagonalSums[i] += std::abs((*col)[i][j]);
+                    }
+                }
+            }
+        }
+        if (l1) {
+            for (int i = 0; i < Block::rows; ++i) {
+                diag[i][i] += diag[i][i] < 0 ? -offDiagonalSums[i] : offDiagonalSums[i];
+            }
+        }
+        // Exceptions must not leave the parallel region, failures are
+        // counted and reported below.
+        try {
+            diag.invert();
+        } catch (...) {
+            ++failed;
+        }
+        invDiag[row] = diag;
+    }
+    if (failed > 0) {
+        DUNE_THROW(Dune::MatrixBlockError, "Singular diagonal block in " << failed << " rows");
+    }
+}
+
+/// \brief Compute r = D^{-1} (b - A x) using all threads.
+template<class Matrix, class Block, class X, class Y>
+void jacobiResidual(const Matrix& A, const std::vector<Block>& invDiag,
+                    const X& x, const Y& b, X& r)
+{
+    const int numRows = A.N();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int row = 0; row < numRows; ++row) {
+        auto res = b[row];
+        const auto& Arow = A[row];
+        for (auto col = Arow.begin(), end = Arow.end(); col != end; ++col) {
+            blockMmv(*col, x[col.index()], res);
+        }
+        blockMv(invDiag[row], res, r[row]);
+    }
+}
+
+/// \brief Global scalar product of vectors that are consistent on all processes.
+template<class ParallelInfo, class X>
+typename X::field_type globalDot(const ParallelInfo* comm, const X& x, const X& y)
+{
+    if constexpr (std::is_same_v<ParallelInfo, Dune::Amg::SequentialInformation>) {
+        return x.dot(y);
+    } else {
+        if (!comm) {
+            return x.dot(y);
+        }
+        typename X::field_type result = 0;
+        comm->dot(x, y, result);
+        return result;
+    }
+}
+
+} // end namespace detail
+
+/// \brief A damped block Jacobi smoother using all threads.
+///
+/// Contrary to the Gauss-Seidel and ILU smoothers every row of a sweep is
+/// independent, hence the sweeps are threaded with OpenMP. Optionally the
+/// l1 variant is used that makes the iteration convergent without
+/// damping. In parallel the update is made consistent after each sweep.
+/// \tparam Matrix The type of the Matrix.
+/// \tparam Domain The type of the Vector representing the domain.
+/// \tparam Range The type of the Vector representing the range.
+/// \tparam ParallelInfo The type of the parallel information object
+///         used, e.g. Dune::OwnerOverlapCommunication
+template<class Matrix, class Domain, class Range, class ParallelInfo>
+class ThreadedJacobi
+    : public Dune::PreconditionerWithUpdate<Domain,Range>
+{
+public:
+    using matrix_type = Matrix;
+    using domain_type = Domain;
+    using range_type = Range;
+    using field_type = typename Domain::field_type;
+
+    /*! \brief Constructor.
+
+      \param A The matrix to operate on.
+      \param comm The communication object, e.g. Dune::OwnerOverlapCopyCommunication
+      \param n The number of sweeps.
+      \param w The relaxation factor.
+      \param l1 Whether to use the l1 variant.
+    */
+    ThreadedJacobi(const Matrix& A, const ParallelInfo& comm,
+                   const int n, const field_type w, const bool l1)
+        : A_(&A), comm_(&comm), n_(n), w_(w), l1_(l1)
+    {
+        update();
+    }
+
+    /*! \brief Constructor for the sequential case.
+
+      \param A The matrix to operate on.
+      \param n The number of sweeps.
+      \param w The relaxation factor.
+      \param l1 Whether to use the l1 variant.
+    */
+    ThreadedJacobi(const Matrix& A, const int n, const field_type w, const bool l1)
+        : A_(&A), comm_(nullptr), n_(n), w_(w), l1_(l1)
+    {
+        update();
+    }
+
+    void pre(Domain&, Range&) override
+    {}
+
+    void apply(Domain& v, const Range& d) override
+    {
+        OPM_TIMEBLOCK(threadedJacobiApply);
+        const int numRows = A_->N();
+        // The first sweep starts from zero.
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int row = 0; row < numRows; ++row) {
+            detail::blockMv(invDiag_[row], d[row], v[row]);
+            v[row] *= w_;
+        }
+        copyOwnerToAll(v);
+        for (int sweep = 1; sweep < n_; ++sweep) {
+            detail::jacobiResidual(*A_, invDiag_, v, d, correction_);
+            v.axpy(w_, correction_);
+            copyOwnerToAll(v);
+        }
+    }
+
+    void post(Domain&) override
+    {}
+
+    void update() override
+    {
+        OPM_TIMEBLOCK(threadedJacobiUpdate);
+        detail::invertDiagonalBlocks(*A_, l1_, invDiag_);
+        correction_.resize(A_->N());
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return comm_ ? Dune::SolverCategory::category(*comm_) : Dune::SolverCategory::sequential;
+    }
+
+private:
+    void copyOwnerToAll(Domain& v) const
+    {
+        if (comm_) {
+            comm_->copyOwnerToAll(v, v);
+        }
+    }
+
+    const Matrix* A_;
+    const ParallelInfo* comm_;
+    int n_;
+    field_type w_;
+    bool l1_;
+    std::vector<typename Matrix::block_type> invDiag_;
+    Domain correction_;
+};
+
+/// \brief A Chebyshev polynomial smoother using all threads.
+///
+/// Applies a fixed number of steps of the Chebyshev iteration for the
+/// block Jacobi preconditioned system, targeting the eigenvalues of
+/// D^{-1} A in [lambda_max / ratio, lambda_max]. This damps the upper part
+/// of the spectrum as multigrid smoothers do, and consists of threaded
+/// matrix-vector products only. The largest eigenvalue is estimated with a
+/// few power iterations in update().
+/// \tparam Matrix The type of the Matrix.
+/// \tparam Domain The type of the Vector representing the domain.
+/// \tparam Range The type of the Vector representing the range.
+/// \tparam ParallelInfo The type of the parallel information object
+///         used, e.g. Dune::OwnerOverlapCommunication
+template<class Matrix, class Domain, class Range, class ParallelInfo>
+class ChebyshevSmoother
+    : public Dune::PreconditionerWithUpdate<Domain,Range>
+{
+public:
+    using matrix_type = Matrix;
+    using domain_type = Domain;
+    using range_type = Range;
+    using field_type = typename Domain::field_type;
+
+    /*! \brief Constructor.
+
+      \param A The matrix to operate on.
+      \param comm The communication object, e.g. Dune::OwnerOverlapCopyCommunication
+      \param degree The degree of the polynomial, i.e. the number of matrix-vector products.
+      \param eigenvalueRatio The ratio of the largest and smallest eigenvalue targeted.
+      \param powerIterations The number of power iterations to estimate the largest eigenvalue.
+    */
+    ChebyshevSmoother(const Matrix& A, const ParallelInfo& comm,
+                      const int degree, const double eigenvalueRatio,
+                      const int powerIterations)
+        : A_(&A), comm_(&comm), degree_(std::max(degree, 1)),
+          eigenvalueRatio_(eigenvalueRatio), powerIterations_(powerIterations)
+    {
+        update();
+    }
+
+    /*! \brief Constructor for the sequential case.
+
+      \param A The matrix to operate on.
+      \param degree The degree of the polynomial, i.e. the number of matrix-vector products.
+      \param eigenvalueRatio The ratio of the largest and smallest eigenvalue targeted.
+      \param powerIterations The number of power iterations to estimate the largest eigenvalue.
+    */
+    ChebyshevSmoother(const Matrix& A, const int degree, const double eigenvalueRatio,
+                      const int powerIterations)
+        : A_(&A), comm_(nullptr), degree_(std::max(degree, 1)),
+          eigenvalueRatio_(eigenvalueRatio), powerIterations_(powerIterations)
+    {
+        update();
+    }
+
+    void pre(Domain&, Range&) override
+    {}
+
+    void apply(Domain& v, const Range& d) override
+    {
+        OPM_TIMEBLOCK(chebyshevApply);
+        const field_type lambdaMin = lambdaMax_ / eigenvalueRatio_;
+        const field_type theta = 0.5 * (lambdaMax_ + lambdaMin);
+        const field_type delta = 0.5 * (lambdaMax_ - lambdaMin);
+        const field_type sigma = theta / delta;
+        field_type rho = 1.0 / sigma;
+        const int numRows = A_->N();
+
+        // First step from zero: v = D^{-1} d / theta.
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int row = 0; row < numRows; ++row) {
+            detail::blockMv(invDiag_[row], d[row], direction_[row]);
+            direction_[row] /= theta;
+            v[row] = direction_[row];
+        }
+        copyOwnerToAll(v);
+
+        for (int step = 1; step < degree_; ++step) {
+            const field_type rhoNew = 1.0 / (2.0 * sigma - rho);
+            const field_type dirScale = rhoNew * rho;
+            const field_type resScale = 2.0 * rhoNew / delta;
+            detail::jacobiResidual(*A_, invDiag_, v, d, residual_);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (int row = 0; row < numRows; ++row) {
+                direction_[row] *= dirScale;
+                direction_[row].axpy(resScale, residual_[row]);
+                v[row] += direction_[row];
+            }
+            copyOwnerToAll(v);
+            rho = rhoNew;
+        }
+    }
+
+    void post(Domain&) override
+    {}
+
+    void update() override
+    {
+        OPM_TIMEBLOCK(chebyshevUpdate);
+        detail::invertDiagonalBlocks(*A_, false, invDiag_);
+        residual_.resize(A_->N());
+        direction_.resize(A_->N());
+        estimateLargestEigenvalue();
+    }
+
+    Dune::SolverCategory::Category category() const override
+    {
+        return comm_ ? Dune::SolverCategory::category(*comm_) : Dune::SolverCategory::sequential;
+    }
+
+    //! \brief The estimate of the largest eigenvalue of D^{-1} A.
+    field_type largestEigenvalue() const
+    {
+        return lambdaMax_;
+    }
+
+private:
+    void copyOwnerToAll(Domain& v) const
+    {
+        if (comm_) {
+            comm_->copyOwnerToAll(v, v);
+        }
+    }
+
+    void estimateLargestEigenvalue()
+    {
+        // Power iteration for D^{-1} A.
+        Domain& x = direction_;
+        Domain& y = residual_;
+        for (std::size_t row = 0; row < x.size(); ++row) {
+            // Deterministic pseudo-random values in [-1, 1], which contain
+            // the high frequencies that dominate the spectrum of D^{-1} A.
+            const auto hash = static_cast<std::uint32_t>(row * 2654435761u) >> 8;
+            for (std::size_t i = 0; i < x[row].size(); ++i) {
+                x[row][i] = static_cast<double>((hash + 7919 * i) % 2001) / 1000.0 - 1.0;
+            }
+        }
+        copyOwnerToAll(x);
+        const Range zero(A_->N(), typename Range::block_type(0.0));
+        field_type lambda = 1.0;
+        field_type norm = std::sqrt(detail::globalDot(comm_, x, x));
+        for (int it = 0; it < powerIterations_ && norm > 0.0; ++it) {
+            x /= norm;
+            // y = -D^{-1} (0 - A x) = D^{-1} A x
+            detail::jacobiResidual(*A_, invDiag_, x, zero, y);
+            y *= -1.0;
+            copyOwnerToAll(y);
+            norm = std::sqrt(detail::globalDot(comm_, y, y));
+            lambda = norm;
+            std::swap(x, y);
+        }
+        // Without power iterations lambda is 1, which is the exact value for
+        // a diagonal matrix. The safety factor accounts for the underestimate
+        // of the power iteration.
+        lambdaMax_ = 1.1 * std::max(std::abs(lambda), field_type(1e-12));
+    }
+
+    const Matrix* A_;
+    const ParallelInfo* comm_;
+    int degree_;
+    double eigenvalueRatio_;
+    int powerIterations_;
+    field_type lambdaMax_ = 1.0;
+    std::vector<typename Matrix::block_type> invDiag_;
+    Domain residual_;
+    Domain direction_;
+};
+
+} // end namespace Opm
+
+#endif // OPM_THREADEDSMOOTHERS_HEADER_INCLUDED
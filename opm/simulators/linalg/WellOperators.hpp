@@ -28,9 +28,18 @@
 
 #include <opm/common/TimingMacros.hpp>
 
+#include <opm/simulators/linalg/BlockKernels.hpp>
 #include <opm/simulators/linalg/matrixblock.hh>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <vector>
 
 namespace Opm
 {
@@ -60,6 +69,18 @@ public:
     virtual void addWellPressureEquations(PressureMatrix& jacobian, const X& weights,const bool use_well_weights) const = 0;
     virtual void addWellPressureEquationsStruct(PressureMatrix& jacobian) const = 0;
     virtual int getNumberOfExtraEquations() const = 0;
+
+    /// Number of wells that can be applied one at a time with applyWell().
+    virtual int numWells() const = 0;
+    /// Cells perforated by a well.
+    virtual const std::vector<int>& wellCells(const int well) const = 0;
+    /// True if the well is perforated on several processes. Applying
+    /// such a well involves communication.
+    virtual bool wellIsDistributed(const int well) const = 0;
+    /// Add the contribution of a single well:  \f$ y = y - C^T D^{-1} B x \f$
+    virtual void applyWell(const int well, const X& x, Y& y) const = 0;
+    /// Changes whenever the set of wells or their cells changes.
+    virtual std::uint64_t wellContainerStamp() const = 0;
 };
 
 template <class WellModel, class X, class Y>
@@ -113,11 +134,221 @@ public:
     {
         return wellMod_.numLocalWellsEnd();
     }
+    int numWells() const override
+    {
+        return wellMod_.localNonshutWells().size();
+    }
+    const std::vector<int>& wellCells(const int well) const override
+    {
+        return wellMod_.localNonshutWells()[well]->cells();
+    }
+    bool wellIsDistributed(const int well) const override
+    {
+        return wellMod_.localNonshutWells()[well]->parallelWellInfo().communication().size() > 1;
+    }
+    void applyWell(const int well, const X& x, Y& y) const override
+    {
+        wellMod_.localNonshutWells()[well]->apply(x, y);
+    }
+    std::uint64_t wellContainerStamp() const override
+    {
+        return wellMod_.wellContainerStamp();
+    }
 
 private:
     const WellModel& wellMod_;
 };
 
+namespace detail
+{
+
+/// Threaded product of the rows [0, numRows) of a matrix with a vector,
+/// fused with the contributions of the wells.
+///
+/// The rows are split into one chunk per thread. A well whose cells all
+/// lie in one chunk is applied by the thread owning that chunk right
+/// after its rows, while x and y are still in cache. The other wells, i.e.
+/// those spanning several chunks, those perforating rows beyond numRows
+/// and those distributed across processes, are applied afterwards by a
+/// single thread. The grouping is kept until the wells or the chunking
+/// change.
+template<class M, class X, class Y>
+class FusedWellMatrixProduct
+{
+public:
+    using field_type = typename X::field_type;
+
+    //! y = A x - C^T D^-1 B x on the rows [0, numRows)
+    void apply(const M& A, const LinearOperatorExtra<X, Y>& wellOper,
+               const std::size_t numRows, const X& x, Y& y) const
+    {
+        multiply<false>(A, wellOper, numRows, 1.0, x, y);
+    }
+
+    //! y += alpha (A x - C^T D^-1 B x) on the rows [0, numRows)
+    void applyscaleadd(const M& A, const LinearOperatorExtra<X, Y>& wellOper,
+                       const std::size_t numRows, const field_type alpha,
+                       const X& x, Y& y) const
+    {
+        multiply<true>(A, wellOper, numRows, alpha, x, y);
+    }
+
+private:
+    template<bool scaleAdd>
+    void multiply(const M& A, const LinearOperatorExtra<X, Y>& wellOper,
+                  const std::size_t numRows, const field_type alpha,
+                  const X& x, Y& y) const
+    {
+#ifdef _OPENMP
+        const int numChunks = std::max(1, std::min(omp_get_max_threads(), static_cast<int>(numRows)));
+#else
+        const int numChunks = 1;
+#endif
+        groupWells(wellOper, numRows, numChunks);
+
+        std::exception_ptr failure;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+        for (int chunk = 0; chunk < numChunks; ++chunk) {
+            const std::size_t rowEnd = rowBegin(chunk + 1, numRows, numChunks);
+            for (std::size_t i = rowBegin(chunk, numRows, numChunks); i < rowEnd; ++i) {
+                const auto& row = A[i];
+                if constexpr (!scaleAdd) {
+                    y[i] = 0;
+                }
+                const auto endc = row.end();
+                for (auto col = row.begin(); col != endc; ++col) {
+                    if constexpr (scaleAdd) {
+                        blockUsmv(alpha, *col, x[col.index()], y[i]);
+                    } else {
+                        blockUmv(*col, x[col.index()], y[i]);
+                    }
+                }
+            }
+            // Exceptions must not escape the parallel region, the first
+            // one is rethrown below.
+            try {
+                std::vector<typename Y::block_type> saved;
+                for (int k = wellStart_[chunk]; k < wellStart_[chunk + 1]; ++k) {
+                    applyWell<scaleAdd>(wellOper, wells_[k], uniqueCells_[wells_[k]], alpha, x, y, saved);
+                }
+            } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+
+        std::vector<typename Y::block_type> saved;
+        for (int k = wellStart_[numChunks]; k < wellStart_[numChunks + 1]; ++k) {
+            applyWell<scaleAdd>(wellOper, wells_[k], uniqueCells_[wells_[k]], alpha, x, y, saved);
+        }
+    }
+
+    // The well model only provides y = y - C^T D^-1 B x, the scaled
+    // version is recovered from the values of y at the cells of the well.
+    // Each cell is visited once, even if the well perforates it several
+    // times, so its contribution is scaled exactly once.
+    template<bool scaleAdd>
+    static void applyWell(const LinearOperatorExtra<X, Y>& wellOper,
+                          const int well, const std::vector<int>& cells,
+                          const field_type alpha, const X& x, Y& y,
+                          std::vector<typename Y::block_type>& saved)
+    {
+        if constexpr (scaleAdd) {
+            saved.resize(cells.size());
+            for (std::size_t c = 0; c < cells.size(); ++c) {
+                saved[c] = y[cells[c]];
+            }
+            wellOper.applyWell(well, x, y);
+            for (std::size_t c = 0; c < cells.size(); ++c) {
+                auto& yc = y[cells[c]];
+                yc -= saved[c];
+                yc *= alpha;
+                yc += saved[c];
+            }
+        } else {
+            wellOper.applyWell(well, x, y);
+        }
+    }
+
+    static std::size_t rowBegin(const int chunk, const std::size_t numRows, const int numChunks)
+    {
+        return (numRows * chunk) / numChunks;
+    }
+
+    static int chunkOf(const std::size_t row, const std::size_t numRows, const int numChunks)
+    {
+        return (numChunks * (row + 1) - 1) / numRows;
+    }
+
+    // Bucket the wells by chunk, wells applied serially go in the
+    // extra bucket numChunks. The operator may be kept while the well
+    // model recreates its wells, which changes the well container stamp.
+    void groupWells(const LinearOperatorExtra<X, Y>& wellOper,
+                    const std::size_t numRows, const int numChunks) const
+    {
+        const auto stamp = wellOper.wellContainerStamp();
+        if (grouped_ && stamp == stamp_ && numRows == numRows_ && numChunks == numChunks_) {
+            return;
+        }
+
+        const int numWells = wellOper.numWells();
+        wellChunk_.resize(numWells);
+        uniqueCells_.resize(numWells);
+        wellStart_.assign(numChunks + 2, 0);
+        for (int w = 0; w < numWells; ++w) {
+            int chunk = numChunks;
+            auto& cells = uniqueCells_[w];
+            cells = wellOper.wellCells(w);
+            std::sort(cells.begin(), cells.end());
+            cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+            if (!cells.empty() && !wellOper.wellIsDistributed(w)) {
+                if (static_cast<std::size_t>(cells.back()) < numRows) {
+                    const int first = chunkOf(cells.front(), numRows, numChunks);
+                    if (first == chunkOf(cells.back(), numRows, numChunks)) {
+                        chunk = first;
+                    }
+                }
+            }
+            wellChunk_[w] = chunk;
+            ++wellStart_[chunk + 1];
+        }
+        for (int chunk = 0; chunk <= numChunks; ++chunk) {
+            wellStart_[chunk + 1] += wellStart_[chunk];
+        }
+        wells_.resize(numWells);
+        pos_.assign(wellStart_.begin(), wellStart_.end() - 1);
+        for (int w = 0; w < numWells; ++w) {
+            wells_[pos_[wellChunk_[w]]++] = w;
+        }
+
+        grouped_ = true;
+        stamp_ = stamp;
+        numRows_ = numRows;
+        numChunks_ = numChunks;
+    }
+
+    mutable bool grouped_ = false;
+    mutable std::uint64_t stamp_ = 0;
+    mutable std::size_t numRows_ = 0;
+    mutable int numChunks_ = 0;
+    mutable std::vector<std::vector<int>> uniqueCells_;
+    mutable std::vector<int> wellChunk_;
+    mutable std::vector<int> wellStart_;
+    mutable std::vector<int> pos_;
+    mutable std::vector<int> wells_;
+};
+
+} // namespace detail
+
 /*!
    \brief Adapter to combine a matrix and another linear operator into
    a combined linear operator.
@@ -161,10 +392,8 @@ public:
   virtual void apply( const X& x, Y& y ) const override
   {
     OPM_TIMEBLOCK(apply);
-    A_.mv( x, y );
-
-    // add well model modification to y
-    wellOper_.apply(x, y );
+    // y = A x with the well model modification added in the same pass
+    product_.apply(A_, wellOper_, A_.N(), x, y);
 
 #if HAVE_MPI
     if( comm_ )
@@ -176,10 +405,8 @@ public:
   virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const override
   {
     OPM_TIMEBLOCK(applyscaleadd);
-    A_.usmv(alpha,x,y);
-
-    // add scaled well model modification to y
-    wellOper_.applyscaleadd( alpha, x, y );
+    // y += alpha * A x with the scaled well model modification
+    product_.applyscaleadd(A_, wellOper_, A_.N(), alpha, x, y);
 
 #if HAVE_MPI
     if( comm_ )
@@ -208,6 +435,7 @@ protected:
   const matrix_type& A_ ;
   const Opm::LinearOperatorExtra<X, Y>& wellOper_;
   std::shared_ptr< communication_type > comm_;
+  detail::FusedWellMatrixProduct<M, X, Y> product_;
 };
 
 
@@ -251,16 +479,8 @@ public:
     virtual void apply( const X& x, Y& y ) const override
     {
         OPM_TIMEBLOCK(apply);
-        for (auto row = A_.begin(); row.index() < interiorSize_; ++row)
-        {
-            y[row.index()]=0;
-            auto endc = (*row).end();
-            for (auto col = (*row).begin(); col != endc; ++col)
-                (*col).umv(x[col.index()], y[row.index()]);
-        }
-
-        // add well model modification to y
-        wellOper_.apply(x, y );
+        // y = A x on the interior rows with the well model modification
+        product_.apply(A_, wellOper_, interiorSize_, x, y);
 
         ghostLastProject( y );
     }
@@ -269,14 +489,9 @@ public:
     virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const override
     {
         OPM_TIMEBLOCK(applyscaleadd);
-        for (auto row = A_.begin(); row.index() < interiorSize_; ++row)
-        {
-            auto endc = (*row).end();
-            for (auto col = (*row).begin(); col != endc; ++col)
-                (*col).usmv(alpha, x[col.index()], y[row.index()]);
-        }
-        // add scaled well model modification to y
-        wellOper_.applyscaleadd( alpha, x, y );
+        // y += alpha * A x on the interior rows with the scaled well
+        // model modification
+        product_.applyscaleadd(A_, wellOper_, interiorSize_, alpha, x, y);
 
         ghostLastProject( y );
     }
@@ -309,6 +524,7 @@ protected:
     const matrix_type& A_ ;
     const Opm::LinearOperatorExtra< X, Y>& wellOper_;
     std::size_t interiorSize_;
+    detail::FusedWellMatrixProduct<M, X, Y> product_;
 };
 
 } // namespace Opm
@@ -23,6 +23,7 @@
 #include <dune/common/exceptions.hh>
 
 #include <memory>
+#include <type_traits>
 
 namespace Dune
 {
@@ -471,15 +472,25 @@ namespace Dune
     {
       OPM_TIMEBLOCK(update);
       Timer watch;
-      smoothers_.reset(new Hierarchy<Smoother,A>);
       solver_.reset();
       coarseSmoother_.reset();
       scalarProduct_.reset();
       buildHierarchy_= true;
       coarsesolverconverged = true;
-      smoothers_.reset(new Hierarchy<Smoother,A>);
+      // The aggregates and the sparsity pattern of the coarse matrices are
+      // kept, only the Galerkin products are recomputed in place.
       recalculateHierarchy();
-      matrices_->coarsenSmoother(*smoothers_, smootherArgs_);
+      if constexpr (std::is_base_of_v<PreconditionerWithUpdate<X,X>, Smoother>) {
+        // The smoothers refer to the matrices of the hierarchy, hence they
+        // can be updated in place and keep their own sparsity patterns.
+        auto smoother = smoothers_->finest();
+        for (std::size_t level = 0; level < smoothers_->levels(); ++level, ++smoother) {
+          smoother->update();
+        }
+      } else {
+        smoothers_.reset(new Hierarchy<Smoother,A>);
+        matrices_->coarsenSmoother(*smoothers_, smootherArgs_);
+      }
       setupCoarseSolver();
       if (verbosity_>0 && matrices_->parallelInformation().finest()->communicator().rank()==0) {
         std::cout << "Recalculating galerkin and coarse smoothers "<< matrices_->maxlevels() << " levels "
@@ -22,10 +22,16 @@
 
 #include <dune/common/fvector.hh>
 
+#include <opm/simulators/linalg/SmallDenseMatrixUtils.hpp>
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Opm
 {
@@ -42,41 +48,96 @@ namespace Details
 
         return tmp;
     }
+
+    /// Scale the weights of a cell to a maximum absolute value of one.
+    template <class VectorBlock>
+    void normalizeWeights(VectorBlock& bweights)
+    {
+        double abs_max = *std::max_element(
+            bweights.begin(), bweights.end(), [](double a, double b) { return std::fabs(a) < std::fabs(b); });
+        bweights /= std::fabs(abs_max);
+    }
+
+    /// True-IMPES weights of a cell from the derivatives of its storage
+    /// term, the solution of B^T w = e_p for the scaled storage Jacobian B.
+    template <class VectorBlock, class Storage>
+    VectorBlock trueImpesBlockWeights(const Storage& storage, const int pressureVarIndex,
+                                      const double storage_scale)
+    {
+        constexpr int numEq = VectorBlock::dimension;
+        Dune::FieldMatrix<double, numEq, numEq> block;
+        double pressure_scale = 50e5;
+        for (int ii = 0; ii < numEq; ++ii) {
+            for (int jj = 0; jj < numEq; ++jj) {
+                block[ii][jj] = storage[ii].derivative(jj)/storage_scale;
+                if (jj == pressureVarIndex) {
+                    block[ii][jj] *= pressure_scale;
+                }
+            }
+        }
+        VectorBlock bweights;
+        detail::solveUnitVector</*transpose=*/true>(block, pressureVarIndex, bweights);
+        // probably a scaling which could give approximately total compressibility would be better
+        normalizeWeights(bweights); // given normal densities this scales weights to about 1.
+        return bweights;
+    }
+
+    /// Whether the local residual can compute the storage term from the
+    /// intensive quantities of a cell alone, without an element context.
+    template <class LocalResidual, class Storage, class IntensiveQuantities, class = void>
+    struct HasIntensiveStorage : std::false_type {};
+
+    template <class LocalResidual, class Storage, class IntensiveQuantities>
+    struct HasIntensiveStorage<LocalResidual, Storage, IntensiveQuantities,
+                               std::void_t<decltype(LocalResidual::computeStorage(std::declval<Storage&>(),
+                                                                                  std::declval<const IntensiveQuantities&>()))>>
+        : std::true_type {};
 } // namespace Details
 
 namespace Amg
 {
+    /// Quasi-IMPES weights from the diagonal blocks of the matrix. The rows
+    /// are independent and processed in parallel, and the block solves use
+    /// the kernels for small blocks in SmallDenseMatrixUtils.
     template <class Matrix, class Vector>
     void getQuasiImpesWeights(const Matrix& matrix, const int pressureVarIndex, const bool transpose, Vector& weights)
     {
         using VectorBlockType = typename Vector::block_type;
         using MatrixBlockType = typename Matrix::block_type;
         const Matrix& A = matrix;
-        VectorBlockType rhs(0.0);
-        rhs[pressureVarIndex] = 1.0;
-        const auto endi = A.end();
-        for (auto i = A.begin(); i != endi; ++i) {
-            const auto endj = (*i).end();
-            MatrixBlockType diag_block(0.0);
-            for (auto j = (*i).begin(); j != endj; ++j) {
-                if (i.index() == j.index()) {
-                    diag_block = (*j);
-                    break;
-                }
-            }
+        const int numRows = A.N();
+        std::exception_ptr failure;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int row = 0; row < numRows; ++row) {
+            const auto& rowA = A[row];
+            const auto diag = rowA.find(row);
+            const MatrixBlockType diag_block = diag != rowA.end() ? *diag : MatrixBlockType(0.0);
             VectorBlockType bweights;
-            if (transpose) {
-                diag_block.solve(bweights, rhs);
-            } else {
-                auto diag_block_transpose = Details::transposeDenseMatrix(diag_block);
-                diag_block_transpose.solve(bweights, rhs);
+            // Singular blocks throw, and exceptions must not escape the
+            // parallel region. The first one is rethrown below.
+            try {
+                if (transpose) {
+                    detail::solveUnitVector<false>(diag_block, pressureVarIndex, bweights);
+                } else {
+                    detail::solveUnitVector<true>(diag_block, pressureVarIndex, bweights);
+                }
+            } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                continue;
             }
-            double abs_max = *std::max_element(
-                bweights.begin(), bweights.end(), [](double a, double b) { return std::fabs(a) < std::fabs(b); });
-            bweights /= std::fabs(abs_max);
-            weights[i.index()] = bweights;
+            Details::normalizeWeights(bweights);
+            weights[row] = bweights;
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
         }
-        // return weights;
     }
 
     template <class Matrix, class Vector>
@@ -87,47 +148,79 @@ namespace Amg
         return weights;
     }
 
+    /// True-IMPES weights from the storage terms of the conservation
+    /// equations. If the local residual can evaluate the storage from the
+    /// intensive quantities alone, the cells whose intensive quantities are
+    /// cached by the model are processed in parallel directly from the
+    /// cache. The intensive quantities of the other cells are recomputed
+    /// through the element context.
     template<class Vector, class GridView, class ElementContext, class Model>
     void getTrueImpesWeights(int pressureVarIndex, Vector& weights, const GridView& gridView,
                              ElementContext& elemCtx, const Model& model, std::size_t threadId)
     {
         using VectorBlockType = typename Vector::block_type;
-        using Matrix = typename std::decay_t<decltype(model.linearizer().jacobian())>;
-        using MatrixBlockType = typename Matrix::MatrixBlock;
         constexpr int numEq = VectorBlockType::size();
         using Evaluation = typename std::decay_t<decltype(model.localLinearizer(threadId).localResidual().residual(0))>
             ::block_type;
-        VectorBlockType rhs(0.0);
-        rhs[pressureVarIndex] = 1.0;
+        using LocalResidual = std::decay_t<decltype(model.localLinearizer(threadId).localResidual())>;
+        using IntensiveQuantities = std::remove_cv_t<std::remove_pointer_t<decltype(model.cachedIntensiveQuantities(0, 0))>>;
+        using Storage = Dune::FieldVector<Evaluation, numEq>;
+
+        // Cells whose weights were computed from the cached intensive quantities.
+        std::vector<char> cached(weights.size(), 0);
+        if constexpr (Details::HasIntensiveStorage<LocalResidual, Storage, IntensiveQuantities>::value) {
+            const int numCells = weights.size();
+            const double dt = elemCtx.simulator().timeStepSize();
+            std::exception_ptr failure;
+            OPM_BEGIN_PARALLEL_TRY_CATCH();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+            for (int cell = 0; cell < numCells; ++cell) {
+                const auto* intQuants = model.cachedIntensiveQuantities(cell, /*timeIdx=*/0);
+                if (!intQuants) {
+                    continue;
+                }
+                try {
+                    Storage storage;
+                    LocalResidual::computeStorage(storage, *intQuants);
+                    const double storage_scale = model.dofTotalVolume(cell) / dt;
+                    weights[cell] = Details::trueImpesBlockWeights<VectorBlockType>(storage, pressureVarIndex,
+                                                                                    storage_scale);
+                    cached[cell] = 1;
+                } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+                }
+            }
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
+            OPM_END_PARALLEL_TRY_CATCH("getTrueImpesWeights() failed: ", elemCtx.simulator().vanguard().grid().comm());
+        }
+
+        // The remaining cells. All ranks run the loop, as the parallel
+        // try-catch is collective.
         int index = 0;
         OPM_BEGIN_PARALLEL_TRY_CATCH();
         for (const auto& elem : elements(gridView)) {
+            if (cached[index]) {
+                ++index;
+                continue;
+            }
             elemCtx.updatePrimaryStencil(elem);
             elemCtx.updatePrimaryIntensiveQuantities(/*timeIdx=*/0);
-            Dune::FieldVector<Evaluation, numEq> storage;
+            Storage storage;
             model.localLinearizer(threadId).localResidual().computeStorage(storage,elemCtx,/*spaceIdx=*/0, /*timeIdx=*/0);
             auto extrusionFactor = elemCtx.intensiveQuantities(0, /*timeIdx=*/0).extrusionFactor();
             auto scvVolume = elemCtx.stencil(/*timeIdx=*/0).subControlVolume(0).volume() * extrusionFactor;
             auto storage_scale = scvVolume / elemCtx.simulator().timeStepSize();
-            MatrixBlockType block;
-            double pressure_scale = 50e5;
-            for (int ii = 0; ii < numEq; ++ii) {
-                for (int jj = 0; jj < numEq; ++jj) {
-                    block[ii][jj] = storage[ii].derivative(jj)/storage_scale;
-                    if (jj == pressureVarIndex) {
-                        block[ii][jj] *= pressure_scale;
-                    }
-                }
-            }
-            VectorBlockType bweights;
-            MatrixBlockType block_transpose = Details::transposeDenseMatrix(block);
-            block_transpose.solve(bweights, rhs);
-            double abs_max = *std::max_element(
-                bweights.begin(), bweights.end(), [](double a, double b) { return std::fabs(a) < std::fabs(b); });
-            // probably a scaling which could give approximately total compressibility would be better
-            bweights /=  std::fabs(abs_max); // given normal densities this scales weights to about 1.
-           
-            weights[index] = bweights;
+            weights[index] = Details::trueImpesBlockWeights<VectorBlockType>(storage, pressureVarIndex,
+                                                                             storage_scale);
             ++index;
         }
         OPM_END_PARALLEL_TRY_CATCH("getTrueImpesWeights() failed: ", elemCtx.simulator().vanguard().grid().comm());
@@ -23,6 +23,7 @@
 #include <opm/input/eclipse/Schedule/ScheduleState.hpp>
 #include <opm/input/eclipse/Units/Units.hpp>
 
+#include <opm/models/nonlinear/newtonmethodproperties.hh>
 #include <opm/models/utils/basicproperties.hh>
 #include <opm/models/utils/parametersystem.hh>
 #include <opm/models/utils/propertysystem.hh>
@@ -315,7 +316,7 @@ std::set<std::string> consistentlyFailingWells(const std::vector<StepReport>& sr
             EWOMS_REGISTER_PARAM(TypeTag, bool, FullTimeStepInitially,
                                  "Always attempt to finish a report step using a single substep");
             EWOMS_REGISTER_PARAM(TypeTag, std::string, TimeStepControl,
-                                 "The algorithm used to determine time-step sizes. valid options are: 'pid' (default), 'pid+iteration', 'pid+newtoniteration', 'iterationcount', 'newtoniterationcount' and 'hardcoded'");
+                                 "The algorithm used to determine time-step sizes. valid options are: 'pid' (default), 'pid+iteration', 'pid+newtoniteration', 'iterationcount', 'newtoniterationcount', 'predictive' and 'hardcoded'");
             EWOMS_REGISTER_PARAM(TypeTag, double, TimeStepControlTolerance,
                                  "The tolerance used by the time step size control algorithm");
             EWOMS_REGISTER_PARAM(TypeTag, int, TimeStepControlTargetIterations,
@@ -436,6 +437,16 @@ std::set<std::string> consistentlyFailingWells(const std::vector<StepReport>& sr
 
                 report += substepReport;
 
+                // create object to compute the time error, simply forwards the call to the model
+                SolutionTimeErrorSolverWrapperEbos<Solver> relativeChange(solver);
+
+                // iterations used by the time step control
+                const int iterations = useNewtonIteration_ ? substepReport.total_newton_iterations
+                    : substepReport.total_linear_iterations;
+
+                // let the controller keep track of converged and failed substeps
+                timeStepControl_->registerSubstep(substepReport, iterations, relativeChange);
+
                 bool continue_on_uncoverged_solution = ignoreConvergenceFailure_ && !substepReport.converged && dt <= minTimeStep_;
 
                 if (continue_on_uncoverged_solution) {
@@ -453,12 +464,7 @@ std::set<std::string> consistentlyFailingWells(const std::vector<StepReport>& sr
                     // advance by current dt
                     ++substepTimer;
 
-                    // create object to compute the time error, simply forwards the call to the model
-                    SolutionTimeErrorSolverWrapperEbos<Solver> relativeChange(solver);
-
                     // compute new time step estimate
-                    const int iterations = useNewtonIteration_ ? substepReport.total_newton_iterations
-                        : substepReport.total_linear_iterations;
                     double dtEstimate = timeStepControl_->computeTimeStepSize(dt, iterations, relativeChange,
                                                                                substepTimer.simulationTimeElapsed());
 
@@ -525,7 +531,7 @@ std::set<std::string> consistentlyFailingWells(const std::vector<StepReport>& sr
                     }
 
                     // The new, chopped timestep.
-                    const double newTimeStep = restartFactor_ * dt;
+                    const double newTimeStep = timeStepControl_->computeChoppedTimeStepSize(dt, restartFactor_);
 
 
                     // If we have restarted (i.e. cut the timestep) too
@@ -649,6 +655,9 @@ std::set<std::string> consistentlyFailingWells(const std::vector<StepReport>& sr
             case TimeStepControlType::PID:
                 allocAndSerialize<PIDTimeStepControl>(serializer);
                 break;
+            case TimeStepControlType::Predictive:
+                allocAndSerialize<PredictiveTimeStepControl>(serializer);
+                break;
             }
             serializer(restartFactor_);
             serializer(growthFactor_);
@@ -686,6 +695,11 @@ std::set<std::string> consistentlyFailingWells(const std::vector<StepReport>& sr
             return serializationTestObject_<SimpleIterationCountTimeStepControl>();
         }
 
+        static AdaptiveTimeSteppingEbos<TypeTag> serializationTestObjectPredictive()
+        {
+            return serializationTestObject_<PredictiveTimeStepControl>();
+        }
+
         bool operator==(const AdaptiveTimeSteppingEbos<TypeTag>& rhs)
         {
             if (timeStepControlType_ != rhs.timeStepControlType_ ||
@@ -708,6 +722,9 @@ std::set<std::string> consistentlyFailingWells(const std::vector<StepReport>& sr
             case TimeStepControlType::PID:
                 result = castAndComp<PIDTimeStepControl>(rhs);
                 break;
+            case TimeStepControlType::Predictive:
+                result = castAndComp<PredictiveTimeStepControl>(rhs);
+                break;
             }
 
             return result &&
@@ -812,6 +829,13 @@ std::set<std::string> consistentlyFailingWells(const std::vector<StepReport>& sr
                 useNewtonIteration_ = true;
                 timeStepControlType_ = TimeStepControlType::SimpleIterationCount;
             }
+            else if (control == "predictive") {
+                const int iterations =  EWOMS_GET_PARAM(TypeTag, int, TimeStepControlTargetNewtonIterations); // 8
+                const int maxIterations = EWOMS_GET_PARAM(TypeTag, int, NewtonMaxIterations); // 20
+                timeStepControl_ = std::make_unique<PredictiveTimeStepControl>(iterations, maxIterations, tol);
+                useNewtonIteration_ = true;
+                timeStepControlType_ = TimeStepControlType::Predictive;
+            }
             else if (control == "hardcoded") {
                 const std::string filename = EWOMS_GET_PARAM(TypeTag, std::string, TimeStepControlFileName); // "timesteps"
                 timeStepControl_ = std::make_unique<HardcodedTimeStepControl>(filename);
@@ -34,8 +34,8 @@ namespace Opm
     {
         return SimulatorReportSingle{1.0, 2.0, 3.0, 4.0, 5.0, 6.0,
                                      7.0, 8.0, 9.0, 10.0, 11.0,
-                                     12, 13, 14, 15, 16, 17,
-                                     true, false, 18, 19.0, 20.0};
+                                     12, 13, 14, 15, 16, 17, 18, 19,
+                                     true, false, 20, 21.0, 22.0};
     }
 
     bool SimulatorReportSingle::operator==(const SimulatorReportSingle& rhs) const
@@ -57,6 +57,8 @@ namespace Opm
                this->total_linear_iterations == rhs.total_linear_iterations &&
                this->min_linear_iterations == rhs.min_linear_iterations &&
                this->max_linear_iterations == rhs.max_linear_iterations &&
+               this->total_well_inner_solves == rhs.total_well_inner_solves &&
+               this->skipped_well_inner_solves == rhs.skipped_well_inner_solves &&
                this->converged == rhs.converged &&
                this->well_group_control_changed == rhs.well_group_control_changed &&
                this->exit_status == rhs.exit_status &&
@@ -85,6 +87,9 @@ namespace Opm
             min_linear_iterations = std::min(min_linear_iterations, sr.total_linear_iterations);
         }
         max_linear_iterations = std::max(max_linear_iterations, sr.total_linear_iterations);
+        total_well_inner_solves += sr.total_well_inner_solves;
+        skipped_well_inner_solves += sr.skipped_well_inner_solves;
+        well_group_control_changed = well_group_control_changed || sr.well_group_control_changed;
 
         // It makes no sense adding time points. Therefore, do not 
         // overwrite the value of global_time which gets set in 
@@ -206,6 +211,15 @@ namespace Opm
                             100.0*failureReport->total_linear_iterations/noZero(n));
         }
         os << std::endl;
+
+        n = total_well_inner_solves + (failureReport ? failureReport->total_well_inner_solves : 0);
+        if (n > 0) {
+            const int skipped = skipped_well_inner_solves
+                              + (failureReport ? failureReport->skipped_well_inner_solves : 0);
+            os << fmt::format("Well Inner Solves:         {:7}    (Skipped: {:3}; {:2.1f}%)",
+                              n, skipped, 100.0*skipped/n);
+            os << std::endl;
+        }
     }
 
     SimulatorReport SimulatorReport::serializationTestObject()
@@ -50,6 +50,8 @@ namespace Opm
         unsigned int total_linear_iterations = 0;
         unsigned int min_linear_iterations = std::numeric_limits<unsigned int>::max();
         unsigned int max_linear_iterations = 0;
+        unsigned int total_well_inner_solves = 0;
+        unsigned int skipped_well_inner_solves = 0;
 
         bool converged = false;
         bool well_group_control_changed = false;
@@ -88,6 +90,8 @@ namespace Opm
             serializer(total_linear_iterations);
             serializer(min_linear_iterations);
             serializer(max_linear_iterations);
+            serializer(total_well_inner_solves);
+            serializer(skipped_well_inner_solves);
             serializer(converged);
             serializer(well_group_control_changed);
             serializer(exit_status);
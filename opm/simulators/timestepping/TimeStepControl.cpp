@@ -32,6 +32,7 @@
 #include <opm/common/ErrorMacros.hpp>
 #include <opm/common/OpmLog/OpmLog.hpp>
 #include <opm/input/eclipse/Units/Units.hpp>
+#include <opm/simulators/timestepping/SimulatorReport.hpp>
 #include <opm/simulators/timestepping/TimeStepControl.hpp>
 
 #include <fmt/format.h>
@@ -279,4 +280,207 @@ namespace Opm
                this->minTimeStepBasedOnIterations_ == ctrl.minTimeStepBasedOnIterations_;
     }
 
+    ////////////////////////////////////////////////////////////
+    //
+    //  PredictiveTimeStepControl  Implementation
+    //
+    ////////////////////////////////////////////////////////////
+
+    PredictiveTimeStepControl::
+    PredictiveTimeStepControl( const int target_iterations,
+                               const int max_iterations,
+                               const double tol,
+                               const std::size_t history_length,
+                               const bool verbose )
+        : target_iterations_( target_iterations )
+        , max_iterations_( max_iterations )
+        , tol_( tol )
+        , history_length_( history_length )
+        , verbose_( verbose )
+    {
+        if( target_iterations_ < 1 || max_iterations_ <= target_iterations_ ) {
+            OPM_THROW(std::runtime_error,
+                      "PredictiveTimeStepControl: the target number of iterations (" +
+                      std::to_string(target_iterations_) + ") should be positive and less "
+                      "than the maximum number of iterations (" + std::to_string(max_iterations_) + ")");
+        }
+        if( history_length_ < 2 ) {
+            OPM_THROW(std::runtime_error,
+                      "PredictiveTimeStepControl: history length should be >= 2 " +
+                      std::to_string(history_length_));
+        }
+    }
+
+    PredictiveTimeStepControl
+    PredictiveTimeStepControl::serializationTestObject()
+    {
+        PredictiveTimeStepControl result(4, 10, 0.5, 3, true);
+        result.dts_ = {1.0, 2.0};
+        result.iterations_ = {3.0, 4.0};
+        result.errors_ = {0.1, 0.2};
+        result.failedDt_ = 5.0;
+        result.controlChanged_ = true;
+
+        return result;
+    }
+
+    void PredictiveTimeStepControl::
+    registerSubstep( const SimulatorReportSingle& report, const int iterations, const RelativeChangeInterface& relChange )
+    {
+        controlChanged_ = report.well_group_control_changed;
+        const double dt = report.timestep_length;
+        if( !report.converged ) {
+            if( dt > 0.0 ) {
+                failedDt_ = failedDt_ > 0.0 ? std::min(failedDt_, dt) : dt;
+            }
+            return;
+        }
+
+        dts_.push_back(dt);
+        iterations_.push_back(iterations);
+        errors_.push_back(relChange.relativeChange());
+        if( dts_.size() > history_length_ ) {
+            dts_.erase(dts_.begin());
+            iterations_.erase(iterations_.begin());
+            errors_.erase(errors_.begin());
+        }
+
+        // relax the bound from failed substeps while steps converge, and
+        // forget it once it is far away
+        if( failedDt_ > 0.0 ) {
+            failedDt_ *= 1.05;
+            if( failedDt_ > 16.0 * dt ) {
+                failedDt_ = 0.0;
+            }
+        }
+    }
+
+    bool PredictiveTimeStepControl::
+    fit_( double& a, double& b ) const
+    {
+        const std::size_t n = dts_.size();
+        if( n < 2 ) {
+            return false;
+        }
+
+        double xMean = 0.0;
+        double yMean = 0.0;
+        for( std::size_t i = 0; i < n; ++i ) {
+            xMean += std::log(dts_[i]);
+            yMean += iterations_[i];
+        }
+        xMean /= n;
+        yMean /= n;
+
+        double sxx = 0.0;
+        double sxy = 0.0;
+        for( std::size_t i = 0; i < n; ++i ) {
+            const double dx = std::log(dts_[i]) - xMean;
+            sxx += dx * dx;
+            sxy += dx * (iterations_[i] - yMean);
+        }
+
+        // the step sizes must differ by a few percent to determine the slope
+        if( sxx < 1e-4 * n ) {
+            return false;
+        }
+
+        b = sxy / sxx;
+        a = yMean - b * xMean;
+
+        // iterations that do not increase with the step size give no
+        // information about where to stop
+        return b > 0.0;
+    }
+
+    double PredictiveTimeStepControl::
+    expectedCost_( const double dt, const double a, const double b ) const
+    {
+        const double iterations = std::max(1.0, a + b * std::log(dt));
+
+        // the probability of a failure grows linearly from zero at the target
+        // to one at the maximum number of iterations, and from zero at half the
+        // size of a recently failed substep to one at its size
+        double pFail = std::clamp((iterations - target_iterations_) / (max_iterations_ - target_iterations_), 0.0, 1.0);
+        if( failedDt_ > 0.0 ) {
+            pFail = std::max(pFail, std::clamp(2.0 * dt / failedDt_ - 1.0, 0.0, 1.0));
+        }
+        if( pFail >= 1.0 ) {
+            return std::numeric_limits<double>::max();
+        }
+
+        // a failure costs the maximum number of iterations without advancing in time
+        return ((1.0 - pFail) * iterations + pFail * max_iterations_) / ((1.0 - pFail) * dt);
+    }
+
+    double PredictiveTimeStepControl::
+    computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& relChange, const double /*simulationTimeElapsed */) const
+    {
+        double a = 0.0;
+        double b = 0.0;
+        if( !fit_(a, b) ) {
+            // assume two more iterations for each doubling of the step size
+            b = 2.0 / std::log(2.0);
+            a = iterations - b * std::log(dt);
+        }
+
+        // candidate step sizes from dt/4 to 4*dt
+        double newDt = 0.25 * dt;
+        double bestCost = std::numeric_limits<double>::max();
+        for( int k = -8; k <= 8; ++k ) {
+            const double candidate = dt * std::pow(2.0, 0.25 * k);
+            const double cost = expectedCost_(candidate, a, b);
+            if( cost < bestCost ) {
+                bestCost = cost;
+                newDt = candidate;
+            }
+        }
+
+        // the iteration count after a control switch is not representative
+        if( controlChanged_ ) {
+            newDt = std::min(newDt, dt);
+        }
+
+        // respect the tolerance of the relative change as in the PID control
+        const double error = relChange.relativeChange();
+        if( error > tol_ ) {
+            newDt = std::min(newDt, dt * tol_ / error);
+        }
+
+        if( verbose_ ) {
+            OpmLog::info(fmt::format("Computed step size (predictive): {} days", unit::convert::to( newDt, unit::day )));
+        }
+
+        return newDt;
+    }
+
+    double PredictiveTimeStepControl::
+    computeChoppedTimeStepSize( const double dt, const double restartFactor ) const
+    {
+        double a = 0.0;
+        double b = 0.0;
+        if( !fit_(a, b) ) {
+            return restartFactor * dt;
+        }
+
+        // cut to the step size predicted to need the target number of
+        // iterations, but at least by restartFactor and at most by its square
+        const double dtTarget = std::exp((target_iterations_ - a) / b);
+        return std::clamp(dtTarget, restartFactor * restartFactor * dt, restartFactor * dt);
+    }
+
+    bool PredictiveTimeStepControl::operator==(const PredictiveTimeStepControl& ctrl) const
+    {
+        return this->target_iterations_ == ctrl.target_iterations_ &&
+               this->max_iterations_ == ctrl.max_iterations_ &&
+               this->tol_ == ctrl.tol_ &&
+               this->history_length_ == ctrl.history_length_ &&
+               this->verbose_ == ctrl.verbose_ &&
+               this->dts_ == ctrl.dts_ &&
+               this->iterations_ == ctrl.iterations_ &&
+               this->errors_ == ctrl.errors_ &&
+               this->failedDt_ == ctrl.failedDt_ &&
+               this->controlChanged_ == ctrl.controlChanged_;
+    }
+
 } // end namespace Opm
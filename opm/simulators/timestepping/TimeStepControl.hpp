@@ -23,6 +23,7 @@
 
 #include <opm/simulators/timestepping/TimeStepControlInterface.hpp>
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -32,7 +33,8 @@ namespace Opm
       SimpleIterationCount,
       PID,
       PIDAndIterationCount,
-      HardCodedTimeStep
+      HardCodedTimeStep,
+      Predictive
     };
 
     ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -211,6 +213,86 @@ namespace Opm
         std::vector<double> subStepTime_;
     };
 
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    ///
+    ///  Predictive time step control.
+    ///
+    ///  Keeps a short history of converged substeps (size, Newton iterations and relative
+    ///  change) and fits the Newton iteration count as a + b*log(dt). The next step size is
+    ///  chosen among candidate sizes to minimize the expected number of Newton iterations per
+    ///  simulated time, where a failed attempt costs the maximum number of iterations plus
+    ///  the retry. Failed substeps impose an upper bound that is relaxed gradually as steps
+    ///  converge again, and no growth is allowed directly after well/group control switches
+    ///  since the iteration count of such steps is not representative.
+    ///
+    ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+    class PredictiveTimeStepControl : public TimeStepControlInterface
+    {
+    public:
+        static constexpr TimeStepControlType Type = TimeStepControlType::Predictive;
+        PredictiveTimeStepControl() = default;
+
+        /// \brief constructor
+        /// \param target_iterations  number of desired Newton iterations per time step
+        /// \param max_iterations     maximum number of Newton iterations before a time step fails
+        /// \param tol                tolerance for the relative changes of the numerical solution
+        /// \param history_length     number of converged substeps used for the prediction
+        /// \param verbose            if true get some output (default = false)
+        PredictiveTimeStepControl( const int target_iterations,
+                                   const int max_iterations,
+                                   const double tol = 1e-1,
+                                   const std::size_t history_length = 8,
+                                   const bool verbose = false );
+
+        static PredictiveTimeStepControl serializationTestObject();
+
+        /// \brief \copydoc TimeStepControlInterface::computeTimeStepSize
+        double computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& relativeChange, const double /*simulationTimeElapsed */ ) const;
+
+        /// \brief \copydoc TimeStepControlInterface::registerSubstep
+        void registerSubstep( const SimulatorReportSingle& report, const int iterations, const RelativeChangeInterface& relativeChange );
+
+        /// \brief \copydoc TimeStepControlInterface::computeChoppedTimeStepSize
+        double computeChoppedTimeStepSize( const double dt, const double restartFactor ) const;
+
+        template<class Serializer>
+        void serializeOp(Serializer& serializer)
+        {
+            serializer(target_iterations_);
+            serializer(max_iterations_);
+            serializer(tol_);
+            serializer(history_length_);
+            serializer(verbose_);
+            serializer(dts_);
+            serializer(iterations_);
+            serializer(errors_);
+            serializer(failedDt_);
+            serializer(controlChanged_);
+        }
+
+        bool operator==(const PredictiveTimeStepControl&) const;
+
+    protected:
+        /// fit iterations = a + b*log(dt) to the history, returns false if
+        /// the history does not determine the slope
+        bool fit_(double& a, double& b) const;
+
+        /// expected Newton iterations per simulated time for a step of size dt
+        double expectedCost_(const double dt, const double a, const double b) const;
+
+        int target_iterations_ = 8;
+        int max_iterations_ = 20;
+        double tol_ = 1e-1;
+        std::size_t history_length_ = 8;
+        bool verbose_ = false;
+
+        std::vector<double> dts_{};        //!< sizes of recent converged substeps
+        std::vector<double> iterations_{}; //!< Newton iterations of recent converged substeps
+        std::vector<double> errors_{};     //!< relative changes of recent converged substeps
+        double failedDt_ = 0.0;            //!< upper bound from failed substeps (0 if none)
+        bool controlChanged_ = false;      //!< well/group controls changed in the last substep
+    };
+
 
 } // end namespace Opm
 #endif
@@ -22,6 +22,7 @@
 
 namespace Opm
 {
+    struct SimulatorReportSingle;
 
     ///////////////////////////////////////////////////////////////////
     ///
@@ -58,6 +59,25 @@ namespace Opm
         /// \return suggested time step size for the next step
         virtual double computeTimeStepSize( const double dt, const int iterations, const RelativeChangeInterface& relativeChange , const double simulationTimeElapsed) const = 0;
 
+        /// register the outcome of a substep, converged or not, before any
+        /// call to computeTimeStepSize() for that substep. Controllers that only
+        /// look at the last step ignore this information.
+        /// \param report          report of the substep
+        /// \param iterations      number of iterations used (linear/nonlinear)
+        /// \param relativeChange  object to compute || u^n+1 - u^n || / || u^n+1 ||,
+        ///                        only meaningful for converged substeps
+        virtual void registerSubstep( const SimulatorReportSingle& /* report */,
+                                      const int /* iterations */,
+                                      const RelativeChangeInterface& /* relativeChange */ ) {}
+
+        /// compute the time step size to retry with after a failed substep
+        /// \param dt             time step size of the failed substep
+        /// \param restartFactor  default reduction factor (e.g. from TUNING)
+        ///
+        /// \return time step size for the next attempt
+        virtual double computeChoppedTimeStepSize( const double dt, const double restartFactor ) const
+        { return restartFactor * dt; }
+
         /// virtual destructor (empty)
         virtual ~TimeStepControlInterface () {}
     };
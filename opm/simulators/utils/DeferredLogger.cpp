@@ -95,4 +95,9 @@ namespace Opm
         messages_.clear();
     }
 
+    void DeferredLogger::append(const DeferredLogger& other)
+    {
+        messages_.insert(messages_.end(), other.messages_.begin(), other.messages_.end());
+    }
+
 } // namespace Opm
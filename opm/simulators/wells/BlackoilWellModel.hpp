@@ -29,6 +29,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <optional>
@@ -346,6 +347,23 @@ namespace Opm {
                 return well_container_;
             }
 
+            /// \brief Counter of the reservoir states the wells were assembled for.
+            /// \details Incremented whenever the well model is entered with a
+            /// possibly updated reservoir state, so quantities the wells compute
+            /// from the perforated cells stay valid while it is unchanged.
+            std::uint64_t reservoirStateStamp() const
+            {
+                return reservoir_state_stamp_;
+            }
+
+            /// \brief Counter of the well containers created.
+            /// \details Incremented whenever localNonshutWells() is rebuilt, so
+            /// data derived from the wells and their cells stays valid until then.
+            std::uint64_t wellContainerStamp() const
+            {
+                return well_container_stamp_;
+            }
+
             // prototype for assemble function for ASPIN solveLocal()
             // will try to merge back to assemble() when done prototyping
             void assembleDomain(const int iterationIdx,
@@ -417,6 +435,13 @@ namespace Opm {
             // Keep track of the domain of each well, if using subdomains.
             std::map<std::string, int> well_domain_;
 
+            // Groups of wells in the well container without common cells,
+            // used to add the well contributions to the matrix concurrently.
+            std::vector<std::vector<int>> well_contribution_groups_;
+
+            std::uint64_t reservoir_state_stamp_ = 0;
+            std::uint64_t well_container_stamp_ = 0;
+
             const Grid& grid() const
             { return ebosSimulator_.vanguard().grid(); }
 
@@ -444,6 +469,11 @@ namespace Opm {
                                               const double dt,
                                               DeferredLogger& local_deferredLogger);
 
+            // derivatives of the production rates of the network leaf nodes with
+            // respect to their pressures from the local wells under THP control.
+            std::map<std::string, std::vector<double>>
+            networkLeafRateSensitivities(const int reportStepIdx) const;
+
             /// Update rank's notion of intersecting wells and their
             /// associate solution variables.
             ///
@@ -491,6 +521,8 @@ namespace Opm {
 
             void computePotentials(const std::size_t widx,
                                    const WellState& well_state_copy,
+                                   const bool allow_reuse,
+                                   std::vector<double>& potentials,
                                    std::string& exc_msg,
                                    ExceptionType::ExcEnum& exc_type,
                                    DeferredLogger& deferred_logger) override;
@@ -522,11 +554,16 @@ namespace Opm {
                 GasLiftGroupInfo &group_info, GLiftWellStateMap &state_map);
 
             // cannot be const since it accesses the non-const WellState
+            // Computes the bhp at the THP limit for lift gas rates around the
+            // current ones, concurrently for the wells.
+            void gasLiftTabulateLiftCurves(
+                std::vector<std::pair<WellInterface<TypeTag>*, std::unique_ptr<GasLiftSingleWell>>>& glift_candidates,
+                DeferredLogger& deferred_logger);
+
             void gasLiftOptimizationStage1SingleWell(WellInterface<TypeTag> *well,
-                DeferredLogger& deferred_logger,
+                std::unique_ptr<GasLiftSingleWell> glift,
                 GLiftProdWells &prod_wells, GLiftOptWells &glift_wells,
-                GasLiftGroupInfo &group_info, GLiftWellStateMap &state_map,
-                GLiftSyncGroups& groups_to_sync);
+                GLiftWellStateMap &state_map);
 
             void extractLegacyCellPvtRegionIndex_();
 
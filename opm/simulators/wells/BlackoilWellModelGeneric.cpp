@@ -67,6 +67,7 @@
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -286,6 +287,19 @@ initializeWellProdIndCalculators()
     }
 }
 
+void
+BlackoilWellModelGeneric::
+initializeAggregatedWellSum(const int reportStepIdx)
+{
+    std::vector<int> well_indices;
+    well_indices.reserve(wells_ecl_.size());
+    for (const auto& well : wells_ecl_) {
+        well_indices.push_back(well.seqIndex());
+    }
+    aggregated_well_sum_.reset(well_indices, local_parallel_well_info_,
+                               schedule().numWells(reportStepIdx), comm_);
+}
+
 void
 BlackoilWellModelGeneric::
 initializeWellPerfData()
@@ -534,23 +548,19 @@ checkGconsaleLimits(const Group& group,
         deferred_logger.info(ss);
 }
 
-bool
+int
 BlackoilWellModelGeneric::
-checkGroupHigherConstraints(const Group& group,
-                            DeferredLogger& deferred_logger,
-                            const int reportStepIdx)
+groupConversionPvtRegion() const
 {
     // Set up coefficients for RESV <-> surface rate conversion.
     // Use the pvtRegionIdx from the top cell of the first well.
     // TODO fix this!
     // This is only used for converting RESV rates.
     // What is the proper approach?
-    const int fipnum = 0;
     int pvtreg = well_perf_data_.empty() || well_perf_data_[0].empty()
         ? pvt_region_idx_[0]
         : pvt_region_idx_[well_perf_data_[0][0].cell_index];
 
-    bool changed = false;
     if ( comm_.size() > 1)
     {
         // Just like in the sequential case the pvtregion is determined
@@ -565,6 +575,58 @@ checkGroupHigherConstraints(const Group& group,
                                   [](const auto& p1, const auto& p2){ return p1.second < p2.second;})
             ->first;
     }
+    return pvtreg;
+}
+
+std::map<std::string, std::vector<double>>
+BlackoilWellModelGeneric::
+groupSurfaceRates(const std::vector<const Group*>& groups,
+                  const int reportStepIdx) const
+{
+    const int np = phase_usage_.num_phases;
+    std::vector<const Group*> all_groups;
+    std::vector<const Group*> stack(groups.rbegin(), groups.rend());
+    while (!stack.empty()) {
+        const Group* group = stack.back();
+        stack.pop_back();
+        all_groups.push_back(group);
+        const auto& children = group->groups();
+        for (auto it = children.rbegin(); it != children.rend(); ++it) {
+            stack.push_back(&schedule().getGroup(*it, reportStepIdx));
+        }
+    }
+
+    std::vector<double> local_rates(all_groups.size() * 2 * np, 0.0);
+    for (std::size_t g = 0; g < all_groups.size(); ++g) {
+        for (int phasePos = 0; phasePos < np; ++phasePos) {
+            local_rates[(2 * g) * np + phasePos] =
+                WellGroupHelpers::sumWellSurfaceRates(*all_groups[g], schedule(), this->wellState(), reportStepIdx, phasePos, /* isInjector */ true);
+            local_rates[(2 * g + 1) * np + phasePos] =
+                WellGroupHelpers::sumWellSurfaceRates(*all_groups[g], schedule(), this->wellState(), reportStepIdx, phasePos, /* isInjector */ false);
+        }
+    }
+    // Sum over all processes
+    comm_.sum(local_rates.data(), local_rates.size());
+
+    std::map<std::string, std::vector<double>> rates;
+    for (std::size_t g = 0; g < all_groups.size(); ++g) {
+        rates.insert_or_assign(all_groups[g]->name(),
+                               std::vector<double>(local_rates.begin() + 2 * g * np,
+                                                   local_rates.begin() + 2 * (g + 1) * np));
+    }
+    return rates;
+}
+
+bool
+BlackoilWellModelGeneric::
+checkGroupHigherConstraints(const Group& group,
+                            DeferredLogger& deferred_logger,
+                            const int reportStepIdx,
+                            const int pvtreg,
+                            const std::vector<double>& surface_rates)
+{
+    const int fipnum = 0;
+    bool changed = false;
 
     std::vector<double> rates(phase_usage_.num_phases, 0.0);
 
@@ -575,9 +637,7 @@ checkGroupHigherConstraints(const Group& group,
         calcInjRates(fipnum, pvtreg, resv_coeff_inj);
 
         for (int phasePos = 0; phasePos < phase_usage_.num_phases; ++phasePos) {
-            const double local_current_rate = WellGroupHelpers::sumWellSurfaceRates(group, schedule(), this->wellState(), reportStepIdx, phasePos, /* isInjector */ true);
-            // Sum over all processes
-            rates[phasePos] = comm_.sum(local_current_rate);
+            rates[phasePos] = surface_rates[phasePos];
         }
         const Phase all[] = { Phase::WATER, Phase::OIL, Phase::GAS };
         for (Phase phase : all) {
@@ -617,9 +677,7 @@ checkGroupHigherConstraints(const Group& group,
     if (!isField && group.isProductionGroup()) {
         // Obtain rates for group.
         for (int phasePos = 0; phasePos < phase_usage_.num_phases; ++phasePos) {
-            const double local_current_rate = WellGroupHelpers::sumWellSurfaceRates(group, schedule(), this->wellState(), reportStepIdx, phasePos, /* isInjector */ false);
-            // Sum over all processes
-            rates[phasePos] = -comm_.sum(local_current_rate);
+            rates[phasePos] = -surface_rates[phase_usage_.num_phases + phasePos];
         }
         std::vector<double> resv_coeff(phase_usage_.num_phases, 0.0);
         calcRates(fipnum, pvtreg, this->groupState().production_rates(group.name()), resv_coeff);
@@ -960,9 +1018,10 @@ updateAndCommunicateGroupData(const int reportStepIdx,
 
     // Set ALQ for off-process wells to zero
     for (const auto& wname : schedule().wellNames(reportStepIdx)) {
-        const bool is_producer = schedule().getWell(wname, reportStepIdx).isProducer();
-        const bool not_on_this_process = !well_state.has(wname);
-        if (is_producer && not_on_this_process) {
+        if (well_state.has(wname)) {
+            continue;
+        }
+        if (schedule().getWell(wname, reportStepIdx).isProducer()) {
             well_state.setALQ(wname, 0.0);
         }
     }
@@ -1057,7 +1116,9 @@ inferLocalShutWells()
 
 double
 BlackoilWellModelGeneric::
-updateNetworkPressures(const int reportStepIdx)
+updateNetworkPressures(const int reportStepIdx,
+                       const std::map<std::string, std::vector<double>>& leaf_sensitivities,
+                       const int max_newton_iterations)
 {
     // Get the network and return if inactive.
     const auto& network = schedule()[reportStepIdx].network();
@@ -1067,12 +1128,55 @@ updateNetworkPressures(const int reportStepIdx)
 
     const auto previous_node_pressures = node_pressures_;
 
-    node_pressures_ = WellGroupHelpers::computeNetworkPressures(network,
-                                                                this->wellState(),
-                                                                this->groupState(),
-                                                                *(vfp_properties_->getProd()),
-                                                                schedule(),
-                                                                reportStepIdx);
+    // The Newton method needs the previous pressures the well rates
+    // respond to, and converges to the balanced network for the
+    // linearized well responses, so its update is not dampened.
+    bool newton_converged = false;
+    if (max_newton_iterations > 0 && !previous_node_pressures.empty()) {
+        // The nodes are the same on all processes, the wells are not.
+        const int np = numPhases();
+        std::vector<double> sensitivities(previous_node_pressures.size() * np, 0.0);
+        std::size_t offset = 0;
+        for (const auto& item : previous_node_pressures) {
+            const auto it = leaf_sensitivities.find(item.first);
+            if (it != leaf_sensitivities.end()) {
+                std::copy(it->second.begin(), it->second.end(), sensitivities.begin() + offset);
+            }
+            offset += np;
+        }
+        comm_.sum(sensitivities.data(), sensitivities.size());
+
+        std::map<std::string, std::vector<double>> node_sensitivities;
+        offset = 0;
+        for (const auto& item : previous_node_pressures) {
+            node_sensitivities[item.first].assign(sensitivities.begin() + offset,
+                                                  sensitivities.begin() + offset + np);
+            offset += np;
+        }
+
+        auto node_pressures = WellGroupHelpers::computeNetworkPressuresNewton(network,
+                                                                              this->wellState(),
+                                                                              this->groupState(),
+                                                                              *(vfp_properties_->getProd()),
+                                                                              schedule(),
+                                                                              reportStepIdx,
+                                                                              previous_node_pressures,
+                                                                              node_sensitivities,
+                                                                              max_newton_iterations,
+                                                                              schedule()[reportStepIdx].network_balance().pressure_tolerance());
+        if (!node_pressures.empty()) {
+            node_pressures_ = std::move(node_pressures);
+            newton_converged = true;
+        }
+    }
+    if (!newton_converged) {
+        node_pressures_ = WellGroupHelpers::computeNetworkPressures(network,
+                                                                    this->wellState(),
+                                                                    this->groupState(),
+                                                                    *(vfp_properties_->getProd()),
+                                                                    schedule(),
+                                                                    reportStepIdx);
+    }
 
     // here, the network imbalance is the difference between the previous nodal pressure and the new nodal pressure
     double network_imbalance = 0.;
@@ -1084,6 +1188,9 @@ updateNetworkPressures(const int reportStepIdx)
             if (std::abs(change) > network_imbalance) {
                 network_imbalance = std::abs(change);
             }
+            if (newton_converged) {
+                continue;
+            }
             // we dampen the amount of the nodal pressure can change during one iteration
             // due to the fact our nodal pressure calculation is somewhat explicit
             // TODO: the following parameters are subject to adjustment for optimization purpose
@@ -1238,6 +1345,9 @@ updateWellPotentials(const int reportStepIdx,
     const bool write_restart_file = schedule().write_rst_file(reportStepIdx);
     auto exc_type = ExceptionType::NONE;
     std::string exc_msg;
+    // Wells to compute the potentials for, and whether the last
+    // potentials may be reused if the conditions changed little.
+    std::vector<std::pair<std::size_t, bool>> wells_to_compute;
     std::size_t widx = 0;
     for (const auto& well : well_container_generic_) {
         const bool needed_for_summary =
@@ -1278,10 +1388,65 @@ updateWellPotentials(const int reportStepIdx,
         const bool compute_potential = needPotentialsForOutput || needPotentialsForGuideRates;
         if (compute_potential)
         {
-            this->computePotentials(widx, well_state_copy, exc_msg, exc_type, deferred_logger);
+            wells_to_compute.emplace_back(widx, !event);
         }
         ++widx;
     }
+
+    // The potential of a well only depends on the reservoir state and the
+    // well state of the previous iteration, which are not modified before
+    // all potentials are computed, so the wells are independent. Wells
+    // perforating several processes communicate while computing their
+    // potentials, they are computed one at a time in the same order on
+    // all processes.
+    well_potential_cache_.resize(wells_ecl_.size());
+    const int num_compute = wells_to_compute.size();
+    std::vector<std::vector<double>> potentials(num_compute);
+    std::vector<DeferredLogger> loggers(num_compute);
+    std::vector<ExceptionType::ExcEnum> exc_types(num_compute, ExceptionType::NONE);
+    std::vector<std::string> exc_msgs(num_compute);
+    auto distributed = [this, &wells_to_compute](const int i)
+    {
+        const auto* well = well_container_generic_[wells_to_compute[i].first];
+        return well->parallelWellInfo().communication().size() > 1;
+    };
+    auto compute = [&](const int i)
+    {
+        // The reuse decision is local, distributed wells could end up
+        // skipping the communication on some processes only.
+        const auto [well_idx, allow_reuse] = wells_to_compute[i];
+        this->computePotentials(well_idx, well_state_copy, allow_reuse && !distributed(i),
+                                potentials[i], exc_msgs[i], exc_types[i], loggers[i]);
+    };
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int i = 0; i < num_compute; ++i) {
+        if (!distributed(i)) {
+            compute(i);
+        }
+    }
+    for (int i = 0; i < num_compute; ++i) {
+        if (distributed(i)) {
+            compute(i);
+        }
+    }
+
+    // Store the potentials in the well state after all are computed, such
+    // that every well starts from the potentials of the previous step.
+    const int np = this->numPhases();
+    for (int i = 0; i < num_compute; ++i) {
+        auto& ws = this->wellState().well(well_container_generic_[wells_to_compute[i].first]->indexOfWell());
+        for (int p = 0; p < np; ++p) {
+            // make sure the potentials are positive
+            ws.well_potentials[p] = std::max(0.0, potentials[i][p]);
+        }
+        deferred_logger.append(loggers[i]);
+        if (exc_types[i] != ExceptionType::NONE) {
+            exc_type = exc_types[i];
+            exc_msg = exc_msgs[i];
+        }
+    }
     logAndCheckForExceptionsAndThrow(deferred_logger, exc_type,
                                      "computeWellPotentials() failed: " + exc_msg,
                                      terminal_output_, comm_);
@@ -35,6 +35,7 @@
 
 #include <opm/simulators/wells/ParallelPAvgDynamicSourceData.hpp>
 #include <opm/simulators/wells/ParallelWBPCalculation.hpp>
+#include <opm/simulators/wells/ParallelWellInfo.hpp>
 #include <opm/simulators/wells/PerforationData.hpp>
 #include <opm/simulators/wells/WellFilterCake.hpp>
 #include <opm/simulators/wells/WellProdIndexCalculator.hpp>
@@ -157,11 +158,12 @@ public:
       Will assign the internal member last_valid_well_state_ to the
       current value of the this->active_well_state_. The state stored
       with storeWellState() can then subsequently be recovered with the
-      resetWellState() method.
+      resetWellState() method. Only the wells modified since the states
+      were last synchronized are copied.
     */
     void commitWGState()
     {
-        this->last_valid_wgstate_ = this->active_wgstate_;
+        this->last_valid_wgstate_.syncFrom(this->active_wgstate_);
     }
 
     data::GroupAndNetworkValues groupAndNetworkData(const int reportStepIdx) const;
@@ -296,7 +298,7 @@ protected:
     */
     void resetWGState()
     {
-        this->active_wgstate_ = this->last_valid_wgstate_;
+        this->active_wgstate_.syncFrom(this->last_valid_wgstate_);
     }
 
     /*
@@ -306,7 +308,7 @@ protected:
     */
     void updateNupcolWGState()
     {
-        this->nupcol_wgstate_ = this->active_wgstate_;
+        this->nupcol_wgstate_.syncFrom(this->active_wgstate_);
     }
 
     /// \brief Create the parallel well information
@@ -316,9 +318,18 @@ protected:
     void initializeWellProdIndCalculators();
     void initializeWellPerfData();
 
+    /// Assigns the distributed local wells their slots for aggregated sums.
+    void initializeAggregatedWellSum(const int reportStepIdx);
+
     bool wasDynamicallyShutThisTimeStep(const int well_index) const;
 
-    double updateNetworkPressures(const int reportStepIdx);
+    /// Updates the network node pressures. With a positive number of Newton
+    /// iterations the pressures are solved for with the rates of the leaf
+    /// nodes linearized by the given local rate derivatives with respect to
+    /// the node pressures, falling back to damped explicit updates otherwise.
+    double updateNetworkPressures(const int reportStepIdx,
+                                  const std::map<std::string, std::vector<double>>& leaf_sensitivities,
+                                  const int max_newton_iterations);
 
     void updateWsolvent(const Group& group,
                         const int reportStepIdx,
@@ -354,9 +365,26 @@ protected:
                           const int report_step_idx,
                           DeferredLogger& deferred_logger);
 
+    //! \brief PVT region for the reservoir rate conversion in the group
+    //! constraint checks, the same on all processes.
+    int groupConversionPvtRegion() const;
+
+    //! \brief Surface rates of the given groups and all groups below them,
+    //! summed over the processes in a single collective.
+    //! \details The rates of a group are the injection rates of all phases
+    //! followed by the production rates.
+    std::map<std::string, std::vector<double>>
+    groupSurfaceRates(const std::vector<const Group*>& groups,
+                      const int reportStepIdx) const;
+
+    //! \brief Checks whether a group must switch to control by its parent.
+    //! \param pvtreg As given by groupConversionPvtRegion()
+    //! \param surface_rates Rates of the group as given by groupSurfaceRates()
     bool checkGroupHigherConstraints(const Group& group,
                                      DeferredLogger& deferred_logger,
-                                     const int reportStepIdx);
+                                     const int reportStepIdx,
+                                     const int pvtreg,
+                                     const std::vector<double>& surface_rates);
 
     void updateAndCommunicateGroupData(const int reportStepIdx,
                                        const int iterationIdx);
@@ -377,8 +405,13 @@ protected:
                                    GLiftWellStateMap& map,
                                    const int episodeIndex);
 
+    /// Compute the potentials of well widx of the well container. If
+    /// allow_reuse is true, the last computed potentials may be returned
+    /// when the conditions of the well changed little since.
     virtual void computePotentials(const std::size_t widx,
                                    const WellState& well_state_copy,
+                                   const bool allow_reuse,
+                                   std::vector<double>& potentials,
                                    std::string& exc_msg,
                                    ExceptionType::ExcEnum& exc_type,
                                    DeferredLogger& deferred_logger) = 0;
@@ -533,6 +566,8 @@ protected:
 
     std::vector<ParallelWellInfo> parallel_well_info_;
     std::vector<std::reference_wrapper<ParallelWellInfo>> local_parallel_well_info_;
+    // sums per well values of all distributed local wells in one collective
+    AggregatedWellSum aggregated_well_sum_;
 
     std::vector<WellProdIndexCalculator> prod_index_calc_;
     mutable ParallelWBPCalculation wbpCalculationService_;
@@ -551,6 +586,16 @@ protected:
     // Handling for filter cake injection multipliers
     std::unordered_map<std::string, WellFilterCake> filter_cake_;
 
+    // Last computed potentials of each well, and the conditions they were
+    // computed for, indexed like wells_ecl_.
+    struct WellPotentialCache
+    {
+        std::string name;
+        std::vector<double> potentials;
+        std::vector<double> conditions;
+    };
+    std::vector<WellPotentialCache> well_potential_cache_;
+
     /*
       The various wellState members should be accessed and modified
       through the accessor functions wellState(), prevWellState(),
@@ -33,6 +33,8 @@
 #include <opm/simulators/wells/ParallelPAvgDynamicSourceData.hpp>
 #include <opm/simulators/wells/ParallelWBPCalculation.hpp>
 #include <opm/simulators/wells/VFPProperties.hpp>
+#include <opm/simulators/wells/WellBhpThpCalculator.hpp>
+#include <opm/simulators/wells/WellHelpers.hpp>
 #include <opm/simulators/utils/MPIPacker.hpp>
 #include <opm/simulators/linalg/bda/WellContributions.hpp>
 
@@ -41,6 +43,7 @@
 #endif
 
 #include <algorithm>
+#include <exception>
 #include <iomanip>
 #include <utility>
 
@@ -192,12 +195,12 @@ namespace Opm {
     linearize(SparseMatrixAdapter& jacobian, GlobalEqVector& res)
     {
         OPM_BEGIN_PARALLEL_TRY_CATCH();
+        // Modifiy the Jacobian with explicit Schur complement
+        // contributions if requested.
+        if (param_.matrix_add_well_contributions_) {
+            addWellContributions(jacobian);
+        }
         for (const auto& well: well_container_) {
-            // Modifiy the Jacobian with explicit Schur complement
-            // contributions if requested.
-            if (param_.matrix_add_well_contributions_) {
-                well->addWellContributions(jacobian);
-            }
             // Apply as Schur complement the well residual to reservoir residuals:
             // r = r - duneC_^T * invDuneD_ * resWell_
             well->apply(res);
@@ -292,6 +295,7 @@ namespace Opm {
         this->wells_ecl_ = this->getLocalWells(reportStepIdx);
         this->local_parallel_well_info_ =
             this->createLocalParallelWellInfo(this->wells_ecl_);
+        this->initializeAggregatedWellSum(reportStepIdx);
 
         // At least initializeWellState() might be throw an exception in
         // UniformTabulated2DFunction.  Playing it safe by extending the
@@ -371,6 +375,7 @@ namespace Opm {
     beginTimeStep()
     {
         OPM_TIMEBLOCK(beginTimeStep);
+        ++reservoir_state_stamp_;
         updateAverageFormationFactor();
         DeferredLogger local_deferredLogger;
         switched_prod_groups_.clear();
@@ -400,6 +405,15 @@ namespace Opm {
             // optimize the usage of the following several member variables
             this->initWellContainer(reportStepIdx);
 
+            if (param_.matrix_add_well_contributions_) {
+                std::vector<std::vector<int>> well_cells;
+                well_cells.reserve(well_container_.size());
+                for (const auto& well : well_container_) {
+                    well_cells.push_back(well->cells());
+                }
+                well_contribution_groups_ = wellhelpers::groupWellsWithDisjointCells(well_cells);
+            }
+
             // update the updated cell flag
             std::fill(is_cell_perforated_.begin(), is_cell_perforated_.end(), false);
             for (auto& well : well_container_) {
@@ -585,6 +599,7 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     timeStepSucceeded(const double simulationTime, const double dt)
     {
+        ++reservoir_state_stamp_;
         this->closed_this_step_.clear();
 
         // time step is finished and we are not any more at the beginning of an report step
@@ -761,6 +776,7 @@ namespace Opm {
         const int nw = numLocalWells();
 
         well_container_.clear();
+        ++well_container_stamp_;
 
         if (nw > 0) {
             well_container_.reserve(nw);
@@ -1055,6 +1071,7 @@ namespace Opm {
                 "assemble() : iteration {}" , iterationIdx);
             gliftDebug(msg, local_deferredLogger);
         }
+        ++reservoir_state_stamp_;
         last_report_ = SimulatorReportSingle();
         Dune::Timer perfTimer;
         perfTimer.start();
@@ -1092,6 +1109,12 @@ namespace Opm {
 
         assembleWellEqWithoutIteration(dt, local_deferredLogger);
 
+        for (const auto& well : well_container_) {
+            last_report_.total_well_inner_solves += well->innerSolves();
+            last_report_.skipped_well_inner_solves += well->skippedInnerSolves();
+            well->resetInnerSolveCounts();
+        }
+
         // if group or well control changes we don't consider the
         // case converged
         last_report_.well_group_control_changed = well_group_control_changed;
@@ -1184,6 +1207,7 @@ namespace Opm {
                    const double dt,
                    const Domain& domain)
     {
+        ++reservoir_state_stamp_;
         last_report_ = SimulatorReportSingle();
         Dune::Timer perfTimer;
         perfTimer.start();
@@ -1206,6 +1230,14 @@ namespace Opm {
         initPrimaryVariablesEvaluationDomain(domain);
         assembleWellEqDomain(dt, domain, local_deferredLogger);
 
+        for (const auto& well : well_container_) {
+            if (well_domain_.at(well->name()) == domain.index) {
+                last_report_.total_well_inner_solves += well->innerSolves();
+                last_report_.skipped_well_inner_solves += well->skippedInnerSolves();
+                well->resetInnerSolveCounts();
+            }
+        }
+
         // TODO: errors here must be caught higher up, as this method is not called in parallel.
         // We will log errors on rank 0, but not other ranks for now.
         if (terminal_output_) {
@@ -1312,16 +1344,25 @@ namespace Opm {
             int num_rates_to_sync = 0;  // communication variable
             GLiftSyncGroups groups_to_sync;
             if (comm.rank() ==  i) {
-                // Run stage1: Optimize single wells while also checking group limits
+                const auto& summary_state = ebosSimulator_.vanguard().summaryState();
+                std::vector<std::pair<WellInterface<TypeTag>*, std::unique_ptr<GasLiftSingleWell>>> glift_candidates;
                 for (const auto& well : well_container_) {
                     // NOTE: Only the wells in "group_info" needs to be optimized
                     if (group_info.hasWell(well->name())) {
-                        gasLiftOptimizationStage1SingleWell(
-                            well.get(), deferred_logger, prod_wells, glift_wells,
-                            group_info, state_map, groups_to_sync
-                        );
+                        glift_candidates.emplace_back(
+                            well.get(),
+                            std::make_unique<GasLiftSingleWell>(
+                                *well, ebosSimulator_, summary_state,
+                                deferred_logger, this->wellState(), this->groupState(),
+                                group_info, groups_to_sync, this->comm_, this->glift_debug));
                     }
                 }
+                gasLiftTabulateLiftCurves(glift_candidates, deferred_logger);
+                // Run stage1: Optimize single wells while also checking group limits
+                for (auto& [well, glift] : glift_candidates) {
+                    gasLiftOptimizationStage1SingleWell(
+                        well, std::move(glift), prod_wells, glift_wells, state_map);
+                }
                 num_rates_to_sync = groups_to_sync.size();
             }
             num_rates_to_sync = comm.sum(num_rates_to_sync);
@@ -1377,24 +1418,60 @@ namespace Opm {
         }
     }
 
-    // NOTE: this method cannot be const since it passes this->wellState()
-    //   (see below) to the GasLiftSingleWell constructor which accepts WellState
-    //   as a non-const reference..
+    template<typename TypeTag>
+    void
+    BlackoilWellModel<TypeTag>::
+    gasLiftTabulateLiftCurves(
+        std::vector<std::pair<WellInterface<TypeTag>*, std::unique_ptr<GasLiftSingleWell>>>& glift_candidates,
+        DeferredLogger& deferred_logger)
+    {
+        const int num_increments = param_.gas_lift_curve_increments_;
+        if (num_increments <= 0) {
+            return;
+        }
+        // Distributed wells communicate when computing their rates, so
+        // they are left to the optimization itself.
+        std::vector<GasLiftSingleWell*> glifts;
+        for (auto& [well, glift] : glift_candidates) {
+            if (well->parallelWellInfo().communication().size() == 1) {
+                glifts.push_back(glift.get());
+            }
+        }
+        const int num_glifts = glifts.size();
+        std::vector<DeferredLogger> loggers(num_glifts);
+        std::exception_ptr failure;
+        // The debug output of the wells goes to the common logger.
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (!this->glift_debug)
+#endif
+        for (int i = 0; i < num_glifts; ++i) {
+            try {
+                glifts[i]->tabulateLiftCurve(num_increments, loggers[i]);
+            } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        }
+        for (const auto& logger : loggers) {
+            deferred_logger.append(logger);
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
     template<typename TypeTag>
     void
     BlackoilWellModel<TypeTag>::
     gasLiftOptimizationStage1SingleWell(WellInterface<TypeTag> *well,
-        DeferredLogger& deferred_logger,
+        std::unique_ptr<GasLiftSingleWell> glift,
         GLiftProdWells &prod_wells, GLiftOptWells &glift_wells,
-        GasLiftGroupInfo &group_info, GLiftWellStateMap &state_map,
-        GLiftSyncGroups& sync_groups)
+        GLiftWellStateMap &state_map)
     {
-        const auto& summary_state = ebosSimulator_.vanguard().summaryState();
-        std::unique_ptr<GasLiftSingleWell> glift
-            = std::make_unique<GasLiftSingleWell>(
-                *well, ebosSimulator_, summary_state,
-                deferred_logger, this->wellState(), this->groupState(),
-                group_info, sync_groups, this->comm_, this->glift_debug);
         auto state = glift->runOptimize(
             ebosSimulator_.model().newtonMethod().numIterations());
         if (state) {
@@ -1458,9 +1535,29 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     assembleWellEqWithoutIteration(const double dt, DeferredLogger& deferred_logger)
     {
+        // The dissolved and vaporized rates and the equations of the
+        // distributed standard wells are summed for all wells at once.
+        constexpr std::size_t num_mixing = std::tuple_size_v<decltype(SingleWellState::phase_mixing_rates)>;
+        constexpr std::size_t num_equations = StandardWell<TypeTag>::numDeferredEntries;
+        this->aggregated_well_sum_.begin(num_mixing + num_equations);
         for (auto& well: well_container_) {
+            well->setDeferDistributedSum(true);
             well->assembleWellEqWithoutIteration(ebosSimulator_, dt, this->wellState(), this->groupState(),
                                                  deferred_logger);
+            well->setDeferDistributedSum(false);
+            // Wells which skipped the assembly hold the sums already.
+            if (well->isOperableAndSolvable() || well->wellIsStopped()) {
+                auto& ws = this->wellState().well(well->indexOfWell());
+                this->aggregated_well_sum_.add(well->indexOfWell(), ws.phase_mixing_rates.data(), 0, num_mixing);
+            }
+            if (auto* entries = well->deferredEquationEntries()) {
+                assert(entries->size() == num_equations);
+                this->aggregated_well_sum_.add(well->indexOfWell(), entries->data(), num_mixing, num_equations);
+            }
+        }
+        this->aggregated_well_sum_.end();
+        for (auto& well: well_container_) {
+            well->finishDeferredAssembly(deferred_logger);
         }
     }
 
@@ -1549,8 +1646,29 @@ namespace Opm {
     BlackoilWellModel<TypeTag>::
     addWellContributions(SparseMatrixAdapter& jacobian) const
     {
-        for ( const auto& well: well_container_ ) {
-            well->addWellContributions(jacobian);
+        OPM_TIMEBLOCK(addWellContributions);
+        // Wells of one group write to disjoint blocks of the matrix.
+        std::exception_ptr failure;
+        for (const auto& group : well_contribution_groups_) {
+            const int num_wells = group.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for (int i = 0; i < num_wells; ++i) {
+                try {
+                    well_container_[group[i]]->addWellContributions(jacobian);
+                } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+                }
+            }
+            if (failure) {
+                std::rethrow_exception(failure);
+            }
         }
     }
 
@@ -1566,8 +1684,14 @@ namespace Opm {
             jacobian[wdof][wdof] = 1.0;// better scaling ?
         }
 
-        for ( const auto& well : well_container_ ) {
-            well->addWellPressureEquations(jacobian, weights, pressureVarIndex, use_well_weights, this->wellState());
+        // Each well only writes to its own row and column, so the wells
+        // may be processed concurrently.
+        const int num_wells = well_container_.size();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+        for (int w = 0; w < num_wells; ++w) {
+            well_container_[w]->addWellPressureEquations(jacobian, weights, pressureVarIndex, use_well_weights, this->wellState());
         }
     }
 
@@ -1827,6 +1951,50 @@ namespace Opm {
 
 
 
+    template<typename TypeTag>
+    std::map<std::string, std::vector<double>>
+    BlackoilWellModel<TypeTag>::
+    networkLeafRateSensitivities(const int reportStepIdx) const
+    {
+        std::map<std::string, std::vector<double>> sensitivities;
+        const auto& network = schedule()[reportStepIdx].network();
+        for (const auto& well : well_container_) {
+            if (!well->isProducer()) {
+                continue;
+            }
+            // The wells of groups below a leaf node contribute through their groups.
+            const auto [node, group_efficiency] = WellGroupHelpers::networkLeafNode(
+                well->wellEcl().groupName(),
+                [&network](const std::string& name) { return network.has_node(name); },
+                [this, reportStepIdx](const std::string& name) -> const Group&
+                { return schedule().getGroup(name, reportStepIdx); });
+            if (node.empty()) {
+                continue;
+            }
+            // Wells split across processes contribute on their owning process only.
+            if (!well->parallelWellInfo().isOwner()) {
+                continue;
+            }
+            const auto well_sensitivities = well->thpRateSensitivities(this->wellState(), this->summaryState());
+            if (well_sensitivities.empty()) {
+                continue;
+            }
+            // The group rates of the leaf nodes include the efficiency factors of the
+            // wells and of the groups below them.
+            const double efficiency = group_efficiency * well->wellEcl().getEfficiencyFactor();
+            auto& leaf = sensitivities[node];
+            leaf.resize(well_sensitivities.size(), 0.0);
+            for (std::size_t p = 0; p < well_sensitivities.size(); ++p) {
+                leaf[p] += efficiency * well_sensitivities[p];
+            }
+        }
+        return sensitivities;
+    }
+
+
+
+
+
     template<typename TypeTag>
     std::pair<bool, bool>
     BlackoilWellModel<TypeTag>::
@@ -1845,7 +2013,12 @@ namespace Opm {
         // network related
         bool more_network_update = false;
         if (shouldBalanceNetwork(episodeIdx, iterationIdx) || mandatory_network_balance) {
-            const auto local_network_imbalance = updateNetworkPressures(episodeIdx);
+            const int newton_iterations = param_.network_newton_iterations_;
+            const auto leaf_sensitivities = newton_iterations > 0
+                ? networkLeafRateSensitivities(episodeIdx)
+                : std::map<std::string, std::vector<double>>{};
+            const auto local_network_imbalance = updateNetworkPressures(episodeIdx, leaf_sensitivities,
+                                                                        newton_iterations);
             const double network_imbalance = comm.max(local_network_imbalance);
             const auto& balance = schedule()[episodeIdx].network_balance();
             constexpr double relaxtion_factor = 10.0;
@@ -2092,31 +2265,45 @@ namespace Opm {
                         const int reportStepIdx,
                         const int iterationIdx)
     {
-        bool changed = false;
-        bool changed_hc = checkGroupHigherConstraints( group, deferred_logger, reportStepIdx);
-        if (changed_hc) {
-            changed = true;
-            updateAndCommunicate(reportStepIdx, iterationIdx, deferred_logger);
-        }
-        bool changed_individual =
-            BlackoilWellModelConstraints(*this).
-                updateGroupIndividualControl(group,
-                                             reportStepIdx,
-                                             this->switched_inj_groups_,
-                                             this->switched_prod_groups_,
-                                             this->groupState(),
-                                             this->wellState(),
-                                             deferred_logger);
-        if (changed_individual) {
-            changed = true;
-            updateAndCommunicate(reportStepIdx, iterationIdx, deferred_logger);
-        }
-        // call recursively down the group hierarchy
-        for (const std::string& groupName : group.groups()) {
-            bool changed_this = updateGroupControls( schedule().getGroup(groupName, reportStepIdx), deferred_logger, reportStepIdx,iterationIdx);
-            changed = changed || changed_this;
-        }
-        return changed;
+        // The groups are checked in sweeps down the hierarchy, with a single
+        // update and communication of the group and well states after each
+        // sweep with a switch. The surface rates of the groups of a sweep are
+        // reduced in one collective at its start.
+        const int pvtreg = this->groupConversionPvtRegion();
+        std::map<std::string, std::vector<double>> surface_rates;
+        return WellGroupHelpers::sweepGroupControls(group,
+            [this, reportStepIdx](const Group& grp)
+            {
+                std::vector<const Group*> children;
+                for (const std::string& groupName : grp.groups()) {
+                    children.push_back(&schedule().getGroup(groupName, reportStepIdx));
+                }
+                return children;
+            },
+            [this, reportStepIdx, &surface_rates](const std::vector<const Group*>& roots)
+            {
+                surface_rates = this->groupSurfaceRates(roots, reportStepIdx);
+            },
+            [this, reportStepIdx, pvtreg, &surface_rates, &deferred_logger](const Group& grp)
+            {
+                return checkGroupHigherConstraints(grp, deferred_logger, reportStepIdx,
+                                                   pvtreg, surface_rates.at(grp.name()));
+            },
+            [this, reportStepIdx, &deferred_logger](const Group& grp)
+            {
+                return BlackoilWellModelConstraints(*this).
+                    updateGroupIndividualControl(grp,
+                                                 reportStepIdx,
+                                                 this->switched_inj_groups_,
+                                                 this->switched_prod_groups_,
+                                                 this->groupState(),
+                                                 this->wellState(),
+                                                 deferred_logger);
+            },
+            [this, reportStepIdx, iterationIdx, &deferred_logger]()
+            {
+                updateAndCommunicate(reportStepIdx, iterationIdx, deferred_logger);
+            });
     }
 
     template<typename TypeTag>
@@ -2148,26 +2335,67 @@ namespace Opm {
     void
     BlackoilWellModel<TypeTag>::computePotentials(const std::size_t widx,
                                                   const WellState& well_state_copy,
+                                                  const bool allow_reuse,
+                                                  std::vector<double>& potentials,
                                                   std::string& exc_msg,
                                                   ExceptionType::ExcEnum& exc_type,
                                                   DeferredLogger& deferred_logger)
     {
-        const int np = numPhases();
-        std::vector<double> potentials;
         const auto& well= well_container_[widx];
+        auto& cache = this->well_potential_cache_[well->indexOfWell()];
+
+        // The potentials of stopped and pressure controlled wells are not
+        // computed but follow from the current rates, so only reuse the
+        // ones of wells where they are the result of a well solve. The
+        // conditions such potentials depend on are the bhp and thp limits
+        // and the pressure and saturations of the perforated cells.
+        const double tol = param_.well_potential_reuse_tolerance_;
+        std::vector<double> conditions;
+        if (tol > 0.0) {
+            const auto& summaryState = ebosSimulator_.vanguard().summaryState();
+            conditions.push_back(WellBhpThpCalculator(*well).mostStrictBhpFromBhpLimits(summaryState));
+            conditions.push_back(well->getTHPConstraint(summaryState));
+            const unsigned pressurePhaseIdx = FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx)
+                ? FluidSystem::oilPhaseIdx
+                : (FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)
+                   ? FluidSystem::gasPhaseIdx : FluidSystem::waterPhaseIdx);
+            for (const int cell_idx : well->cells()) {
+                const auto& fs = ebosSimulator_.model().intensiveQuantities(cell_idx, /*timeIdx=*/0).fluidState();
+                conditions.push_back(fs.pressure(pressurePhaseIdx).value());
+                for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+                    conditions.push_back(FluidSystem::phaseIsActive(phaseIdx)
+                                         ? fs.saturation(phaseIdx).value() : 0.0);
+                }
+            }
+
+            const auto& ws = well_state_copy.well(well->indexOfWell());
+            const bool pressure_controlled = well->isInjector()
+                ? (ws.injection_cmode == Well::InjectorCMode::BHP ||
+                   ws.injection_cmode == Well::InjectorCMode::THP)
+                : (ws.production_cmode == Well::ProducerCMode::BHP ||
+                   ws.production_cmode == Well::ProducerCMode::THP);
+            if (allow_reuse && !well->wellIsStopped() && !pressure_controlled &&
+                cache.name == well->name() &&
+                wellhelpers::potentialConditionsAgree(conditions, cache.conditions, tol))
+            {
+                potentials = cache.potentials;
+                return;
+            }
+        }
+
+        potentials.assign(numPhases(), 0.0);
         try {
             well->computeWellPotentials(ebosSimulator_, well_state_copy, potentials, deferred_logger);
+            if (tol > 0.0) {
+                cache = {well->name(), potentials, std::move(conditions)};
+            }
+            return;
         }
         // catch all possible exception and store type and message.
         OPM_PARALLEL_CATCH_CLAUSE(exc_type, exc_msg);
-        // Store it in the well state
-        // potentials is resized and set to zero in the beginning of well->ComputeWellPotentials
-        // and updated only if sucessfull. i.e. the potentials are zero for exceptions
-        auto& ws = this->wellState().well(well->indexOfWell());
-        for (int p = 0; p < np; ++p) {
-            // make sure the potentials are positive
-            ws.well_potentials[p] = std::max(0.0, potentials[p]);
-        }
+        // potentials is set to zero in the beginning and only updated if
+        // sucessfull, i.e. the potentials are zero for exceptions
+        cache.name.clear();
     }
 
 
@@ -2451,21 +2679,17 @@ namespace Opm {
         double cellDensity;
         double perfPhaseRate;
         const int nw = numLocalWells();
+        // The weights of the distributed wells are summed for all wells at once.
+        std::vector<std::array<double,2>> weights(nw, {0.0, 0.0});
+        this->aggregated_well_sum_.begin(2);
         for (auto wellID = 0*nw; wellID < nw; ++wellID) {
             const Well& well = wells_ecl_[wellID];
             if (well.isInjector())
                 continue;
 
-            int connpos = 0;
-            for (int i = 0; i < wellID; ++i) {
-                connpos += well_perf_data_[i].size();
-            }
-            connpos *= np;
-            std::array<double,2> weighted{0.0,0.0};
-            auto& [weighted_temperature, total_weight] = weighted;
+            auto& [weighted_temperature, total_weight] = weights[wellID];
 
-            auto& well_info = local_parallel_well_info_[wellID].get();
-            const int num_perf_this_well = well_info.communication().sum(well_perf_data_[wellID].size());
+            const int num_perf_this_well = well_perf_data_[wellID].size();
             auto& ws = this->wellState().well(wellID);
             auto& perf_data = ws.perf_data;
             auto& perf_phase_rate = perf_data.phase_rates;
@@ -2493,7 +2717,15 @@ namespace Opm {
                 total_weight += weight_factor;
                 weighted_temperature += weight_factor * cellTemperatures;
             }
-            well_info.communication().sum(weighted.data(), 2);
+            this->aggregated_well_sum_.add(wellID, weights[wellID].data());
+        }
+        this->aggregated_well_sum_.end();
+
+        for (auto wellID = 0*nw; wellID < nw; ++wellID) {
+            if (wells_ecl_[wellID].isInjector())
+                continue;
+
+            const auto& [weighted_temperature, total_weight] = weights[wellID];
             this->wellState().well(wellID).temperature = weighted_temperature/total_weight;
         }
     }
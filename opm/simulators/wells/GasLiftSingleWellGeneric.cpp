@@ -31,6 +31,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <cassert>
 #include <sstream>
 
@@ -105,7 +106,7 @@ GasLiftSingleWellGeneric::calcIncOrDecGradient( double oil_rate,
     if (checkGroupALQrateExceeded(delta_alq, gr_name_dont_limit))
         return std::nullopt;
 
-    if (auto bhp = computeBhpAtThpLimit_(new_alq, debug_output)) {
+    if (auto bhp = getBhpAtThpLimit_(new_alq, debug_output)) {
         auto [new_bhp, bhp_is_limited] = getBhpWithLimit_(*bhp);
         // TODO: What to do if BHP is limited?
         auto rates = computeWellRates_(new_bhp, bhp_is_limited, debug_output);
@@ -166,6 +167,34 @@ GasLiftSingleWellGeneric::runOptimize(const int iteration_idx)
     return state;
 }
 
+void
+GasLiftSingleWellGeneric::tabulateLiftCurve(const int num_increments,
+                                            DeferredLogger& deferred_logger)
+{
+    if (!this->optimize_ || !checkThpControl_())
+        return;
+
+    // Use the same lift gas rates as addOrSubtractAlqIncrement_(), i.e. whole
+    //   increments from the current rate, limited by the minimum and maximum rate.
+    const double min_alq = std::max(this->min_alq_, 0.0);
+    std::vector<double> alqs;
+    alqs.reserve(2 * num_increments + 1);
+    for (int k = -num_increments; k <= num_increments; ++k) {
+        const double alq = std::clamp(this->orig_alq_ + k * this->increment_,
+                                      min_alq, std::max(min_alq, this->max_alq_));
+        if (alqs.empty() || !checkALQequal_(alqs.back(), alq)) {
+            alqs.push_back(alq);
+        }
+    }
+    for (const double alq : alqs) {
+        auto it = this->lift_curve_.lower_bound(alq - this->increment_ * ALQ_EPSILON);
+        if (it == this->lift_curve_.end() || !checkALQequal_(it->first, alq)) {
+            this->lift_curve_.emplace_hint(
+                it, alq, computeBhpAtThpLimit_(alq, deferred_logger, /*debug_output=*/false));
+        }
+    }
+}
+
 /****************************************
  * Protected methods in alphabetical order
  ****************************************/
@@ -290,7 +319,7 @@ computeConvergedBhpAtThpLimitByMaybeIncreasingALQ_() const
     double new_alq = alq;
     std::optional<double> bhp;
     while ((alq < this->max_alq_) || checkALQequal_(alq, this->max_alq_)) {
-        if (bhp = computeBhpAtThpLimit_(alq); bhp) {
+        if (bhp = getBhpAtThpLimit_(alq); bhp) {
             new_alq = alq;
             break;
         }
@@ -343,7 +372,7 @@ std::optional<GasLiftSingleWellGeneric::BasicRates>
 GasLiftSingleWellGeneric::computeWellRatesWithALQ_(double alq) const
 {
     std::optional<BasicRates> rates;
-    auto bhp_opt = computeBhpAtThpLimit_(alq);
+    auto bhp_opt = getBhpAtThpLimit_(alq);
     if (bhp_opt) {
         auto [bhp, bhp_is_limited] = getBhpWithLimit_(*bhp_opt);
         rates = computeWellRates_(bhp, bhp_is_limited);
@@ -405,7 +434,7 @@ GasLiftSingleWellGeneric::debugShowBhpAlqTable_()
     auto max_it = 50;
     auto it = 1;
     while (alq <= (this->max_alq_ + this->increment_)) {
-        auto bhp_at_thp_limit = computeBhpAtThpLimit_(alq);
+        auto bhp_at_thp_limit = getBhpAtThpLimit_(alq);
         if (!bhp_at_thp_limit) {
             const std::string msg = fmt::format("Failed to get converged potentials "
                                                 "for ALQ = {}. Skipping.",
@@ -506,6 +535,20 @@ GasLiftSingleWellGeneric::displayWarning_(const std::string& msg)
     logMessage_(/*prefix=*/"GLIFT", msg, MessageType::WARNING);
 }
 
+std::optional<double>
+GasLiftSingleWellGeneric::getBhpAtThpLimit_(double alq, bool debug_output) const
+{
+    // The rates of the well do not change during the optimization, so the
+    //   bhp computed for a lift gas rate stays valid.
+    auto it = this->lift_curve_.lower_bound(alq - this->increment_ * ALQ_EPSILON);
+    if (it != this->lift_curve_.end() && checkALQequal_(it->first, alq)) {
+        return it->second;
+    }
+    auto bhp = computeBhpAtThpLimit_(alq, this->deferred_logger_, debug_output);
+    this->lift_curve_.emplace_hint(it, alq, bhp);
+    return bhp;
+}
+
 std::pair<double, bool>
 GasLiftSingleWellGeneric::getBhpWithLimit_(double bhp) const
 {
@@ -31,6 +31,7 @@
 #include <opm/simulators/wells/GroupState.hpp>
 
 #include <functional>
+#include <map>
 #include <optional>
 #include <string>
 #include <tuple>
@@ -103,6 +104,13 @@ public:
 
     std::unique_ptr<GasLiftWellState> runOptimize(const int iteration_idx);
 
+    // Computes the bhp at the THP limit for the lift gas rates up to
+    //   num_increments increments below and above the current one, which the
+    //   optimization reuses instead of solving for them again. This only
+    //   touches the state of this well, so different wells can be tabulated
+    //   concurrently as long as each one writes to its own logger.
+    void tabulateLiftCurve(const int num_increments, DeferredLogger& deferred_logger);
+
     virtual const WellInterfaceGeneric& getWell() const = 0;
 
 protected:
@@ -255,7 +263,9 @@ protected:
                       const BasicRates& rates, const BasicRates& new_rates) const;
     bool checkInitialALQmodified_(double alq, double initial_alq) const;
     virtual bool checkThpControl_() const = 0;
-    virtual std::optional<double> computeBhpAtThpLimit_(double alq, bool debug_output = true) const = 0;
+    virtual std::optional<double> computeBhpAtThpLimit_(double alq,
+                                                        DeferredLogger& deferred_logger,
+                                                        bool debug_output = true) const = 0;
     std::pair<std::optional<double>,double> computeConvergedBhpAtThpLimitByMaybeIncreasingALQ_() const;
     std::pair<std::optional<BasicRates>,double> computeInitialWellRates_() const;
     std::optional<LimitedRates> computeLimitedWellRatesWithALQ_(double alq) const;
@@ -274,6 +284,7 @@ protected:
     void debugShowTargets_();
     void displayDebugMessage_(const std::string& msg) const override;
     void displayWarning_(const std::string& warning);
+    std::optional<double> getBhpAtThpLimit_(double alq, bool debug_output = true) const;
     std::pair<double, bool> getBhpWithLimit_(double bhp) const;
     std::pair<double, bool> getGasRateWithLimit_(
                            const BasicRates& rates) const;
@@ -360,6 +371,9 @@ protected:
 
     const GasLiftWell* gl_well_;
 
+    // The bhp at the THP limit for the lift gas rates evaluated so far
+    mutable std::map<double, std::optional<double>> lift_curve_;
+
     bool optimize_;
     bool debug_limit_increase_decrease_;
     bool debug_abort_if_decrease_and_oil_is_limited_ = false;
@@ -128,13 +128,15 @@ computeWellRates_( double bhp, bool bhp_is_limited, bool debug_output ) const
 template<typename TypeTag>
 std::optional<double>
 GasLiftSingleWell<TypeTag>::
-computeBhpAtThpLimit_(double alq, bool debug_output) const
+computeBhpAtThpLimit_(double alq,
+                      DeferredLogger& deferred_logger,
+                      bool debug_output) const
 {
     auto bhp_at_thp_limit = this->well_.computeBhpAtThpLimitProdWithAlq(
         this->ebos_simulator_,
         this->summary_state_,
         alq,
-        this->deferred_logger_);
+        deferred_logger);
     if (bhp_at_thp_limit) {
         if (*bhp_at_thp_limit < this->controls_.bhp_limit) {
             if (debug_output && this->debug) {
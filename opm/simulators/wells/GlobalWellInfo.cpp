@@ -22,6 +22,7 @@
 #endif // HAVE_CONFIG_H
 #include <opm/simulators/wells/GlobalWellInfo.hpp>
 
+#include <opm/input/eclipse/Schedule/Group/Group.hpp>
 #include <opm/input/eclipse/Schedule/Schedule.hpp>
 #include <opm/input/eclipse/Schedule/Well/Well.hpp>
 
@@ -36,10 +37,20 @@ GlobalWellInfo::GlobalWellInfo(const Schedule& sched, std::size_t report_step, c
     auto num_wells = sched.numWells(report_step);
     this->m_in_injecting_group.resize(num_wells);
     this->m_in_producing_group.resize(num_wells);
+    this->m_names.resize(num_wells);
     for (const auto& wname : sched.wellNames(report_step)) {
         const auto& well = sched.getWell(wname, report_step);
         auto global_well_index = well.seqIndex();
         this->name_map.emplace( well.name(), global_well_index );
+        this->m_names.at(global_well_index) = well.name();
+    }
+
+    for (const auto& gname : sched.groupNames(report_step)) {
+        const auto& child_wells = sched.getGroup(gname, report_step).wells();
+        auto& indices = this->m_group_wells[gname];
+        indices.reserve(child_wells.size());
+        for (const auto& wname : child_wells)
+            indices.push_back(this->name_map.at(wname));
     }
 
     for (const auto& well : local_wells)
@@ -48,17 +59,44 @@ GlobalWellInfo::GlobalWellInfo(const Schedule& sched, std::size_t report_step, c
 
 
 bool GlobalWellInfo::in_injecting_group(const std::string& wname) const {
-    auto global_well_index = this->name_map.at(wname);
-    return this->m_in_injecting_group[global_well_index];
+    return this->in_injecting_group(this->name_map.at(wname));
 }
 
 
 bool GlobalWellInfo::in_producing_group(const std::string& wname) const {
-    auto global_well_index = this->name_map.at(wname);
+    return this->in_producing_group(this->name_map.at(wname));
+}
+
+
+bool GlobalWellInfo::in_injecting_group(std::size_t global_well_index) const {
+    return this->m_in_injecting_group[global_well_index];
+}
+
+
+bool GlobalWellInfo::in_producing_group(std::size_t global_well_index) const {
     return this->m_in_producing_group[global_well_index];
 }
 
 
+std::size_t GlobalWellInfo::num_wells() const {
+    return this->m_names.size();
+}
+
+
+bool GlobalWellInfo::has_well(const std::string& wname) const {
+    return this->name_map.find(wname) != this->name_map.end();
+}
+
+
+std::optional<std::size_t> GlobalWellInfo::find_well(const std::string& wname) const {
+    auto iter = this->name_map.find(wname);
+    if (iter == this->name_map.end())
+        return std::nullopt;
+
+    return iter->second;
+}
+
+
 void GlobalWellInfo::update_injector(std::size_t well_index, Well::Status well_status, Well::InjectorCMode injection_cmode) {
     if (well_status == Well::Status::OPEN && injection_cmode == Well::InjectorCMode::GRUP)
         this->m_in_injecting_group[this->local_map[well_index]] = 1;
@@ -70,8 +108,8 @@ void GlobalWellInfo::update_producer(std::size_t well_index, Well::Status well_s
 }
 
 void GlobalWellInfo::clear() {
-    this->m_in_injecting_group.assign(this->name_map.size(), 0);
-    this->m_in_producing_group.assign(this->name_map.size(), 0);
+    this->m_in_injecting_group.assign(this->m_names.size(), 0);
+    this->m_in_producing_group.assign(this->m_names.size(), 0);
 }
 
 
@@ -80,10 +118,18 @@ std::size_t GlobalWellInfo::well_index(const std::string& wname) const {
 }
 
 const std::string& GlobalWellInfo::well_name(std::size_t well_index) const {
-    for (const auto& [name, index] : this->name_map) {
-        if (index == well_index)
-            return name;
-    }
-    throw std::logic_error("No well with index: " + std::to_string(well_index));
+    if (well_index >= this->m_names.size())
+        throw std::logic_error("No well with index: " + std::to_string(well_index));
+
+    return this->m_names[well_index];
+}
+
+const std::vector<std::size_t>& GlobalWellInfo::group_wells(const std::string& gname) const {
+    static const std::vector<std::size_t> no_wells;
+    auto iter = this->m_group_wells.find(gname);
+    if (iter == this->m_group_wells.end())
+        return no_wells;
+
+    return iter->second;
 }
 }
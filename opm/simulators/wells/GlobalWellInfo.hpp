@@ -21,8 +21,9 @@
 #define OPM_GLOBAL_WELL_INFO_HEADER_INCLUDED
 
 #include <cstddef>
-#include <map>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Opm {
@@ -40,11 +41,17 @@ enum class WellStatus;
   the wells defined on the local process, but in some cases we need global
   information about all the wells. This class maintains the following:
 
-  - Mapping between global well index and well name.
+  - Mapping between global well index and well name. The global well index is
+    the sequence index of the well in the schedule, and serves as an integer
+    handle of the well for per-iteration lookups.
 
   - Mapping between local well index and global index (only used internally in
     class).
 
+  - The global indices of the wells in each group, in the order of the
+    schedule, so that loops over the child wells of a group need not look up
+    every child by name.
+
   - Functionality to query well whether it is currently injecting or producing
     under group control.
 */
@@ -70,8 +77,14 @@ public:
     GlobalWellInfo(const Schedule& sched, std::size_t report_step, const std::vector<Well>& local_wells);
     bool in_producing_group(const std::string& wname) const;
     bool in_injecting_group(const std::string& wname) const;
+    bool in_producing_group(std::size_t global_well_index) const;
+    bool in_injecting_group(std::size_t global_well_index) const;
+    std::size_t num_wells() const;
+    bool has_well(const std::string& wname) const;
+    std::optional<std::size_t> find_well(const std::string& wname) const;
     std::size_t well_index(const std::string& wname) const;
     const std::string& well_name(std::size_t well_index) const;
+    const std::vector<std::size_t>& group_wells(const std::string& gname) const;
     void update_injector(std::size_t well_index, WellStatus well_status, WellInjectorCMode injection_cmode);
     void update_producer(std::size_t well_index, WellStatus well_status, WellProducerCMode production_cmode);
     void clear();
@@ -79,7 +92,9 @@ public:
 private:
     std::vector<std::size_t> local_map;    // local_index -> global_index
 
-    std::map<std::string, std::size_t> name_map; // string -> global_index
+    std::unordered_map<std::string, std::size_t> name_map; // string -> global_index
+    std::vector<std::string> m_names;            // global_index -> string
+    std::unordered_map<std::string, std::vector<std::size_t>> m_group_wells; // group -> global_index of child wells
     std::vector<int> m_in_injecting_group;       // global_index -> int/bool
     std::vector<int> m_in_producing_group;       // global_index -> int/bool
 };
@@ -49,10 +49,9 @@ namespace {
 
 template <typename ValueType>
 ValueType haalandFormular(const ValueType& re,
-                          const double diameter,
-                          const double roughness)
+                          const double roughness_term)
 {
-    const ValueType value = -3.6 * log10(6.9 / re + std::pow(roughness / (3.7 * diameter), 10. / 9.) );
+    const ValueType value = -3.6 * log10(6.9 / re + roughness_term);
 
     // sqrt(1/f) should be non-positive
     assert(value >= 0.0);
@@ -212,34 +211,61 @@ invDX(const MatrixType& D, VectorType x, DeferredLogger& deferred_logger)
     return y;
 }
 
+constexpr double re_value1 = 2000.;
+constexpr double re_value2 = 4000.;
+
+double haalandRoughnessTerm(const double diameter, const double roughness)
+{
+    return std::pow(roughness / (3.7 * diameter), 10. / 9.);
+}
+
+double transitionEndFrictionFactor(const double roughness_term)
+{
+    return haalandFormular(re_value2, roughness_term);
+}
+
 template <typename ValueType>
 ValueType frictionPressureLoss(const double l, const double diameter,
                                const double area, const double roughness,
                                const ValueType& density,
                                const ValueType& w, const ValueType& mu)
 {
-    // Reynolds number
-    const ValueType re = abs( diameter * w / (area * mu));
+    const double roughness_term = haalandRoughnessTerm(diameter, roughness);
+    return frictionPressureLoss(diameter / area,
+                                32. * l / (area * diameter * diameter),
+                                2. * l / (area * area * diameter),
+                                roughness_term,
+                                transitionEndFrictionFactor(roughness_term),
+                                density, w, mu);
+}
 
-    constexpr double re_value1 = 2000.;
-    constexpr double re_value2 = 4000.;
+template <typename ValueType>
+ValueType frictionPressureLoss(const double re_factor,
+                               const double laminar_factor,
+                               const double turbulent_factor,
+                               const double roughness_term,
+                               const double transition_friction_factor,
+                               const ValueType& density,
+                               const ValueType& w, const ValueType& mu)
+{
+    // Reynolds number
+    const ValueType re = abs(re_factor * w / mu);
 
     if (re < re_value1) {
         // not using the formula directly because of the division with very small w
         // might introduce inf/nan entries in Jacobian matrix
-        return 32.* mu * l * abs(w) / (area * diameter *diameter * density);
+        return laminar_factor * mu * abs(w) / density;
     }
 
     ValueType f;
     if (re > re_value2) {
-        f = haalandFormular(re, diameter, roughness);
+        f = haalandFormular(re, roughness_term);
     } else { // in between
         constexpr double f1 = 16. / re_value1;
-        const ValueType f2 = haalandFormular(re_value2, diameter, roughness);
-        f = (f2 - f1) / (re_value2 - re_value1) * (re - re_value1) + f1;
+        f = (transition_friction_factor - f1) / (re_value2 - re_value1) * (re - re_value1) + f1;
     }
     // \Note: a factor of 2 needs to be here based on the dimensional analysis
-    return 2. * f * l * w * w / (area * area * diameter * density);
+    return turbulent_factor * f * w * w / density;
 }
 
 template <typename ValueType>
@@ -326,6 +352,15 @@ INSTANCE_UMF(4)
                                       const __VA_ARGS__&, \
                                       const __VA_ARGS__&, \
                                       const __VA_ARGS__&); \
+    template __VA_ARGS__ \
+    frictionPressureLoss<__VA_ARGS__>(const double, \
+                                      const double, \
+                                      const double, \
+                                      const double, \
+                                      const double, \
+                                      const __VA_ARGS__&, \
+                                      const __VA_ARGS__&, \
+                                      const __VA_ARGS__&); \
     template  __VA_ARGS__ \
     valveContrictionPressureLoss<__VA_ARGS__>(const __VA_ARGS__& mass_rate, \
                                               const __VA_ARGS__& density, \
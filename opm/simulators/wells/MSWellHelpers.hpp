@@ -75,6 +75,28 @@ namespace mswellhelpers
                                    const ValueType& density,
                                    const ValueType& w, const ValueType& mu);
 
+    // the friction pressure loss with the terms that only depend on the
+    // segment geometry precomputed
+    // re_factor is diameter / area
+    // laminar_factor is 32 * l / (area * diameter^2)
+    // turbulent_factor is 2 * l / (area^2 * diameter)
+    // roughness_term is from haalandRoughnessTerm()
+    // transition_friction_factor is from transitionEndFrictionFactor()
+    template <typename ValueType>
+    ValueType frictionPressureLoss(const double re_factor,
+                                   const double laminar_factor,
+                                   const double turbulent_factor,
+                                   const double roughness_term,
+                                   const double transition_friction_factor,
+                                   const ValueType& density,
+                                   const ValueType& w, const ValueType& mu);
+
+    // the term (roughness / (3.7 * diameter))^(10/9) of the Haaland formula
+    double haalandRoughnessTerm(const double diameter, const double roughness);
+
+    // the friction factor at the end of the transition to turbulent flow
+    double transitionEndFrictionFactor(const double roughness_term);
+
 
     template <typename ValueType>
     ValueType valveContrictionPressureLoss(const ValueType& mass_rate,
@@ -41,6 +41,7 @@
 
 #include <cstddef>
 #include <stdexcept>
+#include <vector>
 
 namespace Opm {
 
@@ -122,6 +123,9 @@ init(const int num_cells,
     }
 
     resWell_.resize(well_.numberOfSegments());
+
+    jacobianBlocks_.clear();
+    jacobianMatrix_ = nullptr;
 }
 
 template<class Scalar, int numWellEq, int numEq>
@@ -278,20 +282,48 @@ extract(SparseMatrixAdapter& jacobian) const
     // perforation at cell j connected to segment i.  The code
     // assumes that no cell is connected to more than one segment,
     // i.e. the columns of B/C have no more than one nonzero.
+
+    // The addresses of the blocks of A are looked up once per matrix, in
+    // the order in which the loops below visit them.
+    if (jacobianMatrix_ != &jacobian.istlMatrix()) {
+        jacobianBlocks_.clear();
+        jacobianBlocks_.reserve(duneC_.nonzeroes() * duneB_.nonzeroes());
+        for (std::size_t rowC = 0; rowC < duneC_.N(); ++rowC) {
+            for (auto colC = duneC_[rowC].begin(),
+                      endC = duneC_[rowC].end(); colC != endC; ++colC) {
+                for (std::size_t rowB = 0; rowB < duneB_.N(); ++rowB) {
+                    for (auto colB = duneB_[rowB].begin(),
+                              endB = duneB_[rowB].end(); colB != endB; ++colB) {
+                        jacobianBlocks_.push_back(jacobian.blockAddress(colC.index(), colB.index()));
+                    }
+                }
+            }
+        }
+        jacobianMatrix_ = &jacobian.istlMatrix();
+    }
+
+    std::vector<OffDiagMatrixBlockWellType> invDB(duneB_.nonzeroes());
+    typename SparseMatrixAdapter::MatrixBlock tmp;
+    auto block = jacobianBlocks_.begin();
     for (std::size_t rowC = 0; rowC < duneC_.N(); ++rowC) {
+        if (duneC_[rowC].size() == 0) {
+            continue;
+        }
+        // The row of D^-1 B belonging to the segment does not depend on the
+        // cell of the row of A.
+        auto invDBblock = invDB.begin();
+        for (std::size_t rowB = 0; rowB < duneB_.N(); ++rowB) {
+            for (auto colB = duneB_[rowB].begin(),
+                      endB = duneB_[rowB].end(); colB != endB; ++colB, ++invDBblock) {
+                detail::multMatrixImpl(invDuneD[rowC][rowB], (*colB), *invDBblock, std::true_type());
+            }
+        }
         for (auto colC = duneC_[rowC].begin(),
                   endC = duneC_[rowC].end(); colC != endC; ++colC) {
-            const auto row_index = colC.index();
-            for (std::size_t rowB = 0; rowB < duneB_.N(); ++rowB) {
-                for (auto colB = duneB_[rowB].begin(),
-                          endB = duneB_[rowB].end(); colB != endB; ++colB) {
-                    const auto col_index = colB.index();
-                    OffDiagMatrixBlockWellType tmp1;
-                    detail::multMatrixImpl(invDuneD[rowC][rowB], (*colB), tmp1, std::true_type());
-                    typename SparseMatrixAdapter::MatrixBlock tmp2;
-                    detail::multMatrixTransposedImpl((*colC), tmp1, tmp2, std::false_type());
-                    jacobian.addToBlock(row_index, col_index, tmp2);
-                }
+            for (const auto& invDBblock : invDB) {
+                detail::multMatrixTransposedImpl((*colC), invDBblock, tmp, std::false_type());
+                **block += tmp;
+                ++block;
             }
         }
     }
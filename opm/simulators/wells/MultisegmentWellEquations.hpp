@@ -28,6 +28,7 @@
 #include <dune/istl/bvector.hh>
 
 #include <memory>
+#include <vector>
 
 namespace Dune {
 template<class M> class UMFPack;
@@ -106,6 +107,8 @@ public:
 #endif
 
     //! \brief Add the matrices of this well to the sparse matrix adapter.
+    //! \details Only writes to the blocks coupling the perforated cells,
+    //!          hence wells without common cells may be added concurrently.
     template<class SparseMatrixAdapter>
     void extract(SparseMatrixAdapter& jacobian) const;
 
@@ -142,6 +145,10 @@ public:
     BVectorWell resWell_;
 
     const MultisegmentWellGeneric<Scalar>& well_; //!< Reference to well
+
+    // blocks of the reservoir matrix written by extract(), and the matrix they belong to
+    mutable std::vector<Dune::FieldMatrix<Scalar,numEq,numEq>*> jacobianBlocks_;
+    mutable const void* jacobianMatrix_ = nullptr;
 };
 
 }
@@ -246,7 +246,7 @@ assembleDefaultPressureEq(const int seg,
     }
 
     // contribution from the outlet segment
-    const int outlet_segment_index = this->segmentNumberToIndex(this->segmentSet()[seg].outletSegment());
+    const int outlet_segment_index = segments_.outlet(seg);
     const EvalWell outlet_pressure = primary_variables_.getSegmentPressure(outlet_segment_index);
 
     MultisegmentWellAssemble<FluidSystem,Indices,Scalar>(baseif_).
@@ -310,7 +310,7 @@ assembleICDPressureEq(const int seg,
     ws.segments.pressure_drop_friction[seg] = icd_pressure_drop.value();
 
     // contribution from the outlet segment
-    const int outlet_segment_index = this->segmentNumberToIndex(this->segmentSet()[seg].outletSegment());
+    const int outlet_segment_index = segments_.outlet(seg);
     const EvalWell outlet_pressure = primary_variables_.getSegmentPressure(outlet_segment_index);
 
     const int seg_upwind = segments_.upwinding_segment(seg);
@@ -345,7 +345,7 @@ assembleAccelerationAndHydroPressureLosses(const int seg,
             assembleHydroPressureLoss(seg, seg, hydro_pressure_drop_seg, linSys_);
         segments.pressure_drop_hydrostatic[seg] = hydro_pressure_drop_seg.value();
     } else {
-        const int seg_outlet = this->segmentNumberToIndex(this->segmentSet()[seg].outletSegment());
+        const int seg_outlet = segments_.outlet(seg);
         const auto hydro_pressure_drop_outlet = segments_.getHydroPressureLoss(seg, seg_outlet);
         MultisegmentWellAssemble<FluidSystem,Indices,Scalar>(baseif_).
             assembleHydroPressureLoss(seg, seg, 0.5*hydro_pressure_drop_seg, linSys_);
@@ -66,6 +66,13 @@ MultisegmentWellSegments(const int numSegments,
     , perforation_depth_diffs_(well.numPerfs(), 0.0)
     , inlets_(well.wellEcl().getSegments().size())
     , depth_diffs_(numSegments, 0.0)
+    , outlets_(numSegments, -1)
+    , areas_(numSegments, 0.0)
+    , friction_re_factors_(numSegments, 0.0)
+    , friction_laminar_factors_(numSegments, 0.0)
+    , friction_turbulent_factors_(numSegments, 0.0)
+    , friction_roughness_terms_(numSegments, 0.0)
+    , friction_transition_factors_(numSegments, 0.0)
     , densities_(numSegments, 0.0)
     , mass_rates_(numSegments, 0.0)
     , viscosities_(numSegments, 0.0)
@@ -123,10 +130,34 @@ MultisegmentWellSegments(const int numSegments,
     for (int seg = 1; seg < numSegments; ++seg) {
         const double segment_depth = segment_set[seg].depth();
         const int outlet_segment_number = segment_set[seg].outletSegment();
-        const Segment& outlet_segment = segment_set[segment_set.segmentNumberToIndex(outlet_segment_number)];
+        outlets_[seg] = segment_set.segmentNumberToIndex(outlet_segment_number);
+        const Segment& outlet_segment = segment_set[outlets_[seg]];
         const double outlet_depth = outlet_segment.depth();
         depth_diffs_[seg] = segment_depth - outlet_depth;
     }
+
+    // the geometric terms of the acceleration and friction pressure losses
+    for (int seg = 0; seg < numSegments; ++seg) {
+        const Segment& segment = segment_set[seg];
+        areas_[seg] = segment.crossArea();
+        if (seg == 0) {
+            continue;
+        }
+
+        const double length = segment.totalLength() - segment_set[outlets_[seg]].totalLength();
+        const double diameter = segment.internalDiameter();
+        const double area = areas_[seg];
+        if (length <= 0. || diameter <= 0. || area <= 0.) {
+            continue;
+        }
+
+        friction_re_factors_[seg] = diameter / area;
+        friction_laminar_factors_[seg] = 32. * length / (area * diameter * diameter);
+        friction_turbulent_factors_[seg] = 2. * length / (area * area * diameter);
+        friction_roughness_terms_[seg] = mswellhelpers::haalandRoughnessTerm(diameter, segment.roughness());
+        friction_transition_factors_[seg] =
+            mswellhelpers::transitionEndFrictionFactor(friction_roughness_terms_[seg]);
+    }
 }
 
 template<class FluidSystem, class Indices, class Scalar>
@@ -148,15 +179,18 @@ computeFluidProperties(const EvalWell& temperature,
         surf_dens[compIdx] = FluidSystem::referenceDensity( phaseIdx, pvt_region_index);
     }
 
+    // the compostion of the components inside wellbore under surface condition
+    std::vector<EvalWell> mix_s(well_.numComponents(), 0.0);
+    std::vector<EvalWell> b(well_.numComponents(), 0.0);
+    std::vector<EvalWell> visc(well_.numComponents(), 0.0);
+    std::vector<EvalWell> mix(well_.numComponents(), 0.0);
     for (std::size_t seg = 0; seg < perforations_.size(); ++seg) {
-        // the compostion of the components inside wellbore under surface condition
-        std::vector<EvalWell> mix_s(well_.numComponents(), 0.0);
         for (int comp_idx = 0; comp_idx < well_.numComponents(); ++comp_idx) {
             mix_s[comp_idx] = primary_variables.surfaceVolumeFraction(seg, comp_idx);
         }
 
-        std::vector<EvalWell> b(well_.numComponents(), 0.0);
-        std::vector<EvalWell> visc(well_.numComponents(), 0.0);
+        std::fill(b.begin(), b.end(), 0.0);
+        std::fill(visc.begin(), visc.end(), 0.0);
         std::vector<EvalWell>& phase_densities = phase_densities_[seg];
 
         const EvalWell seg_pressure = primary_variables.getSegmentPressure(seg);
@@ -249,7 +283,7 @@ computeFluidProperties(const EvalWell& temperature,
 
         phase_viscosities_[seg] = visc;
 
-        std::vector<EvalWell> mix(mix_s);
+        mix = mix_s;
         if (FluidSystem::phaseIsActive(FluidSystem::oilPhaseIdx) && FluidSystem::phaseIsActive(FluidSystem::gasPhaseIdx)) {
             const unsigned gasCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::gasCompIdx);
             const unsigned oilCompIdx = Indices::canonicalToActiveComponentIndex(FluidSystem::oilCompIdx);
@@ -324,9 +358,7 @@ updateUpwindingSegments(const PrimaryVariables& primary_variables)
         if (primary_variables.eval(seg)[primary_variables.WQTotal] <= 0.) {
             upwinding_segments_[seg] = seg;
         } else {
-            const auto& segment_set = well_.wellEcl().getSegments();
-            const int outlet_segment_index = segment_set.segmentNumberToIndex(segment_set[seg].outletSegment());
-            upwinding_segments_[seg] = outlet_segment_index;
+            upwinding_segments_[seg] = outlets_[seg];
         }
     }
 }
@@ -533,17 +565,17 @@ getFrictionPressureLoss(const int seg, const bool return_extra_derivatives) cons
         }
     }
     
-    const auto& segment_set = well_.wellEcl().getSegments();
-    const int outlet_segment_index = segment_set.segmentNumberToIndex(segment_set[seg].outletSegment());
-    const double length = segment_set[seg].totalLength() - segment_set[outlet_segment_index].totalLength();
-    assert(length > 0.);
-    const double roughness = segment_set[seg].roughness();
-    const double area = segment_set[seg].crossArea();
-    const double diameter = segment_set[seg].internalDiameter();
+    // zero unless the segment has a positive length, diameter and area
+    assert(friction_laminar_factors_[seg] > 0.);
 
     const double sign = mass_rate < 0. ? 1.0 : - 1.0;
 
-    return sign * mswellhelpers::frictionPressureLoss(length, diameter, area, roughness, density, mass_rate, visc);
+    return sign * mswellhelpers::frictionPressureLoss(friction_re_factors_[seg],
+                                                      friction_laminar_factors_[seg],
+                                                      friction_turbulent_factors_[seg],
+                                                      friction_roughness_terms_[seg],
+                                                      friction_transition_factors_[seg],
+                                                      density, mass_rate, visc);
 }
 
 template<class FluidSystem, class Indices, class Scalar>
@@ -755,8 +787,7 @@ typename MultisegmentWellSegments<FluidSystem,Indices,Scalar>::EvalWell
 MultisegmentWellSegments<FluidSystem,Indices,Scalar>::
 accelerationPressureLoss(const int seg) const
 {
-    const auto& segment_set = well_.wellEcl().getSegments();
-    const double area = segment_set[seg].crossArea();
+    const double area = areas_[seg];
     const EvalWell mass_rate = mass_rates_[seg];
     const int seg_upwind = upwinding_segments_[seg];
     EvalWell density = densities_[seg_upwind];
@@ -771,7 +802,7 @@ accelerationPressureLoss(const int seg) const
     // handling the velocity head of intlet segments
     for (const int inlet : inlets_[seg]) {
         const int seg_upwind_inlet = upwinding_segments_[inlet];
-        const double inlet_area = segment_set[inlet].crossArea();
+        const double inlet_area = areas_[inlet];
         EvalWell inlet_density = densities_[seg_upwind_inlet];
         // WARNING
         // We disregard the derivatives from the upwind density to make sure derivatives
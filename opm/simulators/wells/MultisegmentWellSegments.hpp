@@ -101,6 +101,12 @@ public:
         return upwinding_segments_[seg];
     }
 
+    //! Index of the outlet segment, -1 for the top segment.
+    int outlet(const int seg) const
+    {
+        return outlets_[seg];
+    }
+
     Scalar getRefDensity() const
     {
         return densities_[0].value();
@@ -141,6 +147,19 @@ private:
 
     std::vector<Scalar> depth_diffs_;
 
+    // the segment geometry, stored per segment index so that the pressure
+    // drop evaluations do not need to go through the parser segment set
+    std::vector<int> outlets_;
+    std::vector<double> areas_;
+
+    // the terms of the friction pressure loss that only depend on the
+    // segment geometry, see mswellhelpers::frictionPressureLoss()
+    std::vector<double> friction_re_factors_;
+    std::vector<double> friction_laminar_factors_;
+    std::vector<double> friction_turbulent_factors_;
+    std::vector<double> friction_roughness_terms_;
+    std::vector<double> friction_transition_factors_;
+
     // the densities of segment fluids
     // we should not have this member variable
     std::vector<EvalWell> densities_;
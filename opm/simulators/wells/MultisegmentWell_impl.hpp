@@ -1284,6 +1284,7 @@ namespace Opm
     {
         if (!this->isOperableAndSolvable() && !this->wellIsStopped()) return true;
 
+        ++this->inner_solves_;
         const int max_iter_number = this->param_.max_inner_iter_ms_wells_;
 
         {
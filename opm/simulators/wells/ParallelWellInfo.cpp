@@ -23,6 +23,7 @@
 #include <opm/input/eclipse/Schedule/Well/Well.hpp>
 #include <opm/input/eclipse/Schedule/Well/WellConnections.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <iterator>
 #include <numeric>
@@ -652,4 +653,77 @@ CheckDistributedWellConnections::checkAllConnectionsFound()
     }
     return !missingCells;
 }
+
+void AggregatedWellSum::reset(const std::vector<int>& well_indices,
+                              const std::vector<std::reference_wrapper<ParallelWellInfo>>& local_wells,
+                              const std::size_t num_wells,
+                              const Parallel::Communication& comm)
+{
+    assert(well_indices.size() == local_wells.size());
+    comm_ = comm;
+    std::vector<int> distributed(num_wells, 0);
+    for (std::size_t w = 0; w < local_wells.size(); ++w) {
+        if (local_wells[w].get().communication().size() > 1) {
+            distributed[well_indices[w]] = 1;
+        }
+    }
+    if (comm_.size() > 1) {
+        comm_.max(distributed.data(), distributed.size());
+    }
+
+    // Slots are ordered by the schedule index, and hence agree on all ranks.
+    std::vector<int> global_slot(num_wells, -1);
+    num_slots_ = 0;
+    for (std::size_t w = 0; w < num_wells; ++w) {
+        if (distributed[w]) {
+            global_slot[w] = num_slots_++;
+        }
+    }
+    slot_.resize(local_wells.size());
+    for (std::size_t w = 0; w < local_wells.size(); ++w) {
+        slot_[w] = global_slot[well_indices[w]];
+    }
+    registered_.clear();
+}
+
+void AggregatedWellSum::begin(const std::size_t num_values)
+{
+    num_values_ = num_values;
+    registered_.clear();
+}
+
+void AggregatedWellSum::add(const std::size_t local_well, double* values)
+{
+    add(local_well, values, 0, num_values_);
+}
+
+void AggregatedWellSum::add(const std::size_t local_well, double* values,
+                            const std::size_t offset, const std::size_t count)
+{
+    assert(offset + count <= num_values_);
+    if (local_well < slot_.size() && slot_[local_well] >= 0) {
+        registered_.push_back({slot_[local_well], values, offset, count});
+    }
+}
+
+void AggregatedWellSum::end()
+{
+    if (num_slots_ == 0) {
+        registered_.clear();
+        return;
+    }
+
+    // Ranks without a part of a well contribute zeros to its slot.
+    buffer_.assign(num_slots_ * num_values_, 0.0);
+    for (const auto& [slot, values, offset, count] : registered_) {
+        std::copy(values, values + count, buffer_.begin() + slot * num_values_ + offset);
+    }
+    comm_.sum(buffer_.data(), buffer_.size());
+    for (const auto& [slot, values, offset, count] : registered_) {
+        const auto first = buffer_.begin() + slot * num_values_ + offset;
+        std::copy(first, first + count, values);
+    }
+    registered_.clear();
+}
+
 } // end namespace Opm
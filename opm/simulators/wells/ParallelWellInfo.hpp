@@ -27,7 +27,10 @@
 
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
+#include <functional>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace Opm
 {
@@ -354,6 +357,78 @@ private:
     const ParallelWellInfo& pwinfo_;
 };
 
+/// \brief Sums values of all distributed wells with one collective call.
+///
+/// Summing the values of a distributed well over its own communication
+/// costs one collective operation per well. This class gives each well that
+/// is split across ranks a slot in a common buffer, such that the values of
+/// all of them are summed with a single reduction over all ranks per well
+/// model stage. Values of wells living on one rank only are not communicated.
+class AggregatedWellSum
+{
+public:
+    /// \brief Determines the slots of the distributed wells.
+    ///
+    /// Collective over all ranks.
+    /// \param well_indices The index of each local well in the schedule.
+    /// \param local_wells The parallel information of each local well.
+    /// \param num_wells The number of wells in the schedule.
+    /// \param comm The communication with all ranks.
+    void reset(const std::vector<int>& well_indices,
+               const std::vector<std::reference_wrapper<ParallelWellInfo>>& local_wells,
+               std::size_t num_wells,
+               const Parallel::Communication& comm);
+
+    /// \brief Starts a summation with the given number of values per well.
+    void begin(std::size_t num_values);
+
+    /// \brief Registers the local values of a well.
+    ///
+    /// The values of a distributed well are replaced by their sums over all
+    /// ranks in end(), hence they need to stay valid until then.
+    /// \param local_well The index of the well among the local wells.
+    /// \param values The values of the well.
+    void add(std::size_t local_well, double* values);
+
+    /// \brief Registers local values of a well for a part of its slot.
+    ///
+    /// Lets a well contribute values kept in separate arrays. The parts
+    /// registered for one well must not overlap.
+    /// \param local_well The index of the well among the local wells.
+    /// \param values The values of the well.
+    /// \param offset The position of the values within the slot.
+    /// \param count The number of values.
+    void add(std::size_t local_well, double* values,
+             std::size_t offset, std::size_t count);
+
+    /// \brief Sums the values of all registered distributed wells.
+    ///
+    /// Collective over all ranks.
+    void end();
+
+    /// \brief Whether any well is distributed across ranks.
+    bool anyDistributed() const
+    {
+        return num_slots_ > 0;
+    }
+
+private:
+    Parallel::Communication comm_;
+    /// \brief Slot of each local well, -1 if it is not distributed.
+    std::vector<int> slot_;
+    std::size_t num_slots_{};
+    std::size_t num_values_{};
+    struct Registered
+    {
+        int slot;
+        double* values;
+        std::size_t offset;
+        std::size_t count;
+    };
+    std::vector<Registered> registered_;
+    std::vector<double> buffer_;
+};
+
 bool operator<(const ParallelWellInfo& well1, const ParallelWellInfo& well2);
 
 bool operator==(const ParallelWellInfo& well1, const ParallelWellInfo& well2);
@@ -27,7 +27,9 @@
 #include <opm/simulators/wells/RateConverter.hpp>
 #include <opm/simulators/wells/VFPInjProperties.hpp>
 #include <opm/simulators/wells/VFPProdProperties.hpp>
+#include <opm/simulators/wells/WellHelpers.hpp>
 #include <opm/simulators/wells/WellInterface.hpp>
+#include <opm/simulators/wells/WellIPRCurve.hpp>
 #include <opm/simulators/wells/WellProdIndexCalculator.hpp>
 #include <opm/simulators/wells/ParallelWellInfo.hpp>
 
@@ -248,6 +250,14 @@ namespace Opm
 
         int setPrimaryVars(std::vector<double>::const_iterator it) override;
 
+        std::vector<double>* deferredEquationEntries() override;
+
+        void finishDeferredAssembly(DeferredLogger& deferred_logger) override;
+
+        // Number of entries of deferredEquationEntries(), the well matrix
+        // D followed by the well residual.
+        static constexpr int numDeferredEntries = numStaticWellEq * (numStaticWellEq + 1);
+
     protected:
         bool regularize_;
 
@@ -441,6 +451,38 @@ namespace Opm
                                                       DeferredLogger& deferred_logger) const;
 
     private:
+        // The well matrix and residual of the last assembly, packed for the
+        // sum over the ranks sharing the well, empty if summed already.
+        std::vector<double> deferred_entries_;
+
+        // Rates as a function of the bhp for computeWellRatesWithBhp(), rebuilt
+        // when the reservoir state, the well solution or the connection
+        // pressures change.
+        mutable WellIPRCurve ipr_curve_;
+
+        // Whether the connection rates are piecewise linear in the bhp, i.e.
+        // the mobilities do not depend on the well solution.
+        bool canUseIPRCurve() const;
+
+        // The state of the connections the connection rates depend on.
+        std::vector<double> connectionStateKey(const Simulator& ebosSimulator) const;
+
+        void updateIPRCurve(const Simulator& ebosSimulator,
+                            const WellIPRCurve::Stamp& stamp,
+                            DeferredLogger& deferred_logger) const;
+
+        // The inputs the well equations last converged for in
+        // iterateWellEqWithControl(), empty if they may not be reused.
+        wellhelpers::StateKey converged_inner_key_;
+
+        // The well solution, the controls and the state of the connections
+        // the inner iterations depend on, empty if they depend on more.
+        wellhelpers::StateKey innerIterationKey(const Simulator& ebosSimulator,
+                                                const double dt,
+                                                const Well::InjectionControls& inj_controls,
+                                                const Well::ProductionControls& prod_controls,
+                                                const WellState& well_state) const;
+
         Eval connectionRateEnergy(const double maxOilSaturation,
                                   const std::vector<EvalWell>& cq_s,
                                   const IntensiveQuantities& intQuants,
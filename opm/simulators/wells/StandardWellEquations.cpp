@@ -101,6 +101,9 @@ init(const int num_cells,
         duneC_[0][cell_idx].resize(numWellEq, numEq);
     }
 
+    jacobianBlocks_.clear();
+    jacobianMatrix_ = nullptr;
+
     resWell_.resize(1);
     // the block size of resWell_ is also run-time determined now
     resWell_[0].resize(numWellEq);
@@ -255,19 +258,42 @@ extract(SparseMatrixAdapter& jacobian) const
     // D is diagonal
     // B and C have 1 row, nc colums and nonzero
     // at (0,j) only if this well has a perforation at cell j.
+
+    // The addresses of the blocks of A are looked up once per matrix, in
+    // the order in which the loops below visit them.
+    if (jacobianMatrix_ != &jacobian.istlMatrix()) {
+        jacobianBlocks_.clear();
+        jacobianBlocks_.reserve(duneC_.nonzeroes() * duneB_.nonzeroes());
+        for (auto colC = duneC_[0].begin(),
+                  endC = duneC_[0].end(); colC != endC; ++colC)
+        {
+            for (auto colB = duneB_[0].begin(),
+                      endB = duneB_[0].end(); colB != endB; ++colB)
+            {
+                jacobianBlocks_.push_back(jacobian.blockAddress(colC.index(), colB.index()));
+            }
+        }
+        jacobianMatrix_ = &jacobian.istlMatrix();
+    }
+
+    // D^-1 B does not depend on the row of A.
+    invDB_.resize(duneB_.nonzeroes());
+    auto invDB = invDB_.begin();
+    for (auto colB = duneB_[0].begin(),
+              endB = duneB_[0].end(); colB != endB; ++colB, ++invDB)
+    {
+        detail::multMatrix(invDuneD_[0][0], (*colB), *invDB);
+    }
+
     typename SparseMatrixAdapter::MatrixBlock tmpMat;
-    Dune::DynamicMatrix<Scalar> tmp;
+    auto block = jacobianBlocks_.begin();
     for (auto colC = duneC_[0].begin(),
               endC = duneC_[0].end(); colC != endC; ++colC)
     {
-        const auto row_index = colC.index();
-
-        for (auto colB = duneB_[0].begin(),
-                  endB = duneB_[0].end(); colB != endB; ++colB)
-        {
-            detail::multMatrix(invDuneD_[0][0], (*colB), tmp);
-            detail::negativeMultMatrixTransposed((*colC), tmp, tmpMat);
-            jacobian.addToBlock(row_index, colB.index(), tmpMat);
+        for (const auto& invDBcol : invDB_) {
+            detail::negativeMultMatrixTransposed((*colC), invDBcol, tmpMat);
+            **block += tmpMat;
+            ++block;
         }
     }
 }
@@ -399,6 +425,35 @@ sumDistributed(Parallel::Communication comm)
     wellhelpers::sumDistributedWellEntries(duneD_[0][0], resWell_[0], comm);
 }
 
+template<class Scalar, int numEq>
+void StandardWellEquations<Scalar,numEq>::
+packDistributed(std::vector<Scalar>& entries) const
+{
+    const auto& mat = duneD_[0][0];
+    const auto& vec = resWell_[0];
+    entries.clear();
+    entries.reserve(mat.N() * mat.M() + vec.size());
+    for (const auto& row : mat) {
+        entries.insert(entries.end(), row.begin(), row.end());
+    }
+    entries.insert(entries.end(), vec.begin(), vec.end());
+}
+
+template<class Scalar, int numEq>
+void StandardWellEquations<Scalar,numEq>::
+unpackDistributed(const std::vector<Scalar>& entries)
+{
+    auto& mat = duneD_[0][0];
+    auto& vec = resWell_[0];
+    assert(entries.size() == mat.N() * mat.M() + vec.size());
+    auto pos = entries.begin();
+    for (auto&& row : mat) {
+        std::copy(pos, pos + mat.M(), &(row[0]));
+        pos += mat.M();
+    }
+    std::copy(pos, entries.end(), &(vec[0]));
+}
+
 #define INSTANCE(N) \
 template class StandardWellEquations<double,N>; \
 template void StandardWellEquations<double,N>:: \
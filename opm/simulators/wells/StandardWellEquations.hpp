@@ -28,8 +28,10 @@
 #include <opm/common/TimingMacros.hpp>
 #include <dune/common/dynmatrix.hh>
 #include <dune/common/dynvector.hh>
+#include <dune/common/fmatrix.hh>
 #include <dune/istl/bcrsmatrix.hh>
 #include <dune/istl/bvector.hh>
+#include <vector>
 
 namespace Opm
 {
@@ -103,6 +105,8 @@ public:
 #endif
 
     //! \brief Add the matrices of this well to the sparse matrix adapter.
+    //! \details Only writes to the blocks coupling the perforated cells,
+    //!          hence wells without common cells may be added concurrently.
     template<class SparseMatrixAdapter>
     void extract(SparseMatrixAdapter& jacobian) const;
 
@@ -122,6 +126,14 @@ public:
     //! \brief Sum with off-process contribution.
     void sumDistributed(Parallel::Communication comm);
 
+    //! \brief Copy the entries summed by sumDistributed(), the D matrix
+    //!        followed by the residual, to contiguous memory.
+    //! \details Lets the caller sum several wells in one collective.
+    void packDistributed(std::vector<Scalar>& entries) const;
+
+    //! \brief Replace the entries by the ones from packDistributed().
+    void unpackDistributed(const std::vector<Scalar>& entries);
+
     //! \brief Returns a const reference to the residual.
     const BVectorWell& residual() const
     {
@@ -147,6 +159,11 @@ private:
     // several vector used in the matrix calculation
     mutable BVectorWell Bx_;
     mutable BVectorWell invDrw_;
+
+    // blocks of the reservoir matrix written by extract(), and the matrix they belong to
+    mutable std::vector<Dune::FieldMatrix<Scalar,numEq,numEq>*> jacobianBlocks_;
+    mutable const void* jacobianMatrix_ = nullptr;
+    mutable std::vector<OffDiagMatrixBlockWellType> invDB_;
 };
 
 }
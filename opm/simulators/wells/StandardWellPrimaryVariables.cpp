@@ -108,6 +108,7 @@ init()
                                      Indices::numEq + eqIdx);
 
     }
+    ++evaluation_stamp_;
 }
 
 template<class FluidSystem, class Indices, class Scalar>
@@ -117,6 +118,7 @@ resize(const int numWellEq)
     value_.resize(numWellEq, 0.0);
     evaluation_.resize(numWellEq, EvalWell{numWellEq + Indices::numEq, 0.0});
     numWellEq_ = numWellEq;
+    ++evaluation_stamp_;
 }
 
 template<class FluidSystem, class Indices, class Scalar>
@@ -27,6 +27,7 @@
 
 #include <opm/simulators/wells/StandardWellEquations.hpp>
 
+#include <cstdint>
 #include <vector>
 
 namespace Opm
@@ -147,6 +148,11 @@ public:
     void setValue(const int idx, const Scalar val)
     { value_[idx] = val; }
 
+    //! \brief Number of times the evaluations were set from the values.
+    //! \details Quantities computed from the evaluations stay valid while it is unchanged.
+    std::uint64_t evaluationStamp() const
+    { return evaluation_stamp_; }
+
 private:
     //! \brief Calculate a relaxation factor for producers.
     //! \details To avoid overshoot of the fractions which might result in negative rates.
@@ -171,6 +177,9 @@ private:
     //! \brief Total number of the well equations and primary variables.
     //! \details There might be extra equations be used, numWellEq will be updated during the initialization
     int numWellEq_ = numStaticWellEq;
+
+    //! \brief Incremented whenever the evaluations are set.
+    std::uint64_t evaluation_stamp_ = 0;
 };
 
 }
@@ -30,10 +30,12 @@
 #include <opm/simulators/wells/VFPHelpers.hpp>
 #include <opm/simulators/wells/WellBhpThpCalculator.hpp>
 #include <opm/simulators/wells/WellConvergence.hpp>
+#include <opm/simulators/wells/WellHelpers.hpp>
 
 #include <fmt/format.h>
 
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
 #include <functional>
 #include <numeric>
@@ -421,15 +423,23 @@ namespace Opm
         // Update the connection
         this->connectionRates_ = connectionRates;
 
-        // Accumulate dissolved gas and vaporized oil flow rates across all
-        // ranks sharing this well (this->index_of_well_).
-        {
-            const auto& comm = this->parallel_well_info_.communication();
-            comm.sum(ws.phase_mixing_rates.data(), ws.phase_mixing_rates.size());
-        }
+        // The dissolved gas and vaporized oil flow rates are only reported.
+        // They are accumulated across all ranks sharing this well for all
+        // wells at once by BlackoilWellModel::assembleWellEqWithoutIteration().
 
         // accumulate resWell_ and duneD_ in parallel to get effects of all perforations (might be distributed)
-        this->linSys_.sumDistributed(this->parallel_well_info_.communication());
+        // The caller may sum them together with the other wells instead, in
+        // which case only one of the ranks adds the source and the control
+        // equations below.
+        const auto& comm = this->parallel_well_info_.communication();
+        const bool defer = this->defer_distributed_sum_ && comm.size() > 1 &&
+                           this->primary_variables_.numWellEq() == numStaticWellEq;
+        deferred_entries_.clear();
+        if (!defer) {
+            this->linSys_.sumDistributed(comm);
+        } else if (!this->parallel_well_info_.isOwner()) {
+            this->linSys_.packDistributed(deferred_entries_);
+        }
 
         // add vol * dF/dt + Q to the well equations;
         for (int componentIdx = 0; componentIdx < numWellConservationEq; ++componentIdx) {
@@ -460,6 +470,45 @@ namespace Opm
                               this->linSys_,
                               deferred_logger);
 
+        if (defer) {
+            if (this->parallel_well_info_.isOwner()) {
+                this->linSys_.packDistributed(deferred_entries_);
+            }
+            return;
+        }
+
+        // do the local inversion of D.
+        try {
+            this->linSys_.invert();
+        } catch( ... ) {
+            OPM_DEFLOG_THROW(NumericalProblem, "Error when inverting local well equations for well " + name(), deferred_logger);
+        }
+    }
+
+
+
+
+    template<typename TypeTag>
+    std::vector<double>*
+    StandardWell<TypeTag>::
+    deferredEquationEntries()
+    {
+        return deferred_entries_.empty() ? nullptr : &deferred_entries_;
+    }
+
+
+
+
+    template<typename TypeTag>
+    void
+    StandardWell<TypeTag>::
+    finishDeferredAssembly(DeferredLogger& deferred_logger)
+    {
+        if (deferred_entries_.empty()) {
+            return;
+        }
+        this->linSys_.unpackDistributed(deferred_entries_);
+        deferred_entries_.clear();
 
         // do the local inversion of D.
         try {
@@ -822,8 +871,16 @@ namespace Opm
                 this->ipr_b_[comp_idx] += ipr_b_perf[comp_idx];
             }
         }
-        this->parallel_well_info_.communication().sum(this->ipr_a_.data(), this->ipr_a_.size());
-        this->parallel_well_info_.communication().sum(this->ipr_b_.data(), this->ipr_b_.size());
+        const auto& comm = this->parallel_well_info_.communication();
+        if (comm.size() > 1) {
+            // Sum both coefficients in one collective.
+            const std::size_t num_comp = this->ipr_a_.size();
+            std::vector<double> ipr(this->ipr_a_);
+            ipr.insert(ipr.end(), this->ipr_b_.begin(), this->ipr_b_.end());
+            comm.sum(ipr.data(), ipr.size());
+            std::copy(ipr.begin(), ipr.begin() + num_comp, this->ipr_a_.begin());
+            std::copy(ipr.begin() + num_comp, ipr.end(), this->ipr_b_.begin());
+        }
     }
 
 
@@ -1225,6 +1282,8 @@ namespace Opm
                                              solventMobility,
                                              props,
                                              deferred_logger);
+        // The break points of the curve depend on the connection pressures.
+        ipr_curve_.invalidate();
     }
 
 
@@ -1353,6 +1412,25 @@ namespace Opm
         const int np = this->number_of_phases_;
         well_flux.resize(np, 0.0);
 
+        if (this->canUseIPRCurve()) {
+            const WellIPRCurve::Stamp stamp{ebosSimulator.problem().wellModel().reservoirStateStamp(),
+                                            this->primary_variables_.evaluationStamp()};
+            // A single query for a state is cheaper to evaluate connection by
+            // connection than to tabulate.
+            if (!ipr_curve_.isValid(stamp) && ipr_curve_.repeatedQuery(stamp)) {
+                this->updateIPRCurve(ebosSimulator, stamp, deferred_logger);
+            }
+            if (ipr_curve_.isValid(stamp)) {
+                std::vector<double> cq_s;
+                ipr_curve_.rates(bhp, cq_s);
+                for (int p = 0; p < np; ++p) {
+                    well_flux[this->ebosCompIdxToFlowCompIdx(p)] += cq_s[p];
+                }
+                this->parallel_well_info_.communication().sum(well_flux.data(), well_flux.size());
+                return;
+            }
+        }
+
         const bool allow_cf = this->getAllowCrossFlow();
 
         for (int perf = 0; perf < this->number_of_perforations_; ++perf) {
@@ -1378,6 +1456,179 @@ namespace Opm
 
 
 
+    template<typename TypeTag>
+    bool
+    StandardWell<TypeTag>::
+    canUseIPRCurve() const
+    {
+        // Polymer shear thinning and injection multipliers make the mobilities
+        // depend on the rates or the bhp, and filter cake multipliers, solvent
+        // and zFraction properties are not part of the key.
+        if constexpr (has_polymer || has_polymermw || has_solvent || has_zFraction) {
+            return false;
+        }
+        return !(this->isInjector() &&
+                 (this->well_ecl_.getInjMultMode() != Well::InjMultMode::NONE ||
+                  !this->inj_fc_multiplier_.empty()));
+    }
+
+
+
+
+    template<typename TypeTag>
+    std::vector<double>
+    StandardWell<TypeTag>::
+    connectionStateKey(const Simulator& ebosSimulator) const
+    {
+        std::vector<double> key;
+        key.reserve(2 + this->num_components_ + this->number_of_perforations_ * (7 + 3 * FluidSystem::numPhases));
+        key.push_back(this->isInjector());
+        key.push_back(this->getAllowCrossFlow());
+        // The mixture in the wellbore determines the rates of injecting connections.
+        for (int componentIdx = 0; componentIdx < this->numComponents(); ++componentIdx) {
+            key.push_back(getValue(this->primary_variables_.surfaceVolumeFraction(componentIdx)));
+        }
+        for (int perf = 0; perf < this->number_of_perforations_; ++perf) {
+            const int cell_idx = this->well_cells_[perf];
+            const auto& intQuants = ebosSimulator.model().intensiveQuantities(cell_idx, /*timeIdx=*/ 0);
+            const auto& fs = intQuants.fluidState();
+            key.push_back(this->getPerfCellPressure(fs).value());
+            key.push_back(this->connections_.pressure_diff(perf));
+            key.push_back(this->well_index_[perf] *
+                          ebosSimulator.problem().template rockCompTransMultiplier<double>(intQuants, cell_idx));
+            // The saturations cover the mobilities of connections with their
+            // own saturation table.
+            for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
+                if (!FluidSystem::phaseIsActive(phaseIdx)) {
+                    continue;
+                }
+                key.push_back(fs.saturation(phaseIdx).value());
+                key.push_back(intQuants.mobility(phaseIdx).value());
+                key.push_back(fs.invB(phaseIdx).value());
+            }
+            key.push_back(fs.Rs().value());
+            key.push_back(fs.Rv().value());
+            key.push_back(fs.Rvw().value());
+            key.push_back(fs.Rsw().value());
+        }
+        return key;
+    }
+
+
+
+
+    template<typename TypeTag>
+    wellhelpers::StateKey
+    StandardWell<TypeTag>::
+    innerIterationKey(const Simulator& ebosSimulator,
+                      const double dt,
+                      const Well::InjectionControls& inj_controls,
+                      const Well::ProductionControls& prod_controls,
+                      const WellState& well_state) const
+    {
+        // Group controlled wells also depend on the other wells of their groups,
+        // and the state of the connections misses the temperature and the
+        // properties of the energy, foam, brine and MICP models.
+        if constexpr (has_energy || has_foam || has_brine || has_micp) {
+            return {};
+        }
+        const auto& ws = well_state.well(this->index_of_well_);
+        if (!this->canUseIPRCurve() ||
+            (this->isInjector() ? ws.injection_cmode == Well::InjectorCMode::GRUP
+                                : ws.production_cmode == Well::ProducerCMode::GRUP)) {
+            return {};
+        }
+
+        // The THP equation uses the limit from the network balancing when
+        // there is one, not the one of the schedule.
+        const double thp_limit = this->getTHPConstraint(ebosSimulator.vanguard().summaryState());
+        const bool use_vfpexplicit = this->useVfpExplicit();
+        wellhelpers::StateKey key;
+        auto& exact = key.exact;
+        exact.push_back(dt);
+        exact.push_back(this->wellIsStopped());
+        exact.push_back(use_vfpexplicit);
+        if (this->isInjector()) {
+            exact.push_back(static_cast<int>(ws.injection_cmode));
+            exact.insert(exact.end(), {inj_controls.surface_rate, inj_controls.reservoir_rate,
+                                       inj_controls.bhp_limit, thp_limit});
+        } else {
+            exact.push_back(static_cast<int>(ws.production_cmode));
+            exact.insert(exact.end(), {prod_controls.oil_rate, prod_controls.water_rate,
+                                       prod_controls.gas_rate, prod_controls.liquid_rate,
+                                       prod_controls.resv_rate, prod_controls.bhp_limit,
+                                       thp_limit, this->getALQ(well_state)});
+            // The explicit water and gas fractions of the THP equation come
+            // from the rates of the previous time step.
+            if (use_vfpexplicit && prod_controls.vfp_table_number > 0) {
+                const auto* vfp_properties = this->vfpProperties();
+                exact.push_back(vfp_properties->getExplicitWFR(prod_controls.vfp_table_number, this->indexOfWell()));
+                exact.push_back(vfp_properties->getExplicitGFR(prod_controls.vfp_table_number, this->indexOfWell()));
+            }
+        }
+        key.scaled = this->connectionStateKey(ebosSimulator);
+        const auto primary_vars = this->getPrimaryVars();
+        key.scaled.insert(key.scaled.end(), primary_vars.begin(), primary_vars.end());
+        return key;
+    }
+
+
+
+
+    template<typename TypeTag>
+    void
+    StandardWell<TypeTag>::
+    updateIPRCurve(const Simulator& ebosSimulator,
+                   const WellIPRCurve::Stamp& stamp,
+                   DeferredLogger& deferred_logger) const
+    {
+        ipr_curve_.reset(this->num_components_, stamp);
+        const bool allow_cf = this->getAllowCrossFlow();
+        // Rates are evaluated at a drawdown of one bar on either side of
+        // the bhp where the drawdown of the connection is zero.
+        const double dp = 1.0 * unit::barsa;
+        std::vector<Scalar> mob(this->num_components_, 0.);
+        std::vector<Scalar> prod(this->num_components_, 0.);
+        std::vector<Scalar> inj(this->num_components_, 0.);
+        for (int perf = 0; perf < this->number_of_perforations_; ++perf) {
+            const int cell_idx = this->well_cells_[perf];
+            const auto& intQuants = ebosSimulator.model().intensiveQuantities(cell_idx, /*timeIdx=*/ 0);
+            getMobility(ebosSimulator, perf, mob, deferred_logger);
+            double trans_mult = ebosSimulator.problem().template rockCompTransMultiplier<double>(intQuants, cell_idx);
+            const double Tw = this->well_index_[perf] * trans_mult;
+
+            const double pressure = this->getPerfCellPressure(intQuants.fluidState()).value();
+            const double h_perf = this->connections_.pressure_diff(perf);
+            const double break_bhp = pressure - h_perf;
+            PerforationRates perf_rates;
+
+            // Scale with the drawdown as computed by computePerfRate().
+            const double bhp_prod = break_bhp - dp;
+            std::fill(prod.begin(), prod.end(), 0.);
+            computePerfRate(intQuants, mob, bhp_prod, Tw, perf, allow_cf,
+                            prod, perf_rates, deferred_logger);
+            const double drawdown_prod = pressure - (bhp_prod + h_perf);
+            for (auto& rate : prod) {
+                rate /= drawdown_prod;
+            }
+
+            const double bhp_inj = break_bhp + dp;
+            std::fill(inj.begin(), inj.end(), 0.);
+            computePerfRate(intQuants, mob, bhp_inj, Tw, perf, allow_cf,
+                            inj, perf_rates, deferred_logger);
+            const double drawdown_inj = pressure - (bhp_inj + h_perf);
+            for (auto& rate : inj) {
+                rate /= -drawdown_inj;
+            }
+
+            ipr_curve_.addConnection(break_bhp, prod, inj);
+        }
+        ipr_curve_.finalize();
+    }
+
+
+
+
     template<typename TypeTag>
     void
     StandardWell<TypeTag>::
@@ -2117,6 +2368,21 @@ namespace Opm
         bool relax_convergence = false;
         this->regularize_ = false;
         const auto& summary_state = ebosSimulator.vanguard().summaryState();
+        ++this->inner_solves_;
+
+        // Skip the iterations if nothing they depend on changed noticeably
+        // since they last converged.
+        const double tol = this->param_.inner_iter_wells_skip_tolerance_;
+        wellhelpers::StateKey key;
+        if (tol > 0.0) {
+            key = this->innerIterationKey(ebosSimulator, dt, inj_controls, prod_controls, well_state);
+            if (wellhelpers::keysAgree(key, converged_inner_key_, tol)) {
+                ++this->skipped_inner_solves_;
+                return true;
+            }
+            converged_inner_key_.clear();
+        }
+
         do {
             assembleWellEqWithoutIteration(ebosSimulator, dt, inj_controls, prod_controls, well_state, group_state, deferred_logger);
 
@@ -2143,6 +2409,11 @@ namespace Opm
             initPrimaryVariablesEvaluation();
         } while (it < max_iter);
 
+        if (converged && !key.empty()) {
+            converged_inner_key_ = it == 0
+                ? std::move(key)
+                : this->innerIterationKey(ebosSimulator, dt, inj_controls, prod_controls, well_state);
+        }
         return converged;
     }
 
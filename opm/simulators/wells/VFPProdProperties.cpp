@@ -98,6 +98,35 @@ double VFPProdProperties::bhp(int table_id,
 }
 
 
+std::array<double, 5>
+VFPProdProperties::bhpAndDerivatives(const int table_id,
+                                     const double aqua,
+                                     const double liquid,
+                                     const double vapour,
+                                     const double thp,
+                                     const double alq,
+                                     const double explicit_wfr,
+                                     const double explicit_gfr,
+                                     const bool   use_expvfp) const
+{
+    // The rate derivatives are the ones of the evaluation overload, the
+    // thp derivative comes directly from the interpolation.
+    using Eval = DenseAd::Evaluation<double, 3>;
+    const Eval bhp_eval = this->bhp(table_id,
+                                    Eval::createVariable(aqua, 0),
+                                    Eval::createVariable(liquid, 1),
+                                    Eval::createVariable(vapour, 2),
+                                    thp, alq, explicit_wfr, explicit_gfr, use_expvfp);
+
+    const VFPProdTable& table = detail::getTable(m_tables, table_id);
+    const detail::VFPEvaluation retval = detail::bhp(table, aqua, liquid, vapour, thp, alq,
+                                                     explicit_wfr, explicit_gfr, use_expvfp);
+
+    return {retval.value, bhp_eval.derivative(0), bhp_eval.derivative(1),
+            bhp_eval.derivative(2), retval.dthp};
+}
+
+
 const VFPProdTable& VFPProdProperties::getTable(const int table_id) const {
     return detail::getTable(m_tables, table_id);
 }
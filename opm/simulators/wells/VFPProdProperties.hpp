@@ -20,6 +20,7 @@
 #ifndef OPM_AUTODIFF_VFPPRODPROPERTIES_HPP_
 #define OPM_AUTODIFF_VFPPRODPROPERTIES_HPP_
 
+#include <array>
 #include <functional>
 #include <map>
 #include <vector>
@@ -92,6 +93,29 @@ public:
             const double& explicit_gfr,
             const bool    use_expvfp) const;
 
+    /**
+     * Linear interpolation of bhp as a function of the input parameters,
+     * together with its derivatives
+     * @param table_id Table number to use
+     * @param aqua Water phase
+     * @param liquid Oil phase
+     * @param vapour Gas phase
+     * @param thp Tubing head pressure
+     * @param alq Artificial lift or other parameter
+     *
+     * @return The bottom hole pressure as for bhp(), followed by its derivatives
+     * with respect to aqua, liquid, vapour and thp.
+     */
+    std::array<double, 5> bhpAndDerivatives(const int table_id,
+                                            const double aqua,
+                                            const double liquid,
+                                            const double vapour,
+                                            const double thp,
+                                            const double alq,
+                                            const double explicit_wfr,
+                                            const double explicit_gfr,
+                                            const bool   use_expvfp) const;
+
     /**
      * Linear interpolation of thp as a function of the input parameters
      * @param table_id Table number to use
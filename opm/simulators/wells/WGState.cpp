@@ -48,6 +48,13 @@ void WGState::wtest_state(WellTestState wtest_state)
     this->well_test_state = std::move(wtest_state);
 }
 
+void WGState::syncFrom(const WGState& other)
+{
+    this->well_state.syncFrom(other.well_state);
+    this->group_state = other.group_state;
+    this->well_test_state = other.well_test_state;
+}
+
 bool WGState::operator==(const WGState& rhs) const
 {
     return this->well_state == rhs.well_state &&
@@ -41,6 +41,10 @@ struct WGState {
 
     void wtest_state(WellTestState wtest_state);
 
+    /// Make this state equal to other, copying only the modified wells
+    /// of the well state.
+    void syncFrom(const WGState& other);
+
     WellState well_state;
     GroupState group_state;
     WellTestState well_test_state;
@@ -39,8 +39,10 @@
 #include <opm/simulators/wells/WellHelpers.hpp>
 #include <opm/simulators/wells/WellInterfaceGeneric.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <optional>
 
 #include <fmt/format.h>
@@ -387,6 +389,34 @@ calculateBhpFromThp(const WellState& well_state,
     return bhp_tab - dp_hydro + bhp_adjustment;
 }
 
+std::optional<std::array<double, 3>>
+WellBhpThpCalculator::
+thpRateSensitivities(const std::array<double, 3>& ipr_b,
+                     const std::array<double, 5>& bhp_and_derivatives)
+{
+    if (std::all_of(ipr_b.begin(), ipr_b.end(), [](const double b) { return b == 0.0; })) {
+        return std::nullopt;
+    }
+
+    // The negative rates of the VFP convention change with b * bhp, so
+    // bhp(thp) = vfp(rates(bhp), thp) gives
+    // dbhp/dthp = dvfp/dthp / (1 - sum_p dvfp/drate_p * b_p).
+    double denominator = 1.0;
+    for (std::size_t p = 0; p < ipr_b.size(); ++p) {
+        denominator -= bhp_and_derivatives[1 + p] * ipr_b[p];
+    }
+    if (denominator <= 0.0) {
+        return std::nullopt;
+    }
+    const double dbhp_dthp = bhp_and_derivatives[4] / denominator;
+
+    std::array<double, 3> sensitivities{};
+    for (std::size_t p = 0; p < ipr_b.size(); ++p) {
+        sensitivities[p] = -ipr_b[p] * dbhp_dthp;
+    }
+    return sensitivities;
+}
+
 double WellBhpThpCalculator::getVfpBhpAdjustment(const double bhp_tab, const double thp_limit) const
 {
     return well_.wellEcl().getWVFPDP().getPressureLoss(bhp_tab, thp_limit);
@@ -24,6 +24,7 @@
 #ifndef OPM_WELL_BPH_THP_CALCULATOR_HEADER_INCLUDED
 #define OPM_WELL_BPH_THP_CALCULATOR_HEADER_INCLUDED
 
+#include <array>
 #include <functional>
 #include <optional>
 #include <string>
@@ -90,6 +91,15 @@ public:
                    const SummaryState& summary_state,
                    DeferredLogger& deferred_logger) const;
 
+    //! \brief Derivatives of the surface production rates with respect to the THP.
+    //! \details The IPR gives the surface rates a - b * bhp of the canonical
+    //! phases, the VFP table the bhp followed by its derivatives with respect
+    //! to the aqua, liquid and vapour rates (negative for producers) and the THP.
+    //! Empty if the rates do not respond or the linearization has no solution.
+    static std::optional<std::array<double, 3>>
+    thpRateSensitivities(const std::array<double, 3>& ipr_b,
+                         const std::array<double, 5>& bhp_and_derivatives);
+
   template<class EvalWell>
   EvalWell calculateBhpFromThp(const WellState& well_state,
                                const std::vector<EvalWell>& rates,
@@ -20,6 +20,8 @@
 #ifndef OPM_WELL_CONTAINER_HEADER_INCLUDED
 #define OPM_WELL_CONTAINER_HEADER_INCLUDED
 
+#include <atomic>
+#include <cstddef>
 #include <initializer_list>
 #include <optional>
 #include <stdexcept>
@@ -39,6 +41,14 @@ namespace Opm {
   The class is created to facilitate safe and piecewise refactoring of the
   WellState class, and might have a short life in the
   development timeline.
+
+  Every element carries a version stamp which is renewed whenever the element
+  is handed out for modification, i.e. on non-const access. Two containers
+  which hold the same element version hold the same value, so a snapshot can
+  be brought up to date with sync_from() by copying only the elements which
+  have been accessed for modification since the snapshot was taken. Observe
+  that this assumes that non-const references are not kept around across
+  calls to sync_from().
 */
 
 
@@ -57,6 +67,7 @@ public:
         WellContainer<T> result;
 
         result.m_data = {data};
+        result.m_version = {next_version()};
         result.index_map = {{"test1", 1}, {"test2", 4}};
 
         return result;
@@ -76,6 +87,7 @@ public:
 
         this->index_map.emplace(name, this->m_data.size());
         this->m_data.push_back(std::forward<T>(value));
+        this->m_version.push_back(next_version());
         return this->m_data.back();
     }
 
@@ -85,6 +97,7 @@ public:
 
         this->index_map.emplace(name, this->m_data.size());
         this->m_data.push_back(value);
+        this->m_version.push_back(next_version());
         return this->m_data.back();
     }
 
@@ -97,9 +110,10 @@ public:
       in both containers.
     */
     void copy_welldata(const WellContainer<T>& other) {
-        if (this->index_map == other.index_map)
+        if (this->index_map == other.index_map) {
             this->m_data = other.m_data;
-        else {
+            this->m_version = other.m_version;
+        } else {
             for (const auto& [name, index] : this->index_map)
                 this->update_if(index, name, other);
         }
@@ -113,10 +127,46 @@ public:
         auto this_index = this->index_map.at(name);
         auto other_index = other.index_map.at(name);
         this->m_data[this_index] = other.m_data[other_index];
+        this->m_version[this_index] = other.m_version[other_index];
+    }
+
+    /*
+      Will make this container equal to other. If both containers hold the
+      same wells only the elements whose version differs, i.e. which have been
+      accessed for modification since the containers were last synchronized,
+      are copied; otherwise the complete container is copied. Returns the
+      number of copied elements.
+    */
+    std::size_t sync_from(const WellContainer<T>& other) {
+        if (this->index_map != other.index_map) {
+            *this = other;
+            return this->m_data.size();
+        }
+
+        std::size_t copied = 0;
+        for (std::size_t index = 0; index < this->m_data.size(); ++index) {
+            if (this->m_version[index] != other.m_version[index]) {
+                this->m_data[index] = other.m_data[index];
+                this->m_version[index] = other.m_version[index];
+                ++copied;
+            }
+        }
+        return copied;
+    }
+
+    /*
+      Will give all elements a new version, e.g. after they have been
+      modified without going through the non-const accessors.
+    */
+    void mark_modified() {
+        for (auto& version : this->m_version)
+            version = next_version();
     }
 
     T& operator[](std::size_t index) {
-        return this->m_data.at(index);
+        auto& value = this->m_data.at(index);
+        this->m_version[index] = next_version();
+        return value;
     }
 
     const T& operator[](std::size_t index) const {
@@ -125,6 +175,7 @@ public:
 
     T& operator[](const std::string& name) {
         auto index = this->index_map.at(name);
+        this->m_version[index] = next_version();
         return this->m_data[index];
     }
 
@@ -135,6 +186,7 @@ public:
 
     void clear() {
         this->m_data.clear();
+        this->m_version.clear();
         this->index_map.clear();
     }
 
@@ -180,6 +232,10 @@ public:
     {
         serializer(m_data);
         serializer(index_map);
+        if (!serializer.isSerializing()) {
+            this->m_version.resize(this->m_data.size());
+            this->mark_modified();
+        }
     }
 
     bool operator==(const WellContainer<T>& rhs) const
@@ -196,10 +252,17 @@ private:
 
         auto other_index = other_iter->second;
         this->m_data[index] = other.m_data[other_index];
+        this->m_version[index] = other.m_version[other_index];
+    }
+
+    static std::size_t next_version() {
+        static std::atomic<std::size_t> counter{0};
+        return ++counter;
     }
 
 
     std::vector<T> m_data;
+    std::vector<std::size_t> m_version;
     std::unordered_map<std::string, std::size_t> index_map;
 };
 
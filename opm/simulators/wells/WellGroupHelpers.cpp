@@ -41,9 +41,14 @@
 #include <opm/simulators/wells/VFPProdProperties.hpp>
 #include <opm/simulators/wells/WellState.hpp>
 
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/dynvector.hh>
+
 #include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
+#include <limits>
 #include <set>
 #include <stack>
 #include <stdexcept>
@@ -121,6 +126,66 @@ namespace {
         }
         return rate;
     }
+
+    // Finds all leaf nodes of the network, and returns a vector of all
+    // nodes, ordered so that a child is always after its parent.
+    std::vector<std::string>
+    networkRootToChildNodes(const Opm::Network::ExtNetwork& network,
+                            std::set<std::string>& leaf_nodes)
+    {
+        std::stack<std::string> children;
+        std::vector<std::string> root_to_child_nodes;
+        children.push(network.root().name());
+        while (!children.empty()) {
+            const auto node = children.top();
+            children.pop();
+            root_to_child_nodes.push_back(node);
+            auto branches = network.downtree_branches(node);
+            if (branches.empty()) {
+                leaf_nodes.insert(node);
+            }
+            for (const auto& branch : branches) {
+                children.push(branch.downtree_node());
+            }
+        }
+        assert(children.empty());
+        return root_to_child_nodes;
+    }
+
+    // Flow rates into the leaf nodes of the network from the corresponding groups.
+    std::map<std::string, std::vector<double>>
+    networkLeafInflows(const Opm::Network::ExtNetwork& network,
+                       const std::set<std::string>& leaf_nodes,
+                       const Opm::WellState& well_state,
+                       const Opm::GroupState& group_state,
+                       const Opm::Schedule& schedule,
+                       const int report_time_step)
+    {
+        using Opm::BlackoilPhases;
+
+        std::map<std::string, std::vector<double>> node_inflows;
+        for (const auto& node : leaf_nodes) {
+            node_inflows[node] = group_state.production_rates(node);
+            // Add the ALQ amounts to the gas rates if requested.
+            if (network.node(node).add_gas_lift_gas()) {
+                const auto& group = schedule.getGroup(node, report_time_step);
+                for (const std::string& wellname : group.wells()) {
+                    const Opm::Well& well = schedule.getWell(wellname, report_time_step);
+                    // Here we use the efficiency unconditionally, but if WEFAC item 3
+                    // for the well is false (it defaults to true) then we should NOT use
+                    // the efficiency factor. Fixing this requires not only changing the
+                    // code here, but also:
+                    //    - Adding a member to the well for this flag, and setting it in Schedule::handleWEFAC().
+                    //    - Making the wells' maximum flows (i.e. not time-averaged by using a efficiency factor)
+                    //      available and using those (for wells with WEFAC(3) true only) when accumulating group
+                    //      rates, but ONLY for network calculations.
+                    const double efficiency = well.getEfficiencyFactor();
+                    node_inflows[node][BlackoilPhases::Vapour] += well_state.getALQ(wellname) * efficiency;
+                }
+            }
+        }
+        return node_inflows;
+    }
 } // namespace Anonymous
 
 namespace Opm
@@ -628,7 +693,7 @@ namespace WellGroupHelpers
                     rates[phase] = sign * ws.surface_rates[phase];
                 }
             }
-            wellState.setCurrentWellRates(wellName, rates);
+            wellState.setCurrentWellRates(wellState.globalWellIndex(wellName), rates);
         }
     }
 
@@ -787,50 +852,13 @@ namespace WellGroupHelpers
 
         // Fixed pressure nodes of the network are the roots of trees.
         // Leaf nodes must correspond to groups in the group structure.
-        // Let us first find all leaf nodes of the network. We also
-        // create a vector of all nodes, ordered so that a child is
-        // always after its parent.
-        std::stack<std::string> children;
         std::set<std::string> leaf_nodes;
-        std::vector<std::string> root_to_child_nodes;
-        children.push(network.root().name());
-        while (!children.empty()) {
-            const auto node = children.top();
-            children.pop();
-            root_to_child_nodes.push_back(node);
-            auto branches = network.downtree_branches(node);
-            if (branches.empty()) {
-                leaf_nodes.insert(node);
-            }
-            for (const auto& branch : branches) {
-                children.push(branch.downtree_node());
-            }
-        }
-        assert(children.empty());
+        const auto root_to_child_nodes = networkRootToChildNodes(network, leaf_nodes);
 
         // Starting with the leaf nodes of the network, get the flow rates
         // from the corresponding groups.
-        std::map<std::string, std::vector<double>> node_inflows;
-        for (const auto& node : leaf_nodes) {
-            node_inflows[node] = group_state.production_rates(node);
-            // Add the ALQ amounts to the gas rates if requested.
-            if (network.node(node).add_gas_lift_gas()) {
-                const auto& group = schedule.getGroup(node, report_time_step);
-                for (const std::string& wellname : group.wells()) {
-                    const Well& well = schedule.getWell(wellname, report_time_step);
-                    // Here we use the efficiency unconditionally, but if WEFAC item 3
-                    // for the well is false (it defaults to true) then we should NOT use
-                    // the efficiency factor. Fixing this requires not only changing the
-                    // code here, but also:
-                    //    - Adding a member to the well for this flag, and setting it in Schedule::handleWEFAC().
-                    //    - Making the wells' maximum flows (i.e. not time-averaged by using a efficiency factor)
-                    //      available and using those (for wells with WEFAC(3) true only) when accumulating group
-                    //      rates, but ONLY for network calculations.
-                    const double efficiency = well.getEfficiencyFactor();
-                    node_inflows[node][BlackoilPhases::Vapour] += well_state.getALQ(wellname) * efficiency;
-                }
-            }
-        }
+        auto node_inflows = networkLeafInflows(network, leaf_nodes, well_state, group_state,
+                                               schedule, report_time_step);
 
         // Accumulate in the network, towards the roots. Note that a
         // root (i.e. fixed pressure node) can still be contributing
@@ -902,6 +930,179 @@ namespace WellGroupHelpers
         return node_pressures;
     }
 
+    std::map<std::string, double>
+    computeNetworkPressuresNewton(const Opm::Network::ExtNetwork& network,
+                                  const WellState& well_state,
+                                  const GroupState& group_state,
+                                  const VFPProdProperties& vfp_prod_props,
+                                  const Schedule& schedule,
+                                  const int report_time_step,
+                                  const std::map<std::string, double>& reference_pressures,
+                                  const std::map<std::string, std::vector<double>>& leaf_sensitivities,
+                                  const int max_iterations,
+                                  const double tolerance)
+    {
+        if (!network.active()) {
+            return {};
+        }
+
+        std::set<std::string> leaf_nodes;
+        const auto root_to_child_nodes = networkRootToChildNodes(network, leaf_nodes);
+        const auto leaf_inflows = networkLeafInflows(network, leaf_nodes, well_state, group_state,
+                                                     schedule, report_time_step);
+
+        // The unknowns are the pressures of the nodes without a fixed
+        // pressure, starting from the reference pressures the rates
+        // were computed with.
+        std::map<std::string, int> unknown_index;
+        std::map<std::string, double> node_pressures;
+        for (const auto& node : root_to_child_nodes) {
+            const auto press = network.node(node).terminal_pressure();
+            if (press) {
+                node_pressures[node] = *press;
+                continue;
+            }
+            const auto ref = reference_pressures.find(node);
+            if (ref == reference_pressures.end()) {
+                return {};
+            }
+            node_pressures[node] = ref->second;
+            const int index = unknown_index.size();
+            unknown_index[node] = index;
+        }
+
+        // Leaf nodes in the subtree of each node.
+        auto child_to_root_nodes = root_to_child_nodes;
+        std::reverse(child_to_root_nodes.begin(), child_to_root_nodes.end());
+        std::map<std::string, std::vector<std::string>> subtree_leaves;
+        for (const auto& node : child_to_root_nodes) {
+            auto& leaves = subtree_leaves[node];
+            if (leaf_nodes.count(node) > 0) {
+                leaves.push_back(node);
+            }
+            const auto upbranch = network.uptree_branch(node);
+            if (upbranch) {
+                auto& up = subtree_leaves[(*upbranch).uptree_node()];
+                up.insert(up.end(), leaves.begin(), leaves.end());
+            }
+        }
+
+        const std::size_t num_unknowns = unknown_index.size();
+        Dune::DynamicMatrix<double> jacobian(num_unknowns, num_unknowns);
+        Dune::DynamicVector<double> residual(num_unknowns);
+        Dune::DynamicVector<double> update(num_unknowns);
+        for (int iteration = 0; iteration < max_iterations; ++iteration) {
+            // Leaf rates linearized in the leaf pressures by the responses
+            // of the wells under THP control, and their derivatives.
+            std::map<std::string, std::vector<double>> node_inflows;
+            std::map<std::string, std::vector<double>> leaf_derivatives;
+            for (const auto& [node, inflow] : leaf_inflows) {
+                auto& rates = node_inflows[node];
+                auto& derivatives = leaf_derivatives[node];
+                rates = inflow;
+                derivatives.assign(rates.size(), 0.0);
+                const auto sens = leaf_sensitivities.find(node);
+                const auto ref = reference_pressures.find(node);
+                if (sens == leaf_sensitivities.end() || ref == reference_pressures.end()) {
+                    continue;
+                }
+                const double dp = node_pressures[node] - ref->second;
+                for (std::size_t ii = 0; ii < rates.size() && ii < sens->second.size(); ++ii) {
+                    rates[ii] += sens->second[ii] * dp;
+                    derivatives[ii] = sens->second[ii];
+                    if (rates[ii] < 0.0) {
+                        rates[ii] = 0.0;
+                        derivatives[ii] = 0.0;
+                    }
+                }
+            }
+            for (const auto& node : child_to_root_nodes) {
+                const auto upbranch = network.uptree_branch(node);
+                if (upbranch) {
+                    std::vector<double>& up = node_inflows[(*upbranch).uptree_node()];
+                    const std::vector<double>& down = node_inflows[node];
+                    if (up.empty()) {
+                        up = down;
+                    } else {
+                        assert (up.size() == down.size());
+                        for (std::size_t ii = 0; ii < up.size(); ++ii) {
+                            up[ii] += down[ii];
+                        }
+                    }
+                }
+            }
+
+            // Residual p - bhp(rates, p_parent) of every unknown node and its
+            // derivatives with respect to the node itself, the parent node and
+            // the leaf nodes of its subtree.
+            jacobian = 0.0;
+            for (const auto& [node, row] : unknown_index) {
+                const auto upbranch = network.uptree_branch(node);
+                assert(upbranch);
+                const auto& up_node = (*upbranch).uptree_node();
+                const auto up_unknown = unknown_index.find(up_node);
+                const double up_press = node_pressures[up_node];
+                jacobian[row][row] += 1.0;
+                const auto vfp_table = (*upbranch).vfp_table();
+                if (vfp_table) {
+                    // The rates are here positive, but the VFP code expects the
+                    // convention that production rates are negative.
+                    const auto& rates = node_inflows[node];
+                    assert(rates.size() == 3);
+                    const double alq = 0.0; // TODO: Do not ignore ALQ
+                    const auto bhp = vfp_prod_props.bhpAndDerivatives(*vfp_table,
+                                                                      -rates[BlackoilPhases::Aqua],
+                                                                      -rates[BlackoilPhases::Liquid],
+                                                                      -rates[BlackoilPhases::Vapour],
+                                                                      up_press,
+                                                                      alq,
+                                                                      0.0, //explicit_wfr
+                                                                      0.0, //explicit_gfr
+                                                                      false); //use_expvfp we dont support explicit lookup
+                    residual[row] = node_pressures[node] - bhp[0];
+                    if (up_unknown != unknown_index.end()) {
+                        jacobian[row][up_unknown->second] -= bhp[4];
+                    }
+                    for (const auto& leaf : subtree_leaves[node]) {
+                        const auto leaf_unknown = unknown_index.find(leaf);
+                        if (leaf_unknown == unknown_index.end()) {
+                            continue;
+                        }
+                        const auto& derivatives = leaf_derivatives[leaf];
+                        double dbhp = 0.0;
+                        for (std::size_t ii = 0; ii < derivatives.size(); ++ii) {
+                            dbhp -= bhp[1 + ii] * derivatives[ii];
+                        }
+                        jacobian[row][leaf_unknown->second] -= dbhp;
+                    }
+                } else {
+                    // Table number specified as 9999 in the deck, no pressure loss.
+                    residual[row] = node_pressures[node] - up_press;
+                    if (up_unknown != unknown_index.end()) {
+                        jacobian[row][up_unknown->second] -= 1.0;
+                    }
+                }
+            }
+
+            try {
+                jacobian.solve(update, residual);
+            } catch (const Dune::FMatrixError&) {
+                return {};
+            }
+
+            double max_update = 0.0;
+            for (const auto& [node, row] : unknown_index) {
+                node_pressures[node] -= update[row];
+                max_update = std::max(max_update, std::abs(update[row]));
+            }
+            if (max_update < tolerance) {
+                return node_pressures;
+            }
+        }
+
+        return {};
+    }
+
 
 
 
@@ -911,12 +1112,33 @@ namespace WellGroupHelpers
         return getGuideRateVector(well_state.currentWellRates(name), pu);
     }
 
+    GuideRate::RateVector
+    getWellRateVector(const WellState& well_state, const PhaseUsage& pu, std::size_t global_well_index)
+    {
+        return getGuideRateVector(well_state.currentWellRates(global_well_index), pu);
+    }
+
     GuideRate::RateVector
     getProductionGroupRateVector(const GroupState& group_state, const PhaseUsage& pu, const std::string& group_name)
     {
         return getGuideRateVector(group_state.production_rates(group_name), pu);
     }
 
+    double getWellGuideRate(const std::size_t global_well_index,
+                            const WellState& wellState,
+                            const GuideRate* guideRate,
+                            const GuideRateModel::Target target,
+                            const PhaseUsage& pu)
+    {
+        // The guide rates are kept by name in GuideRate, the name comes
+        // from the handle table to avoid constructing it.
+        const auto& name = wellState.globalWellName(global_well_index);
+        if (guideRate->has(name) || guideRate->hasPotentials(name)) {
+            return guideRate->get(name, target, getWellRateVector(wellState, pu, global_well_index));
+        }
+        return 0.0;
+    }
+
     double getGuideRate(const std::string& name,
                         const Schedule& schedule,
                         const WellState& wellState,
@@ -950,7 +1172,12 @@ namespace WellGroupHelpers
             }
         }
 
-        for (const std::string& wellName : group.wells()) {
+        for (const auto well_index : wellState.groupWellIndices(name)) {
+            // Only count wells under group control or the ru
+            if (!wellState.isProductionGrup(well_index))
+                continue;
+
+            const auto& wellName = wellState.globalWellName(well_index);
             const auto& wellTmp = schedule.getWell(wellName, reportStepIdx);
 
             if (wellTmp.isInjector())
@@ -959,13 +1186,7 @@ namespace WellGroupHelpers
             if (wellTmp.getStatus() == Well::Status::SHUT)
                 continue;
 
-            // Only count wells under group control or the ru
-            if (!wellState.isProductionGrup(wellName))
-                continue;
-
-            totalGuideRate += getGuideRate(wellName, schedule, wellState, group_state,
-                                           reportStepIdx, guideRate, target, pu);
-
+            totalGuideRate += getWellGuideRate(well_index, wellState, guideRate, target, pu);
         }
         return totalGuideRate;
     }
@@ -1003,7 +1224,12 @@ namespace WellGroupHelpers
             }
         }
 
-        for (const std::string& wellName : group.wells()) {
+        for (const auto well_index : wellState.groupWellIndices(name)) {
+            // Only count wells under group control or the ru
+            if (!wellState.isInjectionGrup(well_index))
+                continue;
+
+            const auto& wellName = wellState.globalWellName(well_index);
             const auto& wellTmp = schedule.getWell(wellName, reportStepIdx);
 
             if (!wellTmp.isInjector())
@@ -1012,11 +1238,7 @@ namespace WellGroupHelpers
             if (wellTmp.getStatus() == Well::Status::SHUT)
                 continue;
 
-            // Only count wells under group control or the ru
-            if (!wellState.isInjectionGrup(wellName))
-                continue;
-
-            totalGuideRate += guideRate->get(wellName, target, getWellRateVector(wellState, pu, wellName));
+            totalGuideRate += guideRate->get(wellName, target, getWellRateVector(wellState, pu, well_index));
         }
         return totalGuideRate;
     }
@@ -1050,13 +1272,10 @@ namespace WellGroupHelpers
                     += groupControlledWells(schedule, well_state, group_state, report_step, child_group, always_included_child, is_production_group, injection_phase);
             }
         }
-        for (const std::string& child_well : group.wells()) {
-            bool included = (child_well == always_included_child);
-            if (is_production_group) {
-                included = included || well_state.isProductionGrup(child_well);
-            } else {
-                included = included || well_state.isInjectionGrup(child_well);
-            }
+        for (const auto well_index : well_state.groupWellIndices(group_name)) {
+            const bool included = (is_production_group ? well_state.isProductionGrup(well_index)
+                                                       : well_state.isInjectionGrup(well_index))
+                || (well_state.globalWellName(well_index) == always_included_child);
             if (included) {
                 ++num_wells;
             }
@@ -1136,25 +1355,32 @@ namespace WellGroupHelpers
                 total_guide_rate += guideRate(child_group, always_included_child);
             }
         }
-        for (const std::string& child_well : group.wells()) {
-            bool included = (child_well == always_included_child);
-            if (is_producer_) {
-                included = included || well_state_.isProductionGrup(child_well);
-            } else {
-                included = included || well_state_.isInjectionGrup(child_well);
-            }
+        for (const auto well_index : well_state_.groupWellIndices(group.name())) {
+            const bool included = (is_producer_ ? well_state_.isProductionGrup(well_index)
+                                                : well_state_.isInjectionGrup(well_index))
+                || (well_state_.globalWellName(well_index) == always_included_child);
 
             if (included) {
-                total_guide_rate += guideRate(child_well, always_included_child);
+                total_guide_rate += wellGuideRate(well_index);
             }
         }
         return total_guide_rate;
     }
+    double FractionCalculator::wellGuideRate(const std::size_t well_index)
+    {
+        if (well_guide_rates_.size() <= well_index) {
+            well_guide_rates_.resize(well_index + 1, std::numeric_limits<double>::quiet_NaN());
+        }
+        auto& guide_rate = well_guide_rates_[well_index];
+        if (std::isnan(guide_rate)) {
+            guide_rate = getWellGuideRate(well_index, well_state_, guide_rate_, target_, pu_);
+        }
+        return guide_rate;
+    }
     double FractionCalculator::guideRate(const std::string& name, const std::string& always_included_child)
     {
         if (schedule_.hasWell(name, report_step_)) {
-            return getGuideRate(name, schedule_, well_state_, group_state_,
-                                report_step_, guide_rate_, target_, pu_);
+            return wellGuideRate(well_state_.globalWellIndex(name));
         } else {
             if (groupControlledWells(name, always_included_child) > 0) {
                 if (is_producer_ && guide_rate_->has(name)) {
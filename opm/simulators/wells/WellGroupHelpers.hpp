@@ -25,8 +25,10 @@
 #include <opm/input/eclipse/EclipseState/Grid/FieldPropsManager.hpp>
 
 
+#include <cstddef>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Opm
@@ -198,12 +200,37 @@ namespace WellGroupHelpers
                             const Schedule& schedule,
                             const int report_time_step);
 
+    // Solves for the pressures of the network nodes without a fixed pressure
+    // by a Newton method, with the rates of the leaf nodes linearized around
+    // the reference pressures by the given rate derivatives. Returns an empty
+    // map if a reference pressure is missing or the method does not converge.
+    std::map<std::string, double>
+    computeNetworkPressuresNewton(const Opm::Network::ExtNetwork& network,
+                                  const WellState& well_state,
+                                  const GroupState& group_state,
+                                  const VFPProdProperties& vfp_prod_props,
+                                  const Schedule& schedule,
+                                  const int report_time_step,
+                                  const std::map<std::string, double>& reference_pressures,
+                                  const std::map<std::string, std::vector<double>>& leaf_sensitivities,
+                                  const int max_iterations,
+                                  const double tolerance);
+
     GuideRate::RateVector
     getWellRateVector(const WellState& well_state, const PhaseUsage& pu, const std::string& name);
 
+    GuideRate::RateVector
+    getWellRateVector(const WellState& well_state, const PhaseUsage& pu, std::size_t global_well_index);
+
     GuideRate::RateVector
     getProductionGroupRateVector(const GroupState& group_state, const PhaseUsage& pu, const std::string& group_name);
 
+    double getWellGuideRate(const std::size_t global_well_index,
+                            const WellState& wellState,
+                            const GuideRate* guideRate,
+                            const GuideRateModel::Target target,
+                            const PhaseUsage& pu);
+
     double getGuideRate(const std::string& name,
                         const Schedule& schedule,
                         const WellState& wellState,
@@ -253,6 +280,7 @@ namespace WellGroupHelpers
         std::string parent(const std::string& name);
         double guideRateSum(const Group& group, const std::string& always_included_child);
         double guideRate(const std::string& name, const std::string& always_included_child);
+        double wellGuideRate(const std::size_t well_index);
         int groupControlledWells(const std::string& group_name, const std::string& always_included_child);
         GuideRate::RateVector getGroupRateVector(const std::string& group_name);
         const Schedule& schedule_;
@@ -264,6 +292,10 @@ namespace WellGroupHelpers
         const PhaseUsage& pu_;
         bool is_producer_;
         Phase injection_phase_;
+        // Guide rates of the wells by global well index, NaN until computed.
+        // The calculator is short lived, the well state does not change
+        // while it is used.
+        std::vector<double> well_guide_rates_;
     };
 
 
@@ -319,6 +351,98 @@ namespace WellGroupHelpers
                                             const PhaseUsage& pu,
                                             std::map<std::string, std::unique_ptr<AverageRegionalPressureType>>& regionalAveragePressureCalculator);
 
+    /// Checks the controls of a group and the groups below it in sweeps down
+    /// the hierarchy, with one update of the states after each sweep with a
+    /// switch. A group is checked with states that include the switches of
+    /// all groups above it, so after a switch the remaining checks of the
+    /// group and its subtree are deferred to the next sweep. Groups of one
+    /// sweep, e.g. siblings, see the states from before each other's
+    /// switches.
+    /// \param children Child groups of a group, as pointers
+    /// \param begin_sweep Called with the groups a sweep starts from
+    /// \param check_higher Whether a group switches to control by its parent
+    /// \param check_individual Whether a group switches for its own constraints
+    /// \param end_sweep Called after a sweep with a switch, updates the states
+    /// \return Whether any group switched
+    template <class GroupType, class Children, class BeginSweep,
+              class CheckHigher, class CheckIndividual, class EndSweep>
+    bool sweepGroupControls(const GroupType& group,
+                            Children&& children,
+                            BeginSweep&& begin_sweep,
+                            CheckHigher&& check_higher,
+                            CheckIndividual&& check_individual,
+                            EndSweep&& end_sweep)
+    {
+        enum class Check { Higher, Individual };
+        std::vector<std::pair<const GroupType*, Check>> pending{{&group, Check::Higher}};
+        bool changed = false;
+        while (!pending.empty()) {
+            std::vector<const GroupType*> roots;
+            for (const auto& item : pending) {
+                roots.push_back(item.first);
+            }
+            begin_sweep(roots);
+
+            bool changed_sweep = false;
+            std::vector<std::pair<const GroupType*, Check>> deferred;
+            std::vector<std::pair<const GroupType*, Check>> stack(pending.rbegin(), pending.rend());
+            while (!stack.empty()) {
+                const auto [grp, check] = stack.back();
+                stack.pop_back();
+                if (check == Check::Higher && check_higher(*grp)) {
+                    changed_sweep = true;
+                    deferred.emplace_back(grp, Check::Individual);
+                    continue;
+                }
+                const auto child_groups = children(*grp);
+                if (check_individual(*grp)) {
+                    changed_sweep = true;
+                    for (const auto* child : child_groups) {
+                        deferred.emplace_back(child, Check::Higher);
+                    }
+                } else {
+                    // continue down the group hierarchy
+                    for (auto it = child_groups.rbegin(); it != child_groups.rend(); ++it) {
+                        stack.emplace_back(*it, Check::Higher);
+                    }
+                }
+            }
+
+            if (changed_sweep) {
+                changed = true;
+                end_sweep();
+            }
+            pending = std::move(deferred);
+        }
+        return changed;
+    }
+
+    /// Walks up the group tree from a group to the first group which is a
+    /// node of the network, i.e. the leaf node the production of the group
+    /// flows into. The rate of that node includes the group efficiency
+    /// factors of the groups below it.
+    /// \param is_node Whether a group name is a node of the network
+    /// \param get_group The group of a name, with parent() and
+    ///                  getGroupEfficiencyFactor()
+    /// \return The name of the leaf node and the product of the efficiency
+    ///         factors, or an empty name if no group up to FIELD is a node
+    template <class IsNode, class GetGroup>
+    std::pair<std::string, double> networkLeafNode(const std::string& group_name,
+                                                   IsNode&& is_node,
+                                                   GetGroup&& get_group)
+    {
+        std::string name = group_name;
+        double efficiency = 1.0;
+        while (!is_node(name)) {
+            if (name == "FIELD") {
+                return {std::string{}, 0.0};
+            }
+            const auto& group = get_group(name);
+            efficiency *= group.getGroupEfficiencyFactor();
+            name = group.parent();
+        }
+        return {name, efficiency};
+    }
 
 } // namespace WellGroupHelpers
 
@@ -33,7 +33,10 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <unordered_set>
 #include <vector>
 
 namespace Opm {
@@ -215,6 +218,60 @@ bool rateControlWithZeroInjTarget(const WellInjectionControls& controls,
 }
 
 
+std::vector<std::vector<int>>
+groupWellsWithDisjointCells(const std::vector<std::vector<int>>& well_cells)
+{
+    // First fit: each well joins the first group none of whose wells
+    // perforates any of its cells.
+    std::vector<std::vector<int>> groups;
+    std::vector<std::unordered_set<int>> group_cells;
+    for (std::size_t w = 0; w < well_cells.size(); ++w) {
+        const auto& cells = well_cells[w];
+        std::size_t group = 0;
+        for (; group < groups.size(); ++group) {
+            const auto& used = group_cells[group];
+            if (std::none_of(cells.begin(), cells.end(),
+                             [&used](const int cell) { return used.count(cell) > 0; })) {
+                break;
+            }
+        }
+        if (group == groups.size()) {
+            groups.emplace_back();
+            group_cells.emplace_back();
+        }
+        groups[group].push_back(static_cast<int>(w));
+        group_cells[group].insert(cells.begin(), cells.end());
+    }
+    return groups;
+}
+
+bool keysAgree(const StateKey& key,
+               const StateKey& reference,
+               const double tolerance)
+{
+    const auto agree = [tolerance](const double a, const double b)
+    {
+        return std::abs(a - b) <= tolerance * std::max(std::abs(a), std::abs(b));
+    };
+    return !key.empty() &&
+           key.exact == reference.exact &&
+           std::equal(key.scaled.begin(), key.scaled.end(),
+                      reference.scaled.begin(), reference.scaled.end(), agree);
+}
+
+bool potentialConditionsAgree(const std::vector<double>& conditions,
+                              const std::vector<double>& reference,
+                              const double tolerance)
+{
+    const auto unchanged = [tolerance](const double a, const double b)
+    {
+        return std::abs(a - b) <= tolerance * std::max({1.0, std::abs(a), std::abs(b)});
+    };
+    return !conditions.empty() &&
+           std::equal(conditions.begin(), conditions.end(),
+                      reference.begin(), reference.end(), unchanged);
+}
+
 template class ParallelStandardWellB<double>;
 
 template<int Dim> using Vec = Dune::BlockVector<Dune::FieldVector<double,Dim>>;
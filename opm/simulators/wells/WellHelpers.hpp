@@ -27,6 +27,7 @@
 #include <dune/common/dynmatrix.hh>
 
 #include <array>
+#include <vector>
 
 namespace Opm {
 
@@ -95,6 +96,56 @@ bool rateControlWithZeroProdTarget(const WellProductionControls& controls,
 bool rateControlWithZeroInjTarget(const WellInjectionControls& controls,
                                   WellInjectorCMode mode);
 
+/// \brief Groups the wells such that wells in the same group share no cells.
+///
+/// Wells of one group couple disjoint sets of reservoir cells, so their
+/// contributions may be added to the reservoir matrix concurrently.
+/// \param well_cells The perforated cells of each well.
+/// \return The indices of the wells in each group.
+std::vector<std::vector<int>>
+groupWellsWithDisjointCells(const std::vector<std::vector<int>>& well_cells);
+
+/// \brief The inputs a computation depends on, for deciding whether its
+/// result may be reused.
+struct StateKey
+{
+    /// Modes, controls and limits, which have to agree exactly.
+    std::vector<double> exact;
+    /// Solution and state variables, which agree within a tolerance
+    /// relative to their own magnitude.
+    std::vector<double> scaled;
+
+    bool empty() const
+    {
+        return exact.empty() && scaled.empty();
+    }
+
+    void clear()
+    {
+        exact.clear();
+        scaled.clear();
+    }
+};
+
+/// \brief Whether two state keys agree entry by entry.
+///
+/// The exact entries have to be equal, the scaled entries may differ by at
+/// most the tolerance relative to the larger of their magnitudes. Empty
+/// keys never agree.
+bool keysAgree(const StateKey& key,
+               const StateKey& reference,
+               const double tolerance);
+
+/// \brief Whether the conditions the last potentials of a well were computed
+/// for still hold, so that they may be reused.
+///
+/// Entries may differ by at most the tolerance relative to the larger of
+/// their magnitudes, or absolutely for magnitudes below one, i.e. relative
+/// for pressures and absolute for saturations. Empty conditions never agree.
+bool potentialConditionsAgree(const std::vector<double>& conditions,
+                              const std::vector<double>& reference,
+                              const double tolerance);
+
 } // namespace wellhelpers
 } // namespace Opm
 
@@ -0,0 +1,96 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+#include <opm/simulators/wells/WellIPRCurve.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+namespace Opm {
+
+void WellIPRCurve::reset(const int numComponents, const Stamp& stamp)
+{
+    num_comp_ = numComponents;
+    valid_ = false;
+    stamp_ = stamp;
+    connections_.clear();
+}
+
+void WellIPRCurve::addConnection(const double breakBhp,
+                                 const std::vector<double>& prodRates,
+                                 const std::vector<double>& injRates)
+{
+    assert(static_cast<int>(prodRates.size()) >= num_comp_);
+    assert(static_cast<int>(injRates.size()) >= num_comp_);
+    connections_.push_back({breakBhp,
+                            {prodRates.begin(), prodRates.begin() + num_comp_},
+                            {injRates.begin(), injRates.begin() + num_comp_}});
+}
+
+void WellIPRCurve::finalize()
+{
+    std::sort(connections_.begin(), connections_.end(),
+              [](const Connection& a, const Connection& b)
+              { return a.break_bhp < b.break_bhp; });
+
+    // Entry i of the sums covers the connections [0, i) for the injecting
+    // and [i, n) for the producing side.
+    const std::size_t n = connections_.size();
+    const std::size_t nc = num_comp_;
+    break_bhp_.resize(n);
+    inj_sum_.assign((n + 1) * nc, 0.0);
+    inj_break_sum_.assign((n + 1) * nc, 0.0);
+    prod_sum_.assign((n + 1) * nc, 0.0);
+    prod_break_sum_.assign((n + 1) * nc, 0.0);
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto& conn = connections_[i];
+        break_bhp_[i] = conn.break_bhp;
+        for (std::size_t c = 0; c < nc; ++c) {
+            inj_sum_[(i + 1) * nc + c] = inj_sum_[i * nc + c] + conn.inj[c];
+            inj_break_sum_[(i + 1) * nc + c] = inj_break_sum_[i * nc + c] + conn.inj[c] * conn.break_bhp;
+        }
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        const auto& conn = connections_[i];
+        for (std::size_t c = 0; c < nc; ++c) {
+            prod_sum_[i * nc + c] = prod_sum_[(i + 1) * nc + c] + conn.prod[c];
+            prod_break_sum_[i * nc + c] = prod_break_sum_[(i + 1) * nc + c] + conn.prod[c] * conn.break_bhp;
+        }
+    }
+    connections_.clear();
+    valid_ = true;
+}
+
+void WellIPRCurve::rates(const double bhp, std::vector<double>& rates) const
+{
+    assert(valid_);
+    // Connections with a break point above the bhp have positive drawdown
+    // and produce, the others inject.
+    const std::size_t nc = num_comp_;
+    const std::size_t i = std::upper_bound(break_bhp_.begin(), break_bhp_.end(), bhp) - break_bhp_.begin();
+    rates.resize(nc);
+    for (std::size_t c = 0; c < nc; ++c) {
+        rates[c] = (inj_sum_[i * nc + c] * bhp - inj_break_sum_[i * nc + c])
+                 + (prod_break_sum_[i * nc + c] - prod_sum_[i * nc + c] * bhp);
+    }
+}
+
+}
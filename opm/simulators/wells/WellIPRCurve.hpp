@@ -0,0 +1,112 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef OPM_WELL_IPR_CURVE_HEADER_INCLUDED
+#define OPM_WELL_IPR_CURVE_HEADER_INCLUDED
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Opm {
+
+//! \brief Tabulated inflow performance relationship of a well.
+//! \details For a fixed reservoir state, fixed connection pressure
+//! differences and fixed wellbore mixture, the surface rates of a
+//! connection are linear in the drawdown on either side of the bhp where
+//! the drawdown changes sign, with different slopes for the producing and
+//! the injecting side. The well rates are therefore piecewise linear in
+//! the bhp with one break point per connection, and are evaluated from
+//! prefix sums over the connections sorted by break point in logarithmic
+//! time. The stamp identifies the state the curve was built for, and the
+//! owner invalidates the curve when the state changes without a new stamp.
+class WellIPRCurve {
+public:
+    //! \brief Counters of the reservoir state and the well solution.
+    using Stamp = std::pair<std::uint64_t, std::uint64_t>;
+
+    //! \brief Starts a new curve for the given stamp.
+    void reset(const int numComponents, const Stamp& stamp);
+
+    //! \brief Adds a connection.
+    //! \param breakBhp Bhp at which the drawdown of the connection is zero
+    //! \param prodRates Surface rates per unit drawdown when producing
+    //! \param injRates Surface rates per unit negative drawdown when injecting
+    void addConnection(const double breakBhp,
+                       const std::vector<double>& prodRates,
+                       const std::vector<double>& injRates);
+
+    //! \brief Sorts the connections and computes the prefix sums.
+    void finalize();
+
+    //! \brief Whether the curve is finalized and was built for the stamp.
+    bool isValid(const Stamp& stamp) const
+    {
+        return valid_ && stamp == stamp_;
+    }
+
+    //! \brief Records a query for the stamp the curve cannot answer.
+    //! \details Building the curve costs about two direct evaluations, so
+    //! it only pays off from the second query for the same state.
+    //! \return Whether the stamp was queried before.
+    bool repeatedQuery(const Stamp& stamp)
+    {
+        const bool repeated = queried_ && stamp == query_stamp_;
+        queried_ = true;
+        query_stamp_ = stamp;
+        return repeated;
+    }
+
+    //! \brief Invalidates the curve.
+    void invalidate()
+    {
+        valid_ = false;
+        queried_ = false;
+    }
+
+    //! \brief Evaluates the surface rates of all components at the bhp.
+    void rates(const double bhp, std::vector<double>& rates) const;
+
+private:
+    struct Connection
+    {
+        double break_bhp;
+        std::vector<double> prod;
+        std::vector<double> inj;
+    };
+
+    int num_comp_ = 0;
+    bool valid_ = false;
+    Stamp stamp_{};
+    bool queried_ = false;
+    Stamp query_stamp_{};
+    std::vector<Connection> connections_;
+    std::vector<double> break_bhp_; //!< Sorted break points
+    //! Prefix sums of inj and inj * break point over the connections with
+    //! the smallest break points, and suffix sums of prod and prod * break
+    //! point over the others, num_comp_ values per entry.
+    std::vector<double> inj_sum_;
+    std::vector<double> inj_break_sum_;
+    std::vector<double> prod_sum_;
+    std::vector<double> prod_break_sum_;
+};
+
+}
+
+#endif // OPM_WELL_IPR_CURVE_HEADER_INCLUDED
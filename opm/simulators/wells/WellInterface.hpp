@@ -302,6 +302,12 @@ public:
                                const WellState& well_state,
                                DeferredLogger& deferred_logger);
 
+    // derivatives of the surface production rates of a producer under THP
+    // control with respect to the THP, linearized from the IPR and the VFP
+    // table of the well. Empty if not available.
+    std::vector<double> thpRateSensitivities(const WellState& well_state,
+                                             const SummaryState& summary_state) const;
+
 
     // update perforation water throughput based on solved water rate
     virtual void updateWaterThroughput(const double dt, WellState& well_state) const = 0;
@@ -338,6 +344,25 @@ public:
         return 0;
     }
 
+    /// Leave the sum of the equations of a distributed well to the caller,
+    /// which sums the equations of all the wells in one collective.
+    void setDeferDistributedSum(const bool defer)
+    {
+        defer_distributed_sum_ = defer;
+    }
+
+    /// Equation entries waiting for the sum over the ranks sharing the
+    /// well, null unless the last assembly left the sum to the caller.
+    virtual std::vector<double>* deferredEquationEntries()
+    {
+        return nullptr;
+    }
+
+    /// Complete the assembly with the summed deferredEquationEntries().
+    virtual void finishDeferredAssembly(DeferredLogger&)
+    {
+    }
+
 protected:
     // simulation parameters
     const ModelParameters& param_;
@@ -345,6 +370,7 @@ protected:
     std::vector< Scalar > B_avg_;
     bool changed_to_stopped_this_step_ = false;
     bool thp_update_iterations = false;
+    bool defer_distributed_sum_ = false;
 
     double wpolymer() const;
 
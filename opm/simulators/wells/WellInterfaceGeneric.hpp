@@ -198,6 +198,21 @@ public:
         return this->changed_to_open_this_step_;
     }
 
+    /// Number of inner solves of the well equations since the last reset,
+    /// and the number of them that were skipped.
+    unsigned innerSolves() const {
+        return inner_solves_;
+    }
+
+    unsigned skippedInnerSolves() const {
+        return skipped_inner_solves_;
+    }
+
+    void resetInnerSolveCounts() {
+        inner_solves_ = 0;
+        skipped_inner_solves_ = 0;
+    }
+
     void updateWellTestState(const SingleWellState& ws,
                              const double& simulationTime,
                              const bool& writeMessageToOPMLog,
@@ -386,6 +401,9 @@ protected:
     std::vector< std::string> well_control_log_;
 
     bool changed_to_open_this_step_ = true;
+
+    unsigned inner_solves_ = 0;
+    unsigned skipped_inner_solves_ = 0;
 };
 
 }
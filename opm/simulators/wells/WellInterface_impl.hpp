@@ -25,6 +25,7 @@
 #include <opm/simulators/utils/DeferredLoggingErrorHelpers.hpp>
 #include <opm/simulators/wells/GroupState.hpp>
 #include <opm/simulators/wells/TargetCalculator.hpp>
+#include <opm/simulators/wells/VFPProperties.hpp>
 #include <opm/simulators/wells/WellBhpThpCalculator.hpp>
 #include <opm/simulators/wells/WellHelpers.hpp>
 
@@ -32,6 +33,8 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 
 namespace Opm
@@ -728,6 +731,57 @@ namespace Opm
     }
 
 
+
+    template<typename TypeTag>
+    std::vector<double>
+    WellInterface<TypeTag>::
+    thpRateSensitivities(const WellState& well_state,
+                         const SummaryState& summary_state) const
+    {
+        const auto& ws = well_state.well(this->index_of_well_);
+        if (!this->isProducer() || ws.production_cmode != Well::ProducerCMode::THP) {
+            return {};
+        }
+
+        // The IPR gives the surface rates a - b * bhp.
+        const auto& pu = this->phaseUsage();
+        std::array<double, 3> vfp_rates{};
+        std::array<double, 3> ipr_b{};
+        for (const int p : {BlackoilPhases::Aqua, BlackoilPhases::Liquid, BlackoilPhases::Vapour}) {
+            if (pu.phase_used[p]) {
+                vfp_rates[p] = ws.surface_rates[pu.phase_pos[p]];
+                ipr_b[p] = this->ipr_b_[this->flowPhaseToEbosCompIdx(pu.phase_pos[p])];
+            }
+        }
+        if (std::all_of(ipr_b.begin(), ipr_b.end(), [](const double b) { return b == 0.0; })) {
+            return {};
+        }
+
+        const auto& controls = this->well_ecl_.productionControls(summary_state);
+        const auto wfr = this->vfp_properties_->getExplicitWFR(controls.vfp_table_number, this->index_of_well_);
+        const auto gfr = this->vfp_properties_->getExplicitGFR(controls.vfp_table_number, this->index_of_well_);
+        const auto bhp = this->vfp_properties_->getProd()->bhpAndDerivatives(controls.vfp_table_number,
+                                                                             vfp_rates[BlackoilPhases::Aqua],
+                                                                             vfp_rates[BlackoilPhases::Liquid],
+                                                                             vfp_rates[BlackoilPhases::Vapour],
+                                                                             ws.thp,
+                                                                             this->getALQ(well_state),
+                                                                             wfr, gfr, this->useVfpExplicit());
+        const auto phase_sensitivities = WellBhpThpCalculator::thpRateSensitivities(ipr_b, bhp);
+        if (!phase_sensitivities) {
+            return {};
+        }
+
+        std::vector<double> sensitivities(pu.num_phases, 0.0);
+        for (const int p : {BlackoilPhases::Aqua, BlackoilPhases::Liquid, BlackoilPhases::Vapour}) {
+            if (pu.phase_used[p]) {
+                sensitivities[pu.phase_pos[p]] = (*phase_sensitivities)[p];
+            }
+        }
+        return sensitivities;
+    }
+
+
     template<typename TypeTag>
     void
     WellInterface<TypeTag>::
@@ -1247,12 +1301,19 @@ namespace Opm
                 mob[Indices::contiSolventEqIdx] = extendEval(intQuants.solventMobility());
             }
         } else {
-            const auto& paramsCell = materialLawManager->connectionMaterialLawParams(satid, cell_idx);
             auto relativePerms = relpermArray();
-            MaterialLaw::relativePermeabilities(relativePerms, paramsCell, intQuants.fluidState());
+            // The parameters of the cell are switched temporarily, and wells
+            // may be evaluated concurrently, e.g. for the well potentials.
+#ifdef _OPENMP
+#pragma omp critical(WellInterfaceConnectionMaterialLawParams)
+#endif
+            {
+                const auto& paramsCell = materialLawManager->connectionMaterialLawParams(satid, cell_idx);
+                MaterialLaw::relativePermeabilities(relativePerms, paramsCell, intQuants.fluidState());
 
-            // reset the satnumvalue back to original
-            materialLawManager->connectionMaterialLawParams(satid_elem, cell_idx);
+                // reset the satnumvalue back to original
+                materialLawManager->connectionMaterialLawParams(satid_elem, cell_idx);
+            }
 
             // compute the mobility
             for (unsigned phaseIdx = 0; phaseIdx < FluidSystem::numPhases; ++phaseIdx) {
@@ -137,7 +137,7 @@ WellState WellState::serializationTestObject(const ParallelWellInfo& pinfo)
 {
     WellState result(PhaseUsage{});
     result.alq_state = ALQState::serializationTestObject();
-    result.well_rates = {{"test2", {true, {1.0}}}, {"test3", {false, {2.0}}}};
+    result.well_rates = {{true, {1.0}}, {false, {2.0}}};
     result.wells_.add("test4", SingleWellState::serializationTestObject(pinfo));
 
     return result;
@@ -253,13 +253,13 @@ void WellState::init(const std::vector<double>& cellPressures,
     this->global_well_info = std::make_optional<GlobalWellInfo>(schedule,
                                                                 report_step,
                                                                 wells_ecl);
-    for (const auto& wname : schedule.wellNames(report_step))
-    {
-        well_rates.insert({wname, std::make_pair(false, std::vector<double>(this->numPhases()))});
-    }
+    // Wells keep their global index between report steps, new wells are
+    // appended.
+    well_rates.resize(this->global_well_info->num_wells(),
+                      std::make_pair(false, std::vector<double>(this->numPhases())));
     for (const auto& winfo: parallel_well_info)
     {
-        well_rates[winfo.get().name()].first = winfo.get().isOwner();
+        well_rates[this->globalWellIndex(winfo.get().name())].first = winfo.get().isOwner();
     }
 
     const int nw = wells_ecl.size();
@@ -435,13 +435,18 @@ void WellState::resize(const std::vector<Well>& wells_ecl,
 const std::vector<double>&
 WellState::currentWellRates(const std::string& wellName) const
 {
-    auto it = well_rates.find(wellName);
-
-    if (it == well_rates.end())
+    const auto index = this->wellRatesIndex(wellName);
+    if (!index.has_value())
         OPM_THROW(std::logic_error,
                   "Could not find any rates for well " + wellName);
 
-    return it->second.second;
+    return this->well_rates[*index].second;
+}
+
+const std::vector<double>&
+WellState::currentWellRates(std::size_t global_well_index) const
+{
+    return well_rates.at(global_well_index).second;
 }
 
 template<class Communication>
@@ -843,10 +848,8 @@ void WellState::communicateGroupRates(const Comm& comm)
 {
     // Compute the size of the data.
     std::size_t sz = 0;
-    for (const auto& [_, owner_rates] : this->well_rates) {
+    for (const auto& [_, rates] : this->well_rates) {
         (void)_;
-        const auto& [__, rates] = owner_rates;
-        (void)__;
         sz += rates.size();
     }
     sz += this->alq_state.pack_size();
@@ -855,9 +858,7 @@ void WellState::communicateGroupRates(const Comm& comm)
     // Make a vector and collect all data into it.
     std::vector<double> data(sz);
     std::size_t pos = 0;
-    for (const auto& [_, owner_rates] : this->well_rates) {
-        (void)_;
-        const auto& [owner, rates] = owner_rates;
+    for (const auto& [owner, rates] : this->well_rates) {
         for (const auto& value : rates) {
             if (owner)
                 data[pos++] = value;
@@ -872,10 +873,8 @@ void WellState::communicateGroupRates(const Comm& comm)
     comm.sum(data.data(), data.size());
 
     pos = 0;
-    for (auto& [_, owner_rates] : this->well_rates) {
+    for (auto& [_, rates] : this->well_rates) {
         (void)_;
-        auto& [__, rates] = owner_rates;
-        (void)__;
         for (auto& value : rates)
             value = data[pos++];
     }
@@ -1009,6 +1008,15 @@ void WellState::updateWellsDefaultALQ(const std::vector<Well>& wells_ecl)
     }
 }
 
+void WellState::syncFrom(const WellState& other)
+{
+    this->phase_usage_ = other.phase_usage_;
+    this->global_well_info = other.global_well_info;
+    this->alq_state = other.alq_state;
+    this->well_rates = other.well_rates;
+    this->wells_.sync_from(other.wells_);
+}
+
 bool WellState::operator==(const WellState& rhs) const
 {
     return this->alq_state == rhs.alq_state &&
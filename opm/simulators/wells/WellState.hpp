@@ -113,15 +113,21 @@ public:
                 const SummaryState& summary_state);
 
     void setCurrentWellRates(const std::string& wellName, const std::vector<double>& new_rates ) {
-        auto& [owner, rates] = this->well_rates.at(wellName);
+        this->setCurrentWellRates(this->globalWellIndex(wellName), new_rates);
+    }
+
+    void setCurrentWellRates(std::size_t global_well_index, const std::vector<double>& new_rates ) {
+        auto& [owner, rates] = this->well_rates.at(global_well_index);
         if (owner)
             rates = new_rates;
     }
 
     const std::vector<double>& currentWellRates(const std::string& wellName) const;
 
+    const std::vector<double>& currentWellRates(std::size_t global_well_index) const;
+
     bool hasWellRates(const std::string& wellName) const {
-        return this->well_rates.find(wellName) != this->well_rates.end();
+        return this->wellRatesIndex(wellName).has_value();
     }
 
     void clearWellRates()
@@ -164,6 +170,44 @@ public:
         return this->global_well_info.value().in_producing_group(name);
     }
 
+    bool isInjectionGrup(std::size_t global_well_index) const {
+        return this->global_well_info.value().in_injecting_group(global_well_index);
+    }
+
+    bool isProductionGrup(std::size_t global_well_index) const {
+        return this->global_well_info.value().in_producing_group(global_well_index);
+    }
+
+    /// Integer handle of a well among all the wells in the system, assigned
+    /// at the start of the report step. Per-iteration loops should look the
+    /// handle up once and use the index based accessors.
+    std::size_t globalWellIndex(const std::string& name) const {
+        return this->global_well_info.value().well_index(name);
+    }
+
+    const std::string& globalWellName(std::size_t global_well_index) const {
+        return this->global_well_info.value().well_name(global_well_index);
+    }
+
+    /// Handles of the child wells of a group in the order of the schedule,
+    /// collected when the report step is initialised.
+    const std::vector<std::size_t>& groupWellIndices(const std::string& group_name) const {
+        return this->global_well_info.value().group_wells(group_name);
+    }
+
+    /// Handle of a well with group control rates, resolved by a single
+    /// lookup of the name.
+    std::optional<std::size_t> wellRatesIndex(const std::string& name) const {
+        if (!this->global_well_info.has_value())
+            return std::nullopt;
+
+        const auto index = this->global_well_info->find_well(name);
+        if (!index.has_value() || *index >= this->well_rates.size())
+            return std::nullopt;
+
+        return index;
+    }
+
     double getALQ( const std::string& name) const
     {
         return this->alq_state.get(name);
@@ -283,6 +327,11 @@ public:
         return this->wells_.has(well_name);
     }
 
+    /// Make this state equal to other. Only the wells which have been
+    /// accessed for modification since the two states were last
+    /// synchronized are copied, see WellContainer::sync_from().
+    void syncFrom(const WellState& other);
+
     bool operator==(const WellState&) const;
 
     template<class Serializer>
@@ -302,6 +351,9 @@ public:
         for (auto& w : wells_) {
             serializer(w);
         }
+        if (!serializer.isSerializing()) {
+            wells_.mark_modified();
+        }
     }
 
 private:
@@ -321,10 +373,10 @@ private:
     std::optional<GlobalWellInfo> global_well_info;
     ALQState alq_state;
 
-    // The well_rates variable is defined for all wells on all processors. The
-    // bool in the value pair is whether the current process owns the well or
-    // not.
-    std::map<std::string, std::pair<bool, std::vector<double>>> well_rates;
+    // The well_rates variable is defined for all wells on all processors,
+    // indexed by the global well index. The bool in the value pair is whether
+    // the current process owns the well or not.
+    std::vector<std::pair<bool, std::vector<double>>> well_rates;
 
     data::Segment
     reportSegmentResults(const int         well_id,
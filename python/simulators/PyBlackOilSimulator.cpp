@@ -28,9 +28,12 @@
 // NOTE: EXIT_SUCCESS, EXIT_FAILURE is defined in cstdlib
 #include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <opm/simulators/flow/python/PyBlackOilSimulator.hpp>
+#include <pybind11/stl.h>
 
 namespace py = pybind11;
 
@@ -77,6 +80,85 @@ py::array_t<double> PyBlackOilSimulator::getPorosity()
     return py::array(len, array.get());
 }
 
+// The arrays of the fluid state are allocated once and refreshed in place
+// after each step, so the views handed to Python stay valid and always show
+// the current state. They keep the simulator object alive through their base.
+py::array_t<double> PyBlackOilSimulator::cellView_(const std::vector<double>& data)
+{
+    auto view = py::array_t<double>(data.size(), data.data(), py::cast(this));
+    view.attr("flags").attr("writeable") = false;
+    return view;
+}
+
+void PyBlackOilSimulator::checkInitialized_(const std::string& func) const
+{
+    if (!this->fluidState_) {
+        throw std::logic_error(func + " called before step_init()");
+    }
+}
+
+py::array_t<double> PyBlackOilSimulator::getPressure()
+{
+    checkInitialized_("get_pressure()");
+    return cellView_(this->fluidState_->pressure());
+}
+
+py::array_t<double> PyBlackOilSimulator::getWaterSaturation()
+{
+    checkInitialized_("get_water_saturation()");
+    return cellView_(this->fluidState_->waterSaturation());
+}
+
+py::array_t<double> PyBlackOilSimulator::getOilSaturation()
+{
+    checkInitialized_("get_oil_saturation()");
+    return cellView_(this->fluidState_->oilSaturation());
+}
+
+py::array_t<double> PyBlackOilSimulator::getGasSaturation()
+{
+    checkInitialized_("get_gas_saturation()");
+    return cellView_(this->fluidState_->gasSaturation());
+}
+
+py::array_t<double> PyBlackOilSimulator::getRs()
+{
+    checkInitialized_("get_rs()");
+    return cellView_(this->fluidState_->rs());
+}
+
+py::array_t<double> PyBlackOilSimulator::getRv()
+{
+    checkInitialized_("get_rv()");
+    return cellView_(this->fluidState_->rv());
+}
+
+// Surface rates (water, oil, gas) as a (num_wells, 3) array, the rows are
+// ordered as in get_well_names().
+py::array_t<double> PyBlackOilSimulator::getWellRates()
+{
+    checkInitialized_("get_well_rates()");
+    const auto& rates = this->fluidState_->wellRates();
+    constexpr auto numPhases = PyFluidState<TypeTag>::numWellPhases();
+    const std::vector<py::ssize_t> shape {
+        static_cast<py::ssize_t>(rates.size() / numPhases),
+        static_cast<py::ssize_t>(numPhases)
+    };
+    const std::vector<py::ssize_t> strides {
+        static_cast<py::ssize_t>(numPhases * sizeof(double)),
+        static_cast<py::ssize_t>(sizeof(double))
+    };
+    auto view = py::array_t<double>(shape, strides, rates.data(), py::cast(this));
+    view.attr("flags").attr("writeable") = false;
+    return view;
+}
+
+std::vector<std::string> PyBlackOilSimulator::getWellNames()
+{
+    checkInitialized_("get_well_names()");
+    return this->fluidState_->wellNames();
+}
+
 int PyBlackOilSimulator::run()
 {
     auto mainObject = Opm::Main( deckFilename_ );
@@ -91,6 +173,42 @@ void PyBlackOilSimulator::setPorosity( py::array_t<double,
     materialState_->setPorosity(poro, size_);
 }
 
+void PyBlackOilSimulator::setPorosityMultipliers( py::array_t<double,
+    py::array::c_style | py::array::forcecast> array)
+{
+    materialState_->setPorosityMultipliers(array.data(), array.size());
+}
+
+void PyBlackOilSimulator::setPermeabilityMultipliers( py::array_t<double,
+    py::array::c_style | py::array::forcecast> array)
+{
+    materialState_->setPermeabilityMultipliers(array.data(), array.size());
+}
+
+// Take an in-memory snapshot of the complete simulator state. Python
+// optimization loops can repeatedly restore() it to branch from this point
+// without re-reading the deck.
+std::shared_ptr<PyBlackOilSimulator::SimulatorState> PyBlackOilSimulator::snapshot()
+{
+    checkInitialized_("snapshot()");
+    if (hasRunCleanup_) {
+        throw std::logic_error("snapshot() called after step_cleanup()");
+    }
+    return std::make_shared<SimulatorState>(this->mainEbos_->saveState());
+}
+
+void PyBlackOilSimulator::restore(const SimulatorState& state)
+{
+    checkInitialized_("restore()");
+    if (hasRunCleanup_) {
+        throw std::logic_error("restore() called after step_cleanup()");
+    }
+    this->mainEbos_->loadState(state);
+    this->fluidState_->update();
+    // the restored porosity is the base of later multipliers
+    this->materialState_->resetPorosityBase();
+}
+
 void PyBlackOilSimulator::advance(int report_step)
 {
     while (currentStep() < report_step) {
@@ -112,6 +230,7 @@ int PyBlackOilSimulator::step()
     //if (this->debug_)
     //    this->mainEbos_->getSimTimer()->report(std::cout);
     auto result = mainEbos_->executeStep();
+    fluidState_->update();
     return result;
 }
 
@@ -164,6 +283,9 @@ int PyBlackOilSimulator::stepInit()
         ebosSimulator_ = mainEbos_->getSimulatorPtr();
         materialState_ = std::make_unique<PyMaterialState<TypeTag>>(
             ebosSimulator_);
+        fluidState_ = std::make_unique<PyFluidState<TypeTag>>(
+            ebosSimulator_);
+        fluidState_->update();
         return result;
     }
     else {
@@ -173,6 +295,11 @@ int PyBlackOilSimulator::stepInit()
 
 void export_PyBlackOilSimulator(py::module& m)
 {
+    py::class_<PyBlackOilSimulator::SimulatorState,
+               std::shared_ptr<PyBlackOilSimulator::SimulatorState>>(m, "SimulatorState")
+        .def_property_readonly("report_step",
+            [](const PyBlackOilSimulator::SimulatorState& state) { return state.reportStep; });
+
     py::class_<PyBlackOilSimulator>(m, "BlackOilSimulator")
         .def(py::init< const std::string& >())
         .def(py::init<
@@ -182,8 +309,20 @@ void export_PyBlackOilSimulator(py::module& m)
             std::shared_ptr<Opm::SummaryConfig> >())
         .def("get_porosity", &PyBlackOilSimulator::getPorosity,
             py::return_value_policy::copy)
+        .def("get_pressure", &PyBlackOilSimulator::getPressure)
+        .def("get_water_saturation", &PyBlackOilSimulator::getWaterSaturation)
+        .def("get_oil_saturation", &PyBlackOilSimulator::getOilSaturation)
+        .def("get_gas_saturation", &PyBlackOilSimulator::getGasSaturation)
+        .def("get_rs", &PyBlackOilSimulator::getRs)
+        .def("get_rv", &PyBlackOilSimulator::getRv)
+        .def("get_well_rates", &PyBlackOilSimulator::getWellRates)
+        .def("get_well_names", &PyBlackOilSimulator::getWellNames)
         .def("run", &PyBlackOilSimulator::run)
         .def("set_porosity", &PyBlackOilSimulator::setPorosity)
+        .def("set_porosity_multipliers", &PyBlackOilSimulator::setPorosityMultipliers)
+        .def("set_permeability_multipliers", &PyBlackOilSimulator::setPermeabilityMultipliers)
+        .def("snapshot", &PyBlackOilSimulator::snapshot)
+        .def("restore", &PyBlackOilSimulator::restore, py::arg("state"))
         .def("current_step", &PyBlackOilSimulator::currentStep)
         .def("step", &PyBlackOilSimulator::step)
         .def("advance", &PyBlackOilSimulator::advance, py::arg("report_step"))
@@ -73,3 +73,24 @@ class TestBasic(unittest.TestCase):
             poro2 = sim.get_porosity()
             self.assertAlmostEqual(poro2[0], 0.285, places=7, msg='value of porosity 2')
 
+            pressure = sim.get_pressure()
+            self.assertEqual(len(pressure), 300, 'length of pressure vector')
+            self.assertFalse(pressure.flags.writeable, 'pressure view is read-only')
+            sw = sim.get_water_saturation()
+            so = sim.get_oil_saturation()
+            sg = sim.get_gas_saturation()
+            self.assertAlmostEqual(sw[0] + so[0] + sg[0], 1.0, places=7, msg='sum of saturations')
+            rates = sim.get_well_rates()
+            self.assertEqual(rates.shape, (len(sim.get_well_names()), 3), 'shape of well rates')
+
+            state = sim.snapshot()
+            step = sim.current_step()
+            self.assertEqual(state.report_step, step, 'report step of snapshot')
+            p_before = pressure.copy()
+            sim.step()
+            # the view follows the simulator state
+            self.assertNotEqual(pressure[0], p_before[0], 'pressure view updated by step')
+            sim.restore(state)
+            self.assertEqual(sim.current_step(), step, 'report step after restore')
+            self.assertAlmostEqual(pressure[0], p_before[0], places=7, msg='pressure after restore')
+
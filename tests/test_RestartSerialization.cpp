@@ -101,6 +101,7 @@ TEST_FOR_TYPE(Inplace)
 TEST_FOR_TYPE(PerfData)
 TEST_FOR_TYPE(PIDAndIterationCountTimeStepControl)
 TEST_FOR_TYPE(PIDTimeStepControl)
+TEST_FOR_TYPE(PredictiveTimeStepControl)
 TEST_FOR_TYPE(SegmentState)
 TEST_FOR_TYPE(SimpleIterationCountTimeStepControl)
 TEST_FOR_TYPE(SimulatorReport)
@@ -112,6 +113,7 @@ TEST_FOR_TYPE_NAMED_OBJ(ATE, AdaptiveTimeSteppingEbosHardcoded, serializationTes
 TEST_FOR_TYPE_NAMED_OBJ(ATE, AdaptiveTimeSteppingEbosPID, serializationTestObjectPID)
 TEST_FOR_TYPE_NAMED_OBJ(ATE, AdaptiveTimeSteppingEbosPIDIt, serializationTestObjectPIDIt)
 TEST_FOR_TYPE_NAMED_OBJ(ATE, AdaptiveTimeSteppingEbosSimple, serializationTestObjectSimple)
+TEST_FOR_TYPE_NAMED_OBJ(ATE, AdaptiveTimeSteppingEbosPredictive, serializationTestObjectPredictive)
 
 namespace Opm { using BPV = BlackOilPrimaryVariables<Properties::TTag::EbosTypeTag>; }
 TEST_FOR_TYPE_NAMED(BPV, BlackoilPrimaryVariables)
@@ -292,6 +294,8 @@ public:
 
     void computePotentials(const std::size_t,
                            const WellState&,
+                           const bool,
+                           std::vector<double>&,
                            std::string&,
                            ExceptionType::ExcEnum&,
                            DeferredLogger&) override
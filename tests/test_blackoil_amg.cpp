@@ -25,6 +25,7 @@
 #include <opm/simulators/linalg/FlexibleSolver.hpp>
 #include <opm/simulators/linalg/PropertyTree.hpp>
 #include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
 
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/common/fmatrix.hh>
@@ -305,6 +306,56 @@ void runBlackoilAmgLaplace()
 
 }
 
+BOOST_AUTO_TEST_CASE(runCommunicationReducingSolvers)
+{
+    constexpr int BS=2, N=20;
+    using BCRSMat = Dune::BCRSMatrix<Opm::MatrixBlock<double,BS,BS>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double,BS>>;
+    using Communication = Dune::OwnerOverlapCopyCommunication<int,int>;
+    using Operator = Dune::OverlappingSchwarzOperator<BCRSMat,Vector,Vector,Communication>;
+
+    const auto& ccomm = Dune::MPIHelper::getCommunication();
+    Communication comm(ccomm);
+    int n=0;
+    BCRSMat mat = setupAnisotropic2d<BCRSMat>(N, comm.indexSet(), comm.communicator(), &n, 1);
+    comm.remoteIndices().template rebuild<false>();
+    Operator fop(mat, comm);
+
+    using namespace std::string_literals;
+    Opm::PropertyTree prm;
+    prm.put("tol", 1e-12);
+    prm.put("maxiter", 500);
+    prm.put("verbosity", 0);
+    prm.put("preconditioner.type", "ILU0"s);
+    prm.put("preconditioner.relaxation", 1.0);
+    const std::function<Vector()> weights;
+
+    auto solve = [&](const std::string& solver) {
+        prm.put("solver", solver);
+        Dune::FlexibleSolver<Operator> flexsolver(fop, comm, prm, weights, 0);
+        Vector x(mat.M()), b(mat.N());
+        x = 0;
+        b = 1.0;
+        comm.copyOwnerToAll(b, b);
+        Dune::InverseOperatorResult r;
+        flexsolver.apply(x, b, r);
+        BOOST_CHECK(r.converged);
+        comm.copyOwnerToAll(x, x);
+        return x;
+    };
+
+    const Vector expected = solve("bicgstab"s);
+    for (const auto& solver : {"pipelinedbicgstab"s, "sstepgmres"s}) {
+        const Vector x = solve(solver);
+        BOOST_REQUIRE_EQUAL(x.size(), expected.size());
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            for (int row = 0; row < BS; ++row) {
+                BOOST_CHECK_CLOSE(x[i][row], expected[i][row], 1e-4);
+            }
+        }
+    }
+}
+
 bool init_unit_test_func()
 {
     return true;
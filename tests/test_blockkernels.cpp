@@ -0,0 +1,331 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestBlockKernels
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/linalg/BlockKernels.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0.hpp>
+#include <opm/simulators/linalg/ParallelOverlappingILU0_impl.hpp>
+#include <opm/simulators/linalg/matrixblock.hh>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/version.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/ilu.hh>
+#include <dune/istl/paamg/pinfo.hh>
+#include <dune/istl/preconditioners.hh>
+
+#include <cmath>
+#include <utility>
+
+namespace {
+
+template <int rows, int cols>
+Dune::FieldMatrix<double, rows, cols> makeBlock(const double shift)
+{
+    Dune::FieldMatrix<double, rows, cols> a;
+    for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+            a[i][j] = std::sin(1.3 * i + 0.7 * j + shift);
+        }
+    }
+    return a;
+}
+
+template <int n>
+Dune::FieldVector<double, n> makeVector(const double shift)
+{
+    Dune::FieldVector<double, n> x;
+    for (int i = 0; i < n; ++i) {
+        x[i] = std::cos(0.9 * i + shift);
+    }
+    return x;
+}
+
+template <class V>
+void checkEqual(const V& x, const V& expected)
+{
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        BOOST_CHECK_SMALL(x[i] - expected[i], 1.0e-13);
+    }
+}
+
+template <int rows, int cols>
+void checkEqual(const Dune::FieldMatrix<double, rows, cols>& a,
+                const Dune::FieldMatrix<double, rows, cols>& expected)
+{
+    for (int i = 0; i < rows; ++i) {
+        checkEqual(a[i], expected[i]);
+    }
+}
+
+// The raw kernels of a block size against the operations of FieldMatrix.
+template <class Kernels, int n>
+void checkKernels()
+{
+    const auto a = makeBlock<n, n>(0.1);
+    const auto b = makeBlock<n, n>(2.3);
+    const auto x = makeVector<n>(0.4);
+    const auto y0 = makeVector<n>(1.7);
+    const double alpha = -0.6;
+
+    auto y = y0;
+    auto expected = y0;
+    Kernels::umv(&a[0][0], &x[0], &y[0]);
+    a.umv(x, expected);
+    checkEqual(y, expected);
+
+    y = y0;
+    expected = y0;
+    Kernels::mmv(&a[0][0], &x[0], &y[0]);
+    a.mmv(x, expected);
+    checkEqual(y, expected);
+
+    y = y0;
+    expected = y0;
+    Kernels::usmv(alpha, &a[0][0], &x[0], &y[0]);
+    a.usmv(alpha, x, expected);
+    checkEqual(y, expected);
+
+    y = y0;
+    Kernels::mv(&a[0][0], &x[0], &y[0]);
+    a.mv(x, expected);
+    checkEqual(y, expected);
+
+    Dune::FieldMatrix<double, n, n> c;
+    Kernels::multiply(&a[0][0], &b[0][0], &c[0][0]);
+    auto product = a;
+    product.rightmultiply(b);
+    checkEqual(c, product);
+
+    c = makeBlock<n, n>(3.1);
+    auto difference = c;
+    difference -= product;
+    Kernels::multiplySubtract(&a[0][0], &b[0][0], &c[0][0]);
+    checkEqual(c, difference);
+}
+
+template <int n>
+void checkBlockSize()
+{
+    checkKernels<Opm::detail::BlockKernelsGeneric<double, n>, n>();
+    checkKernels<Opm::detail::BlockKernels<double, n>, n>();
+}
+
+// 1D Laplacian like matrix with random looking, diagonally dominant blocks.
+template <int n>
+Dune::BCRSMatrix<Opm::MatrixBlock<double, n, n>> makeMatrix(const int size)
+{
+    using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, n, n>>;
+    Matrix m(size, size, Matrix::row_wise);
+    for (auto row = m.createbegin(); row != m.createend(); ++row) {
+        const int i = row.index();
+        if (i > 1) {
+            row.insert(i - 2);
+        }
+        if (i > 0) {
+            row.insert(i - 1);
+        }
+        row.insert(i);
+        if (i < size - 1) {
+            row.insert(i + 1);
+        }
+    }
+    for (auto row = m.begin(); row != m.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            *col = makeBlock<n, n>(0.3 * row.index() + 0.11 * col.index());
+            if (col.index() == row.index()) {
+                for (int i = 0; i < n; ++i) {
+                    (*col)[i][i] += 4.0 * n;
+                }
+            }
+        }
+    }
+    return m;
+}
+
+// The block ILU0 factorization and solves with the kernels against the
+// ones of dune-istl.
+template <int n>
+void checkILU0()
+{
+    using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, n, n>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, n>>;
+    const int size = 30;
+    const Matrix A = makeMatrix<n>(size);
+
+    Matrix ilu = A;
+    Opm::detail::ghost_last_bilu0_decomposition(ilu, ilu.N());
+    Matrix expected = A;
+#if DUNE_VERSION_LT(DUNE_GRID, 2, 8)
+    bilu0_decomposition(expected);
+#else
+    Dune::ILU::blockILU0Decomposition(expected);
+#endif
+    for (auto row = ilu.begin(); row != ilu.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    BOOST_CHECK_SMALL((*col)[i][j] - expected[row.index()][col.index()][i][j], 1.0e-12);
+                }
+            }
+        }
+    }
+
+    Dune::SeqILU<Matrix, Vector, Vector> seqIlu(A, 1.0);
+    Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Dune::Amg::SequentialInformation>
+        opmIlu(A, 0, 1.0, Opm::MILU_VARIANT::ILU);
+    Vector d(size);
+    for (int i = 0; i < size; ++i) {
+        d[i] = makeVector<n>(0.2 * i);
+    }
+    Vector v(size), vExpected(size);
+    v = 0.0;
+    vExpected = 0.0;
+    opmIlu.apply(v, d);
+    seqIlu.apply(vExpected, d);
+    for (int i = 0; i < size; ++i) {
+        for (int r = 0; r < n; ++r) {
+            BOOST_CHECK_SMALL(v[i][r] - vExpected[i][r], 1.0e-12);
+        }
+    }
+}
+
+// The ILU0 with reverse Cuthill-McKee ordering refilled by update() after
+// the values of the matrix changed against one set up anew.
+template <int n>
+void checkReorderedUpdate()
+{
+    using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, n, n>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, n>>;
+    using ILU = Opm::ParallelOverlappingILU0<Matrix, Vector, Vector, Dune::Amg::SequentialInformation>;
+    const int size = 30;
+    Matrix A = makeMatrix<n>(size);
+    ILU updated(A, 0, 1.0, Opm::MILU_VARIANT::ILU, /*redblack=*/false,
+                /*reorder_sphere=*/true, /*reorder_rcm=*/true);
+
+    for (auto row = A.begin(); row != A.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            *col *= 1.0 + 0.05 * std::sin(0.7 * row.index() + 0.3 * col.index());
+        }
+    }
+    updated.update();
+    ILU rebuilt(A, 0, 1.0, Opm::MILU_VARIANT::ILU, /*redblack=*/false,
+                /*reorder_sphere=*/true, /*reorder_rcm=*/true);
+
+    Vector d(size);
+    for (int i = 0; i < size; ++i) {
+        d[i] = makeVector<n>(0.4 * i);
+    }
+    Vector v(size), vExpected(size);
+    v = 0.0;
+    vExpected = 0.0;
+    updated.apply(v, d);
+    rebuilt.apply(vExpected, d);
+    for (int i = 0; i < size; ++i) {
+        for (int r = 0; r < n; ++r) {
+            BOOST_CHECK_SMALL(v[i][r] - vExpected[i][r], 1.0e-13);
+        }
+    }
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(KernelsMatchDuneBlockOperations)
+{
+    BOOST_TEST_MESSAGE("AVX2 kernels " << (OPM_BLOCK_KERNELS_AVX2 ? "enabled" : "disabled"));
+    checkBlockSize<1>();
+    checkBlockSize<2>();
+    checkBlockSize<3>();
+    // The AVX2 specialization if compiled with AVX2 and FMA.
+    checkBlockSize<4>();
+    checkBlockSize<5>();
+    checkBlockSize<6>();
+}
+
+BOOST_AUTO_TEST_CASE(BlockOperationsMatchDune)
+{
+    // Square blocks use the kernels.
+    {
+        using Block = Opm::MatrixBlock<double, 4, 4>;
+        const Block a = makeBlock<4, 4>(0.5);
+        const Block b = makeBlock<4, 4>(1.5);
+        const auto x = makeVector<4>(0.2);
+        auto y = makeVector<4>(0.8);
+        auto expected = y;
+        Opm::detail::blockUmv(a, x, y);
+        a.umv(x, expected);
+        checkEqual(y, expected);
+        Opm::detail::blockMmv(a, x, y);
+        a.mmv(x, expected);
+        checkEqual(y, expected);
+        Opm::detail::blockUsmv(2.5, a, x, y);
+        a.usmv(2.5, x, expected);
+        checkEqual(y, expected);
+        Opm::detail::blockMv(a, x, y);
+        a.mv(x, expected);
+        checkEqual(y, expected);
+
+        Block c = a;
+        Opm::detail::blockRightMultiply(c, b);
+        Dune::FieldMatrix<double, 4, 4> product = a;
+        product.rightmultiply(b);
+        checkEqual(static_cast<const Dune::FieldMatrix<double, 4, 4>&>(c), product);
+
+        Block d = makeBlock<4, 4>(2.5);
+        Dune::FieldMatrix<double, 4, 4> difference = d;
+        difference -= product;
+        Opm::detail::blockMultiplySubtract(a, b, d);
+        checkEqual(static_cast<const Dune::FieldMatrix<double, 4, 4>&>(d), difference);
+    }
+
+    // Others fall back to the operations of the block.
+    {
+        const auto a = makeBlock<3, 2>(0.5);
+        const auto x = makeVector<2>(0.2);
+        auto y = makeVector<3>(0.8);
+        auto expected = y;
+        Opm::detail::blockUmv(a, x, y);
+        a.umv(x, expected);
+        checkEqual(y, expected);
+        Opm::detail::blockMmv(a, x, y);
+        a.mmv(x, expected);
+        checkEqual(y, expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ILU0MatchesDune)
+{
+    checkILU0<1>();
+    checkILU0<2>();
+    checkILU0<3>();
+    checkILU0<4>();
+}
+
+BOOST_AUTO_TEST_CASE(ReorderedILU0UpdateMatchesRebuild)
+{
+    checkReorderedUpdate<1>();
+    checkReorderedUpdate<3>();
+}
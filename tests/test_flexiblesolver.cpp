@@ -29,6 +29,7 @@
 
 #include <dune/common/fmatrix.hh>
 #include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/istlexception.hh>
 #include <dune/istl/matrixmarket.hh>
 
 #include <fstream>
@@ -118,3 +119,179 @@ BOOST_AUTO_TEST_CASE(TestFlexibleSolver)
         }
     }
 }
+
+BOOST_AUTO_TEST_CASE(TestCommunicationReducingSolvers)
+{
+    Opm::PropertyTree prm;
+    prm.put("tol", 1e-12);
+    prm.put("maxiter", 200);
+    prm.put("verbosity", 0);
+    prm.put("preconditioner.type", std::string("ILU0"));
+    prm.put("preconditioner.relaxation", 1.0);
+    prm.put("solver", std::string("bicgstab"));
+
+    const int bz = 3;
+    const auto expected = testSolver<bz>(prm, "matr33.txt", "rhs3.txt");
+    for (const std::string solver : {"pipelinedbicgstab", "sstepgmres", "gcrodr"}) {
+        prm.put("solver", solver);
+        auto sol = testSolver<bz>(prm, "matr33.txt", "rhs3.txt");
+        BOOST_REQUIRE_EQUAL(sol.size(), expected.size());
+        for (size_t i = 0; i < sol.size(); ++i) {
+            for (int row = 0; row < bz; ++row) {
+                BOOST_CHECK_SMALL(sol[i][row] - expected[i][row], 1e-6);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestCommunicationReducingSolversBreakdown)
+{
+    // A = [1 1; 1 1] annihilates b = (1, -1), so the first Krylov vector
+    // A M^-1 b is zero and both solvers must report the breakdown.
+    using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, 1, 1>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+    Matrix matrix(2, 2, 4, Matrix::row_wise);
+    for (auto row = matrix.createbegin(); row != matrix.createend(); ++row) {
+        row.insert(0);
+        row.insert(1);
+    }
+    matrix = 1.0;
+
+    Opm::PropertyTree prm;
+    prm.put("tol", 1e-8);
+    prm.put("maxiter", 20);
+    prm.put("verbosity", 0);
+    prm.put("preconditioner.type", std::string("Jac"));
+    prm.put("preconditioner.relaxation", 1.0);
+
+    using SeqOperatorType = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+    SeqOperatorType op(matrix);
+    for (const std::string solver : {"pipelinedbicgstab", "sstepgmres"}) {
+        prm.put("solver", solver);
+        Dune::FlexibleSolver<SeqOperatorType> flexsolver(op, prm, std::function<Vector()>(), 0);
+        Vector x(2), rhs(2);
+        x = 0.0;
+        rhs[0] = 1.0;
+        rhs[1] = -1.0;
+        Dune::InverseOperatorResult res;
+        BOOST_CHECK_THROW(flexsolver.apply(x, rhs, res), Dune::SolverAbort);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestThreadedSmoothers)
+{
+    Opm::PropertyTree prm;
+    prm.put("tol", 1e-12);
+    prm.put("maxiter", 200);
+    prm.put("verbosity", 0);
+    prm.put("preconditioner.type", std::string("ILU0"));
+    prm.put("preconditioner.relaxation", 1.0);
+    prm.put("solver", std::string("bicgstab"));
+
+    const int bz = 3;
+    const auto expected = testSolver<bz>(prm, "matr33.txt", "rhs3.txt");
+    prm.put("preconditioner.l1", true);
+    prm.put("preconditioner.degree", 3);
+    auto check = [&expected](const Opm::PropertyTree& p)
+    {
+        auto sol = testSolver<bz>(p, "matr33.txt", "rhs3.txt");
+        BOOST_REQUIRE_EQUAL(sol.size(), expected.size());
+        for (size_t i = 0; i < sol.size(); ++i) {
+            for (int row = 0; row < bz; ++row) {
+                BOOST_CHECK_SMALL(sol[i][row] - expected[i][row], 1e-6);
+            }
+        }
+    };
+    for (const std::string smoother : {"ThreadedJac", "Chebyshev"}) {
+        BOOST_TEST_MESSAGE("Smoother " << smoother);
+        prm.put("preconditioner.type", smoother);
+        check(prm);
+
+        // As the smoother of the AMG variants.
+        for (const std::string amg : {"amg", "kamg"}) {
+            Opm::PropertyTree amgprm = prm;
+            amgprm.put("preconditioner.type", amg);
+            amgprm.put("preconditioner.smoother", smoother);
+            check(amgprm);
+        }
+
+        // As the fine smoother of CPR and the smoother of its coarse AMG.
+        Opm::PropertyTree cprprm = prm;
+        cprprm.put("preconditioner.type", std::string("cpr"));
+        cprprm.put("preconditioner.finesmoother.type", smoother);
+        cprprm.put("preconditioner.finesmoother.l1", true);
+        cprprm.put("preconditioner.finesmoother.degree", 3);
+        cprprm.put("preconditioner.coarsesolver.preconditioner.type", std::string("amg"));
+        cprprm.put("preconditioner.coarsesolver.preconditioner.smoother", smoother);
+        cprprm.put("preconditioner.coarsesolver.solver", std::string("loopsolver"));
+        cprprm.put("preconditioner.coarsesolver.maxiter", 1);
+        cprprm.put("preconditioner.coarsesolver.tol", 1e-1);
+        cprprm.put("preconditioner.coarsesolver.verbosity", 0);
+        check(cprprm);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(TestRecyclingSolverRepeatedSolves)
+{
+    // 1D convection-diffusion with Jacobi, where restarted GMRES is slow
+    // because of the small eigenvalues, which the recycled space removes.
+    using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, 1, 1>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+    const int n = 60;
+    Matrix matrix(n, n, 3 * n - 2, Matrix::row_wise);
+    for (auto row = matrix.createbegin(); row != matrix.createend(); ++row) {
+        const int i = row.index();
+        if (i > 0) {
+            row.insert(i - 1);
+        }
+        row.insert(i);
+        if (i < n - 1) {
+            row.insert(i + 1);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        matrix[i][i] = 2.0;
+        if (i > 0) {
+            matrix[i][i - 1] = -1.1;
+        }
+        if (i < n - 1) {
+            matrix[i][i + 1] = -0.9;
+        }
+    }
+
+    Opm::PropertyTree prm;
+    prm.put("tol", 1e-10);
+    prm.put("maxiter", 2000);
+    prm.put("verbosity", 0);
+    prm.put("preconditioner.type", std::string("Jac"));
+    prm.put("preconditioner.relaxation", 1.0);
+    prm.put("solver", std::string("gcrodr"));
+    prm.put("restart", 10);
+    prm.put("recycle", 5);
+
+    using SeqOperatorType = Dune::MatrixAdapter<Matrix, Vector, Vector>;
+    SeqOperatorType op(matrix);
+    Dune::FlexibleSolver<SeqOperatorType> solver(op, prm, std::function<Vector()>(), 0);
+
+    // Related right hand sides, as for the steps of a Newton method.
+    std::vector<int> iterations;
+    for (int solve = 0; solve < 3; ++solve) {
+        Vector expected(n);
+        for (int i = 0; i < n; ++i) {
+            expected[i] = std::sin(3.0 * (i + 1) / n) + 0.05 * solve * std::cos(7.0 * (i + 1) / n);
+        }
+        Vector rhs(n);
+        matrix.mv(expected, rhs);
+
+        Vector x(n);
+        x = 0.0;
+        Dune::InverseOperatorResult res;
+        solver.apply(x, rhs, res);
+        BOOST_CHECK(res.converged);
+        for (int i = 0; i < n; ++i) {
+            BOOST_CHECK_SMALL(x[i][0] - expected[i][0], 1e-6);
+        }
+        iterations.push_back(res.iterations);
+    }
+    BOOST_CHECK_LT(iterations.back(), iterations.front());
+}
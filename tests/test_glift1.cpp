@@ -97,6 +97,18 @@ initSimulator(const char *filename)
 
 namespace {
 
+// Exposes the lift curve and the bhp computation it caches.
+template <class TypeTag>
+class TabulatedGasLift : public Opm::GasLiftSingleWell<TypeTag>
+{
+    using Base = Opm::GasLiftSingleWell<TypeTag>;
+
+public:
+    using Base::Base;
+    using Opm::GasLiftSingleWellGeneric::computeBhpAtThpLimit_;
+    using Opm::GasLiftSingleWellGeneric::lift_curve_;
+};
+
 struct GliftFixture {
     GliftFixture() {
     int argc = boost::unit_test::framework::master_test_suite().argc;
@@ -200,5 +212,26 @@ BOOST_AUTO_TEST_CASE(G1)
     BOOST_CHECK(!state->alqIsLimited());
     BOOST_CHECK_CLOSE(state->alq(), 0.0, 1e-8);
     BOOST_CHECK(!state->increase().has_value());
+
+    // The lift curve is tabulated for wells under THP control only. It
+    // matches the bhp computed on demand for each lift gas rate.
+    auto& ws = well_state.well(well_ptr->indexOfWell());
+    const auto cmode = ws.production_cmode;
+    ws.production_cmode = Opm::Well::ProducerCMode::THP;
+    TabulatedGasLift<TypeTag> tabulated {*std_well, *(simulator.get()), summary_state,
+        deferred_logger, well_state, group_state, group_info, sync_groups,
+        comm, /*glift_debug=*/false
+    };
+    tabulated.tabulateLiftCurve(/*num_increments=*/3, deferred_logger);
+    BOOST_CHECK(!tabulated.lift_curve_.empty());
+    BOOST_CHECK_LE(tabulated.lift_curve_.size(), 7u);
+    for (const auto& [alq, bhp] : tabulated.lift_curve_) {
+        const auto expected = tabulated.computeBhpAtThpLimit_(alq, deferred_logger, /*debug_output=*/false);
+        BOOST_CHECK_EQUAL(bhp.has_value(), expected.has_value());
+        if (bhp && expected) {
+            BOOST_CHECK_CLOSE(*bhp, *expected, 1e-10);
+        }
+    }
+    ws.production_cmode = cmode;
 }
 
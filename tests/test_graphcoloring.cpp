@@ -99,3 +99,68 @@ BOOST_AUTO_TEST_CASE(TestWelschPowell)
                                            graph, 0);
     checkAllIndices(newOrder);
 }
+
+BOOST_AUTO_TEST_CASE(TestReverseCuthillMcKee)
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double,1,1>>;
+    using Graph = Dune::Amg::MatrixGraph<Matrix>;
+    // 2D 5-point stencil with the cells numbered in a scrambled order.
+    const int N = 10;
+    std::vector<int> cellIndex(N*N);
+    for (int cell = 0; cell < N*N; ++cell)
+    {
+        cellIndex[cell] = (cell * 37) % (N*N);
+    }
+    Matrix matrix(N*N, N*N, 5, 0.4, Matrix::implicit);
+    for (int j = 0; j < N; j++)
+    {
+        for (int i = 0; i < N; i++)
+        {
+            const auto index = cellIndex[j*N+i];
+            matrix.entry(index, index) = 1;
+            if ( i > 0 )
+                matrix.entry(index, cellIndex[j*N+i-1]) = 1;
+            if ( i < N - 1 )
+                matrix.entry(index, cellIndex[j*N+i+1]) = 1;
+            if ( j > 0 )
+                matrix.entry(index, cellIndex[(j-1)*N+i]) = 1;
+            if ( j < N - 1 )
+                matrix.entry(index, cellIndex[(j+1)*N+i]) = 1;
+        }
+    }
+    matrix.compress();
+
+    auto bandwidth = [&matrix](const std::vector<std::size_t>& ordering)
+    {
+        std::size_t width = 0;
+        for (auto row = matrix.begin(); row != matrix.end(); ++row)
+        {
+            for (auto col = row->begin(); col != row->end(); ++col)
+            {
+                const auto r = ordering[row.index()];
+                const auto c = ordering[col.index()];
+                width = std::max(width, r > c ? r - c : c - r);
+            }
+        }
+        return width;
+    };
+
+    Graph graph(matrix);
+    auto newOrder = Opm::reorderVerticesReverseCuthillMcKee(graph);
+    checkAllIndices(newOrder);
+    // A breadth first search of the grid started at a corner numbers the
+    // anti-diagonals consecutively, at most N+1 cells apart.
+    BOOST_CHECK(bandwidth(newOrder) <= N + 1);
+
+    // Only reorder the first vertices, the others keep their index.
+    const std::size_t noReordered = 60;
+    newOrder = Opm::reorderVerticesReverseCuthillMcKee(graph, noReordered);
+    checkAllIndices(newOrder);
+    for (std::size_t vertex = 0; vertex < newOrder.size(); ++vertex)
+    {
+        if (vertex < noReordered)
+            BOOST_CHECK(newOrder[vertex] < noReordered);
+        else
+            BOOST_CHECK(newOrder[vertex] == vertex);
+    }
+}
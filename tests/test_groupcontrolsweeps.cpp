@@ -0,0 +1,165 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestGroupControlSweeps
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/wells/WellGroupHelpers.hpp>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Node
+{
+    std::string name;
+    std::vector<const Node*> children;
+};
+
+// FIELD <- {A <- {A1}, B}, where A and B share a limit on their total
+// rate and each switches to a lower rate if the total exceeds it.
+struct GroupTree
+{
+    GroupTree()
+    {
+        a.children = {&a1};
+        field.children = {&a, &b};
+    }
+
+    bool sweep()
+    {
+        return Opm::WellGroupHelpers::sweepGroupControls(field,
+            [](const Node& grp) { return grp.children; },
+            [this](const std::vector<const Node*>& roots)
+            {
+                std::string names;
+                for (const auto* root : roots) {
+                    names += root->name;
+                }
+                log.push_back("sweep " + names);
+            },
+            [this](const Node& grp)
+            {
+                log.push_back("higher " + grp.name);
+                seen_parent_rate[grp.name] = grp.name == "A1" ? committed.at("A") : 0.0;
+                return switch_higher.erase(grp.name) > 0;
+            },
+            [this](const Node& grp)
+            {
+                log.push_back("individual " + grp.name);
+                if (!committed.count(grp.name) || switched.count(grp.name) ||
+                    committed.at("A") + committed.at("B") <= limit) {
+                    return false;
+                }
+                switched.insert(grp.name);
+                current[grp.name] = 5.0;
+                return true;
+            },
+            [this]()
+            {
+                log.push_back("update");
+                committed = current;
+            });
+    }
+
+    Node field{"FIELD", {}};
+    Node a{"A", {}};
+    Node a1{"A1", {}};
+    Node b{"B", {}};
+
+    const double limit = 15.0;
+    // The rates of the states after the last update, and with all switches.
+    std::map<std::string, double> committed{{"A", 10.0}, {"B", 10.0}};
+    std::map<std::string, double> current = committed;
+    std::set<std::string> switched;
+    // Groups whose check of the higher constraints switches once.
+    std::set<std::string> switch_higher;
+    std::map<std::string, double> seen_parent_rate;
+    std::vector<std::string> log;
+};
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(NoSwitchSingleSweep)
+{
+    GroupTree tree;
+    tree.committed = tree.current = {{"A", 5.0}, {"B", 5.0}};
+    BOOST_CHECK(!tree.sweep());
+    const std::vector<std::string> expected{
+        "sweep FIELD",
+        "higher FIELD", "individual FIELD",
+        "higher A", "individual A",
+        "higher A1", "individual A1",
+        "higher B", "individual B",
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(tree.log.begin(), tree.log.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(SiblingsSwitchWithinSweep)
+{
+    GroupTree tree;
+    BOOST_CHECK(tree.sweep());
+
+    // B is checked with the states from before the switch of A, so both
+    // switch, where a state update after every switch would have left B
+    // under the limit.
+    BOOST_CHECK(tree.switched.count("A"));
+    BOOST_CHECK(tree.switched.count("B"));
+
+    // The subtree of A is checked in the next sweep, after the update.
+    const std::vector<std::string> expected{
+        "sweep FIELD",
+        "higher FIELD", "individual FIELD",
+        "higher A", "individual A",
+        "higher B", "individual B",
+        "update",
+        "sweep A1",
+        "higher A1", "individual A1",
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(tree.log.begin(), tree.log.end(), expected.begin(), expected.end());
+    BOOST_CHECK_EQUAL(tree.seen_parent_rate.at("A1"), 5.0);
+}
+
+BOOST_AUTO_TEST_CASE(HigherSwitchDefersIndividualCheck)
+{
+    GroupTree tree;
+    tree.committed = tree.current = {{"A", 5.0}, {"B", 5.0}};
+    tree.switch_higher = {"A"};
+    BOOST_CHECK(tree.sweep());
+
+    // The individual check of A and its subtree wait for the update, the
+    // higher constraints of A are not checked again.
+    const std::vector<std::string> expected{
+        "sweep FIELD",
+        "higher FIELD", "individual FIELD",
+        "higher A",
+        "higher B", "individual B",
+        "update",
+        "sweep A",
+        "individual A",
+        "higher A1", "individual A1",
+    };
+    BOOST_CHECK_EQUAL_COLLECTIONS(tree.log.begin(), tree.log.end(), expected.begin(), expected.end());
+}
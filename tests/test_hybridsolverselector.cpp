@@ -0,0 +1,71 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE HybridSolverSelectorTest
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/linalg/HybridSolverSelector.hpp>
+
+BOOST_AUTO_TEST_CASE(SwitchesWithHysteresis)
+{
+    Opm::HybridSolverSelector selector(2, 0.2, 1.0);
+
+    // Speed test measuring both solvers, the second one is cheaper.
+    selector.addSolve(0, 0.5, 1.5, 10, true);
+    selector.addSolve(1, 0.0, 1.0, 50, true);
+    selector.setActiveSolver(1);
+    BOOST_CHECK_EQUAL(selector.selectForStep(), 1);
+    BOOST_CHECK_CLOSE(selector.predictedCost(0), 2.0, 1e-12);
+    BOOST_CHECK_CLOSE(selector.predictedIterations(1), 50.0, 1e-12);
+
+    // The first solver is cheaper now, but not by enough to switch.
+    selector.addSolve(1, 0.0, 2.2, 100, true);
+    BOOST_CHECK_EQUAL(selector.selectForStep(), 1);
+
+    selector.addSolve(1, 0.0, 3.0, 150, true);
+    BOOST_CHECK_EQUAL(selector.selectForStep(), 0);
+    BOOST_CHECK_EQUAL(selector.activeSolver(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(FallbackAfterFailure)
+{
+    Opm::HybridSolverSelector selector(2, 0.2, 0.5, 2);
+    selector.addSolve(0, 0.0, 1.0, 10, true);
+    selector.addSolve(1, 0.0, 4.0, 80, true);
+    BOOST_CHECK_EQUAL(selector.selectForStep(), 0);
+
+    selector.addSolve(0, 0.0, 5.0, 200, false);
+    BOOST_CHECK_EQUAL(selector.failures(0), 1);
+    BOOST_CHECK_EQUAL(selector.fallback(), 1);
+    selector.setActiveSolver(1);
+    selector.addSolve(1, 0.0, 4.0, 80, true);
+
+    // The failed solver is excluded for two steps despite being cheaper.
+    BOOST_CHECK_EQUAL(selector.selectForStep(), 1);
+    BOOST_CHECK_EQUAL(selector.selectForStep(), 1);
+    BOOST_CHECK_EQUAL(selector.selectForStep(), 0);
+
+    // Both solvers failing in the same step leaves nothing to fall back to.
+    selector.addSolve(0, 0.0, 1.0, 200, false);
+    selector.setActiveSolver(1);
+    selector.addSolve(1, 0.0, 1.0, 200, false);
+    BOOST_CHECK_EQUAL(selector.fallback(), -1);
+}
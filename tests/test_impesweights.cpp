@@ -0,0 +1,419 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestImpesWeights
+#define BOOST_TEST_NO_MAIN
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/material/densead/Evaluation.hpp>
+#include <opm/simulators/linalg/SmallDenseMatrixUtils.hpp>
+#include <opm/simulators/linalg/getQuasiImpesWeights.hpp>
+#include <opm/simulators/utils/ParallelCommunication.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+template <int n>
+Dune::FieldMatrix<double, n, n> makeBlock(const double shift)
+{
+    Dune::FieldMatrix<double, n, n> a;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            a[i][j] = std::sin(1.3 * i + 0.7 * j + shift) + (i == j ? 2.0 : 0.0);
+        }
+    }
+    return a;
+}
+
+template <int n>
+Dune::FieldMatrix<double, n, n> transposed(const Dune::FieldMatrix<double, n, n>& a)
+{
+    Dune::FieldMatrix<double, n, n> t;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            t[j][i] = a[i][j];
+        }
+    }
+    return t;
+}
+
+// The weights of a block with the general solver of dune-common.
+template <int n>
+Dune::FieldVector<double, n> expectedWeights(const Dune::FieldMatrix<double, n, n>& block, const int k)
+{
+    Dune::FieldVector<double, n> rhs(0.0);
+    rhs[k] = 1.0;
+    Dune::FieldVector<double, n> w;
+    transposed(block).solve(w, rhs);
+    Opm::Details::normalizeWeights(w);
+    return w;
+}
+
+template <int n>
+void checkEqual(const Dune::FieldVector<double, n>& x, const Dune::FieldVector<double, n>& expected)
+{
+    for (int i = 0; i < n; ++i) {
+        BOOST_CHECK_SMALL(x[i] - expected[i], 1.0e-10);
+    }
+}
+
+template <int n, bool transpose>
+void checkSolveUnitVector()
+{
+    const auto a = makeBlock<n>(0.3 * n);
+    const auto op = transpose ? transposed(a) : a;
+    for (int k = 0; k < n; ++k) {
+        Dune::FieldVector<double, n> x;
+        Opm::detail::solveUnitVector<transpose>(a, k, x);
+        Dune::FieldVector<double, n> ek;
+        op.mv(x, ek);
+        for (int i = 0; i < n; ++i) {
+            BOOST_CHECK_SMALL(ek[i] - (i == k ? 1.0 : 0.0), 1.0e-12);
+        }
+    }
+}
+
+template <int n>
+void checkSolveUnitVector()
+{
+    checkSolveUnitVector<n, false>();
+    checkSolveUnitVector<n, true>();
+}
+
+// Mocks of the model, element context and grid view with what
+// getTrueImpesWeights() uses. The storage of a cell is linear in the
+// primary variables, with the matrix of the cell as the derivatives.
+constexpr int numEq = 3;
+constexpr int pressureIndex = 1;
+using Evaluation = Opm::DenseAd::Evaluation<double, numEq>;
+using Storage = Dune::FieldVector<Evaluation, numEq>;
+using WeightVector = Dune::BlockVector<Dune::FieldVector<double, numEq>>;
+
+struct IntensiveQuantities
+{
+    Dune::FieldMatrix<double, numEq, numEq> storageMatrix;
+
+    double extrusionFactor() const
+    {
+        return 1.0;
+    }
+};
+
+double cellVolume(const int cell)
+{
+    return 10.0 + cell;
+}
+
+constexpr double stepLength = 86400.0;
+
+struct Cells
+{
+    std::vector<IntensiveQuantities> intQuants;
+    std::vector<bool> isCached;
+};
+
+struct ElementContext
+{
+    struct Grid
+    {
+        Opm::Parallel::Communication comm() const
+        {
+            return Dune::MPIHelper::getCommunication();
+        }
+    };
+    struct Vanguard
+    {
+        Grid grid() const
+        {
+            return {};
+        }
+    };
+    struct Simulator
+    {
+        double timeStepSize() const
+        {
+            return stepLength;
+        }
+        Vanguard vanguard() const
+        {
+            return {};
+        }
+    };
+    struct SubControlVolume
+    {
+        double volume_;
+        double volume() const
+        {
+            return volume_;
+        }
+    };
+    struct Stencil
+    {
+        SubControlVolume scv;
+        const SubControlVolume& subControlVolume(int) const
+        {
+            return scv;
+        }
+    };
+
+    const Simulator& simulator() const
+    {
+        return simulator_;
+    }
+    void updatePrimaryStencil(const int cell)
+    {
+        cell_ = cell;
+        ++updates;
+    }
+    void updatePrimaryIntensiveQuantities(int)
+    {
+    }
+    const IntensiveQuantities& intensiveQuantities(int, int) const
+    {
+        return cells->intQuants[cell_];
+    }
+    Stencil stencil(int) const
+    {
+        return {{cellVolume(cell_)}};
+    }
+
+    const Cells* cells = nullptr;
+    int cell_ = -1;
+    int updates = 0;
+    Simulator simulator_;
+};
+
+struct LocalResidual
+{
+    struct Residual
+    {
+        using block_type = Evaluation;
+    };
+
+    Residual residual(int) const
+    {
+        return {};
+    }
+
+    static void computeStorage(Storage& storage, const IntensiveQuantities& intQuants)
+    {
+        for (int i = 0; i < numEq; ++i) {
+            storage[i] = 0.0;
+            for (int j = 0; j < numEq; ++j) {
+                storage[i] += intQuants.storageMatrix[i][j] * Evaluation::createVariable(1.0 + j, j);
+            }
+        }
+    }
+
+    void computeStorage(Storage& storage, const ElementContext& elemCtx, int, int timeIdx) const
+    {
+        computeStorage(storage, elemCtx.intensiveQuantities(0, timeIdx));
+    }
+};
+
+struct Model
+{
+    struct LocalLinearizer
+    {
+        const LocalResidual& localResidual() const
+        {
+            return residual;
+        }
+        LocalResidual residual;
+    };
+
+    const LocalLinearizer& localLinearizer(std::size_t) const
+    {
+        return linearizer;
+    }
+    const IntensiveQuantities* cachedIntensiveQuantities(const int cell, int) const
+    {
+        return cells->isCached[cell] ? &cells->intQuants[cell] : nullptr;
+    }
+    double dofTotalVolume(const int cell) const
+    {
+        return cellVolume(cell);
+    }
+
+    const Cells* cells = nullptr;
+    LocalLinearizer linearizer;
+};
+
+struct GridView
+{
+    int numCells;
+};
+
+std::vector<int> elements(const GridView& gridView)
+{
+    std::vector<int> cells(gridView.numCells);
+    for (int c = 0; c < gridView.numCells; ++c) {
+        cells[c] = c;
+    }
+    return cells;
+}
+
+Cells makeCells(const int numCells)
+{
+    Cells cells;
+    for (int c = 0; c < numCells; ++c) {
+        auto m = makeBlock<numEq>(0.37 * c);
+        m *= 1.0 + c;
+        cells.intQuants.push_back({m});
+    }
+    cells.isCached.assign(numCells, true);
+    return cells;
+}
+
+// The true-IMPES weights of a cell, i.e. the quasi-IMPES weights of the
+// scaled storage derivatives.
+Dune::FieldVector<double, numEq> expectedTrueImpesWeights(const Cells& cells, const int cell)
+{
+    auto block = cells.intQuants[cell].storageMatrix;
+    block /= cellVolume(cell) / stepLength;
+    for (int i = 0; i < numEq; ++i) {
+        block[i][pressureIndex] *= 50e5;
+    }
+    return expectedWeights(block, pressureIndex);
+}
+
+void checkTrueImpesWeights(const Cells& cells, const int expectedUpdates)
+{
+    const int numCells = cells.intQuants.size();
+    Model model;
+    model.cells = &cells;
+    ElementContext elemCtx;
+    elemCtx.cells = &cells;
+    WeightVector weights(numCells);
+    Opm::Amg::getTrueImpesWeights(pressureIndex, weights, GridView{numCells}, elemCtx, model, 0);
+    BOOST_CHECK_EQUAL(elemCtx.updates, expectedUpdates);
+    for (int c = 0; c < numCells; ++c) {
+        checkEqual(weights[c], expectedTrueImpesWeights(cells, c));
+    }
+}
+
+// Compares the weights of the parallel loop of getQuasiImpesWeights()
+// with the ones of dune-common, returns the matrix.
+template <int n>
+Dune::BCRSMatrix<Dune::FieldMatrix<double, n, n>> checkQuasiImpesWeights()
+{
+    using Matrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, n, n>>;
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, n>>;
+    const int numRows = 500;
+    Matrix A(numRows, numRows, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int i = row.index();
+        if (i > 0) {
+            row.insert(i - 1);
+        }
+        row.insert(i);
+    }
+    for (int i = 0; i < numRows; ++i) {
+        A[i][i] = makeBlock<n>(0.1 * i);
+        if (i > 0) {
+            A[i][i - 1] = makeBlock<n>(-0.2 * i);
+        }
+    }
+
+    const auto weights = Opm::Amg::getQuasiImpesWeights<Matrix, Vector>(A, pressureIndex, false);
+    const auto weightsT = Opm::Amg::getQuasiImpesWeights<Matrix, Vector>(A, pressureIndex, true);
+    BOOST_REQUIRE_EQUAL(weights.size(), numRows);
+    BOOST_REQUIRE_EQUAL(weightsT.size(), numRows);
+    for (int i = 0; i < numRows; ++i) {
+        checkEqual(weights[i], expectedWeights(A[i][i], pressureIndex));
+        checkEqual(weightsT[i], expectedWeights(transposed(A[i][i]), pressureIndex));
+    }
+    return A;
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SolveUnitVector)
+{
+    // The sizes 3 and 4 use the cofactors, the others dune-common.
+    checkSolveUnitVector<1>();
+    checkSolveUnitVector<2>();
+    checkSolveUnitVector<3>();
+    checkSolveUnitVector<4>();
+    checkSolveUnitVector<5>();
+
+    // Singular blocks are left to dune-common, which throws.
+    Dune::FieldMatrix<double, 5, 5> singular(1.0);
+    Dune::FieldVector<double, 5> x;
+    BOOST_CHECK_THROW(Opm::detail::solveUnitVector<true>(singular, 0, x), Dune::FMatrixError);
+}
+
+BOOST_AUTO_TEST_CASE(QuasiImpesWeights)
+{
+    checkQuasiImpesWeights<3>();
+    checkQuasiImpesWeights<4>();
+    auto A = checkQuasiImpesWeights<5>();
+
+    // The failure of a row in the parallel loop reaches the caller.
+    using Matrix = decltype(A);
+    using Vector = Dune::BlockVector<Dune::FieldVector<double, 5>>;
+    A[A.N() / 2][A.N() / 2] = 0.0;
+    BOOST_CHECK_THROW((Opm::Amg::getQuasiImpesWeights<Matrix, Vector>(A, pressureIndex, false)),
+                      Dune::FMatrixError);
+}
+
+BOOST_AUTO_TEST_CASE(TrueImpesWeightsFromCache)
+{
+    const int numCells = 200;
+    auto cells = makeCells(numCells);
+
+    // All cells from the cache.
+    checkTrueImpesWeights(cells, 0);
+
+    // Cells without cached intensive quantities, including the first one,
+    // go through the element context.
+    int uncached = 0;
+    for (int c = 0; c < numCells; c += 7) {
+        cells.isCached[c] = false;
+        ++uncached;
+    }
+    checkTrueImpesWeights(cells, uncached);
+
+    // No cache at all.
+    cells.isCached.assign(numCells, false);
+    checkTrueImpesWeights(cells, numCells);
+}
+
+bool init_unit_test_func()
+{
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    Dune::MPIHelper::instance(argc, argv);
+    return boost::unit_test::unit_test_main(&init_unit_test_func, argc, argv);
+}
@@ -0,0 +1,125 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE MultiRhsBiCGSTABTest
+#include <boost/test/unit_test.hpp>
+
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/istlexception.hh>
+
+#include <opm/simulators/linalg/matrixblock.hh>
+#include <opm/simulators/linalg/MultiRhsBiCGSTAB.hpp>
+
+#include <cmath>
+#include <vector>
+
+using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, 1, 1>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, 1>>;
+
+namespace {
+
+// Upwind transport-like matrix: diagonally dominant and non-symmetric.
+Matrix upwindMatrix(const int n)
+{
+    Matrix A(n, n, 3*n, Matrix::row_wise);
+    for (auto row = A.createbegin(); row != A.createend(); ++row) {
+        const int i = row.index();
+        if (i > 0)
+            row.insert(i - 1);
+        row.insert(i);
+        if (i + 7 < n)
+            row.insert(i + 7);
+    }
+    for (int i = 0; i < n; ++i) {
+        double diag = 0.5;
+        if (i > 0) {
+            A[i][i - 1] = -1.0 - 0.1*(i % 3);
+            diag += 1.0 + 0.1*(i % 3);
+        }
+        if (i + 7 < n) {
+            A[i][i + 7] = -0.2;
+            diag += 0.2;
+        }
+        A[i][i] = diag;
+    }
+    return A;
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(SolvesAllRightHandSides)
+{
+    const int n = 200;
+    const Matrix A = upwindMatrix(n);
+
+    std::vector<Vector> b(4, Vector(n)), x(4, Vector(n));
+    for (int k = 0; k < 4; ++k) {
+        for (int i = 0; i < n; ++i) {
+            b[k][i] = std::sin(0.1*(k + 1)*i) + k;
+        }
+    }
+    // a zero right-hand side converges immediately
+    b[2] = 0.0;
+
+    Opm::MultiRhsBiCGSTAB<Matrix> solver(A, 1e-10, 200);
+    BOOST_CHECK(solver.apply(x, b));
+
+    for (int k = 0; k < 4; ++k) {
+        Vector res = b[k];
+        A.mmv(x[k], res);
+        BOOST_CHECK_SMALL(res.two_norm(), 1e-8*(1.0 + b[k].two_norm()));
+    }
+    BOOST_CHECK_SMALL(x[2].two_norm(), 1e-300);
+}
+
+BOOST_AUTO_TEST_CASE(MatchesSingleRightHandSide)
+{
+    const int n = 100;
+    const Matrix A = upwindMatrix(n);
+
+    std::vector<Vector> b(3, Vector(n)), x(3, Vector(n));
+    for (int k = 0; k < 3; ++k) {
+        for (int i = 0; i < n; ++i) {
+            b[k][i] = 1.0 + 0.01*i*(k + 1);
+        }
+    }
+    Opm::MultiRhsBiCGSTAB<Matrix> solver(A, 1e-12, 200);
+    BOOST_CHECK(solver.apply(x, b));
+
+    for (int k = 0; k < 3; ++k) {
+        std::vector<Vector> bk{b[k]}, xk(1, Vector(n));
+        BOOST_CHECK(solver.apply(xk, bk));
+        for (int i = 0; i < n; ++i) {
+            BOOST_CHECK_CLOSE(x[k][i][0], xk[0][i][0], 1e-6);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ZeroPivotThrows)
+{
+    const int n = 20;
+    Matrix A = upwindMatrix(n);
+    A[0][0] = 0.0;
+    using Solver = Opm::MultiRhsBiCGSTAB<Matrix>;
+    BOOST_CHECK_THROW(Solver(A, 1e-10, 200), Dune::MatrixBlockError);
+}
@@ -0,0 +1,311 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestNetworkPressures
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/core/props/BlackoilPhases.hpp>
+#include <opm/input/eclipse/Schedule/Network/Branch.hpp>
+#include <opm/input/eclipse/Schedule/Network/ExtNetwork.hpp>
+#include <opm/input/eclipse/Schedule/Network/Node.hpp>
+#include <opm/input/eclipse/Schedule/Schedule.hpp>
+#include <opm/input/eclipse/Schedule/VFPProdTable.hpp>
+#include <opm/simulators/wells/GroupState.hpp>
+#include <opm/simulators/wells/VFPProdProperties.hpp>
+#include <opm/simulators/wells/WellBhpThpCalculator.hpp>
+#include <opm/simulators/wells/WellGroupHelpers.hpp>
+#include <opm/simulators/wells/WellState.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Table with bhp = thp + slope * oil rate, which is linear in all the
+// interpolation variables.
+Opm::VFPProdTable linearTable(const int table_num, const double slope)
+{
+    const std::vector<double> flo_axis{0.0, 0.01};
+    const std::vector<double> thp_axis{0.0, 1.0e7};
+    std::vector<double> data;
+    for (const double thp : thp_axis) {
+        for (const double flo : flo_axis) {
+            data.push_back(thp + slope * flo);
+        }
+    }
+    return Opm::VFPProdTable(table_num,
+                             1000.0,
+                             Opm::VFPProdTable::FLO_TYPE::FLO_OIL,
+                             Opm::VFPProdTable::WFR_TYPE::WFR_WOR,
+                             Opm::VFPProdTable::GFR_TYPE::GFR_GOR,
+                             Opm::VFPProdTable::ALQ_TYPE::ALQ_UNDEF,
+                             flo_axis,
+                             thp_axis,
+                             {0.0},
+                             {0.0},
+                             {0.0},
+                             data);
+}
+
+// FIELD (fixed pressure) <- PLAT <- {G1, G2}
+struct TwoLevelNetwork
+{
+    TwoLevelNetwork()
+        : table1(linearTable(1, 1.0e8))
+        , table2(linearTable(2, 2.0e8))
+        , group_state(3)
+        , well_state(phaseUsage())
+    {
+        using Opm::Network::Branch;
+        network.add_branch(Branch("PLAT", "FIELD", 1, Branch::AlqEQ::ALQ_INPUT));
+        network.add_branch(Branch("G1", "PLAT", 2, Branch::AlqEQ::ALQ_INPUT));
+        network.add_branch(Branch("G2", "PLAT", 2, Branch::AlqEQ::ALQ_INPUT));
+        Opm::Network::Node root("FIELD");
+        root.terminal_pressure(2.0e6);
+        network.update_node(root);
+
+        vfp_props.addTable(table1);
+        vfp_props.addTable(table2);
+        setLeafRates({});
+    }
+
+    static Opm::PhaseUsage phaseUsage()
+    {
+        Opm::PhaseUsage pu;
+        pu.num_phases = 3;
+        return pu;
+    }
+
+    // Oil rates of the leaves, linear in their pressure.
+    void setLeafRates(const std::map<std::string, double>& pressures)
+    {
+        for (const auto& leaf : {"G1", "G2"}) {
+            std::vector<double> rates(3, 0.0);
+            rates[Opm::BlackoilPhases::Liquid] = oil_rates.at(leaf);
+            const auto p = pressures.find(leaf);
+            if (p != pressures.end()) {
+                rates[Opm::BlackoilPhases::Liquid] +=
+                    sensitivities.at(leaf)[Opm::BlackoilPhases::Liquid] * (p->second - reference.at(leaf));
+            }
+            group_state.update_production_rates(leaf, rates);
+        }
+    }
+
+    std::map<std::string, double> explicitPressures() const
+    {
+        return Opm::WellGroupHelpers::computeNetworkPressures(network, well_state, group_state,
+                                                              vfp_props, schedule, 0);
+    }
+
+    std::map<std::string, double>
+    newtonPressures(const std::map<std::string, std::vector<double>>& leaf_sensitivities) const
+    {
+        return Opm::WellGroupHelpers::computeNetworkPressuresNewton(network, well_state, group_state,
+                                                                    vfp_props, schedule, 0,
+                                                                    reference, leaf_sensitivities,
+                                                                    10, 1.0e-3);
+    }
+
+    Opm::Network::ExtNetwork network;
+    Opm::VFPProdTable table1;
+    Opm::VFPProdTable table2;
+    Opm::VFPProdProperties vfp_props;
+    Opm::GroupState group_state;
+    Opm::WellState well_state;
+    Opm::Schedule schedule;
+
+    const std::map<std::string, double> oil_rates{{"G1", 0.002}, {"G2", 0.003}};
+    const std::map<std::string, std::vector<double>> sensitivities{
+        {"G1", {0.0, -1.0e-9, 0.0}},
+        {"G2", {0.0, -2.0e-9, 0.0}},
+    };
+    // The node pressures the leaf rates were computed with.
+    const std::map<std::string, double> reference{{"PLAT", 2.4e6}, {"G1", 2.7e6}, {"G2", 2.8e6}};
+};
+
+struct TestGroup
+{
+    std::string parent_name;
+    double efficiency;
+
+    const std::string& parent() const
+    {
+        return parent_name;
+    }
+
+    double getGroupEfficiencyFactor() const
+    {
+        return efficiency;
+    }
+};
+
+// FIELD <- PLAT <- {G1 <- {SUB <- {DEEP}}, G2}, with PLAT, G1 and G2 being
+// network nodes. ISLAND is not below a node.
+struct GroupTree
+{
+    std::pair<std::string, double> leaf(const std::string& group) const
+    {
+        return Opm::WellGroupHelpers::networkLeafNode(group,
+            [this](const std::string& name) { return nodes.count(name) > 0; },
+            [this](const std::string& name) -> const TestGroup& { return groups.at(name); });
+    }
+
+    const std::set<std::string> nodes{"PLAT", "G1", "G2"};
+    const std::map<std::string, TestGroup> groups{
+        {"PLAT", {"FIELD", 0.9}},
+        {"G1", {"PLAT", 0.8}},
+        {"G2", {"PLAT", 0.7}},
+        {"SUB", {"G1", 0.5}},
+        {"DEEP", {"SUB", 0.25}},
+        {"ISLAND", {"FIELD", 0.6}},
+        {"FIELD", {"", 1.0}},
+    };
+};
+
+// Bhp of a producer with the oil rate a - b * bhp from the IPR and the THP,
+// by fixed point iteration on the VFP table.
+double solveBhp(const Opm::VFPProdProperties& vfp, const double a, const double b, const double thp)
+{
+    double bhp = thp;
+    for (int iteration = 0; iteration < 200; ++iteration) {
+        bhp = vfp.bhp(1, 0.0, -(a - b * bhp), 0.0, thp, 0.0, 0.0, 0.0, false);
+    }
+    return bhp;
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(ConstantRatesMatchExplicit)
+{
+    TwoLevelNetwork net;
+    const auto expected = net.explicitPressures();
+    BOOST_CHECK_CLOSE(expected.at("PLAT"), 2.5e6, 1.0e-8);
+    BOOST_CHECK_CLOSE(expected.at("G1"), 2.9e6, 1.0e-8);
+    BOOST_CHECK_CLOSE(expected.at("G2"), 3.1e6, 1.0e-8);
+
+    const auto pressures = net.newtonPressures({});
+    BOOST_REQUIRE_EQUAL(pressures.size(), expected.size());
+    for (const auto& [node, press] : expected) {
+        BOOST_CHECK_CLOSE(pressures.at(node), press, 1.0e-8);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(NewtonMatchesExplicitFixedPoint)
+{
+    TwoLevelNetwork net;
+
+    // Fixed point of the explicit pressure update with the leaf rates
+    // responding to the leaf pressures.
+    auto expected = net.reference;
+    expected["FIELD"] = 2.0e6;
+    double change = 0.0;
+    for (int iteration = 0; iteration < 100; ++iteration) {
+        net.setLeafRates(expected);
+        const auto next = net.explicitPressures();
+        change = 0.0;
+        for (const auto& [node, press] : next) {
+            change = std::max(change, std::abs(press - expected[node]));
+        }
+        expected = next;
+        if (change < 1.0e-6) {
+            break;
+        }
+    }
+    BOOST_REQUIRE_LT(change, 1.0e-6);
+    // The rates responded, i.e. the fixed point is not the reference state.
+    BOOST_CHECK_GT(std::abs(expected.at("G2") - net.reference.at("G2")), 1.0e5);
+
+    // Newton linearizes around the rates at the reference pressures.
+    net.setLeafRates({});
+    const auto pressures = net.newtonPressures(net.sensitivities);
+    BOOST_REQUIRE_EQUAL(pressures.size(), expected.size());
+    for (const auto& [node, press] : expected) {
+        BOOST_CHECK_CLOSE(pressures.at(node), press, 1.0e-6);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(LeafNodeOfGroups)
+{
+    const GroupTree tree;
+
+    // Groups which are nodes are their own leaf.
+    const auto [g1, g1_efficiency] = tree.leaf("G1");
+    BOOST_CHECK_EQUAL(g1, "G1");
+    BOOST_CHECK_EQUAL(g1_efficiency, 1.0);
+
+    // Groups below a node contribute with their efficiency factors.
+    const auto [sub, sub_efficiency] = tree.leaf("SUB");
+    BOOST_CHECK_EQUAL(sub, "G1");
+    BOOST_CHECK_CLOSE(sub_efficiency, 0.5, 1.0e-12);
+    const auto [deep, deep_efficiency] = tree.leaf("DEEP");
+    BOOST_CHECK_EQUAL(deep, "G1");
+    BOOST_CHECK_CLOSE(deep_efficiency, 0.125, 1.0e-12);
+
+    // No node up to FIELD.
+    BOOST_CHECK(tree.leaf("ISLAND").first.empty());
+    BOOST_CHECK(tree.leaf("FIELD").first.empty());
+}
+
+BOOST_AUTO_TEST_CASE(ThpRateSensitivitiesMatchFixedPoint)
+{
+    Opm::VFPProdProperties vfp;
+    vfp.addTable(linearTable(1, 1.0e8));
+
+    // Oil rate from the IPR of a reservoir at 120 bar, within the table.
+    const double b = 1.0e-9;
+    const double a = b * 1.2e7;
+    const double thp = 2.0e6;
+    const double bhp = solveBhp(vfp, a, b, thp);
+    const double rate = a - b * bhp;
+    BOOST_REQUIRE_GT(rate, 0.0);
+    BOOST_REQUIRE_LT(rate, 0.01);
+
+    const std::array<double, 3> ipr_b{0.0, b, 0.0};
+    const auto derivatives = vfp.bhpAndDerivatives(1, 0.0, -rate, 0.0, thp, 0.0, 0.0, 0.0, false);
+    BOOST_CHECK_CLOSE(derivatives[0], bhp, 1.0e-8);
+    const auto sensitivities = Opm::WellBhpThpCalculator::thpRateSensitivities(ipr_b, derivatives);
+    BOOST_REQUIRE(sensitivities.has_value());
+
+    // The rates at a perturbed THP.
+    const double dthp = 1.0e4;
+    const double perturbed = a - b * solveBhp(vfp, a, b, thp + dthp);
+    BOOST_CHECK_CLOSE((*sensitivities)[Opm::BlackoilPhases::Liquid], (perturbed - rate) / dthp, 1.0e-6);
+    BOOST_CHECK_LT((*sensitivities)[Opm::BlackoilPhases::Liquid], 0.0);
+    BOOST_CHECK_EQUAL((*sensitivities)[Opm::BlackoilPhases::Aqua], 0.0);
+    BOOST_CHECK_EQUAL((*sensitivities)[Opm::BlackoilPhases::Vapour], 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(ThpRateSensitivitiesUnavailable)
+{
+    const std::array<double, 5> derivatives{3.0e6, 0.0, -1.0e8, 0.0, 1.0};
+
+    // Rates not responding to the bhp.
+    BOOST_CHECK(!Opm::WellBhpThpCalculator::thpRateSensitivities({0.0, 0.0, 0.0}, derivatives));
+
+    // No solution of the linearized bhp(thp).
+    BOOST_CHECK(!Opm::WellBhpThpCalculator::thpRateSensitivities({0.0, -2.0e-8, 0.0}, derivatives));
+}
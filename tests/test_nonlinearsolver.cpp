@@ -0,0 +1,132 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestNonlinearSolver
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/flow/NonlinearSolverEbos.hpp>
+
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/communication.hh>
+#include <dune/istl/bvector.hh>
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+using BVector = Dune::BlockVector<Dune::FieldVector<double, 2>>;
+
+BVector makeVector(const double scale)
+{
+    BVector v(4);
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        v[i][0] = scale * (1.0 + i);
+        v[i][1] = -scale * 0.5 * i;
+    }
+    return v;
+}
+
+void checkVector(const BVector& x, const BVector& expected)
+{
+    BOOST_REQUIRE_EQUAL(x.size(), expected.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        for (int j = 0; j < 2; ++j) {
+            BOOST_CHECK_CLOSE(x[i][j] + 1.0, expected[i][j] + 1.0, 1.0e-12);
+        }
+    }
+}
+
+const Dune::Communication<Dune::No_Comm> comm;
+
+}
+
+BOOST_AUTO_TEST_CASE(ExtrapolateScalesByContraction)
+{
+    // Halving updates: the next one is a quarter of the previous one.
+    const auto previous = makeVector(1.0);
+    const auto last = makeVector(0.5);
+    auto x = makeVector(3.0);
+    Opm::detail::extrapolateLinearUpdate(x, last, previous, comm);
+    checkVector(x, makeVector(0.25));
+}
+
+BOOST_AUTO_TEST_CASE(ExtrapolateClampsFactor)
+{
+    const auto previous = makeVector(1.0);
+
+    // Growing updates are not extrapolated beyond the last one.
+    auto x = makeVector(3.0);
+    Opm::detail::extrapolateLinearUpdate(x, makeVector(2.0), previous, comm);
+    checkVector(x, makeVector(2.0));
+
+    // Nor are reversed ones.
+    x = makeVector(3.0);
+    Opm::detail::extrapolateLinearUpdate(x, makeVector(-0.5), previous, comm);
+    checkVector(x, makeVector(0.0));
+}
+
+BOOST_AUTO_TEST_CASE(ExtrapolateFromZeroUpdate)
+{
+    auto x = makeVector(3.0);
+    Opm::detail::extrapolateLinearUpdate(x, makeVector(1.0), makeVector(0.0), comm);
+    checkVector(x, makeVector(0.0));
+}
+
+BOOST_AUTO_TEST_CASE(DivergenceDisabledOrTooEarly)
+{
+    const std::vector<std::vector<double>> history{{1.0, 0.1}, {2.0, 0.1}, {40.0, 0.1}, {80.0, 0.1}};
+
+    // Disabled.
+    BOOST_CHECK(!Opm::detail::detectDivergence(history, 3, 0, 10.0));
+    BOOST_CHECK(!Opm::detail::detectDivergence(history, 3, -1, 10.0));
+
+    // Not before minIter, and never before two updates are seen.
+    BOOST_CHECK(!Opm::detail::detectDivergence(history, 3, 4, 10.0));
+    BOOST_CHECK(!Opm::detail::detectDivergence(history, 1, 1, 1.0));
+    BOOST_CHECK(Opm::detail::detectDivergence(history, 3, 3, 10.0));
+}
+
+BOOST_AUTO_TEST_CASE(DivergenceGrowingResiduals)
+{
+    // The largest residual of each iteration is monitored, here the second
+    // phase from the third iteration on.
+    const std::vector<std::vector<double>> history{{4.0, 1.0}, {2.0, 1.0}, {1.0, 3.0}, {0.5, 25.0}};
+    BOOST_CHECK(Opm::detail::detectDivergence(history, 3, 2, 10.0));
+
+    // Grown twice, but not by the factor above the smallest residual.
+    BOOST_CHECK(!Opm::detail::detectDivergence(history, 3, 2, 20.0));
+}
+
+BOOST_AUTO_TEST_CASE(DivergenceNeedsTwoIncreases)
+{
+    // Large, but decreased in between.
+    const std::vector<std::vector<double>> history{{1.0}, {0.5}, {60.0}, {50.0}, {100.0}};
+    BOOST_CHECK(!Opm::detail::detectDivergence(history, 4, 2, 10.0));
+
+    // Increased once only since the start.
+    BOOST_CHECK(!Opm::detail::detectDivergence(history, 2, 2, 10.0));
+
+    // Increased twice from the smallest one.
+    const std::vector<std::vector<double>> growing{{1.0}, {0.5}, {60.0}, {70.0}};
+    BOOST_CHECK(Opm::detail::detectDivergence(growing, 3, 2, 10.0));
+}
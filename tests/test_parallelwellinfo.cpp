@@ -24,6 +24,8 @@
 #include <opm/simulators/utils/ParallelCommunication.hpp>
 
 #include <dune/common/version.hh>
+#include <array>
+#include <functional>
 #include<vector>
 #include<string>
 #include<tuple>
@@ -483,3 +485,64 @@ BOOST_AUTO_TEST_CASE(EmptyWell) {
 
     BOOST_CHECK_EQUAL(local_p, global_p);
 }
+
+BOOST_AUTO_TEST_CASE(AggregatedSum)
+{
+    auto comm = Opm::Parallel::Communication(Dune::MPIHelper::getCommunicator());
+    Opm::ParallelWellInfo shared({"WELL1", true}, comm);
+    Opm::ParallelWellInfo single({"WELL2", comm.rank() == 0}, comm);
+
+    std::vector<std::reference_wrapper<Opm::ParallelWellInfo>> local_wells{shared};
+    std::vector<int> well_indices{0};
+    if (comm.rank() == 0) {
+        local_wells.push_back(single);
+        well_indices.push_back(1);
+    }
+
+    Opm::AggregatedWellSum sum;
+    sum.reset(well_indices, local_wells, 2, comm);
+    BOOST_CHECK_EQUAL(sum.anyDistributed(), comm.size() > 1);
+
+    std::vector<std::array<double, 2>> values(local_wells.size());
+    sum.begin(2);
+    for (std::size_t w = 0; w < values.size(); ++w) {
+        values[w] = {1.0, comm.rank() + 1.0};
+        sum.add(w, values[w].data());
+    }
+    sum.end();
+
+    const double size = comm.size();
+    BOOST_CHECK_EQUAL(values[0][0], size);
+    BOOST_CHECK_EQUAL(values[0][1], size * (size + 1) / 2);
+    if (comm.rank() == 0) {
+        BOOST_CHECK_EQUAL(values[1][0], 1.0);
+        BOOST_CHECK_EQUAL(values[1][1], 1.0);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(AggregatedSumParts)
+{
+    auto comm = Opm::Parallel::Communication(Dune::MPIHelper::getCommunicator());
+    Opm::ParallelWellInfo shared({"WELL1", true}, comm);
+    std::vector<std::reference_wrapper<Opm::ParallelWellInfo>> local_wells{shared};
+
+    Opm::AggregatedWellSum sum;
+    sum.reset({0}, local_wells, 1, comm);
+
+    // Two arrays in one slot, the second one registered on rank 0 only.
+    std::array<double, 2> first{1.0, comm.rank() + 1.0};
+    std::array<double, 3> second{2.0, 3.0, 4.0};
+    sum.begin(first.size() + second.size());
+    sum.add(0, first.data(), 0, first.size());
+    if (comm.rank() == 0) {
+        sum.add(0, second.data(), first.size(), second.size());
+    }
+    sum.end();
+
+    const double size = comm.size();
+    BOOST_CHECK_EQUAL(first[0], size);
+    BOOST_CHECK_EQUAL(first[1], size * (size + 1) / 2);
+    BOOST_CHECK_EQUAL(second[0], 2.0);
+    BOOST_CHECK_EQUAL(second[1], 3.0);
+    BOOST_CHECK_EQUAL(second[2], 4.0);
+}
@@ -189,7 +189,7 @@ BOOST_AUTO_TEST_CASE(TestAddingPreconditioner)
 
     // Add preconditioner to factory for block size 1.
     PF<1>::addCreator("nothing", [](const O<1>&, const Opm::PropertyTree&, const std::function<V<1>()>&,
-                                    std::size_t) {
+                                    std::size_t, const PF<1>::PatternCache&) {
             return Dune::wrapPreconditioner<NothingPreconditioner<V<1>>>();
         });
 
@@ -205,7 +205,7 @@ BOOST_AUTO_TEST_CASE(TestAddingPreconditioner)
 
     // Add preconditioner to factory for block size 3.
     PF<3>::addCreator("nothing", [](const O<3>&, const Opm::PropertyTree&, const std::function<V<3>()>&,
-                                    std::size_t) {
+                                    std::size_t, const PF<3>::PatternCache&) {
             return Dune::wrapPreconditioner<NothingPreconditioner<V<3>>>();
         });
 
@@ -302,7 +302,7 @@ testPrecRepeating(const Opm::PropertyTree& prm, const std::string& matrix_filena
 
     // Add no-oppreconditioner to factory for block size 1.
     PrecFactory::addCreator("nothing", [](const Operator&, const Opm::PropertyTree&, const std::function<Vector()>&,
-                                          std::size_t) {
+                                          std::size_t, const PrecFactory::PatternCache&) {
         return Dune::wrapPreconditioner<NothingPreconditioner<Vector>>();
     });
 
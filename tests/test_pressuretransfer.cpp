@@ -0,0 +1,161 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestPressureTransfer
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/linalg/PressureTransferHelpers.hpp>
+#include <opm/simulators/linalg/PressureTransferPolicy.hpp>
+#include <opm/simulators/linalg/PropertyTree.hpp>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/paamg/pinfo.hh>
+
+#include <memory>
+#include <vector>
+
+namespace {
+
+using FineMatrix = Dune::BCRSMatrix<Dune::FieldMatrix<double, 2, 2>>;
+using FineVector = Dune::BlockVector<Dune::FieldVector<double, 2>>;
+using CoarseMatrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, 1, 1>>;
+
+// Tridiagonal matrix, optionally with a coupling of the first and the
+// last row.
+FineMatrix makeMatrix(const int n, const bool periodic = false)
+{
+    FineMatrix m(n, n, FineMatrix::row_wise);
+    for (auto row = m.createbegin(); row != m.createend(); ++row) {
+        const int i = row.index();
+        if (periodic && i == n - 1) {
+            row.insert(0);
+        }
+        if (i > 0) {
+            row.insert(i - 1);
+        }
+        row.insert(i);
+        if (i < n - 1) {
+            row.insert(i + 1);
+        }
+        if (periodic && i == 0) {
+            row.insert(n - 1);
+        }
+    }
+    for (auto row = m.begin(); row != m.end(); ++row) {
+        for (auto col = row->begin(); col != row->end(); ++col) {
+            *col = 0.0;
+            (*col)[0][0] = col.index() == row.index() ? 2.0 : -1.0;
+            (*col)[1][1] = 1.0;
+        }
+    }
+    return m;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(SamePattern)
+{
+    const auto a = makeMatrix(6);
+    BOOST_CHECK(Opm::Details::samePattern(a, a));
+    BOOST_CHECK(Opm::Details::samePattern(a, makeMatrix(6)));
+    BOOST_CHECK(!Opm::Details::samePattern(a, makeMatrix(7)));
+    BOOST_CHECK(!Opm::Details::samePattern(a, makeMatrix(6, true)));
+
+    // Same size and number of nonzeroes, but a moved entry.
+    auto b = makeMatrix(6, true);
+    auto c = makeMatrix(6, true);
+    BOOST_CHECK(Opm::Details::samePattern(b, c));
+    FineMatrix d(6, 6, FineMatrix::row_wise);
+    for (auto row = d.createbegin(); row != d.createend(); ++row) {
+        const int i = row.index();
+        for (auto col = b[i].begin(); col != b[i].end(); ++col) {
+            // Couple the first row to the fifth instead of the last cell.
+            row.insert(i == 0 && col.index() == 5 ? 4 : col.index());
+        }
+    }
+    BOOST_CHECK_EQUAL(d.nonzeroes(), b.nonzeroes());
+    BOOST_CHECK(!Opm::Details::samePattern(b, d));
+}
+
+BOOST_AUTO_TEST_CASE(CachedPressurePattern)
+{
+    const auto fine = makeMatrix(5);
+    std::shared_ptr<const CoarseMatrix> cache;
+
+    const auto pattern = Opm::Details::cachedPressurePattern(fine, cache);
+    BOOST_REQUIRE(pattern);
+    BOOST_CHECK(pattern == cache);
+    BOOST_CHECK(Opm::Details::samePattern(fine, *pattern));
+
+    // Reused for a matrix with the same pattern.
+    BOOST_CHECK(Opm::Details::cachedPressurePattern(makeMatrix(5), cache) == pattern);
+
+    // Rebuilt when the pattern changes.
+    const auto periodic = makeMatrix(5, true);
+    const auto rebuilt = Opm::Details::cachedPressurePattern(periodic, cache);
+    BOOST_CHECK(rebuilt != pattern);
+    BOOST_CHECK(rebuilt == cache);
+    BOOST_CHECK(Opm::Details::samePattern(periodic, *rebuilt));
+}
+
+BOOST_AUTO_TEST_CASE(PatternSurvivesRecreatedPolicy)
+{
+    using Operator = Dune::MatrixAdapter<FineMatrix, FineVector, FineVector>;
+    using Comm = Dune::Amg::SequentialInformation;
+    using Policy = Opm::PressureTransferPolicy<Operator, Comm, false>;
+
+    const auto matrix = makeMatrix(5);
+    const Operator op(matrix);
+    FineVector weights(matrix.N());
+    for (auto& w : weights) {
+        w[0] = 1.0;
+        w[1] = 0.0;
+    }
+    const Comm comm;
+    const Opm::PropertyTree prm;
+    auto cache = std::make_shared<Opm::PressurePatternCache>();
+
+    Policy first(comm, weights, prm, 0, cache);
+    first.createCoarseLevelSystem(op);
+    const auto pattern = cache->pattern;
+    BOOST_REQUIRE(pattern);
+    BOOST_CHECK(Opm::Details::samePattern(matrix, *pattern));
+    const auto& coarse = first.getCoarseLevelOperator()->getmat();
+    BOOST_CHECK(Opm::Details::samePattern(matrix, coarse));
+    BOOST_CHECK_EQUAL(coarse[2][2][0][0], 2.0);
+    BOOST_CHECK_EQUAL(coarse[2][1][0][0], -1.0);
+
+    // A policy of a recreated preconditioner reuses the pattern.
+    Policy second(comm, weights, prm, 0, cache);
+    second.createCoarseLevelSystem(op);
+    BOOST_CHECK(cache->pattern == pattern);
+    BOOST_CHECK_EQUAL(second.getCoarseLevelOperator()->getmat()[2][1][0][0], -1.0);
+
+    // Without a shared cache every policy builds its own.
+    Policy own(comm, weights, prm, 0);
+    own.createCoarseLevelSystem(op);
+    BOOST_CHECK(cache->pattern == pattern);
+}
@@ -0,0 +1,157 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestTimeStepControl
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/input/eclipse/Units/Units.hpp>
+#include <opm/simulators/timestepping/SimulatorReport.hpp>
+#include <opm/simulators/timestepping/TimeStepControl.hpp>
+
+#include <cmath>
+
+namespace {
+
+constexpr double day = Opm::unit::day;
+
+class RelativeChange : public Opm::RelativeChangeInterface
+{
+public:
+    explicit RelativeChange(const double change)
+        : change_(change)
+    {}
+
+    double relativeChange() const override
+    {
+        return change_;
+    }
+
+private:
+    double change_;
+};
+
+const RelativeChange smallChange(0.01);
+
+void registerSubstep(Opm::PredictiveTimeStepControl& control,
+                     const double dt, const bool converged, const int iterations,
+                     const bool controlChanged = false)
+{
+    Opm::SimulatorReportSingle report;
+    report.timestep_length = dt;
+    report.converged = converged;
+    report.well_group_control_changed = controlChanged;
+    control.registerSubstep(report, iterations, smallChange);
+}
+
+// Converged substeps taking two more iterations for each doubling of the
+// step size, reaching the target of eight iterations at two days.
+Opm::PredictiveTimeStepControl makeControlWithHistory()
+{
+    Opm::PredictiveTimeStepControl control(8, 20);
+    registerSubstep(control, 1.0 * day, true, 6);
+    registerSubstep(control, 2.0 * day, true, 8);
+    registerSubstep(control, 4.0 * day, true, 10);
+    return control;
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(GrowsWithFewIterations)
+{
+    // Without history two more iterations are assumed for each doubling,
+    // and the largest candidate stays at the target.
+    const Opm::PredictiveTimeStepControl control(8, 20);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(1.0 * day, 4, smallChange, 0.0), 4.0 * day, 1.0e-10);
+}
+
+BOOST_AUTO_TEST_CASE(StepChoiceDoesNotChangeState)
+{
+    const auto control = makeControlWithHistory();
+    const auto copy = control;
+    const double dt = control.computeTimeStepSize(4.0 * day, 10, smallChange, 0.0);
+    BOOST_CHECK(control == copy);
+    BOOST_CHECK_EQUAL(control.computeTimeStepSize(4.0 * day, 10, smallChange, 0.0), dt);
+}
+
+BOOST_AUTO_TEST_CASE(FailedSubstepBoundsStep)
+{
+    auto control = makeControlWithHistory();
+    const double unbounded = control.computeTimeStepSize(4.0 * day, 10, smallChange, 0.0);
+    BOOST_CHECK_CLOSE(unbounded, 16.0 * day, 1.0e-10);
+
+    // Steps above half of the failed size may fail too.
+    registerSubstep(control, 3.0 * day, false, 20);
+    const double bounded = control.computeTimeStepSize(4.0 * day, 10, smallChange, 0.0);
+    BOOST_CHECK_LE(bounded, 1.5 * day);
+    BOOST_CHECK_CLOSE(bounded, 4.0 * day * std::pow(2.0, -1.5), 1.0e-10);
+}
+
+BOOST_AUTO_TEST_CASE(FailedSubstepBoundRelaxes)
+{
+    Opm::PredictiveTimeStepControl control(8, 20);
+    registerSubstep(control, 1.0 * day, false, 20);
+    registerSubstep(control, 0.5 * day, true, 4);
+    BOOST_CHECK_LE(control.computeTimeStepSize(0.5 * day, 4, smallChange, 0.0), 0.525 * day);
+
+    // Forgotten once it is far above the converged steps.
+    registerSubstep(control, 0.05 * day, true, 4);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(0.5 * day, 4, smallChange, 0.0), 2.0 * day, 1.0e-10);
+}
+
+BOOST_AUTO_TEST_CASE(FailedSubstepsNotInHistory)
+{
+    Opm::PredictiveTimeStepControl control(8, 20);
+    registerSubstep(control, 1.0 * day, false, 20);
+    registerSubstep(control, 0.5 * day, false, 20);
+
+    // Nothing to fit, so the default reduction applies.
+    BOOST_CHECK_CLOSE(control.computeChoppedTimeStepSize(0.5 * day, 0.33), 0.165 * day, 1.0e-10);
+}
+
+BOOST_AUTO_TEST_CASE(NoGrowthAfterControlChange)
+{
+    Opm::PredictiveTimeStepControl control(8, 20);
+    registerSubstep(control, 1.0 * day, true, 4, true);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(1.0 * day, 4, smallChange, 0.0), 1.0 * day, 1.0e-10);
+
+    registerSubstep(control, 1.0 * day, true, 4);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(1.0 * day, 4, smallChange, 0.0), 4.0 * day, 1.0e-10);
+}
+
+BOOST_AUTO_TEST_CASE(RelativeChangeLimitsStep)
+{
+    const Opm::PredictiveTimeStepControl control(8, 20, 0.1);
+    const RelativeChange largeChange(0.5);
+    BOOST_CHECK_CLOSE(control.computeTimeStepSize(1.0 * day, 4, largeChange, 0.0), 0.2 * day, 1.0e-10);
+}
+
+BOOST_AUTO_TEST_CASE(ChoppedStepTargetsIterations)
+{
+    const auto control = makeControlWithHistory();
+
+    // The fit reaches the target iterations at two days.
+    BOOST_CHECK_CLOSE(control.computeChoppedTimeStepSize(4.0 * day, 0.6), 2.0 * day, 1.0e-8);
+
+    // Within [restartFactor^2 dt, restartFactor dt].
+    BOOST_CHECK_CLOSE(control.computeChoppedTimeStepSize(4.0 * day, 0.33), 1.32 * day, 1.0e-8);
+    BOOST_CHECK_CLOSE(control.computeChoppedTimeStepSize(0.5 * day, 0.5), 0.25 * day, 1.0e-8);
+}
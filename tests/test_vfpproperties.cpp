@@ -571,6 +571,32 @@ BOOST_AUTO_TEST_CASE(ExplicitBhpLookup)
     BOOST_CHECK_CLOSE(bhp_val, bhp_val_explicit, max_d_tol);
 }
 
+BOOST_AUTO_TEST_CASE(BhpAndDerivativesPlane)
+{
+    fillDataPlane();
+    initProperties();
+
+    const double aqua = -0.5;
+    const double liquid = -0.9;
+    const double vapour = -0.1;
+    const double thp = 0.5;
+    const double alq = 0.5;
+    const double eps = 1.0e-6;
+
+    const auto bhp = properties->bhpAndDerivatives(1, aqua, liquid, vapour, thp, alq, 0, 0, false);
+    const double bhp_val = properties->bhp(1, aqua, liquid, vapour, thp, alq, 0, 0, false);
+    BOOST_CHECK_CLOSE(bhp[0], bhp_val, max_d_tol);
+
+    const double daqua = (properties->bhp(1, aqua + eps, liquid, vapour, thp, alq, 0, 0, false) - bhp_val) / eps;
+    const double dliquid = (properties->bhp(1, aqua, liquid + eps, vapour, thp, alq, 0, 0, false) - bhp_val) / eps;
+    const double dvapour = (properties->bhp(1, aqua, liquid, vapour + eps, thp, alq, 0, 0, false) - bhp_val) / eps;
+    const double dthp = (properties->bhp(1, aqua, liquid, vapour, thp + eps, alq, 0, 0, false) - bhp_val) / eps;
+    BOOST_CHECK_CLOSE(bhp[1], daqua, 1.0e-3);
+    BOOST_CHECK_CLOSE(bhp[2], dliquid, 1.0e-3);
+    BOOST_CHECK_CLOSE(bhp[3], dvapour, 1.0e-3);
+    BOOST_CHECK_CLOSE(bhp[4], dthp, 1.0e-3);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END() // Trivial tests
 
@@ -0,0 +1,268 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestWellHelpers
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/wells/WellHelpers.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <vector>
+
+namespace {
+
+using Opm::wellhelpers::StateKey;
+
+// Key of a THP controlled producer in SI units. The exact part holds the
+// time step, stopped, explicit VFP lookup, control mode, rate targets, bhp
+// limit, THP limit, ALQ and explicit WFR and GFR, the scaled part a cell
+// pressure, a saturation and the primary variables.
+StateKey thpControlKey(const double thp_limit,
+                       const double oil_rate = 0.001,
+                       const double wfr = 0.3,
+                       const double gfr = 150.0)
+{
+    StateKey key;
+    key.exact = {86400.0, 0.0, 1.0, 6.0,
+                 oil_rate, 0.0, 0.0, 0.0, 0.0, 50.0e5,
+                 thp_limit, 0.0, wfr, gfr};
+    key.scaled = {250.0e5, 0.2, -0.0012, 0.25, 0.05, 180.0e5};
+    return key;
+}
+
+// Conditions of the potentials of a producer as collected by the well
+// model: bhp and thp limits, then the pressure and the water, oil and gas
+// saturations of each perforated cell.
+std::vector<double> potentialConditions(const std::vector<double>& pressures,
+                                        const std::vector<double>& oil_saturations)
+{
+    std::vector<double> conditions{150.0e5, 0.0};
+    for (std::size_t c = 0; c < pressures.size(); ++c) {
+        conditions.insert(conditions.end(), {pressures[c], 0.2, oil_saturations[c],
+                                             0.8 - oil_saturations[c]});
+    }
+    return conditions;
+}
+
+// Oil potential of the producer, with a mobility proportional to the oil
+// saturation and the drawdown to the bhp limit.
+double oilPotential(const std::vector<double>& conditions)
+{
+    double rate = 0.0;
+    for (std::size_t i = 2; i < conditions.size(); i += 4) {
+        rate += 1.0e-10 * conditions[i + 2] * (conditions[i] - conditions[0]);
+    }
+    return rate;
+}
+
+// Every well is in exactly one group, and the wells of a group perforate
+// disjoint sets of cells.
+void checkGrouping(const std::vector<std::vector<int>>& well_cells,
+                   const std::vector<std::vector<int>>& groups)
+{
+    std::vector<int> count(well_cells.size(), 0);
+    for (const auto& group : groups) {
+        BOOST_CHECK(!group.empty());
+        std::set<int> cells;
+        for (const int w : group) {
+            BOOST_REQUIRE(w >= 0 && w < static_cast<int>(well_cells.size()));
+            ++count[w];
+            const std::set<int> own(well_cells[w].begin(), well_cells[w].end());
+            for (const int cell : own) {
+                BOOST_CHECK_MESSAGE(cells.insert(cell).second,
+                                    "cell " << cell << " shared within a group");
+            }
+        }
+    }
+    BOOST_CHECK(std::all_of(count.begin(), count.end(), [](const int c) { return c == 1; }));
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(KeysAgree)
+{
+    const double tol = 1.0e-6;
+    const auto key = thpControlKey(20.0e5);
+    BOOST_CHECK(Opm::wellhelpers::keysAgree(key, key, tol));
+    BOOST_CHECK(Opm::wellhelpers::keysAgree(key, key, 0.0));
+
+    auto close = key;
+    close.scaled[0] *= 1.0 + 0.5 * tol;
+    BOOST_CHECK(Opm::wellhelpers::keysAgree(close, key, tol));
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(close, key, 0.0));
+}
+
+BOOST_AUTO_TEST_CASE(SmallQuantitiesScaleWithTheirMagnitude)
+{
+    const double tol = 1.0e-3;
+    const auto converged = thpControlKey(20.0e5);
+
+    // A total well rate of 0.0012 m^3/s changing by a fifth.
+    auto changed = converged;
+    changed.scaled[2] *= 1.2;
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(changed, converged, tol));
+
+    // Agreement is relative to the rate itself, not to one.
+    changed.scaled[2] = converged.scaled[2] * (1.0 + 0.5 * tol);
+    BOOST_CHECK(Opm::wellhelpers::keysAgree(changed, converged, tol));
+    changed.scaled[2] = converged.scaled[2] * (1.0 + 2.0 * tol);
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(changed, converged, tol));
+
+    // A zero entry only agrees with zero.
+    auto zero = converged;
+    zero.scaled[4] = 0.0;
+    changed = zero;
+    changed.scaled[4] = 1.0e-12;
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(changed, zero, tol));
+}
+
+BOOST_AUTO_TEST_CASE(ChangedInputPreventsSkip)
+{
+    const double tol = 1.0e-3;
+    const auto converged = thpControlKey(20.0e5);
+
+    // An oil rate target raised from 0.001 to 0.0015 m^3/s.
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(thpControlKey(20.0e5, 0.0015), converged, tol));
+    // Controls are compared exactly, however close.
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(thpControlKey(20.0e5, 0.001 * (1.0 + 1.0e-9)),
+                                             converged, tol));
+
+    // A THP limit updated by the network balancing.
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(thpControlKey(19.5e5), converged, tol));
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(thpControlKey(20.0e5 + 1.0), converged, tol));
+
+    // Explicit fractions from new previous step rates.
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(thpControlKey(20.0e5, 0.001, 0.31), converged, tol));
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(thpControlKey(20.0e5, 0.001, 0.3, 160.0), converged, tol));
+
+    // A switch of the control mode.
+    auto switched = converged;
+    switched.exact[3] = 5.0;
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(switched, converged, tol));
+
+    // Switching off the explicit lookup drops the fractions from the key.
+    auto implicit = converged;
+    implicit.exact[2] = 0.0;
+    implicit.exact.resize(implicit.exact.size() - 2);
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(implicit, converged, tol));
+}
+
+BOOST_AUTO_TEST_CASE(EmptyKeysNeverAgree)
+{
+    const StateKey empty;
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(empty, empty, 1.0));
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(empty, thpControlKey(20.0e5), 1.0));
+    BOOST_CHECK(!Opm::wellhelpers::keysAgree(thpControlKey(20.0e5), empty, 1.0));
+}
+
+BOOST_AUTO_TEST_CASE(WellsSharingCellInDifferentGroups)
+{
+    // Wells 0 and 1 share cell 1, wells 1 and 3 share cell 2.
+    const std::vector<std::vector<int>> well_cells{{0, 1}, {1, 2}, {3}, {2, 4}, {5}};
+    const auto groups = Opm::wellhelpers::groupWellsWithDisjointCells(well_cells);
+    checkGrouping(well_cells, groups);
+
+    // First fit keeps the wells in their order.
+    const std::vector<std::vector<int>> expected{{0, 2, 3, 4}, {1}};
+    BOOST_REQUIRE_EQUAL(groups.size(), expected.size());
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        BOOST_CHECK_EQUAL_COLLECTIONS(groups[g].begin(), groups[g].end(),
+                                      expected[g].begin(), expected[g].end());
+    }
+}
+
+BOOST_AUTO_TEST_CASE(WellsSharingAllCells)
+{
+    // Every pair shares cell 7, and a well perforating a cell twice does not
+    // conflict with itself.
+    const std::vector<std::vector<int>> well_cells{{7, 7, 1}, {2, 7}, {7}};
+    const auto groups = Opm::wellhelpers::groupWellsWithDisjointCells(well_cells);
+    checkGrouping(well_cells, groups);
+    BOOST_CHECK_EQUAL(groups.size(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(DisjointWellsInOneGroup)
+{
+    const std::vector<std::vector<int>> well_cells{{0, 1}, {2}, {}, {3, 4, 5}};
+    const auto groups = Opm::wellhelpers::groupWellsWithDisjointCells(well_cells);
+    checkGrouping(well_cells, groups);
+    BOOST_CHECK_EQUAL(groups.size(), 1u);
+
+    BOOST_CHECK(Opm::wellhelpers::groupWellsWithDisjointCells({}).empty());
+}
+
+BOOST_AUTO_TEST_CASE(ReusedPotentialsMatchRecomputed)
+{
+    const double tol = 1.0e-3;
+    const std::vector<double> pressures{250.0e5, 255.0e5, 262.0e5};
+    const std::vector<double> oil_saturations{0.6, 0.55, 0.5};
+    const auto reference = potentialConditions(pressures, oil_saturations);
+    const double cached = oilPotential(reference);
+
+    // Pressures changed relatively and saturations absolutely within the
+    // tolerance, in the directions reducing the rate.
+    auto pressures_changed = pressures;
+    auto saturations_changed = oil_saturations;
+    for (std::size_t c = 0; c < pressures.size(); ++c) {
+        pressures_changed[c] *= 1.0 - 0.99 * tol;
+        saturations_changed[c] -= 0.99 * tol;
+    }
+    const auto conditions = potentialConditions(pressures_changed, saturations_changed);
+    BOOST_REQUIRE(Opm::wellhelpers::potentialConditionsAgree(conditions, reference, tol));
+
+    // The reused potential differs from the recomputed one by the change of
+    // the drawdown and of the mobility, i.e. a few times the tolerance.
+    const double recomputed = oilPotential(conditions);
+    BOOST_CHECK_LT(recomputed, cached);
+    BOOST_CHECK_LT((cached - recomputed) / recomputed, 5.0 * tol);
+}
+
+BOOST_AUTO_TEST_CASE(ChangedConditionsRecomputePotentials)
+{
+    const double tol = 1.0e-3;
+    const std::vector<double> pressures{250.0e5, 255.0e5};
+    const std::vector<double> oil_saturations{0.6, 0.55};
+    const auto reference = potentialConditions(pressures, oil_saturations);
+    BOOST_CHECK(Opm::wellhelpers::potentialConditionsAgree(reference, reference, 0.0));
+
+    // A pressure or a saturation changed by more than the tolerance.
+    BOOST_CHECK(!Opm::wellhelpers::potentialConditionsAgree(
+        potentialConditions({250.0e5 * (1.0 + 1.01 * tol), 255.0e5}, oil_saturations), reference, tol));
+    BOOST_CHECK(!Opm::wellhelpers::potentialConditionsAgree(
+        potentialConditions(pressures, {0.6, 0.55 + 1.01 * tol}), reference, tol));
+
+    // A changed limit.
+    auto limit_changed = reference;
+    limit_changed[0] = 140.0e5;
+    BOOST_CHECK(!Opm::wellhelpers::potentialConditionsAgree(limit_changed, reference, tol));
+    limit_changed = reference;
+    limit_changed[1] = 20.0e5;
+    BOOST_CHECK(!Opm::wellhelpers::potentialConditionsAgree(limit_changed, reference, tol));
+
+    // Other perforated cells, or nothing computed yet.
+    BOOST_CHECK(!Opm::wellhelpers::potentialConditionsAgree(
+        potentialConditions({250.0e5}, {0.6}), reference, tol));
+    BOOST_CHECK(!Opm::wellhelpers::potentialConditionsAgree(reference, {}, tol));
+    BOOST_CHECK(!Opm::wellhelpers::potentialConditionsAgree({}, {}, tol));
+}
@@ -0,0 +1,114 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestWellIPRCurve
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/wells/WellIPRCurve.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace {
+
+struct Conn
+{
+    double break_bhp;
+    std::vector<double> prod;
+    std::vector<double> inj;
+};
+
+std::vector<double> directRates(const std::vector<Conn>& conns, const double bhp)
+{
+    std::vector<double> rates(conns.front().prod.size(), 0.0);
+    for (const auto& conn : conns) {
+        const double drawdown = conn.break_bhp - bhp;
+        for (std::size_t c = 0; c < rates.size(); ++c) {
+            rates[c] += drawdown > 0.0 ? conn.prod[c] * drawdown
+                                       : -conn.inj[c] * drawdown;
+        }
+    }
+    return rates;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(PiecewiseLinear)
+{
+    // Producing rates are negative per unit drawdown, injecting rates
+    // are positive per unit negative drawdown.
+    const std::vector<Conn> conns = {
+        {250.0, {-1.0, -0.5}, {2.0, 0.0}},
+        {200.0, {-3.0, -0.1}, {1.5, 0.5}},
+        {220.0, {-0.2, -2.0}, {0.0, 1.0}},
+        {220.0, {-0.7, -0.3}, {0.3, 0.3}},
+    };
+
+    Opm::WellIPRCurve curve;
+    curve.reset(2, {1, 2});
+    BOOST_CHECK(!curve.isValid({1, 2}));
+    for (const auto& conn : conns) {
+        curve.addConnection(conn.break_bhp, conn.prod, conn.inj);
+    }
+    curve.finalize();
+    BOOST_CHECK(curve.isValid({1, 2}));
+    BOOST_CHECK(!curve.isValid({1, 3}));
+    BOOST_CHECK(!curve.isValid({2, 2}));
+
+    std::vector<double> rates;
+    for (const double bhp : {100.0, 200.0, 210.0, 220.0, 230.0, 250.0, 300.0}) {
+        curve.rates(bhp, rates);
+        const auto expected = directRates(conns, bhp);
+        BOOST_REQUIRE_EQUAL(rates.size(), expected.size());
+        for (std::size_t c = 0; c < rates.size(); ++c) {
+            BOOST_CHECK_CLOSE(rates[c] + 1.0, expected[c] + 1.0, 1.0e-10);
+        }
+    }
+
+    curve.invalidate();
+    BOOST_CHECK(!curve.isValid({1, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(RepeatedQuery)
+{
+    Opm::WellIPRCurve curve;
+    BOOST_CHECK(!curve.repeatedQuery({1, 1}));
+    BOOST_CHECK(curve.repeatedQuery({1, 1}));
+    BOOST_CHECK(!curve.repeatedQuery({1, 2}));
+    BOOST_CHECK(!curve.repeatedQuery({2, 2}));
+    curve.invalidate();
+    BOOST_CHECK(!curve.repeatedQuery({2, 2}));
+    BOOST_CHECK(curve.repeatedQuery({2, 2}));
+}
+
+BOOST_AUTO_TEST_CASE(NoConnections)
+{
+    Opm::WellIPRCurve curve;
+    curve.reset(3, {1, 1});
+    curve.finalize();
+    std::vector<double> rates;
+    curve.rates(200.0, rates);
+    BOOST_REQUIRE_EQUAL(rates.size(), 3u);
+    for (const double rate : rates) {
+        BOOST_CHECK_EQUAL(rate, 0.0);
+    }
+}
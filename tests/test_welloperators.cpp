@@ -0,0 +1,236 @@
+/*
+  Copyright 2023 Equinor ASA
+
+  This file is part of the Open Porous Media project (OPM).
+
+  OPM is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  OPM is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with OPM.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include <config.h>
+
+#define BOOST_TEST_MODULE TestWellOperators
+
+#include <boost/test/unit_test.hpp>
+
+#include <opm/simulators/linalg/WellOperators.hpp>
+
+#include <dune/common/fvector.hh>
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr int bz = 2;
+using Matrix = Dune::BCRSMatrix<Opm::MatrixBlock<double, bz, bz>>;
+using Vector = Dune::BlockVector<Dune::FieldVector<double, bz>>;
+
+Matrix makeMatrix(const int n)
+{
+    Matrix m(n, n, Matrix::row_wise);
+    for (auto row = m.createbegin(); row != m.createend(); ++row) {
+        const int i = row.index();
+        if (i > 0) {
+            row.insert(i - 1);
+        }
+        row.insert(i);
+        if (i < n - 1) {
+            row.insert(i + 1);
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        for (auto col = m[i].begin(); col != m[i].end(); ++col) {
+            for (int r = 0; r < bz; ++r) {
+                for (int c = 0; c < bz; ++c) {
+                    (*col)[r][c] = col.index() == std::size_t(i) ? 4.0 + r - 0.5 * c : -1.0 + 0.1 * (r + c);
+                }
+            }
+        }
+    }
+    return m;
+}
+
+Vector makeVector(const int n, const double shift)
+{
+    Vector v(n);
+    for (int i = 0; i < n; ++i) {
+        for (int r = 0; r < bz; ++r) {
+            v[i][r] = std::sin(0.3 * i + r + shift);
+        }
+    }
+    return v;
+}
+
+// Wells coupling the cells they perforate, y[c] -= coeff * sum_c' x[c']
+// for every perforation c, so a cell perforated twice gets the
+// contribution twice.
+class TestWells : public Opm::LinearOperatorExtra<Vector, Vector>
+{
+public:
+    struct Well
+    {
+        std::vector<int> cells;
+        double coeff;
+    };
+
+    void setWells(std::vector<Well> wells)
+    {
+        wells_ = std::move(wells);
+        ++stamp_;
+    }
+
+    void apply(const Vector& x, Vector& y) const override
+    {
+        y = 0.0;
+        for (int w = 0; w < numWells(); ++w) {
+            applyWell(w, x, y);
+        }
+    }
+    void applyscaleadd(field_type alpha, const Vector& x, Vector& y) const override
+    {
+        Vector tmp(y.size());
+        apply(x, tmp);
+        y.axpy(alpha, tmp);
+    }
+    Dune::SolverCategory::Category category() const override
+    {
+        return Dune::SolverCategory::sequential;
+    }
+    void addWellPressureEquations(PressureMatrix&, const Vector&, const bool) const override
+    {
+    }
+    void addWellPressureEquationsStruct(PressureMatrix&) const override
+    {
+    }
+    int getNumberOfExtraEquations() const override
+    {
+        return 0;
+    }
+    int numWells() const override
+    {
+        return wells_.size();
+    }
+    const std::vector<int>& wellCells(const int well) const override
+    {
+        ++cellQueries;
+        return wells_[well].cells;
+    }
+    bool wellIsDistributed(const int) const override
+    {
+        return false;
+    }
+    void applyWell(const int well, const Vector& x, Vector& y) const override
+    {
+        const auto& [cells, coeff] = wells_[well];
+        typename Vector::block_type sum(0.0);
+        for (const int c : cells) {
+            sum += x[c];
+        }
+        for (const int c : cells) {
+            y[c].axpy(-coeff, sum);
+        }
+    }
+    std::uint64_t wellContainerStamp() const override
+    {
+        return stamp_;
+    }
+
+    mutable int cellQueries = 0;
+
+private:
+    std::vector<Well> wells_;
+    std::uint64_t stamp_ = 0;
+};
+
+// y = A x - C^T D^-1 B x computed without the fused product.
+Vector reference(const Matrix& A, const TestWells& wells, const Vector& x)
+{
+    Vector y(A.N());
+    A.mv(x, y);
+    Vector w(A.N());
+    wells.apply(x, w);
+    y += w;
+    return y;
+}
+
+void checkEqual(const Vector& y, const Vector& expected)
+{
+    BOOST_REQUIRE_EQUAL(y.size(), expected.size());
+    for (std::size_t i = 0; i < y.size(); ++i) {
+        for (int r = 0; r < bz; ++r) {
+            BOOST_CHECK_SMALL(y[i][r] - expected[i][r], 1.0e-12);
+        }
+    }
+}
+
+} // Anonymous namespace
+
+BOOST_AUTO_TEST_CASE(FusedProductMatchesSeparateProducts)
+{
+    const int n = 40;
+    const Matrix A = makeMatrix(n);
+    TestWells wells;
+    // Local wells, a well spanning the domain, two wells sharing cell 5
+    // and a well perforating cell 10 twice.
+    wells.setWells({{{3, 4, 5}, 0.3},
+                    {{5, 20, 38}, 0.2},
+                    {{10, 10, 11}, 0.5},
+                    {{30}, 1.5}});
+    Opm::WellModelMatrixAdapter<Matrix, Vector, Vector, false> op(A, wells);
+
+    const Vector x = makeVector(n, 0.0);
+    Vector y(n);
+    op.apply(x, y);
+    checkEqual(y, reference(A, wells, x));
+
+    const double alpha = -0.7;
+    const Vector y0 = makeVector(n, 1.0);
+    y = y0;
+    op.applyscaleadd(alpha, x, y);
+    Vector expected = y0;
+    expected.axpy(alpha, reference(A, wells, x));
+    checkEqual(y, expected);
+}
+
+BOOST_AUTO_TEST_CASE(GroupingFollowsWellContainer)
+{
+    const int n = 40;
+    const Matrix A = makeMatrix(n);
+    TestWells wells;
+    wells.setWells({{{3, 4, 5}, 0.3}, {{5, 20}, 0.2}});
+    Opm::WellModelMatrixAdapter<Matrix, Vector, Vector, false> op(A, wells);
+
+    const Vector x = makeVector(n, 0.5);
+    Vector y(n);
+    op.apply(x, y);
+    const int queries = wells.cellQueries;
+    BOOST_CHECK_GT(queries, 0);
+
+    // Unchanged wells reuse the grouping.
+    y = 1.0;
+    op.applyscaleadd(2.0, x, y);
+    op.apply(x, y);
+    BOOST_CHECK_EQUAL(wells.cellQueries, queries);
+    checkEqual(y, reference(A, wells, x));
+
+    // New wells are grouped anew.
+    wells.setWells({{{0, 39}, 0.4}, {{17, 17, 18}, 0.6}, {{3}, 0.1}});
+    op.apply(x, y);
+    BOOST_CHECK_GT(wells.cellQueries, queries);
+    checkEqual(y, reference(A, wells, x));
+}
@@ -20,6 +20,7 @@
 #include <algorithm>
 #include <config.h>
 #include <functional>
+#include <utility>
 #include <vector>
 
 #define BOOST_TEST_MODULE WellStateFIBOTest
@@ -58,6 +59,7 @@
 
 #include <chrono>
 #include <cstddef>
+#include <stdexcept>
 #include <string>
 
 BOOST_GLOBAL_FIXTURE(MPIFixture);
@@ -79,9 +81,9 @@ struct Setup
         initWellPerfData();
     }
 
-    void initWellPerfData()
+    void initWellPerfData(const std::size_t timeStep = 0)
     {
-        const auto& wells = sched.getWells(0);
+        const auto& wells = sched.getWells(timeStep);
         const auto& cartDims = Opm::UgGridHelpers::cartDims(*grid.c_grid());
         const int* compressed_to_cartesian = Opm::UgGridHelpers::globalCell(*grid.c_grid());
         std::vector<int> cartesian_to_compressed(cartDims[0] * cartDims[1] * cartDims[2], -1);
@@ -135,12 +137,11 @@ struct Setup
 };
 
 namespace {
-    Opm::WellState
-    buildWellState(const Setup& setup, const std::size_t timeStep,
-                   std::vector<Opm::ParallelWellInfo>& pinfos)
+    void
+    initWellState(Opm::WellState& state, const Setup& setup,
+                  const std::size_t timeStep,
+                  std::vector<Opm::ParallelWellInfo>& pinfos)
     {
-        auto state  = Opm::WellState{setup.pu};
-
         const auto cpress =
             std::vector<double>(setup.grid.c_grid()->number_of_cells,
                                 100.0*Opm::unit::barsa);
@@ -164,10 +165,69 @@ namespace {
 
         state.initWellStateMSWell(setup.sched.getWells(timeStep),
                                   nullptr);
+    }
 
+    Opm::WellState
+    buildWellState(const Setup& setup, const std::size_t timeStep,
+                   std::vector<Opm::ParallelWellInfo>& pinfos)
+    {
+        auto state  = Opm::WellState{setup.pu};
+        initWellState(state, setup, timeStep, pinfos);
         return state;
     }
 
+    // Two wells in the first report step, two more added in the second.
+    const std::string addedWellsDeck = R"(
+RUNSPEC
+OIL
+GAS
+WATER
+DIMENS
+   10 10 5 /
+GRID
+DXV
+10*1000.0 /
+DYV
+10*1000.0 /
+DZV
+10.0 20.0 30.0 10.0 5.0 /
+TOPS
+100*10 /
+PERMX
+500*0.25 /
+COPY
+  PERMX PERMY /
+  PERMX PERMZ /
+/
+PORO
+500*0.2 /
+SCHEDULE
+GRUPTREE
+ 'G1' 'FIELD' /
+ 'G2' 'FIELD' /
+/
+WELSPECS
+    'INJ1'  'G1'  1  1  8335 'GAS' /
+    'PROD1' 'G2' 10 10  8400 'OIL' /
+/
+COMPDAT
+    'INJ1'   1  1 1 1 'OPEN' 1 10.6092 0.5 /
+    'PROD1' 10 10 1 1 'OPEN' 0 10.6092 0.5 /
+/
+TSTEP
+  14.0 /
+WELSPECS
+    'INJ2'  'G1'  2  1  8335 'GAS' /
+    'PROD2' 'G2'  9 10  8400 'OIL' /
+/
+COMPDAT
+    'INJ2'   2  1 1 1 'OPEN' 1 10.6092 0.5 /
+    'PROD2'  9 10 1 1 'OPEN' 0 10.6092 0.5 /
+/
+TSTEP
+  3 /
+)";
+
 
     void setSegPress(const std::vector<Opm::Well>& wells,
                      Opm::WellState& wstate)
@@ -426,6 +486,74 @@ BOOST_AUTO_TEST_CASE(STOP_well)
 //    BOOST_CHECK(!gwi.in_producing_group("PROD01"));
 //}
 
+BOOST_AUTO_TEST_CASE(GlobalWellInfoHandles)
+{
+    const Setup setup{ Opm::Parser{}.parseString(addedWellsDeck) };
+    const Opm::GlobalWellInfo gwi(setup.sched, 1, setup.sched.getWells(1));
+
+    BOOST_REQUIRE_EQUAL(gwi.num_wells(), 4U);
+    for (const std::string wname : {"INJ1", "PROD1", "INJ2", "PROD2"}) {
+        const auto index = gwi.find_well(wname);
+        BOOST_REQUIRE(index.has_value());
+        BOOST_CHECK_EQUAL(*index, gwi.well_index(wname));
+        BOOST_CHECK_EQUAL(gwi.well_name(*index), wname);
+    }
+    BOOST_CHECK(!gwi.find_well("NOWELL").has_value());
+    BOOST_CHECK(!gwi.has_well("NOWELL"));
+    BOOST_CHECK_THROW(gwi.well_name(4), std::logic_error);
+
+    const std::vector<std::size_t> g1{gwi.well_index("INJ1"), gwi.well_index("INJ2")};
+    const std::vector<std::size_t> g2{gwi.well_index("PROD1"), gwi.well_index("PROD2")};
+    BOOST_CHECK_EQUAL_COLLECTIONS(gwi.group_wells("G1").begin(), gwi.group_wells("G1").end(),
+                                  g1.begin(), g1.end());
+    BOOST_CHECK_EQUAL_COLLECTIONS(gwi.group_wells("G2").begin(), gwi.group_wells("G2").end(),
+                                  g2.begin(), g2.end());
+    BOOST_CHECK(gwi.group_wells("FIELD").empty());
+    BOOST_CHECK(gwi.group_wells("NOGROUP").empty());
+}
+
+BOOST_AUTO_TEST_CASE(WellRatesAcrossReportSteps)
+{
+    Setup setup{ Opm::Parser{}.parseString(addedWellsDeck) };
+    std::vector<Opm::ParallelWellInfo> pinfos;
+    auto wstate = buildWellState(setup, 0, pinfos);
+
+    BOOST_CHECK(wstate.hasWellRates("PROD1"));
+    BOOST_CHECK(!wstate.hasWellRates("PROD2"));
+    const auto prod1 = wstate.globalWellIndex("PROD1");
+    const std::vector<double> rates1{1.0, 2.0, 3.0};
+    wstate.setCurrentWellRates(prod1, rates1);
+
+    // The next report step adds two wells, the existing ones keep their
+    // handles and rates.
+    setup.initWellPerfData(1);
+    std::vector<Opm::ParallelWellInfo> pinfos1;
+    initWellState(wstate, setup, 1, pinfos1);
+
+    BOOST_CHECK_EQUAL(wstate.globalWellIndex("PROD1"), prod1);
+    const auto& kept = wstate.currentWellRates(prod1);
+    BOOST_CHECK_EQUAL_COLLECTIONS(kept.begin(), kept.end(), rates1.begin(), rates1.end());
+
+    BOOST_REQUIRE(wstate.hasWellRates("PROD2"));
+    const auto prod2 = wstate.globalWellIndex("PROD2");
+    BOOST_CHECK_NE(prod2, prod1);
+    for (const auto& rate : wstate.currentWellRates(prod2)) {
+        BOOST_CHECK_EQUAL(rate, 0.0);
+    }
+
+    const std::vector<double> rates2{4.0, 5.0, 6.0};
+    wstate.setCurrentWellRates("PROD2", rates2);
+    const auto& by_index = wstate.currentWellRates(prod2);
+    BOOST_CHECK_EQUAL_COLLECTIONS(by_index.begin(), by_index.end(), rates2.begin(), rates2.end());
+    const auto& by_name = wstate.currentWellRates("PROD1");
+    BOOST_CHECK_EQUAL_COLLECTIONS(by_name.begin(), by_name.end(), rates1.begin(), rates1.end());
+
+    const std::vector<std::size_t> g2{prod1, prod2};
+    const auto& children = wstate.groupWellIndices("G2");
+    BOOST_CHECK_EQUAL_COLLECTIONS(children.begin(), children.end(), g2.begin(), g2.end());
+    BOOST_CHECK_EQUAL(wstate.globalWellName(prod2), "PROD2");
+}
+
 BOOST_AUTO_TEST_CASE(TESTWellContainer) {
     Opm::WellContainer<int> wc;
     BOOST_CHECK_EQUAL(wc.size(), 0);
@@ -506,6 +634,42 @@ BOOST_AUTO_TEST_CASE(TESTWellContainer) {
     BOOST_CHECK(!wx.has_value());
 }
 
+BOOST_AUTO_TEST_CASE(TESTWellContainerSync) {
+    Opm::WellContainer<int> active({{"W1", 1}, {"W2", 2}, {"W3", 3}});
+    Opm::WellContainer<int> committed;
+
+    // Different wells: everything is copied
+    BOOST_CHECK_EQUAL(committed.sync_from(active), 3);
+    BOOST_CHECK(committed == active);
+    BOOST_CHECK_EQUAL(committed.sync_from(active), 0);
+
+    // Only the elements accessed for modification are copied
+    active["W2"] = 20;
+    BOOST_CHECK_EQUAL(committed.sync_from(active), 1);
+    BOOST_CHECK_EQUAL(std::as_const(committed)["W2"], 20);
+
+    // Read access does not mark elements as modified
+    const auto& cactive = active;
+    BOOST_CHECK_EQUAL(cactive[0], 1);
+    BOOST_CHECK_EQUAL(committed.sync_from(active), 0);
+
+    // Resetting restores the modified elements of the snapshot
+    active[0] = 10;
+    active[2] = 30;
+    BOOST_CHECK_EQUAL(active.sync_from(committed), 2);
+    BOOST_CHECK(active == committed);
+    BOOST_CHECK_EQUAL(cactive[0], 1);
+    BOOST_CHECK_EQUAL(cactive[2], 3);
+
+    // Modifications after a reset are still detected
+    active[0] = 100;
+    BOOST_CHECK_EQUAL(committed.sync_from(active), 1);
+    BOOST_CHECK_EQUAL(std::as_const(committed)[0], 100);
+
+    active.mark_modified();
+    BOOST_CHECK_EQUAL(committed.sync_from(active), 3);
+}
+
 BOOST_AUTO_TEST_CASE(TESTSegmentState) {
     const Setup setup{ "msw.data" };
     const auto& well = setup.sched.getWell("PROD01", 0);